@@ -42,6 +42,12 @@ export 'src/config/sonix_config.dart';
 export 'src/models/waveform_data.dart';
 export 'src/models/waveform_type.dart';
 export 'src/models/waveform_metadata.dart';
+export 'src/models/waveform_channel_mode.dart';
+export 'src/models/waveform_bins.dart';
+export 'src/models/waveform_pyramid.dart';
+export 'src/models/waveform_binary_codec.dart';
+export 'src/models/mapped_waveform_data.dart';
+export 'src/models/waveform_priority.dart';
 
 // Audio format enum (from decoders)
 export 'src/decoders/audio_decoder.dart' show AudioFormat;
@@ -54,6 +60,9 @@ export 'src/processing/normalization_method.dart';
 export 'src/processing/scaling_curve.dart';
 export 'src/processing/downsample_method.dart';
 export 'src/processing/upsample_method.dart';
+export 'src/processing/waveform_range_source.dart';
+export 'src/processing/waveform_tile_cache.dart';
+export 'src/processing/waveform_cache.dart';
 
 // Exceptions
 export 'src/exceptions/sonix_exceptions.dart';
@@ -65,3 +74,5 @@ export 'src/widgets/waveform_style.dart';
 export 'src/widgets/waveform_style_presets.dart';
 export 'src/widgets/waveform_widget.dart';
 export 'src/widgets/waveform_controller.dart';
+export 'src/widgets/scrollable_waveform_widget.dart';
+export 'src/widgets/waveform_viewport_controller.dart';
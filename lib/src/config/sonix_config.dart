@@ -1,8 +1,13 @@
 /// Configuration class for Sonix instances
 ///
-/// Provides configuration options for memory usage and logging.
+/// Provides configuration options for memory usage, background workers,
+/// waveform caching and logging.
 class SonixConfig {
   /// Maximum memory usage in bytes
+  ///
+  /// Also the decoded size one file may occupy on the heap: larger files are
+  /// streamed into the waveform or decoded to a memory-mapped scratch file
+  /// (see `AudioFileProcessor.scratchBudget`).
   final int maxMemoryUsage;
 
   /// FFmpeg log level configuration
@@ -21,6 +26,45 @@ class SonixConfig {
   /// noisy MP3 format detection warnings while still showing actual errors.
   final int logLevel;
 
+  /// Number of persistent background isolates used for isolate processing
+  ///
+  /// Workers are started on first use and keep the native libraries loaded
+  /// until the `Sonix` instance is disposed, so batches of short files do
+  /// not pay isolate spawn and FFmpeg initialization costs per file.
+  ///
+  /// * `null` = one worker per CPU core, leaving one core for the UI
+  /// * `0` = no pool; every request spawns and tears down its own isolate
+  final int? workerPoolSize;
+
+  /// Whether the number of concurrent background decodes adapts at runtime
+  ///
+  /// When enabled, background requests start at two concurrent decodes and
+  /// the limit grows towards [workerPoolSize] while throughput improves and
+  /// the memory used by running decodes stays below [maxMemoryUsage]. It is
+  /// halved when that memory exceeds [maxMemoryUsage]. When disabled, every
+  /// worker of the pool is used as soon as there is work.
+  final bool adaptiveConcurrency;
+
+  /// Bytes of generated waveforms kept in memory for repeat requests
+  ///
+  /// Repeat requests for an unchanged file and config return the cached
+  /// waveform instead of decoding again (see `WaveformCache`). `0` disables
+  /// the memory tier.
+  final int waveformCacheSize;
+
+  /// Directory where generated waveforms persist across runs, or null
+  ///
+  /// Entries are keyed by a fingerprint of the file content, its
+  /// modification time and the config, so they stay valid when the app
+  /// restarts and are not served once the file changes. Use an app support
+  /// or cache directory.
+  final String? waveformCacheDirectory;
+
+  /// Bytes the persistent waveform cache may use in [waveformCacheDirectory]
+  ///
+  /// The least recently used entries are deleted beyond this size.
+  final int waveformDiskCacheSize;
+
   /// Global flag to enable debug logging
   ///
   /// When true, debug messages will be logged even in release builds.
@@ -31,6 +75,11 @@ class SonixConfig {
   const SonixConfig({
     this.maxMemoryUsage = 100 * 1024 * 1024, // 100MB
     this.logLevel = 2, // ERROR level - suppresses MP3 warnings
+    this.workerPoolSize,
+    this.adaptiveConcurrency = true,
+    this.waveformCacheSize = 32 * 1024 * 1024, // 32MB
+    this.waveformCacheDirectory,
+    this.waveformDiskCacheSize = 256 * 1024 * 1024, // 256MB
   });
 
   /// Create a default configuration
@@ -40,6 +89,8 @@ class SonixConfig {
   factory SonixConfig.mobile() => const SonixConfig(
     maxMemoryUsage: 50 * 1024 * 1024, // 50MB
     logLevel: 2, // ERROR level - suppress MP3 warnings
+    workerPoolSize: 2, // Limit concurrent decodes on memory-constrained devices
+    waveformCacheSize: 8 * 1024 * 1024, // 8MB
   );
 
   /// Create a configuration optimized for desktop devices
@@ -67,7 +118,11 @@ class SonixConfig {
   String toString() {
     return 'SonixConfig('
         'maxMemoryUsage: ${(maxMemoryUsage / 1024 / 1024).toStringAsFixed(1)}MB, '
-        'logLevel: $logLevel'
+        'logLevel: $logLevel, '
+        'workerPoolSize: ${workerPoolSize ?? 'auto'}, '
+        'adaptiveConcurrency: $adaptiveConcurrency, '
+        'waveformCacheSize: ${(waveformCacheSize / 1024 / 1024).toStringAsFixed(1)}MB, '
+        'waveformCacheDirectory: ${waveformCacheDirectory ?? 'none'}'
         ')';
   }
 }
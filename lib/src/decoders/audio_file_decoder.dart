@@ -7,9 +7,9 @@ import 'package:ffi/ffi.dart';
 
 import '../exceptions/sonix_exceptions.dart';
 import '../models/audio_data.dart';
+import '../native/native_audio_bindings.dart';
 import '../native/sonix_bindings.dart';
 import 'audio_decoder.dart';
-import 'audio_decoder_factory.dart';
 import 'audio_format_service.dart';
 
 /// Abstract interface for file-level audio decoding.
@@ -31,17 +31,19 @@ abstract class AudioFileDecoder {
   void dispose();
 }
 
-/// Simple file decoder that reads the entire file and decodes it at once.
+/// Simple file decoder that decodes the entire file at once.
 ///
 /// This is suitable for:
 /// - Small to medium-sized files that fit in memory
 /// - Cases where you need all audio data before processing
 /// - Simpler use cases without streaming requirements
 ///
+/// The file is decoded by path: FFmpeg reads it through its own buffered I/O,
+/// so the compressed data is never loaded and copied as a whole. Only the
+/// decoded samples are held in memory.
+///
 /// For large files or progressive processing, use [StreamingAudioFileDecoder].
 class SimpleAudioFileDecoder implements AudioFileDecoder {
-  AudioDecoder? _decoder;
-
   @override
   Future<AudioData> decode(String filePath) async {
     final file = File(filePath);
@@ -54,25 +56,12 @@ class SimpleAudioFileDecoder implements AudioFileDecoder {
       throw UnsupportedError('Unsupported audio format: $filePath');
     }
 
-    // Create the appropriate decoder for this format
-    _decoder = AudioDecoderFactory.createDecoderFromFormat(format);
-
-    try {
-      // Read entire file into memory
-      final bytes = await file.readAsBytes();
-
-      // Decode all bytes at once
-      return _decoder!.decode(bytes);
-    } finally {
-      _decoder?.dispose();
-      _decoder = null;
-    }
+    return NativeAudioBindings.decodeFile(filePath);
   }
 
   @override
   void dispose() {
-    _decoder?.dispose();
-    _decoder = null;
+    // Nothing to release: every decode owns its native resources
   }
 }
 
@@ -184,11 +173,12 @@ class StreamingAudioFileDecoder implements AudioFileDecoder {
             // Check if this is the final chunk
             isFinalChunk = result.ref.is_final_chunk == 1;
 
-            // Extract audio data from result
+            // Take ownership of the decoded samples without copying; detach
+            // them so freeing the chunk result leaves them alone
             final audioDataPtr = result.ref.audio_data;
-            if (audioDataPtr != ffi.nullptr) {
-              final audioData = _extractAudioData(audioDataPtr);
-              yield audioData;
+            if (audioDataPtr != ffi.nullptr && audioDataPtr.ref.samples != ffi.nullptr && audioDataPtr.ref.sample_count > 0) {
+              result.ref.audio_data = ffi.nullptr;
+              yield NativeAudioBindings.adoptNativeAudioData(audioDataPtr);
             }
 
             chunkIndex++;
@@ -240,28 +230,9 @@ class StreamingAudioFileDecoder implements AudioFileDecoder {
     }
   }
 
-  /// Extract AudioData from native pointer
-  AudioData _extractAudioData(ffi.Pointer<SonixAudioData> ptr) {
-    final sampleCount = ptr.ref.sample_count;
-    final sampleRate = ptr.ref.sample_rate;
-    final channels = ptr.ref.channels;
-    final durationMs = ptr.ref.duration_ms;
-
-    // Copy samples from native memory
-    final samples = Float32List(sampleCount);
-    for (var i = 0; i < sampleCount; i++) {
-      samples[i] = ptr.ref.samples[i];
-    }
-
-    return AudioData(
-      samples: samples,
-      sampleRate: sampleRate,
-      channels: channels,
-      duration: Duration(milliseconds: durationMs),
-    );
-  }
-
   /// Combine multiple AudioData chunks into a single AudioData.
+  ///
+  /// The chunks are disposed once copied.
   AudioData _combineAudioChunks(List<AudioData> chunks) {
     if (chunks.isEmpty) {
       throw ArgumentError('Cannot combine empty list of chunks');
@@ -297,6 +268,9 @@ class StreamingAudioFileDecoder implements AudioFileDecoder {
       combinedSamples.setRange(offset, offset + chunk.samples.length, chunk.samples);
       offset += chunk.samples.length;
     }
+    for (final chunk in chunks) {
+      chunk.dispose();
+    }
 
     return AudioData(
       samples: combinedSamples,
@@ -0,0 +1,168 @@
+/// Adaptive limit for the number of concurrent background decodes
+///
+/// Grows and shrinks the number of jobs the `WaveformScheduler` runs at once
+/// based on measured throughput and process memory, instead of a fixed
+/// worker count that is either too timid on many-core machines or runs out
+/// of memory on small ones.
+library;
+
+import 'dart:io';
+import 'dart:math' as math;
+
+/// AIMD (additive increase, multiplicative decrease) concurrency controller
+///
+/// The controller measures completed jobs per second over windows of
+/// [sampleInterval] and the memory used by running jobs, i.e. the growth of
+/// the process resident set size ([ProcessInfo.currentRss], which includes
+/// native FFmpeg allocations) over its size while no job was running.
+/// At the end of every window:
+///
+/// * **Memory above [memoryBudget]:** the limit is halved.
+/// * **Throughput fell after the last increase:** the cores (or disk) are
+///   saturated and the extra job only adds contention, so the increase is
+///   undone.
+/// * **Otherwise,** if jobs were waiting and one more job is projected to fit
+///   into [memoryBudget], the limit grows by one.
+///
+/// Independently of the windows, [canStart] refuses to start further jobs
+/// while memory is over budget, so a burst of huge files cannot push the
+/// process past its budget before the next window ends. One job is always
+/// allowed so work keeps progressing.
+///
+/// Example:
+/// ```dart
+/// final pool = IsolateWorkerPool();
+/// final controller = AdaptiveConcurrencyController(
+///   maxConcurrency: pool.size,
+///   memoryBudget: 200 * 1024 * 1024,
+/// );
+/// final scheduler = WaveformScheduler(pool.runMany, controller: controller);
+/// ```
+class AdaptiveConcurrencyController {
+  /// Lower bound of [limit]
+  final int minConcurrency;
+
+  /// Upper bound of [limit], typically the worker pool size
+  final int maxConcurrency;
+
+  /// Memory in bytes that running jobs may use on top of the idle process
+  final int memoryBudget;
+
+  /// Length of a throughput measurement window
+  final Duration sampleInterval;
+
+  /// Relative throughput drop treated as saturation
+  final double saturationTolerance;
+
+  final int Function() _readRss;
+  final Duration Function() _clock;
+
+  int _limit;
+  int _baselineRss;
+  Duration _windowStart;
+  int _completions = 0;
+  bool _backlogSeen = false;
+  bool _increasedLastWindow = false;
+  double? _lastThroughput;
+
+  /// Creates a controller starting at [initialConcurrency]
+  ///
+  /// [initialConcurrency] defaults to two jobs (or [maxConcurrency] if lower),
+  /// letting the limit grow as measurements come in. [readRss] and [clock]
+  /// default to [ProcessInfo.currentRss] and a monotonic stopwatch and can be
+  /// replaced in tests.
+  ///
+  /// Throws [ArgumentError] if the bounds are not positive or not ordered
+  AdaptiveConcurrencyController({
+    required this.maxConcurrency,
+    required this.memoryBudget,
+    this.minConcurrency = 1,
+    int? initialConcurrency,
+    this.sampleInterval = const Duration(seconds: 1),
+    this.saturationTolerance = 0.1,
+    int Function()? readRss,
+    Duration Function()? clock,
+  }) : _readRss = readRss ?? _currentRss,
+       _clock = clock ?? _monotonicClock(),
+       _limit = 0,
+       _baselineRss = 0,
+       _windowStart = Duration.zero {
+    if (minConcurrency <= 0 || maxConcurrency < minConcurrency) {
+      throw ArgumentError('Concurrency bounds must satisfy 0 < minConcurrency ($minConcurrency) <= maxConcurrency ($maxConcurrency)');
+    }
+    _limit = (initialConcurrency ?? math.min(2, maxConcurrency)).clamp(minConcurrency, maxConcurrency);
+    _baselineRss = _readRss();
+    _windowStart = _clock();
+  }
+
+  /// Current number of jobs allowed to run at once
+  int get limit => _limit;
+
+  /// Completed jobs per second measured in the last window, if any
+  double? get throughput => _lastThroughput;
+
+  /// Memory currently used by running jobs, in bytes
+  int get memoryInUse => math.max(0, _readRss() - _baselineRss);
+
+  /// Whether another job may start while [running] jobs are in progress
+  bool canStart(int running) {
+    if (running == 0) {
+      // Idle: re-measure the process without any job in flight
+      _baselineRss = _readRss();
+      return true;
+    }
+    return running < _limit && memoryInUse <= memoryBudget;
+  }
+
+  /// Records that jobs are waiting for a free slot
+  void recordBacklog() {
+    _backlogSeen = true;
+  }
+
+  /// Records a finished job, with [running] jobs still in progress
+  ///
+  /// Re-evaluates [limit] when the current window has ended.
+  void recordCompletion(int running) {
+    _completions++;
+
+    final now = _clock();
+    final elapsed = now - _windowStart;
+    if (elapsed < sampleInterval) return;
+
+    final throughput = _completions * Duration.microsecondsPerSecond / elapsed.inMicroseconds;
+    final memory = memoryInUse;
+    final lastThroughput = _lastThroughput;
+    final increasedLastWindow = _increasedLastWindow;
+    _increasedLastWindow = false;
+
+    if (memory > memoryBudget) {
+      _limit = math.max(minConcurrency, _limit ~/ 2);
+    } else if (increasedLastWindow && lastThroughput != null && throughput < lastThroughput * (1 - saturationTolerance)) {
+      _limit = math.max(minConcurrency, _limit - 1);
+    } else if (_backlogSeen && _limit < maxConcurrency && _fitsAnotherJob(memory, running)) {
+      _limit++;
+      _increasedLastWindow = true;
+    }
+
+    _lastThroughput = throughput;
+    _windowStart = now;
+    _completions = 0;
+    _backlogSeen = false;
+  }
+
+  /// Whether one more job is projected to stay within [memoryBudget]
+  bool _fitsAnotherJob(int memory, int running) {
+    final perJob = memory / math.max(1, running);
+    return perJob * (_limit + 1) <= memoryBudget;
+  }
+
+  static int _currentRss() => ProcessInfo.currentRss;
+
+  static Duration Function() _monotonicClock() {
+    final stopwatch = Stopwatch()..start();
+    return () => stopwatch.elapsed;
+  }
+
+  @override
+  String toString() => 'AdaptiveConcurrencyController(limit: $_limit, range: $minConcurrency..$maxConcurrency, throughput: $_lastThroughput)';
+}
@@ -8,12 +8,11 @@ import 'dart:async';
 import 'dart:isolate';
 
 import 'package:sonix/src/models/waveform_data.dart';
-import 'package:sonix/src/models/audio_data.dart';
 import 'package:sonix/src/processing/audio_file_processor.dart';
 import 'package:sonix/src/processing/waveform_config.dart';
-import 'package:sonix/src/processing/waveform_generator.dart';
 import 'package:sonix/src/exceptions/sonix_exceptions.dart';
 import 'package:sonix/src/native/native_audio_bindings.dart';
+import 'package:sonix/src/isolate/waveform_job.dart';
 
 /// Runs waveform generation in a background isolate
 ///
@@ -29,8 +28,12 @@ import 'package:sonix/src/native/native_audio_bindings.dart';
 /// );
 /// ```
 class IsolateRunner {
+  /// Decoded size in bytes a job may hold on the heap, see
+  /// [AudioFileProcessor.scratchBudget]
+  final int scratchBudget;
+
   /// Creates a new isolate runner
-  const IsolateRunner();
+  const IsolateRunner({this.scratchBudget = AudioFileProcessor.defaultScratchBudget});
 
   /// Runs waveform generation in a background isolate
   ///
@@ -46,10 +49,31 @@ class IsolateRunner {
   /// Throws [IsolateSpawnException] if the isolate fails to spawn
   /// Throws [SonixException] subclasses for processing errors
   Future<WaveformData> run(String filePath, WaveformConfig config) async {
+    final results = await _spawn(filePath, [config]);
+    return results.single;
+  }
+
+  /// Runs generation of several waveforms from one file in a background isolate
+  ///
+  /// The file is decoded once and every config is reduced from the same
+  /// decoded frames (see `MultiWaveformGenerator`).
+  ///
+  /// [filePath] - Path to the audio file to process
+  /// [configs] - One configuration per waveform to generate
+  ///
+  /// Returns one [WaveformData] per config, in the same order
+  ///
+  /// Throws [IsolateSpawnException] if the isolate fails to spawn
+  /// Throws [SonixException] subclasses for processing errors
+  Future<List<WaveformData>> runMany(String filePath, List<WaveformConfig> configs) {
+    return _spawn(filePath, List<WaveformConfig>.unmodifiable(configs));
+  }
+
+  Future<List<WaveformData>> _spawn(String filePath, List<WaveformConfig> configs) async {
     final receivePort = ReceivePort();
     final errorPort = ReceivePort();
     final exitPort = ReceivePort();
-    final completer = Completer<WaveformData>();
+    final completer = Completer<List<WaveformData>>();
 
     void cleanup(Isolate? isolate) {
       receivePort.close();
@@ -65,7 +89,8 @@ class IsolateRunner {
         _IsolateEntryPoint.process,
         _IsolateParams(
           filePath: filePath,
-          config: config,
+          configs: configs,
+          scratchBudget: scratchBudget,
           sendPort: receivePort.sendPort,
         ),
         onError: errorPort.sendPort,
@@ -118,14 +143,12 @@ class IsolateRunner {
 
       cleanup(isolate);
 
-      if (message is _IsolateSuccess) {
-        completer.complete(message.waveformData);
-      } else if (message is _IsolateError) {
+      if (message is WaveformJobSuccess) {
+        completer.complete(message.unpack());
+      } else if (message is WaveformJobError) {
         completer.completeError(
-          _ErrorReconstructor.reconstruct(message),
-          message.stackTrace != null
-              ? StackTrace.fromString(message.stackTrace!)
-              : null,
+          message.toException(),
+          message.remoteStackTrace,
         );
       } else {
         completer.completeError(
@@ -144,38 +167,18 @@ class IsolateRunner {
 /// Parameters passed to the isolate
 class _IsolateParams {
   final String filePath;
-  final WaveformConfig config;
+  final List<WaveformConfig> configs;
+  final int scratchBudget;
   final SendPort sendPort;
 
   const _IsolateParams({
     required this.filePath,
-    required this.config,
+    required this.configs,
+    required this.scratchBudget,
     required this.sendPort,
   });
 }
 
-/// Result types from isolate processing
-sealed class _IsolateResult {}
-
-class _IsolateSuccess extends _IsolateResult {
-  final WaveformData waveformData;
-  _IsolateSuccess(this.waveformData);
-}
-
-class _IsolateError extends _IsolateResult {
-  final String errorType;
-  final String message;
-  final String? details;
-  final String? stackTrace;
-
-  _IsolateError({
-    required this.errorType,
-    required this.message,
-    this.details,
-    this.stackTrace,
-  });
-}
-
 /// Entry point for the processing isolate
 class _IsolateEntryPoint {
   _IsolateEntryPoint._();
@@ -188,77 +191,22 @@ class _IsolateEntryPoint {
   }
 
   /// Async processing logic
-  static Future<_IsolateResult> _processAsync(_IsolateParams params) async {
+  static Future<WaveformJobResult> _processAsync(_IsolateParams params) async {
     try {
       // Initialize native bindings in this isolate context
       NativeAudioBindings.initialize();
-
-      if (!NativeAudioBindings.isFFMPEGAvailable) {
-        return _IsolateError(
-          errorType: 'FFIException',
-          message: 'FFMPEG not available in isolate',
-          details:
-              'FFMPEG libraries are required but not available in this isolate context. '
-              'Please install system FFmpeg (on macOS via Homebrew: brew install ffmpeg).',
-        );
-      }
-
-      // Decode audio
-      final processor = AudioFileProcessor();
-      final AudioData audioData = await processor.process(params.filePath);
-
-      // Generate waveform
-      final waveformData = await WaveformGenerator.generateInMemory(
-        audioData,
-        config: params.config,
-      );
-
-      // Cleanup before returning
-      NativeAudioBindings.cleanup();
-
-      return _IsolateSuccess(waveformData);
     } catch (error, stackTrace) {
-      // Attempt cleanup even on error
-      try {
-        NativeAudioBindings.cleanup();
-      } catch (_) {}
-
-      return _IsolateError(
-        errorType: error.runtimeType.toString(),
-        message: error is SonixException ? error.message : error.toString(),
-        details: error is SonixException ? error.details : null,
-        stackTrace: stackTrace.toString(),
-      );
+      return WaveformJobError.from(error, stackTrace);
     }
-  }
-}
 
-/// Reconstructs exceptions from isolate error data
-class _ErrorReconstructor {
-  _ErrorReconstructor._();
+    final result = await WaveformJob.execute(params.filePath, params.configs, scratchBudget: params.scratchBudget);
 
-  static SonixException reconstruct(_IsolateError error) {
-    return switch (error.errorType) {
-      'UnsupportedFormatException' => UnsupportedFormatException(
-          error.message,
-          error.details,
-        ),
-      'DecodingException' => DecodingException(error.message, error.details),
-      'MemoryException' => MemoryException(error.message, error.details),
-      'FileAccessException' => FileAccessException(
-          '',
-          error.message,
-          error.details,
-        ),
-      'FileNotFoundException' => FileNotFoundException('', error.details),
-      'CorruptedFileException' => CorruptedFileException('', error.details),
-      'FFIException' => FFIException(error.message, error.details),
-      _ => IsolateProcessingException(
-          'unknown',
-          error.message,
-          details: error.details,
-        ),
-    };
+    // Cleanup before returning
+    try {
+      NativeAudioBindings.cleanup();
+    } catch (_) {}
+
+    return result;
   }
 }
 
@@ -0,0 +1,381 @@
+/// Persistent pool of waveform worker isolates
+///
+/// Keeps a fixed number of long-lived isolates with native bindings and
+/// FFmpeg initialized, so many short jobs do not each pay for spawning an
+/// isolate and loading the native libraries.
+library;
+
+import 'dart:async';
+import 'dart:collection';
+import 'dart:io';
+import 'dart:isolate';
+import 'dart:math' as math;
+
+import 'package:sonix/src/models/waveform_data.dart';
+import 'package:sonix/src/processing/audio_file_processor.dart';
+import 'package:sonix/src/processing/waveform_config.dart';
+import 'package:sonix/src/exceptions/sonix_exceptions.dart';
+import 'package:sonix/src/native/native_audio_bindings.dart';
+import 'package:sonix/src/isolate/isolate_runner.dart';
+import 'package:sonix/src/isolate/waveform_job.dart';
+
+/// Runs waveform generation on a pool of persistent background isolates
+///
+/// Workers are spawned lazily up to [size] as jobs arrive and then stay
+/// alive until [close] is called. Each worker initializes the native
+/// bindings once and processes one job at a time. Jobs that cannot start
+/// immediately wait in a FIFO queue; once [maxQueueLength] jobs are waiting,
+/// further submissions wait for queue space (back-pressure) instead of
+/// growing the queue without bound.
+///
+/// A worker that crashes fails only its current job and is replaced on
+/// demand.
+///
+/// Example:
+/// ```dart
+/// final pool = IsolateWorkerPool(size: 4);
+/// try {
+///   final waveforms = await Future.wait([
+///     for (final path in clipPaths) pool.run(path, const WaveformConfig(resolution: 200)),
+///   ]);
+/// } finally {
+///   await pool.close();
+/// }
+/// ```
+class IsolateWorkerPool {
+  /// Default number of jobs that may wait for a worker before submissions block
+  static const int defaultMaxQueueLength = 256;
+
+  /// Maximum number of worker isolates
+  final int size;
+
+  /// Maximum number of jobs waiting for a worker
+  final int maxQueueLength;
+
+  /// Decoded size in bytes a job may hold on the heap, see
+  /// [AudioFileProcessor.scratchBudget]
+  final int scratchBudget;
+
+  final Queue<_PoolJob> _queue = Queue<_PoolJob>();
+  final Queue<Completer<void>> _spaceWaiters = Queue<Completer<void>>();
+  final List<_PoolWorker> _workers = [];
+  final List<_PoolWorker> _idleWorkers = [];
+  Completer<void>? _closed;
+
+  /// Creates a pool of up to [size] workers
+  ///
+  /// [size] defaults to [defaultSize]. No isolate is spawned until the first
+  /// job is submitted.
+  ///
+  /// Throws [ArgumentError] if [size] or [maxQueueLength] is not positive
+  IsolateWorkerPool({int? size, this.maxQueueLength = defaultMaxQueueLength, this.scratchBudget = AudioFileProcessor.defaultScratchBudget})
+    : size = size ?? defaultSize {
+    if (this.size <= 0) {
+      throw ArgumentError.value(this.size, 'size', 'Must be positive');
+    }
+    if (maxQueueLength <= 0) {
+      throw ArgumentError.value(maxQueueLength, 'maxQueueLength', 'Must be positive');
+    }
+  }
+
+  /// One worker per core, leaving a core for the UI isolate
+  static int get defaultSize => math.max(1, Platform.numberOfProcessors - 1);
+
+  /// Number of worker isolates currently alive or starting
+  int get workerCount => _workers.length;
+
+  /// Number of jobs currently being processed
+  int get activeJobs => _workers.where((worker) => worker.job != null).length;
+
+  /// Number of jobs waiting for a worker
+  int get queuedJobs => _queue.length;
+
+  /// Whether [close] has been called
+  bool get isClosed => _closed != null;
+
+  /// Generates one waveform on a pool worker
+  ///
+  /// Throws [StateError] if the pool has been closed
+  /// Throws [SonixException] subclasses for processing errors
+  Future<WaveformData> run(String filePath, WaveformConfig config) async {
+    final results = await runMany(filePath, [config]);
+    return results.single;
+  }
+
+  /// Generates several waveforms from one decode on a pool worker
+  ///
+  /// Completes once the job has finished. If [maxQueueLength] jobs are
+  /// already waiting, the job is only queued once space becomes available.
+  ///
+  /// Throws [StateError] if the pool has been closed
+  /// Throws [SonixException] subclasses for processing errors
+  Future<List<WaveformData>> runMany(String filePath, List<WaveformConfig> configs) async {
+    _ensureOpen();
+    while (_queue.length >= maxQueueLength) {
+      final space = Completer<void>();
+      _spaceWaiters.add(space);
+      await space.future;
+      _ensureOpen();
+    }
+
+    final job = _PoolJob(filePath, List<WaveformConfig>.unmodifiable(configs));
+    _queue.add(job);
+    _dispatch();
+    return job.completer.future;
+  }
+
+  /// Shuts the pool down
+  ///
+  /// Jobs that are still queued fail with [StateError]; jobs already running
+  /// complete normally. The returned future completes once every worker has
+  /// exited. Calling [close] again returns the same future.
+  Future<void> close() {
+    if (_closed != null) return _closed!.future;
+    final closed = _closed = Completer<void>();
+
+    while (_queue.isNotEmpty) {
+      _queue.removeFirst().completer.completeError(StateError('IsolateWorkerPool has been closed'));
+    }
+    _releaseSpace(all: true);
+
+    for (final worker in _workers) {
+      worker.shutdown();
+    }
+    _completeCloseIfDone();
+    return closed.future;
+  }
+
+  /// Hands queued jobs to idle workers and starts workers for the rest
+  void _dispatch() {
+    while (_queue.isNotEmpty && _idleWorkers.isNotEmpty) {
+      final worker = _idleWorkers.removeLast();
+      worker.start(_queue.removeFirst(), scratchBudget);
+      _releaseSpace();
+    }
+
+    final starting = _workers.where((worker) => worker.isStarting).length;
+    var needed = _queue.length - starting;
+    while (needed > 0 && _workers.length < size) {
+      _spawnWorker();
+      needed--;
+    }
+  }
+
+  void _spawnWorker() {
+    final worker = _PoolWorker(onReady: _onWorkerReady, onDone: _onWorkerDone, onExit: _onWorkerExit);
+    _workers.add(worker);
+    worker.spawn().catchError((Object error) {
+      _workers.remove(worker);
+      // Spawning fails for every worker alike, so fail the waiting jobs
+      // instead of leaving them queued forever.
+      if (_workers.isEmpty) {
+        while (_queue.isNotEmpty) {
+          _queue.removeFirst().completer.completeError(IsolateSpawnException('Failed to spawn worker isolate: $error'));
+        }
+        _releaseSpace(all: true);
+      }
+      _completeCloseIfDone();
+    });
+  }
+
+  void _onWorkerReady(_PoolWorker worker) {
+    if (isClosed) {
+      worker.shutdown();
+      return;
+    }
+    _idleWorkers.add(worker);
+    _dispatch();
+  }
+
+  void _onWorkerDone(_PoolWorker worker) {
+    if (isClosed) return;
+    _idleWorkers.add(worker);
+    _dispatch();
+  }
+
+  void _onWorkerExit(_PoolWorker worker) {
+    _workers.remove(worker);
+    _idleWorkers.remove(worker);
+    if (isClosed) {
+      _completeCloseIfDone();
+    } else {
+      // Replace the worker if jobs are waiting
+      _dispatch();
+    }
+  }
+
+  /// Wakes one submission waiting for queue space, or all of them when closing
+  void _releaseSpace({bool all = false}) {
+    if (all) {
+      while (_spaceWaiters.isNotEmpty) {
+        _spaceWaiters.removeFirst().complete();
+      }
+    } else if (_spaceWaiters.isNotEmpty && _queue.length < maxQueueLength) {
+      _spaceWaiters.removeFirst().complete();
+    }
+  }
+
+  void _completeCloseIfDone() {
+    final closed = _closed;
+    if (closed != null && !closed.isCompleted && _workers.isEmpty) {
+      closed.complete();
+    }
+  }
+
+  void _ensureOpen() {
+    if (isClosed) {
+      throw StateError('IsolateWorkerPool has been closed');
+    }
+  }
+}
+
+/// A job waiting for or running on a worker
+class _PoolJob {
+  final String filePath;
+  final List<WaveformConfig> configs;
+  final Completer<List<WaveformData>> completer = Completer<List<WaveformData>>();
+
+  _PoolJob(this.filePath, this.configs);
+}
+
+/// Job message sent to a worker isolate
+class _WorkerRequest {
+  final String filePath;
+  final List<WaveformConfig> configs;
+  final int scratchBudget;
+
+  const _WorkerRequest(this.filePath, this.configs, this.scratchBudget);
+}
+
+/// Main-isolate handle of one worker isolate
+class _PoolWorker {
+  final void Function(_PoolWorker worker) onReady;
+  final void Function(_PoolWorker worker) onDone;
+  final void Function(_PoolWorker worker) onExit;
+
+  final ReceivePort _messages = ReceivePort();
+  final ReceivePort _errors = ReceivePort();
+  final ReceivePort _exits = ReceivePort();
+  SendPort? _commands;
+  bool _shuttingDown = false;
+
+  /// Job currently running on this worker
+  _PoolJob? job;
+
+  _PoolWorker({required this.onReady, required this.onDone, required this.onExit});
+
+  /// Whether the worker has not finished its startup handshake yet
+  bool get isStarting => _commands == null && !_shuttingDown;
+
+  Future<void> spawn() async {
+    _messages.listen(_handleMessage);
+    _errors.listen(_handleError);
+    _exits.listen((_) => _handleExit());
+
+    try {
+      await Isolate.spawn(_WorkerEntryPoint.main, _messages.sendPort, onError: _errors.sendPort, onExit: _exits.sendPort);
+    } catch (_) {
+      _closePorts();
+      rethrow;
+    }
+  }
+
+  void start(_PoolJob job, int scratchBudget) {
+    this.job = job;
+    _commands!.send(_WorkerRequest(job.filePath, job.configs, scratchBudget));
+  }
+
+  /// Asks the worker to exit once its current job is done
+  void shutdown() {
+    if (_shuttingDown) return;
+    _shuttingDown = true;
+    // Workers that have not finished starting receive the request from the
+    // pool once they report ready.
+    _commands?.send(null);
+  }
+
+  void _handleMessage(dynamic message) {
+    if (message is SendPort) {
+      _commands = message;
+      if (_shuttingDown) {
+        message.send(null);
+      } else {
+        onReady(this);
+      }
+      return;
+    }
+
+    final job = this.job;
+    if (job == null) return;
+    this.job = null;
+
+    if (message is WaveformJobSuccess) {
+      job.completer.complete(message.unpack());
+    } else if (message is WaveformJobError) {
+      job.completer.completeError(message.toException(), message.remoteStackTrace);
+    } else {
+      job.completer.completeError(IsolateProcessingException('unknown', 'Unexpected message type from worker: ${message.runtimeType}'));
+    }
+    onDone(this);
+  }
+
+  void _handleError(dynamic message) {
+    final job = this.job;
+    if (job == null) return;
+    this.job = null;
+
+    if (message is List && message.length >= 2) {
+      job.completer.completeError(IsolateProcessingException('isolate_error', message[0].toString(), details: message[1]?.toString()));
+    } else {
+      job.completer.completeError(IsolateProcessingException('isolate_error', 'Unknown error from worker: $message'));
+    }
+  }
+
+  void _handleExit() {
+    final job = this.job;
+    this.job = null;
+    job?.completer.completeError(IsolateProcessingException('isolate_exit', 'Worker isolate exited unexpectedly without sending a result'));
+
+    _shuttingDown = true;
+    _closePorts();
+    onExit(this);
+  }
+
+  void _closePorts() {
+    _messages.close();
+    _errors.close();
+    _exits.close();
+  }
+}
+
+/// Code running inside a worker isolate
+class _WorkerEntryPoint {
+  _WorkerEntryPoint._();
+
+  /// Initializes native bindings once, then serves jobs until told to stop
+  ///
+  /// Jobs are handled strictly one after another; a `null` message ends the
+  /// loop and exits the isolate.
+  static Future<void> main(SendPort replyPort) async {
+    final commands = ReceivePort();
+
+    WaveformJobError? initError;
+    try {
+      NativeAudioBindings.initialize();
+    } catch (error, stackTrace) {
+      initError = WaveformJobError.from(error, stackTrace);
+    }
+
+    replyPort.send(commands.sendPort);
+
+    await for (final message in commands) {
+      if (message is! _WorkerRequest) break;
+      replyPort.send(initError ?? await WaveformJob.execute(message.filePath, message.configs, scratchBudget: message.scratchBudget));
+    }
+
+    // FFmpeg state is process-wide and may still be used by other isolates,
+    // so it is deliberately not deinitialized here.
+    commands.close();
+    Isolate.exit();
+  }
+}
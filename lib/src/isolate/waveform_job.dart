@@ -0,0 +1,118 @@
+/// Waveform generation job shared by the background isolate implementations
+///
+/// Both the spawn-per-request `IsolateRunner` and the persistent
+/// `IsolateWorkerPool` run the same job inside their isolates and send the
+/// resulting [WaveformJobResult] back to the calling isolate.
+library;
+
+import 'package:sonix/src/models/waveform_data.dart';
+import 'package:sonix/src/processing/audio_file_processor.dart';
+import 'package:sonix/src/processing/multi_waveform_generator.dart';
+import 'package:sonix/src/processing/waveform_config.dart';
+import 'package:sonix/src/exceptions/sonix_exceptions.dart';
+import 'package:sonix/src/native/native_audio_bindings.dart';
+import 'package:sonix/src/isolate/waveform_transfer.dart';
+
+/// Result of a waveform job, sent from a background isolate
+sealed class WaveformJobResult {
+  const WaveformJobResult();
+}
+
+/// Waveforms generated by a successful job, one per config
+///
+/// The numeric buffers travel as a [WaveformTransfer], so sending the result
+/// to the calling isolate does not copy or box the amplitudes.
+class WaveformJobSuccess extends WaveformJobResult {
+  final WaveformTransfer _transfer;
+
+  /// Packs [waveforms] for transfer; call in the isolate that generated them
+  WaveformJobSuccess(List<WaveformData> waveforms) : _transfer = WaveformTransfer.pack(waveforms);
+
+  /// Unpacks the waveforms; call once, in the receiving isolate
+  List<WaveformData> unpack() => _transfer.unpack();
+}
+
+/// Serializable description of an error raised by a job
+///
+/// Exceptions cannot be sent between isolates reliably, so the error is sent
+/// as plain data and rebuilt with [toException] on the receiving side.
+class WaveformJobError extends WaveformJobResult {
+  final String errorType;
+  final String message;
+  final String? details;
+  final String? stackTrace;
+
+  const WaveformJobError({required this.errorType, required this.message, this.details, this.stackTrace});
+
+  /// Captures [error] thrown inside the isolate
+  factory WaveformJobError.from(Object error, StackTrace stackTrace) {
+    return WaveformJobError(
+      errorType: error.runtimeType.toString(),
+      message: error is SonixException ? error.message : error.toString(),
+      details: error is SonixException ? error.details : null,
+      stackTrace: stackTrace.toString(),
+    );
+  }
+
+  /// Error returned when the FFmpeg libraries cannot be loaded in the isolate
+  factory WaveformJobError.ffmpegUnavailable() {
+    return const WaveformJobError(
+      errorType: 'FFIException',
+      message: 'FFMPEG not available in isolate',
+      details:
+          'FFMPEG libraries are required but not available in this isolate context. '
+          'Please install system FFmpeg (on macOS via Homebrew: brew install ffmpeg).',
+    );
+  }
+
+  /// Rebuilds the original exception type where possible
+  SonixException toException() {
+    return switch (errorType) {
+      'UnsupportedFormatException' => UnsupportedFormatException(message, details),
+      'DecodingException' => DecodingException(message, details),
+      'MemoryException' => MemoryException(message, details),
+      'FileAccessException' => FileAccessException('', message, details),
+      'FileNotFoundException' => FileNotFoundException('', details),
+      'CorruptedFileException' => CorruptedFileException('', details),
+      'FFIException' => FFIException(message, details),
+      _ => IsolateProcessingException('unknown', message, details: details),
+    };
+  }
+
+  /// Stack trace captured in the isolate, if any
+  StackTrace? get remoteStackTrace => stackTrace != null ? StackTrace.fromString(stackTrace!) : null;
+}
+
+/// Runs waveform jobs inside a background isolate
+class WaveformJob {
+  WaveformJob._();
+
+  /// Decodes [filePath] and generates one waveform per config
+  ///
+  /// Native bindings must already be initialized in the calling isolate.
+  /// A single config goes through `AudioFileProcessor.generateWaveform`, which
+  /// streams large files into the waveform; several configs share one decode
+  /// via [MultiWaveformGenerator]. Both hold at most [scratchBudget] bytes of
+  /// decoded audio on the heap (see [AudioFileProcessor.scratchBudget]).
+  /// Never throws; failures are returned as [WaveformJobError].
+  static Future<WaveformJobResult> execute(
+    String filePath,
+    List<WaveformConfig> configs, {
+    int scratchBudget = AudioFileProcessor.defaultScratchBudget,
+  }) async {
+    try {
+      if (!NativeAudioBindings.isFFMPEGAvailable) {
+        return WaveformJobError.ffmpegUnavailable();
+      }
+
+      if (configs.length == 1) {
+        return WaveformJobSuccess([await AudioFileProcessor(scratchBudget: scratchBudget).generateWaveform(filePath, config: configs.single)]);
+      }
+
+      // Decode once, reduce once per config
+      return WaveformJobSuccess(await MultiWaveformGenerator.generate(filePath, configs, scratchBudget: scratchBudget));
+    } catch (error, stackTrace) {
+      return WaveformJobError.from(error, stackTrace);
+    }
+  }
+}
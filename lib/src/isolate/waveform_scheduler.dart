@@ -0,0 +1,206 @@
+/// Deduplicating priority scheduler for background waveform jobs
+///
+/// Sits in front of the isolate workers so identical concurrent requests
+/// share one decode and visible work is started before prefetch work.
+library;
+
+import 'dart:async';
+import 'dart:collection';
+import 'dart:io';
+
+import 'package:sonix/src/isolate/adaptive_concurrency_controller.dart';
+import 'package:sonix/src/models/waveform_data.dart';
+import 'package:sonix/src/models/waveform_priority.dart';
+import 'package:sonix/src/processing/waveform_config.dart';
+
+/// Runs one job on a background isolate
+typedef WaveformJobExecutor = Future<List<WaveformData>> Function(String filePath, List<WaveformConfig> configs);
+
+/// Schedules waveform jobs by priority and merges identical requests
+///
+/// Requests are keyed by file path, file modification time and configs.
+/// A request whose key matches a queued or running job joins that job and
+/// receives copies of its results instead of decoding again; if it has a
+/// higher priority, a queued job is moved up accordingly.
+///
+/// At most [maxConcurrent] jobs are handed to the executor at a time, or as
+/// many as the [controller] currently allows if one is given. The rest wait
+/// in one FIFO queue per [WaveformPriority] and the highest priority is
+/// started first, so high-priority work preempts queued low-priority work.
+/// Jobs already running are not interrupted.
+///
+/// Example:
+/// ```dart
+/// final pool = IsolateWorkerPool();
+/// final scheduler = WaveformScheduler(pool.runMany, maxConcurrent: pool.size);
+///
+/// final waveforms = await scheduler.schedule(
+///   'track.mp3',
+///   const [WaveformConfig(resolution: 200)],
+///   priority: WaveformPriority.visible,
+/// );
+/// ```
+class WaveformScheduler {
+  final WaveformJobExecutor _executor;
+
+  /// Maximum number of jobs running at once, or null for no limit
+  final int? maxConcurrent;
+
+  /// Adaptive limit used instead of [maxConcurrent] if set
+  final AdaptiveConcurrencyController? controller;
+
+  final Map<_JobKey, _ScheduledJob> _jobs = {};
+  final List<Queue<_ScheduledJob>> _queues = List.generate(WaveformPriority.values.length, (_) => Queue<_ScheduledJob>());
+  int _running = 0;
+  bool _closed = false;
+
+  /// Creates a scheduler that runs jobs with [executor]
+  ///
+  /// Throws [ArgumentError] if [maxConcurrent] is not positive
+  WaveformScheduler(WaveformJobExecutor executor, {this.maxConcurrent, this.controller}) : _executor = executor {
+    if (maxConcurrent != null && maxConcurrent! <= 0) {
+      throw ArgumentError.value(maxConcurrent, 'maxConcurrent', 'Must be positive');
+    }
+  }
+
+  /// Number of jobs handed to the executor and not yet finished
+  int get runningJobs => _running;
+
+  /// Number of jobs waiting to be started
+  int get queuedJobs => _queues.fold(0, (sum, queue) => sum + queue.length);
+
+  /// Schedules generation of one waveform per config from [filePath]
+  ///
+  /// Joins an identical in-flight job if there is one; callers that join
+  /// receive copies of its results (see `WaveformData.copy`).
+  ///
+  /// Throws [StateError] if the scheduler has been closed
+  Future<List<WaveformData>> schedule(String filePath, List<WaveformConfig> configs, {WaveformPriority priority = WaveformPriority.normal}) async {
+    _ensureOpen();
+    final key = _JobKey(filePath, await _modificationTime(filePath), List<WaveformConfig>.unmodifiable(configs));
+    _ensureOpen();
+
+    final existing = _jobs[key];
+    if (existing != null) {
+      _promote(existing, priority);
+      // Every caller owns its result and may dispose or edit it
+      final waveforms = await existing.completer.future;
+      return [for (final waveform in waveforms) waveform.copy()];
+    }
+
+    final job = _ScheduledJob(key, priority);
+    _jobs[key] = job;
+    _queues[priority.index].add(job);
+    _pump();
+    return job.completer.future;
+  }
+
+  /// Fails all queued jobs and rejects new ones
+  ///
+  /// Running jobs complete normally.
+  void close() {
+    if (_closed) return;
+    _closed = true;
+
+    for (final queue in _queues) {
+      while (queue.isNotEmpty) {
+        final job = queue.removeFirst();
+        _jobs.remove(job.key);
+        job.completer.completeError(StateError('WaveformScheduler has been closed'));
+      }
+    }
+  }
+
+  /// Moves a queued job to a higher priority queue
+  void _promote(_ScheduledJob job, WaveformPriority priority) {
+    if (job.isRunning || priority.index <= job.priority.index) return;
+
+    _queues[job.priority.index].remove(job);
+    job.priority = priority;
+    _queues[priority.index].add(job);
+  }
+
+  /// Starts queued jobs, highest priority first, while there is capacity
+  void _pump() {
+    while (queuedJobs > 0) {
+      if (!_hasCapacity()) {
+        controller?.recordBacklog();
+        return;
+      }
+      _start(_nextJob()!);
+    }
+  }
+
+  bool _hasCapacity() {
+    final controller = this.controller;
+    if (controller != null) return controller.canStart(_running);
+    return maxConcurrent == null || _running < maxConcurrent!;
+  }
+
+  _ScheduledJob? _nextJob() {
+    for (int i = _queues.length - 1; i >= 0; i--) {
+      if (_queues[i].isNotEmpty) return _queues[i].removeFirst();
+    }
+    return null;
+  }
+
+  void _start(_ScheduledJob job) {
+    job.isRunning = true;
+    _running++;
+
+    _executor(job.key.filePath, job.key.configs)
+        .then(job.completer.complete, onError: job.completer.completeError)
+        .whenComplete(() {
+          _running--;
+          _jobs.remove(job.key);
+          controller?.recordCompletion(_running);
+          if (!_closed) _pump();
+        });
+  }
+
+  void _ensureOpen() {
+    if (_closed) {
+      throw StateError('WaveformScheduler has been closed');
+    }
+  }
+
+  /// Modification time used in the dedup key, or null if the file is missing
+  static Future<DateTime?> _modificationTime(String filePath) async {
+    final stat = await FileStat.stat(filePath);
+    return stat.type == FileSystemEntityType.notFound ? null : stat.modified;
+  }
+}
+
+/// Identity of a job for deduplication
+class _JobKey {
+  final String filePath;
+  final DateTime? modified;
+  final List<WaveformConfig> configs;
+
+  const _JobKey(this.filePath, this.modified, this.configs);
+
+  @override
+  bool operator ==(Object other) {
+    if (identical(this, other)) return true;
+    if (other is! _JobKey || other.filePath != filePath || other.modified != modified || other.configs.length != configs.length) {
+      return false;
+    }
+    for (int i = 0; i < configs.length; i++) {
+      if (other.configs[i] != configs[i]) return false;
+    }
+    return true;
+  }
+
+  @override
+  int get hashCode => Object.hash(filePath, modified, Object.hashAll(configs));
+}
+
+/// A queued or running job and the callers waiting for it
+class _ScheduledJob {
+  final _JobKey key;
+  final Completer<List<WaveformData>> completer = Completer<List<WaveformData>>();
+  WaveformPriority priority;
+  bool isRunning = false;
+
+  _ScheduledJob(this.key, this.priority);
+}
@@ -0,0 +1,153 @@
+/// Zero-copy transfer of waveform results between isolates
+///
+/// Sending a [WaveformData] through a [SendPort] deep-copies every list and
+/// boxes every amplitude. [WaveformTransfer] instead packs all numeric
+/// buffers of a job's waveforms into a single [TransferableTypedData], which
+/// moves between isolates in O(1) and is exposed on the receiving side as
+/// [Float32List] views without any further copy.
+library;
+
+import 'dart:isolate';
+import 'dart:typed_data';
+
+import 'package:sonix/src/models/waveform_bins.dart';
+import 'package:sonix/src/models/waveform_channel_mode.dart';
+import 'package:sonix/src/models/waveform_data.dart';
+import 'package:sonix/src/models/waveform_metadata.dart';
+import 'package:sonix/src/models/waveform_pyramid.dart';
+
+/// Waveforms packed for transfer to another isolate
+///
+/// Created with [WaveformTransfer.pack] in the worker isolate and sent as
+/// part of a message; the receiving isolate calls [unpack] exactly once.
+///
+/// Example:
+/// ```dart
+/// // In the worker isolate
+/// replyPort.send(WaveformTransfer.pack(waveforms));
+///
+/// // In the receiving isolate
+/// final waveforms = (message as WaveformTransfer).unpack();
+/// ```
+class WaveformTransfer {
+  final TransferableTypedData _buffer;
+  final List<_WaveformLayout> _layouts;
+
+  WaveformTransfer._(this._buffer, this._layouts);
+
+  /// Packs the numeric data of [waveforms] into one transferable buffer
+  ///
+  /// Everything besides the typed buffers (metadata, duration, sample rate)
+  /// is small and travels as regular message data.
+  factory WaveformTransfer.pack(List<WaveformData> waveforms) {
+    final buffers = <TypedData>[];
+    final layouts = <_WaveformLayout>[];
+
+    for (final waveform in waveforms) {
+      final amplitudes = waveform.amplitudes;
+      buffers.add(amplitudes);
+
+      final channelAmplitudes = waveform.channelAmplitudes;
+      if (channelAmplitudes != null) buffers.add(channelAmplitudes);
+
+      final bins = waveform.bins;
+      if (bins != null) buffers.add(bins.data);
+
+      final pyramid = waveform.pyramid;
+      if (pyramid != null) {
+        for (final level in pyramid.levels) {
+          buffers.add(level.data);
+        }
+      }
+
+      layouts.add(
+        _WaveformLayout(
+          duration: waveform.duration,
+          sampleRate: waveform.sampleRate,
+          metadata: waveform.metadata,
+          channelCount: waveform.channelCount,
+          channelMode: waveform.channelMode,
+          amplitudeCount: amplitudes.length,
+          channelValueCount: channelAmplitudes?.length,
+          binValueCount: bins?.data.length,
+          pyramidLevelValueCounts: pyramid?.levels.map((level) => level.data.length).toList(),
+          pyramidBaseFramesPerBin: pyramid?.baseFramesPerBin ?? 0,
+          pyramidSampleRate: pyramid?.sampleRate ?? 0,
+          pyramidTotalFrames: pyramid?.totalFrames ?? 0,
+        ),
+      );
+    }
+
+    return WaveformTransfer._(TransferableTypedData.fromList(buffers), layouts);
+  }
+
+  /// Number of packed waveforms
+  int get length => _layouts.length;
+
+  /// Rebuilds the waveforms as views over the transferred buffer
+  ///
+  /// May only be called once, in the receiving isolate.
+  List<WaveformData> unpack() {
+    final buffer = _buffer.materialize();
+    var offset = 0;
+
+    Float32List take(int length) {
+      final view = Float32List.view(buffer, offset, length);
+      offset += length * Float32List.bytesPerElement;
+      return view;
+    }
+
+    return [
+      for (final layout in _layouts)
+        WaveformData(
+          amplitudes: take(layout.amplitudeCount),
+          duration: layout.duration,
+          sampleRate: layout.sampleRate,
+          metadata: layout.metadata,
+          channelAmplitudes: layout.channelValueCount == null ? null : take(layout.channelValueCount!),
+          channelCount: layout.channelCount,
+          channelMode: layout.channelMode,
+          bins: layout.binValueCount == null ? null : WaveformBins(take(layout.binValueCount!)),
+          pyramid: layout.pyramidLevelValueCounts == null
+              ? null
+              : WaveformPyramid.fromLevels(
+                  [for (final count in layout.pyramidLevelValueCounts!) WaveformBins(take(count))],
+                  sampleRate: layout.pyramidSampleRate,
+                  totalFrames: layout.pyramidTotalFrames,
+                  baseFramesPerBin: layout.pyramidBaseFramesPerBin,
+                ),
+        ),
+    ];
+  }
+}
+
+/// Scalar fields of one waveform and the sizes of its packed buffers
+class _WaveformLayout {
+  final Duration duration;
+  final int sampleRate;
+  final WaveformMetadata metadata;
+  final int channelCount;
+  final WaveformChannelMode channelMode;
+  final int amplitudeCount;
+  final int? channelValueCount;
+  final int? binValueCount;
+  final List<int>? pyramidLevelValueCounts;
+  final int pyramidBaseFramesPerBin;
+  final int pyramidSampleRate;
+  final int pyramidTotalFrames;
+
+  const _WaveformLayout({
+    required this.duration,
+    required this.sampleRate,
+    required this.metadata,
+    required this.channelCount,
+    required this.channelMode,
+    required this.amplitudeCount,
+    required this.channelValueCount,
+    required this.binValueCount,
+    required this.pyramidLevelValueCounts,
+    required this.pyramidBaseFramesPerBin,
+    required this.pyramidSampleRate,
+    required this.pyramidTotalFrames,
+  });
+}
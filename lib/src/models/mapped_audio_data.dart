@@ -0,0 +1,126 @@
+import 'dart:ffi' as ffi;
+import 'dart:typed_data';
+
+import 'package:sonix/src/native/native_audio_bindings.dart';
+import 'package:sonix/src/native/sonix_bindings.dart';
+import 'audio_data.dart';
+
+/// Decoded audio backed by a memory-mapped scratch file instead of the heap.
+///
+/// Produced by `AudioFileProcessor` for inputs whose decoded size exceeds its
+/// scratch budget. [samples] is a [Float32List] view over the mapped file, so
+/// it can be passed to `WaveformGenerator` (or re-binned at any resolution)
+/// like regular [AudioData]. Pages are loaded on demand and can be dropped by
+/// the OS under memory pressure, which keeps resident memory bounded even for
+/// many hours of audio.
+///
+/// The scratch file belongs to this object. On POSIX it is unlinked as soon
+/// as it is mapped, so it never outlives the process; on Windows it is
+/// deleted when the mapping is released. [dispose] releases the mapping
+/// immediately, otherwise a [ffi.NativeFinalizer] does so once this object is
+/// garbage collected.
+///
+/// **Important:** [samples] and any views obtained from it (including
+/// [frameRange]) are only valid while this object is alive and not disposed.
+/// Keep the [MappedAudioData] itself, not just its samples. Reading
+/// [samples] after [dispose] throws a [StateError]; views taken earlier
+/// point into unmapped memory and crash the process when read.
+///
+/// ## Example Usage
+///
+/// ```dart
+/// final processor = AudioFileProcessor(scratchBudget: 256 * 1024 * 1024);
+/// final audioData = await processor.process('ten_hours.flac');
+/// try {
+///   final overview = await WaveformGenerator.generateInMemory(audioData, config: const WaveformConfig(resolution: 2000));
+///   final detail = await WaveformGenerator.generateInMemory(audioData, config: const WaveformConfig(resolution: 200000));
+/// } finally {
+///   audioData.dispose();
+/// }
+/// ```
+class MappedAudioData extends AudioData implements ffi.Finalizable {
+  // No externalSize: the pages are file-backed and reclaimable, not heap
+  static final ffi.NativeFinalizer _finalizer = ffi.NativeFinalizer(SonixNativeBindings.releaseScratchMappingFinalizer);
+
+  /// Path the scratch file was mapped from
+  ///
+  /// On POSIX the file is already unlinked; the path is informational.
+  final String scratchPath;
+
+  ffi.Pointer<SonixScratchMapping>? _mapping;
+
+  MappedAudioData._(
+    this._mapping, {
+    required Float32List samples,
+    required super.sampleRate,
+    required super.channels,
+    required super.duration,
+    required this.scratchPath,
+  }) : super(samples: samples);
+
+  /// Maps an existing scratch file of interleaved 32-bit float samples.
+  ///
+  /// Ownership of the file passes to the returned object, see
+  /// [MappedAudioData].
+  ///
+  /// **Throws:** `DecodingException` if the file cannot be mapped; the file
+  /// is then left in place.
+  factory MappedAudioData.open(String scratchPath, {required int sampleRate, required int channels, required Duration duration}) {
+    final mapping = NativeAudioBindings.openScratchMapping(scratchPath);
+    final data = mapping.ref.data;
+    final samples = data.asTypedList(mapping.ref.byte_size ~/ Float32List.bytesPerElement);
+    NativeAudioBindings.trackNativeSamples(samples, data);
+
+    final audioData = MappedAudioData._(mapping, samples: samples, sampleRate: sampleRate, channels: channels, duration: duration, scratchPath: scratchPath);
+    _finalizer.attach(audioData, mapping.cast(), detach: audioData);
+    return audioData;
+  }
+
+  /// Whether [dispose] has been called
+  bool get isDisposed => _mapping == null;
+
+  /// Interleaved samples, a view of the mapping
+  ///
+  /// **Throws:** [StateError] after [dispose].
+  @override
+  List<double> get samples {
+    if (_mapping == null) {
+      throw StateError('MappedAudioData has been disposed');
+    }
+    return super.samples;
+  }
+
+  /// Number of frames (samples per channel)
+  int get frameCount => channels > 0 ? super.samples.length ~/ channels : 0;
+
+  /// Zero-copy view of the interleaved samples of frames `[startFrame, endFrame)`
+  ///
+  /// Useful for range queries over long recordings without touching the
+  /// rest of the file.
+  ///
+  /// **Throws:** [StateError] after [dispose].
+  Float32List frameRange(int startFrame, int endFrame) {
+    final samples = this.samples;
+    RangeError.checkValidRange(startFrame, endFrame, frameCount);
+    return Float32List.sublistView(samples as Float32List, startFrame * channels, endFrame * channels);
+  }
+
+  /// Unmaps the scratch file now instead of at garbage collection
+  ///
+  /// On Windows this also deletes the file.
+  @override
+  void dispose() {
+    final mapping = _mapping;
+    if (mapping == null) return;
+    _mapping = null;
+
+    _finalizer.detach(this);
+    NativeAudioBindings.releaseScratchMapping(mapping);
+  }
+
+  @override
+  String toString() {
+    return 'MappedAudioData(samples: ${super.samples.length}, sampleRate: $sampleRate, '
+        'channels: $channels, duration: $duration, scratchPath: $scratchPath)';
+  }
+}
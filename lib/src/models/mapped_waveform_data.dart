@@ -0,0 +1,107 @@
+import 'dart:ffi' as ffi;
+import 'dart:io';
+
+import 'package:sonix/src/native/native_audio_bindings.dart';
+import 'waveform_binary_codec.dart';
+import 'waveform_data.dart';
+
+/// A binary waveform file opened as memory-mapped [WaveformData] views.
+///
+/// [WaveformData.fromBinary] needs the whole file in memory first: for a
+/// 3-hour track with a pyramid that is tens of megabytes read before the
+/// first frame is drawn. Mapping the file instead costs one system call;
+/// [amplitudes], [channelAmplitudes], [bins] and every pyramid level are
+/// `Float32List` views straight into the mapping, and the OS loads a page
+/// only when something reads it. Opening only touches the header and the
+/// section headers, and a viewport showing ten minutes of a three-hour file
+/// reads the pages of those ten minutes:
+///
+/// ```
+/// file     [header][amplitudes][bins][pyramid 0 ............][1 .....][2 ..]...
+/// touched  [██████]                  [      ███          ]
+///                                     ^ visible range at level 0
+/// ```
+///
+/// Write files for mapping with [save] (or `sonix_write_waveform_file` from
+/// native code): float32 values and every pyramid level, so nothing is
+/// computed on open. Other binary waveforms open too, but quantized sections
+/// and missing pyramid levels are rebuilt on the heap.
+///
+/// **Important:** [dispose] unmaps the file. [amplitudes], [bins], the
+/// pyramid and any views obtained from them must not be used afterwards.
+///
+/// ## Example Usage
+///
+/// ```dart
+/// // Once, after generation (or on the server)
+/// await MappedWaveformData.save(waveform, 'cache/track.snxw');
+///
+/// // Every time the track is shown
+/// final mapped = MappedWaveformData.open('cache/track.snxw');
+/// final bins = mapped.pyramid!.slice(const Duration(hours: 1), const Duration(hours: 1, minutes: 10), 800);
+/// mapped.dispose();
+/// ```
+class MappedWaveformData extends WaveformData {
+  /// Path of the mapped waveform file
+  final String path;
+
+  final ffi.Pointer<ffi.Uint8> _data;
+  final int _byteSize;
+  bool _disposed = false;
+
+  MappedWaveformData._(WaveformData views, {required this.path, required ffi.Pointer<ffi.Uint8> data, required int byteSize})
+    : _data = data,
+      _byteSize = byteSize,
+      super(
+        amplitudes: views.amplitudes,
+        duration: views.duration,
+        sampleRate: views.sampleRate,
+        metadata: views.metadata,
+        channelAmplitudes: views.channelAmplitudes,
+        channelCount: views.channelCount,
+        channelMode: views.channelMode,
+        bins: views.bins,
+        pyramid: views.pyramid,
+      );
+
+  /// Maps the binary waveform file at [path]
+  ///
+  /// **Throws:** `FileAccessException` if the file cannot be mapped, or
+  /// [FormatException] if it is not a supported binary waveform.
+  factory MappedWaveformData.open(String path) {
+    final mapping = NativeAudioBindings.mapWaveformFile(path);
+    try {
+      final views = WaveformBinaryCodec.decode(mapping.data.asTypedList(mapping.byteSize));
+      return MappedWaveformData._(views, path: path, data: mapping.data, byteSize: mapping.byteSize);
+    } catch (_) {
+      NativeAudioBindings.unmapWaveformFile(mapping.data, mapping.byteSize);
+      rethrow;
+    }
+  }
+
+  /// Writes [waveform] to [path] in the layout [open] serves without work
+  ///
+  /// [configHash] is stored in the header, typically `WaveformConfig.stableHash`.
+  static Future<void> save(WaveformData waveform, String path, {int configHash = 0}) async {
+    await File(path).writeAsBytes(waveform.toBinary(configHash: configHash, allPyramidLevels: true), flush: true);
+  }
+
+  /// Whether [dispose] has been called
+  bool get isDisposed => _disposed;
+
+  /// Unmaps the file
+  @override
+  void dispose() {
+    if (_disposed) return;
+    _disposed = true;
+
+    super.dispose();
+    NativeAudioBindings.unmapWaveformFile(_data, _byteSize);
+  }
+
+  @override
+  String toString() {
+    return 'MappedWaveformData(amplitudes: ${amplitudes.length}, duration: $duration, '
+        'sampleRate: $sampleRate, path: $path)';
+  }
+}
@@ -0,0 +1,92 @@
+import 'dart:ffi' as ffi;
+import 'dart:typed_data';
+
+import 'package:sonix/src/native/native_audio_bindings.dart';
+import 'package:sonix/src/native/sonix_bindings.dart';
+import 'audio_data.dart';
+
+/// Decoded audio whose samples stay in the native buffer of the decoder.
+///
+/// Produced by the native decoders. [samples] is a [Float32List] view of the
+/// FFmpeg output buffer, so decoding never copies PCM onto the Dart heap.
+/// The buffer is owned by this object:
+///
+/// - [dispose] frees it immediately
+/// - otherwise a [ffi.NativeFinalizer] frees it once this object is garbage
+///   collected; the finalizer reports the buffer size to the GC, so
+///   undisposed decodes still count against the heap and trigger collections
+///
+/// **Important:** [samples] and any views obtained from it are only valid
+/// while this object is alive and not disposed. Keep the [NativeAudioData]
+/// itself, not just its samples. Reading [samples] after [dispose] throws a
+/// [StateError]; views taken earlier point into freed memory.
+///
+/// ## Example Usage
+///
+/// ```dart
+/// final audioData = NativeAudioBindings.decodeFile('track.flac');
+/// try {
+///   final waveform = await WaveformGenerator.generateInMemory(audioData);
+/// } finally {
+///   audioData.dispose(); // Releases the PCM now instead of at the next GC
+/// }
+/// ```
+class NativeAudioData extends AudioData implements ffi.Finalizable {
+  static final ffi.NativeFinalizer _finalizer = ffi.NativeFinalizer(SonixNativeBindings.freeAudioDataFinalizer);
+
+  ffi.Pointer<SonixAudioData>? _pointer;
+
+  NativeAudioData._(this._pointer, {required Float32List samples, required super.sampleRate, required super.channels, required super.duration})
+    : super(samples: samples);
+
+  /// Takes ownership of [pointer] without copying the samples
+  ///
+  /// The caller must not free [pointer] (or a chunk result still referencing
+  /// it) afterwards.
+  factory NativeAudioData.adopt(ffi.Pointer<SonixAudioData> pointer) {
+    final nativeData = pointer.ref;
+    final samples = nativeData.samples.asTypedList(nativeData.sample_count);
+    NativeAudioBindings.trackNativeSamples(samples, nativeData.samples);
+
+    final audioData = NativeAudioData._(
+      pointer,
+      samples: samples,
+      sampleRate: nativeData.sample_rate,
+      channels: nativeData.channels,
+      duration: Duration(milliseconds: nativeData.duration_ms),
+    );
+    _finalizer.attach(audioData, pointer.cast(), detach: audioData, externalSize: samples.lengthInBytes);
+    return audioData;
+  }
+
+  /// Whether [dispose] has been called
+  bool get isDisposed => _pointer == null;
+
+  /// Interleaved samples, a view of the native buffer
+  ///
+  /// **Throws:** [StateError] after [dispose].
+  @override
+  List<double> get samples {
+    if (_pointer == null) {
+      throw StateError('NativeAudioData has been disposed');
+    }
+    return super.samples;
+  }
+
+  /// Frees the native sample buffer now instead of at garbage collection
+  @override
+  void dispose() {
+    final pointer = _pointer;
+    if (pointer == null) return;
+    _pointer = null;
+
+    _finalizer.detach(this);
+    SonixNativeBindings.freeAudioData(pointer);
+  }
+
+  @override
+  String toString() {
+    return 'NativeAudioData(samples: ${super.samples.length}, sampleRate: $sampleRate, '
+        'channels: $channels, duration: $duration)';
+  }
+}
@@ -0,0 +1,382 @@
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'waveform_bins.dart';
+import 'waveform_channel_mode.dart';
+import 'waveform_data.dart';
+import 'waveform_metadata.dart';
+import 'waveform_pyramid.dart';
+import 'waveform_type.dart';
+
+/// Storage precision of the sample values in a binary waveform.
+enum WaveformQuantization {
+  /// 32-bit floats; lossless for generated waveforms (4 bytes per value)
+  float32,
+
+  /// 16-bit integers scaled to the largest value (2 bytes per value)
+  bits16,
+
+  /// 8-bit integers scaled to the largest value (1 byte per value)
+  ///
+  /// Plenty for display: a bar is rarely taller than 256 pixels.
+  bits8,
+}
+
+/// Fixed-size header of a binary waveform; see [WaveformBinaryCodec.readHeader]
+class WaveformBinaryHeader {
+  /// Format version the data was written with
+  final int version;
+
+  /// Storage precision of the sample values
+  final WaveformQuantization quantization;
+
+  /// Sample rate of the source audio in Hz
+  final int sampleRate;
+
+  /// Duration of the source audio
+  final Duration duration;
+
+  /// Number of amplitude values (waveform bins)
+  final int binCount;
+
+  /// Number of per-channel amplitude lists (0 when absent)
+  final int channelCount;
+
+  /// `WaveformConfig.stableHash` of the generating config, or 0 if unknown
+  final int configHash;
+
+  const WaveformBinaryHeader({
+    required this.version,
+    required this.quantization,
+    required this.sampleRate,
+    required this.duration,
+    required this.binCount,
+    required this.channelCount,
+    required this.configHash,
+  });
+
+  @override
+  String toString() =>
+      'WaveformBinaryHeader(version: $version, quantization: ${quantization.name}, sampleRate: $sampleRate, '
+      'duration: $duration, bins: $binCount, channels: $channelCount, configHash: 0x${configHash.toRadixString(16)})';
+}
+
+/// Compact, versioned binary encoding of [WaveformData].
+///
+/// A JSON waveform spends roughly 20 bytes per amplitude and must be parsed
+/// character by character; this format stores 1 to 4 bytes per value and
+/// decodes float data as a view of the input without copying.
+///
+/// ## Layout (little-endian)
+///
+/// ```
+/// header   56 bytes  magic "SNXW", version, section flags, quantization,
+///                    type, normalized, channel mode, sample rate, duration,
+///                    generation time, bin count, channel count, config hash,
+///                    pyramid base frames per bin, pyramid total frames
+/// sections           amplitudes, then channel amplitudes, bins and pyramid
+///                    base level when flagged, then the coarser pyramid levels
+///                    if all levels are flagged; each is a 12-byte section
+///                    header (count, signed, scale) and values padded to 4 bytes
+/// ```
+///
+/// Quantized sections store `value / scale` mapped onto the integer range,
+/// unsigned for non-negative data (amplitudes) and signed otherwise (bins).
+/// By default only the finest pyramid level is stored and coarser levels are
+/// rebuilt on decode. Files written with `allPyramidLevels` store every level
+/// so nothing has to be computed (or read) to open them; float32 files of
+/// that kind can be memory-mapped with `MappedWaveformData.open`, and the
+/// native `sonix_write_waveform_file` writes them without Dart.
+///
+/// ## Example Usage
+///
+/// ```dart
+/// final bytes = waveform.toBinary(quantization: WaveformQuantization.bits8, configHash: config.stableHash);
+/// await File('cache/track.snxw').writeAsBytes(bytes);
+///
+/// final cached = await File('cache/track.snxw').readAsBytes();
+/// if (WaveformBinaryCodec.readHeader(cached).configHash == config.stableHash) {
+///   final restored = WaveformData.fromBinary(cached);
+/// }
+/// ```
+class WaveformBinaryCodec {
+  WaveformBinaryCodec._();
+
+  /// Current format version
+  static const int version = 1;
+
+  /// Size of the fixed header in bytes
+  static const int headerSize = 56;
+
+  static const int _magic = 0x57584e53; // "SNXW" read as little-endian uint32
+  static const int _sectionHeaderSize = 12;
+  static const int _flagChannels = 1 << 0;
+  static const int _flagBins = 1 << 1;
+  static const int _flagPyramid = 1 << 2;
+  static const int _flagPyramidLevels = 1 << 3;
+
+  /// Encodes [data] with the given [quantization]
+  ///
+  /// [configHash] is stored in the header for cache validation, typically
+  /// `WaveformConfig.stableHash` of the config the waveform was generated with.
+  /// [allPyramidLevels] stores every pyramid level instead of only the finest;
+  /// the pyramid then takes about twice the space but decodes without work.
+  static Uint8List encode(
+    WaveformData data, {
+    WaveformQuantization quantization = WaveformQuantization.float32,
+    int configHash = 0,
+    bool allPyramidLevels = false,
+  }) {
+    final sections = <Float32List>[data.amplitudes];
+    int flags = 0;
+    if (data.hasChannelData) {
+      flags |= _flagChannels;
+      sections.add(data.channelAmplitudes!);
+    }
+    if (data.bins != null) {
+      flags |= _flagBins;
+      sections.add(data.bins!.data);
+    }
+    final pyramid = data.pyramid;
+    if (pyramid != null) {
+      flags |= _flagPyramid;
+      sections.add(pyramid.levels.first.data);
+      if (allPyramidLevels) {
+        flags |= _flagPyramidLevels;
+        sections.addAll([for (final level in pyramid.levels.skip(1)) level.data]);
+      }
+    }
+
+    final valueBytes = _bytesPerValue(quantization);
+    final size = sections.fold(headerSize, (total, section) => total + _sectionHeaderSize + _padded(section.length * valueBytes));
+    final bytes = Uint8List(size);
+    final view = ByteData.sublistView(bytes);
+
+    view.setUint32(0, _magic, Endian.little);
+    view.setUint16(4, version, Endian.little);
+    view.setUint16(6, flags, Endian.little);
+    view.setUint8(8, quantization.index);
+    view.setUint8(9, data.metadata.type.index);
+    view.setUint8(10, data.metadata.normalized ? 1 : 0);
+    view.setUint8(11, data.hasChannelData ? data.channelMode.index : WaveformChannelMode.mixed.index);
+    view.setUint32(12, data.sampleRate, Endian.little);
+    view.setInt64(16, data.duration.inMicroseconds, Endian.little);
+    view.setInt64(24, data.metadata.generatedAt.microsecondsSinceEpoch, Endian.little);
+    view.setUint32(32, data.amplitudes.length, Endian.little);
+    view.setUint32(36, data.hasChannelData ? data.channelCount : 0, Endian.little);
+    view.setUint32(40, configHash & 0xffffffff, Endian.little);
+    view.setUint32(44, pyramid?.baseFramesPerBin ?? 0, Endian.little);
+    view.setInt64(48, pyramid?.totalFrames ?? 0, Endian.little);
+
+    int offset = headerSize;
+    for (final section in sections) {
+      offset = _writeSection(bytes, view, offset, section, quantization);
+    }
+    return bytes;
+  }
+
+  /// Reads only the header, e.g. to validate a cache entry before decoding
+  ///
+  /// **Throws:** [FormatException] if [bytes] is not a supported binary waveform.
+  static WaveformBinaryHeader readHeader(Uint8List bytes) {
+    final view = _checkedView(bytes);
+    return WaveformBinaryHeader(
+      version: view.getUint16(4, Endian.little),
+      quantization: _quantizationAt(view),
+      sampleRate: view.getUint32(12, Endian.little),
+      duration: Duration(microseconds: view.getInt64(16, Endian.little)),
+      binCount: view.getUint32(32, Endian.little),
+      channelCount: view.getUint32(36, Endian.little),
+      configHash: view.getUint32(40, Endian.little),
+    );
+  }
+
+  /// Decodes a waveform written by [encode]
+  ///
+  /// Unquantized sections are returned as views of [bytes] when it is
+  /// suitably aligned, so [bytes] must not be modified afterwards.
+  ///
+  /// **Throws:** [FormatException] if [bytes] is not a supported binary waveform.
+  static WaveformData decode(Uint8List bytes) {
+    final view = _checkedView(bytes);
+    final flags = view.getUint16(6, Endian.little);
+    final quantization = _quantizationAt(view);
+    final type = _enumAt(WaveformType.values, view.getUint8(9), 'waveform type');
+    final channelMode = _enumAt(WaveformChannelMode.values, view.getUint8(11), 'channel mode');
+    final sampleRate = view.getUint32(12, Endian.little);
+    final binCount = view.getUint32(32, Endian.little);
+
+    int offset = headerSize;
+    Float32List readSection() {
+      final (values, next) = _readSection(bytes, view, offset, quantization);
+      offset = next;
+      return values;
+    }
+
+    final amplitudes = readSection();
+    if (amplitudes.length != binCount) {
+      throw FormatException('Amplitude count ${amplitudes.length} does not match header bin count $binCount');
+    }
+    final channelAmplitudes = flags & _flagChannels != 0 ? readSection() : null;
+    final bins = flags & _flagBins != 0 ? WaveformBins(readSection()) : null;
+    WaveformPyramid? pyramid;
+    if (flags & _flagPyramid != 0) {
+      final baseLevel = _readBins(readSection(), 'pyramid level 0');
+      final totalFrames = view.getInt64(48, Endian.little);
+      final baseFramesPerBin = view.getUint32(44, Endian.little);
+      if (flags & _flagPyramidLevels != 0) {
+        // Every level is stored: wrap the sections instead of merging bins
+        final levels = [baseLevel];
+        while (levels.last.length > 1) {
+          final level = _readBins(readSection(), 'pyramid level ${levels.length}');
+          if (level.length != (levels.last.length + 1) ~/ 2) {
+            throw FormatException('Pyramid level ${levels.length} has ${level.length} bins, expected ${(levels.last.length + 1) ~/ 2}');
+          }
+          levels.add(level);
+        }
+        pyramid = WaveformPyramid.fromLevels(levels, sampleRate: sampleRate, totalFrames: totalFrames, baseFramesPerBin: baseFramesPerBin);
+      } else {
+        pyramid = WaveformPyramid.fromBaseLevel(baseLevel, sampleRate: sampleRate, totalFrames: totalFrames, baseFramesPerBin: baseFramesPerBin);
+      }
+    }
+
+    return WaveformData(
+      amplitudes: amplitudes,
+      duration: Duration(microseconds: view.getInt64(16, Endian.little)),
+      sampleRate: sampleRate,
+      metadata: WaveformMetadata(
+        resolution: binCount,
+        type: type,
+        normalized: view.getUint8(10) != 0,
+        generatedAt: DateTime.fromMicrosecondsSinceEpoch(view.getInt64(24, Endian.little)),
+      ),
+      channelAmplitudes: channelAmplitudes,
+      channelCount: channelAmplitudes == null ? 0 : view.getUint32(36, Endian.little),
+      channelMode: channelAmplitudes == null ? WaveformChannelMode.mixed : channelMode,
+      bins: bins,
+      pyramid: pyramid,
+    );
+  }
+
+  static WaveformBins _readBins(Float32List values, String name) {
+    if (values.length % WaveformBins.valuesPerBin != 0) {
+      throw FormatException('Section $name holds ${values.length} values, not a multiple of ${WaveformBins.valuesPerBin}');
+    }
+    return WaveformBins(values);
+  }
+
+  static int _writeSection(Uint8List bytes, ByteData view, int offset, Float32List values, WaveformQuantization quantization) {
+    double scale = 0.0;
+    bool signed = false;
+    for (int i = 0; i < values.length; i++) {
+      final value = values[i];
+      if (value < 0) signed = true;
+      scale = math.max(scale, value.abs());
+    }
+    if (quantization == WaveformQuantization.float32 || scale == 0.0) scale = 1.0;
+
+    view.setUint32(offset, values.length, Endian.little);
+    view.setUint8(offset + 4, signed ? 1 : 0);
+    view.setFloat32(offset + 8, scale, Endian.little);
+    offset += _sectionHeaderSize;
+
+    final maxValue = _maxQuantized(quantization, signed);
+    for (int i = 0; i < values.length; i++) {
+      switch (quantization) {
+        case WaveformQuantization.float32:
+          view.setFloat32(offset + i * 4, values[i], Endian.little);
+        case WaveformQuantization.bits16:
+          final q = (values[i] / scale * maxValue).round();
+          if (signed) {
+            view.setInt16(offset + i * 2, q, Endian.little);
+          } else {
+            view.setUint16(offset + i * 2, q, Endian.little);
+          }
+        case WaveformQuantization.bits8:
+          final q = (values[i] / scale * maxValue).round();
+          if (signed) {
+            view.setInt8(offset + i, q);
+          } else {
+            view.setUint8(offset + i, q);
+          }
+      }
+    }
+    return offset + _padded(values.length * _bytesPerValue(quantization));
+  }
+
+  static (Float32List, int) _readSection(Uint8List bytes, ByteData view, int offset, WaveformQuantization quantization) {
+    if (offset + _sectionHeaderSize > bytes.length) {
+      throw const FormatException('Binary waveform is truncated');
+    }
+    final count = view.getUint32(offset, Endian.little);
+    final signed = view.getUint8(offset + 4) != 0;
+    final scale = view.getFloat32(offset + 8, Endian.little);
+    offset += _sectionHeaderSize;
+
+    final valueBytes = _bytesPerValue(quantization);
+    final end = offset + _padded(count * valueBytes);
+    if (end > bytes.length) {
+      throw const FormatException('Binary waveform is truncated');
+    }
+
+    if (quantization == WaveformQuantization.float32) {
+      final start = bytes.offsetInBytes + offset;
+      if (Endian.host == Endian.little && start % Float32List.bytesPerElement == 0) {
+        return (Float32List.view(bytes.buffer, start, count), end);
+      }
+    }
+
+    final values = Float32List(count);
+    final factor = scale / _maxQuantized(quantization, signed);
+    for (int i = 0; i < count; i++) {
+      values[i] = switch (quantization) {
+        WaveformQuantization.float32 => view.getFloat32(offset + i * 4, Endian.little),
+        WaveformQuantization.bits16 => (signed ? view.getInt16(offset + i * 2, Endian.little) : view.getUint16(offset + i * 2, Endian.little)) * factor,
+        WaveformQuantization.bits8 => (signed ? view.getInt8(offset + i) : view.getUint8(offset + i)) * factor,
+      };
+    }
+    return (values, end);
+  }
+
+  static ByteData _checkedView(Uint8List bytes) {
+    if (bytes.length < headerSize) {
+      throw const FormatException('Binary waveform is truncated');
+    }
+    final view = ByteData.sublistView(bytes);
+    if (view.getUint32(0, Endian.little) != _magic) {
+      throw const FormatException('Not a binary waveform (bad magic)');
+    }
+    final dataVersion = view.getUint16(4, Endian.little);
+    if (dataVersion > version) {
+      throw FormatException('Unsupported binary waveform version $dataVersion (supported: $version)');
+    }
+    return view;
+  }
+
+  static WaveformQuantization _quantizationAt(ByteData view) => _enumAt(WaveformQuantization.values, view.getUint8(8), 'quantization');
+
+  static T _enumAt<T>(List<T> values, int index, String name) {
+    if (index >= values.length) {
+      throw FormatException('Unknown $name $index');
+    }
+    return values[index];
+  }
+
+  static int _bytesPerValue(WaveformQuantization quantization) {
+    return switch (quantization) {
+      WaveformQuantization.float32 => 4,
+      WaveformQuantization.bits16 => 2,
+      WaveformQuantization.bits8 => 1,
+    };
+  }
+
+  static int _maxQuantized(WaveformQuantization quantization, bool signed) {
+    return switch (quantization) {
+      WaveformQuantization.float32 => 1,
+      WaveformQuantization.bits16 => signed ? 32767 : 65535,
+      WaveformQuantization.bits8 => signed ? 127 : 255,
+    };
+  }
+
+  static int _padded(int byteCount) => (byteCount + 3) & ~3;
+}
@@ -0,0 +1,110 @@
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+/// Signed min/max/RMS envelope of the audio, one entry per waveform bin.
+///
+/// A plain amplitude list holds one unsigned value per bin, which loses the
+/// shape of the signal: an asymmetric waveform and its mirror image look the
+/// same. These bins keep the minimum and maximum sample of every bin together
+/// with its RMS, which is enough to draw the true signed envelope (the way
+/// audiowaveform-style editors do) with an RMS body inside it.
+///
+/// ## Memory Layout
+///
+/// Values are stored struct-of-arrays in a single [Float32List]:
+///
+/// ```
+/// [min0 .. minN-1 | max0 .. maxN-1 | rms0 .. rmsN-1]
+/// ```
+///
+/// [min], [max] and [rms] are zero-copy views into that buffer.
+///
+/// ## Example Usage
+///
+/// ```dart
+/// final waveform = await sonix.generateWaveform(
+///   'audio.mp3',
+///   config: const WaveformConfig(generateBins: true),
+/// );
+/// final bins = waveform.bins!;
+/// for (int i = 0; i < bins.length; i++) {
+///   print('bin $i: ${bins.min[i]}..${bins.max[i]} (rms ${bins.rms[i]})');
+/// }
+/// ```
+class WaveformBins {
+  /// Number of values stored per bin (min, max, RMS)
+  static const int valuesPerBin = 3;
+
+  /// Backing buffer holding all min values, then all max values, then all RMS values
+  final Float32List data;
+
+  /// Number of bins
+  final int length;
+
+  /// Wraps an existing struct-of-arrays buffer.
+  ///
+  /// **Throws:** [ArgumentError] if the buffer length is not a multiple of 3.
+  WaveformBins(this.data) : length = data.length ~/ valuesPerBin {
+    if (data.length % valuesPerBin != 0) {
+      throw ArgumentError.value(data.length, 'data', 'Length must be a multiple of $valuesPerBin');
+    }
+  }
+
+  /// Allocates zero-filled bins
+  WaveformBins.allocate(int length) : this(Float32List(length * valuesPerBin));
+
+  /// Minimum (most negative) sample per bin
+  Float32List get min => Float32List.sublistView(data, 0, length);
+
+  /// Maximum (most positive) sample per bin
+  Float32List get max => Float32List.sublistView(data, length, 2 * length);
+
+  /// RMS of the samples per bin
+  Float32List get rms => Float32List.sublistView(data, 2 * length, 3 * length);
+
+  /// Whether there are no bins
+  bool get isEmpty => length == 0;
+
+  /// Largest absolute value across all min and max entries
+  double get peak {
+    double peak = 0.0;
+    for (int i = 0; i < 2 * length; i++) {
+      peak = math.max(peak, data[i].abs());
+    }
+    return peak;
+  }
+
+  /// Multiplies every value in place, e.g. to normalize the envelope
+  void scale(double factor) {
+    for (int i = 0; i < data.length; i++) {
+      data[i] *= factor;
+    }
+  }
+
+  /// Convert to JSON for serialization
+  Map<String, dynamic> toJson() {
+    return {'min': min, 'max': max, 'rms': rms};
+  }
+
+  /// Create from JSON
+  factory WaveformBins.fromJson(Map<String, dynamic> json) {
+    final minValues = json['min'] as List;
+    final maxValues = json['max'] as List;
+    final rmsValues = json['rms'] as List;
+    final length = minValues.length;
+    if (maxValues.length != length || rmsValues.length != length) {
+      throw const FormatException('min, max and rms must have the same length');
+    }
+
+    final bins = WaveformBins.allocate(length);
+    for (int i = 0; i < length; i++) {
+      bins.data[i] = (minValues[i] as num).toDouble();
+      bins.data[length + i] = (maxValues[i] as num).toDouble();
+      bins.data[2 * length + i] = (rmsValues[i] as num).toDouble();
+    }
+    return bins;
+  }
+
+  @override
+  String toString() => 'WaveformBins(length: $length)';
+}
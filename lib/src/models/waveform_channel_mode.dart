@@ -0,0 +1,48 @@
+/// Channel layout of the amplitude data produced during waveform generation.
+///
+/// By default all channels are mixed down to a single amplitude list. The
+/// other modes additionally produce one amplitude list per output channel in
+/// the same pass over the audio, stored contiguously in
+/// [WaveformData.channelAmplitudes].
+///
+/// ## Example Usage
+///
+/// ```dart
+/// // Split L/R waveforms for a stereo editor
+/// final waveform = await sonix.generateWaveform(
+///   'stereo.wav',
+///   config: const WaveformConfig(channelMode: WaveformChannelMode.perChannel),
+/// );
+/// final left = waveform.channel(0);
+/// final right = waveform.channel(1);
+/// ```
+enum WaveformChannelMode {
+  /// All channels averaged into a single amplitude list (default).
+  ///
+  /// No per-channel data is produced.
+  mixed,
+
+  /// One amplitude list per source channel, in source channel order.
+  ///
+  /// Produces as many output channels as the audio has.
+  perChannel,
+
+  /// Left, right, mid and side amplitude lists, in that order.
+  ///
+  /// Mid is `(L + R) / 2` and side is `(L - R) / 2`. Mono audio is treated as
+  /// dual mono (side is silent); for more than two channels only the first
+  /// two are used.
+  midSide;
+
+  /// Number of per-channel amplitude lists produced for [sourceChannels] input channels
+  int outputChannelCount(int sourceChannels) {
+    switch (this) {
+      case WaveformChannelMode.mixed:
+        return 0;
+      case WaveformChannelMode.perChannel:
+        return sourceChannels;
+      case WaveformChannelMode.midSide:
+        return 4;
+    }
+  }
+}
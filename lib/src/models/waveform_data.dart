@@ -1,5 +1,10 @@
 import 'dart:convert';
+import 'dart:typed_data';
 
+import 'waveform_binary_codec.dart';
+import 'waveform_bins.dart';
+import 'waveform_channel_mode.dart';
+import 'waveform_pyramid.dart';
 import 'waveform_type.dart';
 import 'waveform_metadata.dart';
 
@@ -12,7 +17,8 @@ import 'waveform_metadata.dart';
 /// ## Key Features
 ///
 /// - **Memory Efficient**: Implements [Disposable] for explicit cleanup
-/// - **Serializable**: Full JSON support for caching and storage
+/// - **Compact**: Amplitudes are stored in a [Float32List] (4 bytes per value)
+/// - **Serializable**: JSON and a compact binary format for caching and storage
 /// - **Comprehensive**: Includes both waveform and source audio metadata
 /// - **Flexible Creation**: Multiple factory constructors for different use cases
 ///
@@ -64,7 +70,8 @@ class WaveformData {
   /// - 1.0 = maximum amplitude in the audio
   ///
   /// The number of values equals the resolution specified during generation.
-  /// Values are evenly distributed across the audio duration.
+  /// Values are evenly distributed across the audio duration. Stored as
+  /// 32-bit floats; the list has a fixed length.
   ///
   /// ## Example
   /// ```dart
@@ -76,7 +83,8 @@ class WaveformData {
   ///   print('At ${timePosition}ms: amplitude $amplitude');
   /// }
   /// ```
-  final List<double> amplitudes;
+  Float32List get amplitudes => _amplitudes;
+  Float32List _amplitudes;
 
   /// Total duration of the source audio file.
   ///
@@ -103,20 +111,110 @@ class WaveformData {
   /// details. See [WaveformMetadata] for complete information.
   final WaveformMetadata metadata;
 
-  const WaveformData({required this.amplitudes, required this.duration, required this.sampleRate, required this.metadata});
+  /// Per-channel amplitude values, stored planar in one contiguous buffer.
+  ///
+  /// Only present when the waveform was generated with a [WaveformChannelMode]
+  /// other than [WaveformChannelMode.mixed]. Channel `c` occupies indices
+  /// `[c * channelResolution, (c + 1) * channelResolution)`. Use [channel] to
+  /// get a zero-copy view of a single channel.
+  ///
+  /// All channels are normalized with a shared reference, so a quiet left
+  /// channel stays visibly quieter than a loud right channel.
+  final Float32List? channelAmplitudes;
+
+  /// Number of channels stored in [channelAmplitudes] (0 when absent).
+  final int channelCount;
+
+  /// Layout of [channelAmplitudes]; see [WaveformChannelMode].
+  final WaveformChannelMode channelMode;
+
+  /// Signed min/max/RMS bins of the mixed signal, one per amplitude value.
+  ///
+  /// Only present when generated with `WaveformConfig.generateBins`. Used by
+  /// the painter to draw the true signed envelope with
+  /// `DownsampleMethod.minMax`.
+  final WaveformBins? bins;
+
+  /// Multi-resolution min/max/RMS pyramid for zooming.
+  ///
+  /// Only present when generated with `WaveformConfig.generatePyramid`.
+  /// Normalized with the same reference as [bins].
+  final WaveformPyramid? pyramid;
+
+  /// Creates waveform data; [amplitudes] is copied into a [Float32List]
+  /// unless it already is one.
+  WaveformData({
+    required List<double> amplitudes,
+    required this.duration,
+    required this.sampleRate,
+    required this.metadata,
+    this.channelAmplitudes,
+    this.channelCount = 0,
+    this.channelMode = WaveformChannelMode.mixed,
+    this.bins,
+    this.pyramid,
+  }) : _amplitudes = amplitudes is Float32List ? amplitudes : Float32List.fromList(amplitudes);
+
+  /// Whether per-channel amplitudes are available
+  bool get hasChannelData => channelAmplitudes != null && channelCount > 0;
+
+  /// Number of amplitude values per channel in [channelAmplitudes]
+  int get channelResolution => hasChannelData ? channelAmplitudes!.length ~/ channelCount : 0;
+
+  /// Returns a view of the amplitudes of a single channel.
+  ///
+  /// The view shares memory with [channelAmplitudes]; no data is copied.
+  ///
+  /// **Throws:** [StateError] if no per-channel data is available,
+  /// [RangeError] if [index] is out of range.
+  ///
+  /// ## Example
+  /// ```dart
+  /// final waveform = await sonix.generateWaveform(
+  ///   'stereo.wav',
+  ///   config: const WaveformConfig(channelMode: WaveformChannelMode.midSide),
+  /// );
+  /// final mid = waveform.channel(2);
+  /// final side = waveform.channel(3);
+  /// ```
+  Float32List channel(int index) {
+    if (!hasChannelData) {
+      throw StateError('No per-channel amplitudes available (channel mode: ${channelMode.name})');
+    }
+    RangeError.checkValidIndex(index, this, 'index', channelCount);
+
+    final resolution = channelResolution;
+    return Float32List.sublistView(channelAmplitudes!, index * resolution, (index + 1) * resolution);
+  }
 
   /// Convert to JSON for serialization
   Map<String, dynamic> toJson() {
-    return {'amplitudes': amplitudes, 'duration': duration.inMicroseconds, 'sampleRate': sampleRate, 'metadata': metadata.toJson()};
+    return {
+      'amplitudes': amplitudes,
+      'duration': duration.inMicroseconds,
+      'sampleRate': sampleRate,
+      'metadata': metadata.toJson(),
+      if (hasChannelData) ...{'channelMode': channelMode.name, 'channelCount': channelCount, 'channelAmplitudes': channelAmplitudes},
+      if (bins != null) 'bins': bins!.toJson(),
+      if (pyramid != null) 'pyramid': pyramid!.toJson(),
+    };
   }
 
   /// Create from JSON
   factory WaveformData.fromJson(Map<String, dynamic> json) {
+    final channelJson = json['channelAmplitudes'] as List?;
+    final binsJson = json['bins'] as Map<String, dynamic>?;
+    final pyramidJson = json['pyramid'] as Map<String, dynamic>?;
     return WaveformData(
-      amplitudes: (json['amplitudes'] as List).cast<double>(),
+      amplitudes: Float32List.fromList([for (final value in json['amplitudes'] as List) (value as num).toDouble()]),
       duration: Duration(microseconds: json['duration'] as int),
       sampleRate: json['sampleRate'] as int,
       metadata: WaveformMetadata.fromJson(json['metadata'] as Map<String, dynamic>),
+      channelAmplitudes: channelJson == null ? null : Float32List.fromList([for (final value in channelJson) (value as num).toDouble()]),
+      channelCount: json['channelCount'] as int? ?? 0,
+      channelMode: WaveformChannelMode.values.firstWhere((e) => e.name == json['channelMode'], orElse: () => WaveformChannelMode.mixed),
+      bins: binsJson == null ? null : WaveformBins.fromJson(binsJson),
+      pyramid: pyramidJson == null ? null : WaveformPyramid.fromJson(pyramidJson),
     );
   }
 
@@ -209,10 +307,41 @@ class WaveformData {
   /// final waveform = WaveformData.fromAmplitudeString(response.body);
   /// ```
   factory WaveformData.fromAmplitudeString(String amplitudeString) {
-    final List<double> amplitudes = (jsonDecode(amplitudeString) as List).cast<double>();
+    final amplitudes = [for (final value in jsonDecode(amplitudeString) as List) (value as num).toDouble()];
     return WaveformData.fromAmplitudes(amplitudes);
   }
 
+  /// Creates a [WaveformData] instance from the binary format written by [toBinary].
+  ///
+  /// Much faster than [fromJsonString]: unquantized data is used in place
+  /// without parsing. See [WaveformBinaryCodec] for the format.
+  ///
+  /// **Throws:** [FormatException] if [bytes] is not a supported binary waveform
+  ///
+  /// ## Example
+  /// ```dart
+  /// final waveform = WaveformData.fromBinary(await File('track.snxw').readAsBytes());
+  /// ```
+  factory WaveformData.fromBinary(Uint8List bytes) => WaveformBinaryCodec.decode(bytes);
+
+  /// Encodes the waveform in the compact binary format.
+  ///
+  /// [quantization] trades precision for size: 8-bit values take a quarter
+  /// of the space of the default 32-bit floats and are indistinguishable when
+  /// drawn. [configHash] is stored in the header so caches can detect entries
+  /// generated with other settings (see `WaveformConfig.stableHash`).
+  /// [allPyramidLevels] stores every pyramid level, so the file opens without
+  /// rebuilding them (see `MappedWaveformData`).
+  ///
+  /// ## Example
+  /// ```dart
+  /// final bytes = waveform.toBinary(quantization: WaveformQuantization.bits8);
+  /// await File('track.snxw').writeAsBytes(bytes);
+  /// ```
+  Uint8List toBinary({WaveformQuantization quantization = WaveformQuantization.float32, int configHash = 0, bool allPyramidLevels = false}) {
+    return WaveformBinaryCodec.encode(this, quantization: quantization, configHash: configHash, allPyramidLevels: allPyramidLevels);
+  }
+
   /// Converts the waveform data to a JSON string for serialization.
   ///
   /// This creates a complete JSON representation including all amplitude data,
@@ -240,9 +369,36 @@ class WaveformData {
     return jsonEncode(toJson());
   }
 
+  /// Returns a deep copy that shares no buffers with this waveform
+  ///
+  /// Amplitudes, channel amplitudes, bins and every pyramid level are
+  /// copied, so disposing or editing either waveform leaves the other
+  /// untouched. Use it to hand one generated result to several owners.
+  WaveformData copy() {
+    final pyramid = this.pyramid;
+    return WaveformData(
+      amplitudes: Float32List.fromList(amplitudes),
+      duration: duration,
+      sampleRate: sampleRate,
+      metadata: metadata,
+      channelAmplitudes: channelAmplitudes == null ? null : Float32List.fromList(channelAmplitudes!),
+      channelCount: channelCount,
+      channelMode: channelMode,
+      bins: bins == null ? null : WaveformBins(Float32List.fromList(bins!.data)),
+      pyramid: pyramid == null
+          ? null
+          : WaveformPyramid.fromLevels(
+              [for (final level in pyramid.levels) WaveformBins(Float32List.fromList(level.data))],
+              sampleRate: pyramid.sampleRate,
+              totalFrames: pyramid.totalFrames,
+              baseFramesPerBin: pyramid.baseFramesPerBin,
+            ),
+    );
+  }
+
   /// Releases memory resources used by this waveform data.
   ///
-  /// This method clears the amplitude data array to help with garbage collection
+  /// This method drops the amplitude data array to help with garbage collection
   /// and reduce memory usage. Call this when the waveform data is no longer needed,
   /// especially for large waveforms or in memory-constrained environments.
   ///
@@ -263,13 +419,16 @@ class WaveformData {
   /// **Best Practice:** Always dispose of waveform data in your widget's
   /// dispose() method or when changing to different audio files.
   void dispose() {
-    // Clear the amplitudes list to help with garbage collection
-    amplitudes.clear();
+    // Drop the amplitude buffer to help with garbage collection
+    _amplitudes = Float32List(0);
   }
 
   @override
   String toString() {
     return 'WaveformData(amplitudes: ${amplitudes.length}, duration: $duration, '
-        'sampleRate: $sampleRate, metadata: $metadata)';
+        'sampleRate: $sampleRate, metadata: $metadata'
+        '${hasChannelData ? ', channels: $channelCount (${channelMode.name})' : ''}'
+        '${bins != null ? ', bins: ${bins!.length}' : ''}'
+        '${pyramid != null ? ', pyramid: ${pyramid!.levelCount} levels' : ''})';
   }
 }
@@ -0,0 +1,26 @@
+/// Scheduling priority of a background waveform request.
+///
+/// Requests wait in one queue per priority and the highest non-empty queue
+/// is served first, so a waveform that is on screen overtakes queued
+/// prefetch work. Requests that are already being processed are never
+/// interrupted.
+///
+/// ## Example Usage
+///
+/// ```dart
+/// // Waveform of a list item that just scrolled into view
+/// final visible = sonix.generateWaveformInIsolate('track_12.mp3', priority: WaveformPriority.visible);
+///
+/// // Warm up items just below the viewport
+/// sonix.generateWaveformInIsolate('track_13.mp3', priority: WaveformPriority.prefetch);
+/// ```
+enum WaveformPriority {
+  /// Speculative work whose result may never be shown
+  prefetch,
+
+  /// Default priority
+  normal,
+
+  /// Work the user is currently waiting for
+  visible,
+}
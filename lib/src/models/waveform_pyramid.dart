@@ -0,0 +1,201 @@
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'waveform_bins.dart';
+
+/// Multi-resolution (level-of-detail) pyramid of min/max/RMS bins.
+///
+/// Level 0 holds one bin per [baseFramesPerBin] audio frames; every coarser
+/// level merges pairs of bins of the level below, halving the bin count until
+/// a single bin covers the whole file. The pyramid costs about twice the
+/// memory of its finest level.
+///
+/// Any zoom level and viewport is served by picking the coarsest level that
+/// still has enough detail and slicing it, so zooming from hours down to
+/// milliseconds never re-runs waveform generation.
+///
+/// ## Example Usage
+///
+/// ```dart
+/// final waveform = await sonix.generateWaveform(
+///   'long_recording.wav',
+///   config: const WaveformConfig(generatePyramid: true),
+/// );
+///
+/// // 800 pixels showing 2 minutes starting at 1 hour
+/// final bins = waveform.pyramid!.slice(
+///   const Duration(hours: 1),
+///   const Duration(hours: 1, minutes: 2),
+///   800,
+/// );
+/// final displayBins = DisplaySampler.resampleBinsForDisplay(sourceBins: bins, targetCount: 800);
+/// ```
+class WaveformPyramid {
+  /// Default number of audio frames per bin at the finest level
+  static const int defaultBaseFramesPerBin = 256;
+
+  /// Levels from finest (index 0) to coarsest (a single bin)
+  final List<WaveformBins> levels;
+
+  /// Number of audio frames covered by one bin of level 0
+  final int baseFramesPerBin;
+
+  /// Sample rate of the source audio in Hz
+  final int sampleRate;
+
+  /// Total number of audio frames covered by the pyramid
+  final int totalFrames;
+
+  const WaveformPyramid._({required this.levels, required this.baseFramesPerBin, required this.sampleRate, required this.totalFrames});
+
+  /// Builds all coarser levels from the finest level.
+  ///
+  /// [baseLevel] must hold one bin per [baseFramesPerBin] frames, with the
+  /// last bin possibly covering fewer frames.
+  factory WaveformPyramid.fromBaseLevel(
+    WaveformBins baseLevel, {
+    required int sampleRate,
+    required int totalFrames,
+    int baseFramesPerBin = defaultBaseFramesPerBin,
+  }) {
+    if (baseFramesPerBin <= 0) {
+      throw ArgumentError.value(baseFramesPerBin, 'baseFramesPerBin', 'Must be positive');
+    }
+
+    final levels = <WaveformBins>[baseLevel];
+    while (levels.last.length > 1) {
+      levels.add(_mergePairs(levels.last));
+    }
+    return WaveformPyramid._(levels: List.unmodifiable(levels), baseFramesPerBin: baseFramesPerBin, sampleRate: sampleRate, totalFrames: totalFrames);
+  }
+
+  /// Wraps levels that were already built, e.g. after transfer between isolates.
+  ///
+  /// [levels] must be ordered finest first, each holding half the bins of the
+  /// previous one, as produced by [WaveformPyramid.fromBaseLevel].
+  ///
+  /// **Throws:** [ArgumentError] if [levels] is empty.
+  factory WaveformPyramid.fromLevels(
+    List<WaveformBins> levels, {
+    required int sampleRate,
+    required int totalFrames,
+    int baseFramesPerBin = defaultBaseFramesPerBin,
+  }) {
+    if (levels.isEmpty) {
+      throw ArgumentError.value(levels, 'levels', 'Must contain at least the base level');
+    }
+    return WaveformPyramid._(levels: List.unmodifiable(levels), baseFramesPerBin: baseFramesPerBin, sampleRate: sampleRate, totalFrames: totalFrames);
+  }
+
+  /// Number of levels in the pyramid
+  int get levelCount => levels.length;
+
+  /// Total duration covered by the pyramid
+  Duration get duration => sampleRate > 0 ? Duration(microseconds: totalFrames * Duration.microsecondsPerSecond ~/ sampleRate) : Duration.zero;
+
+  /// Approximate memory used by all levels in bytes
+  int get memoryUsage => levels.fold(0, (sum, level) => sum + level.data.lengthInBytes);
+
+  /// Number of audio frames covered by one bin of [level]
+  int framesPerBin(int level) => baseFramesPerBin << level;
+
+  /// Coarsest level that still provides at least [targetBins] bins over [frameSpan] frames
+  int levelForSpan(int frameSpan, int targetBins) {
+    if (frameSpan <= 0 || targetBins <= 0) return 0;
+
+    final maxFramesPerBin = frameSpan / targetBins;
+    int level = 0;
+    while (level + 1 < levelCount && framesPerBin(level + 1) <= maxFramesPerBin) {
+      level++;
+    }
+    return level;
+  }
+
+  /// Bins covering frames `[startFrame, endFrame)` at the level chosen by [levelForSpan].
+  ///
+  /// Returns between [targetBins] and roughly twice as many bins (fewer when
+  /// even level 0 is too coarse for the span). Pass the result to
+  /// `DisplaySampler.resampleBinsForDisplay` for an exact count.
+  WaveformBins sliceFrames(int startFrame, int endFrame, int targetBins) {
+    final start = startFrame.clamp(0, totalFrames);
+    final end = endFrame.clamp(start, totalFrames);
+    if (end == start) return WaveformBins.allocate(0);
+
+    final level = levelForSpan(end - start, targetBins);
+    final bins = levels[level];
+    final binFrames = framesPerBin(level);
+
+    final firstBin = math.min(start ~/ binFrames, bins.length);
+    final lastBin = math.min((end + binFrames - 1) ~/ binFrames, bins.length);
+    return _copyRange(bins, firstBin, lastBin);
+  }
+
+  /// Bins covering the time range `[start, end)`; see [sliceFrames]
+  WaveformBins slice(Duration start, Duration end, int targetBins) {
+    return sliceFrames(_frameAt(start), _frameAt(end), targetBins);
+  }
+
+  /// Multiplies every level in place, e.g. to normalize the pyramid
+  void scale(double factor) {
+    for (final level in levels) {
+      level.scale(factor);
+    }
+  }
+
+  /// Convert to JSON for serialization
+  ///
+  /// Only the finest level is stored; coarser levels are rebuilt on load.
+  Map<String, dynamic> toJson() {
+    return {'baseFramesPerBin': baseFramesPerBin, 'sampleRate': sampleRate, 'totalFrames': totalFrames, 'base': levels.first.toJson()};
+  }
+
+  /// Create from JSON
+  factory WaveformPyramid.fromJson(Map<String, dynamic> json) {
+    return WaveformPyramid.fromBaseLevel(
+      WaveformBins.fromJson(json['base'] as Map<String, dynamic>),
+      sampleRate: json['sampleRate'] as int,
+      totalFrames: json['totalFrames'] as int,
+      baseFramesPerBin: json['baseFramesPerBin'] as int? ?? defaultBaseFramesPerBin,
+    );
+  }
+
+  int _frameAt(Duration position) => position.inMicroseconds * sampleRate ~/ Duration.microsecondsPerSecond;
+
+  /// Merge neighbouring bin pairs into a level with half as many bins
+  static WaveformBins _mergePairs(WaveformBins source) {
+    final sourceLength = source.length;
+    final length = (sourceLength + 1) ~/ 2;
+    final merged = WaveformBins.allocate(length);
+    final from = source.data;
+    final to = merged.data;
+
+    for (int i = 0; i < length; i++) {
+      final a = 2 * i;
+      final b = math.min(a + 1, sourceLength - 1);
+      to[i] = math.min(from[a], from[b]);
+      to[length + i] = math.max(from[sourceLength + a], from[sourceLength + b]);
+
+      final rmsA = from[2 * sourceLength + a];
+      final rmsB = from[2 * sourceLength + b];
+      to[2 * length + i] = math.sqrt((rmsA * rmsA + rmsB * rmsB) / 2);
+    }
+    return merged;
+  }
+
+  /// Copy bins `[first, last)` into a new struct-of-arrays buffer
+  static WaveformBins _copyRange(WaveformBins bins, int first, int last) {
+    final count = last - first;
+    final result = WaveformBins.allocate(count);
+    if (count == 0) return result;
+
+    final from = bins.data;
+    final length = bins.length;
+    for (int row = 0; row < WaveformBins.valuesPerBin; row++) {
+      result.data.setRange(row * count, (row + 1) * count, Float32List.sublistView(from, row * length + first, row * length + last));
+    }
+    return result;
+  }
+
+  @override
+  String toString() => 'WaveformPyramid(levels: $levelCount, baseFramesPerBin: $baseFramesPerBin, totalFrames: $totalFrames)';
+}
@@ -4,16 +4,29 @@ import 'package:ffi/ffi.dart';
 
 import 'sonix_bindings.dart';
 import 'package:sonix/src/models/audio_data.dart';
+import 'package:sonix/src/models/native_audio_data.dart';
+import 'package:sonix/src/models/waveform_channel_mode.dart';
 import 'package:sonix/src/decoders/audio_decoder.dart';
 import 'package:sonix/src/exceptions/sonix_exceptions.dart';
+import 'package:sonix/src/processing/downsampling_algorithm.dart';
+import 'package:sonix/src/processing/waveform_config.dart';
 import 'package:sonix/src/utils/sonix_logger.dart';
 
+/// Raw output of one reducer of the native decode-once pipeline
+///
+/// [amplitudes] holds the mixed-down bins; [channelAmplitudes] holds planar
+/// per-channel bins (null for [WaveformChannelMode.mixed]).
+typedef NativeWaveformReduction = ({Float64List amplitudes, Float32List? channelAmplitudes, int channelCount});
+
 /// High-level wrapper for native audio bindings
 class NativeAudioBindings {
   static bool _initialized = false;
   static bool _ffmpegInitialized = false;
   static int _memoryPressureThreshold = 100 * 1024 * 1024; // 100MB threshold
 
+  /// Native buffers behind sample lists, for sharing them across isolates
+  static final Expando<ffi.Pointer<ffi.Float>> _nativeSamples = Expando('nativeSamples');
+
   /// Initialize the native bindings
   static void initialize() {
     if (_initialized) return;
@@ -246,49 +259,14 @@ class NativeAudioBindings {
       final resultPointer = SonixNativeBindings.decodeAudio(dataPointer, data.length, formatCode);
 
       if (resultPointer == ffi.nullptr) {
-        final errorMsg = _getLastErrorMessage();
-
-        // Provide detailed FFMPEG-specific error messages
-        if (errorMsg.contains('not found') || errorMsg.contains('download')) {
-          throw DecodingException(
-            'FFMPEG libraries not found',
-            'FFMPEG libraries are required but not properly installed. '
-                'Install system FFmpeg (e.g., macOS: brew install ffmpeg)\n'
-                'Error: $errorMsg',
-          );
-        } else if (errorMsg.contains('probe')) {
-          throw DecodingException(
-            'FFMPEG format probing failed',
-            'The file format could not be detected by FFMPEG. '
-                'The file may be corrupted or use an unsupported format variant.\n'
-                'Error: $errorMsg',
-          );
-        } else if (errorMsg.contains('codec')) {
-          throw DecodingException(
-            'FFMPEG codec not found',
-            'The required codec for this audio format is not available in the FFMPEG build.\n'
-                'Error: $errorMsg',
-          );
-        } else if (errorMsg.contains('decode')) {
-          throw DecodingException(
-            'FFMPEG decoding failed',
-            'FFMPEG could not decode the audio data. The file may be corrupted.\n'
-                'Error: $errorMsg',
-          );
-        } else {
-          throw DecodingException(
-            'FFMPEG audio decoding failed',
-            'FFMPEG failed to decode the audio data.\n'
-                'Error: $errorMsg',
-          );
-        }
+        throw _decodeFailure(_getLastErrorMessage());
       }
 
-      try {
-        return _convertNativeAudioData(resultPointer.ref);
-      } finally {
+      if (resultPointer.ref.samples == ffi.nullptr || resultPointer.ref.sample_count == 0) {
         SonixNativeBindings.freeAudioData(resultPointer);
+        throw DecodingException('Invalid native audio data');
       }
+      return adoptNativeAudioData(resultPointer);
     } catch (e) {
       if (e is SonixException) {
         rethrow;
@@ -305,6 +283,357 @@ class NativeAudioBindings {
     }
   }
 
+  /// Decode an audio file by path
+  ///
+  /// FFmpeg reads the file through its own buffered I/O, so unlike
+  /// [decodeAudio] the compressed bytes are never loaded into (and copied
+  /// between) Dart and native memory. The decoded samples are handed over
+  /// without copying, see [adoptNativeAudioData].
+  ///
+  /// Throws [DecodingException] if the file cannot be opened or decoded.
+  static AudioData decodeFile(String filePath) {
+    _ensureInitialized();
+
+    if (!isFFMPEGAvailable) {
+      throw DecodingException(
+        'FFMPEG not available for audio decoding',
+        'FFMPEG libraries are required for audio decoding. '
+            'Install system FFmpeg (e.g., macOS: brew install ffmpeg)',
+      );
+    }
+
+    final pathPointer = filePath.toNativeUtf8();
+    try {
+      final resultPointer = SonixNativeBindings.decodeFile(pathPointer.cast<ffi.Char>());
+      if (resultPointer == ffi.nullptr) {
+        throw _decodeFailure(_getLastErrorMessage());
+      }
+      return adoptNativeAudioData(resultPointer);
+    } catch (e) {
+      if (e is SonixException) {
+        rethrow;
+      }
+      SonixLogger.native('decodeFile', 'Native decoding failed: ${e.toString()}', level: 2);
+      throw DecodingException('Native decoding failed', 'Error during FFI operation.\nError: $e');
+    } finally {
+      malloc.free(pathPointer);
+    }
+  }
+
+  /// Decode an audio file once and reduce it into one raw waveform per config
+  ///
+  /// All configs share a single native decode pass: every decoded frame is fed
+  /// to each reducer, so generating N waveforms costs one decode instead of N.
+  /// Only the downsampling step runs natively; smoothing, normalization and
+  /// scaling are left to the caller (see `WaveformGenerator.fromRawAmplitudes`).
+  ///
+  /// [DownsamplingAlgorithm.median] needs every sample of a bin at once and
+  /// cannot be reduced in a single streaming pass; use [supportsNativeReduction]
+  /// to check configs before calling.
+  ///
+  /// Returns one reduction per config, in the same order, together with the
+  /// stream properties of the decoded file. Each reduction holds the mixed
+  /// amplitudes and, for configs with a [WaveformChannelMode] other than
+  /// mixed, the planar per-channel amplitudes from the same pass.
+  ///
+  /// Throws [DecodingException] if the file cannot be decoded.
+  static ({List<NativeWaveformReduction> reductions, int sampleRate, int channels, Duration duration}) generateWaveforms(
+    String filePath,
+    List<WaveformConfig> configs,
+  ) {
+    _ensureInitialized();
+
+    if (configs.isEmpty) {
+      throw ArgumentError('At least one waveform configuration is required');
+    }
+
+    if (!isFFMPEGAvailable) {
+      throw DecodingException(
+        'FFMPEG not available for waveform generation',
+        'FFMPEG libraries are required for audio decoding. '
+            'Install system FFmpeg (e.g., macOS: brew install ffmpeg)',
+      );
+    }
+
+    final pathPointer = filePath.toNativeUtf8();
+    final configPointer = malloc<SonixReducerConfig>(configs.length);
+
+    try {
+      for (int i = 0; i < configs.length; i++) {
+        configPointer[i].resolution = configs[i].resolution;
+        configPointer[i].algorithm = _reducerAlgorithmCode(configs[i].algorithm);
+        configPointer[i].channel_mode = _channelModeCode(configs[i].channelMode);
+      }
+
+      final resultPointer = SonixNativeBindings.generateWaveforms(pathPointer.cast<ffi.Char>(), configPointer, configs.length);
+      if (resultPointer == ffi.nullptr) {
+        final errorMsg = _getLastErrorMessage();
+        throw DecodingException(
+          'FFMPEG waveform generation failed',
+          'FFMPEG could not decode the audio file.\n'
+              'Error: $errorMsg',
+        );
+      }
+
+      try {
+        final result = resultPointer.ref;
+        final reductions = <NativeWaveformReduction>[];
+        for (int i = 0; i < result.output_count; i++) {
+          final output = result.outputs[i];
+          final hasChannels = output.channel_values != ffi.nullptr && output.channel_count > 0;
+          reductions.add((
+            amplitudes: Float64List.fromList(output.values.asTypedList(output.resolution)),
+            channelAmplitudes: hasChannels ? Float32List.fromList(output.channel_values.asTypedList(output.channel_count * output.resolution)) : null,
+            channelCount: hasChannels ? output.channel_count : 0,
+          ));
+        }
+
+        return (
+          reductions: reductions,
+          sampleRate: result.sample_rate,
+          channels: result.channels,
+          duration: Duration(milliseconds: result.duration_ms),
+        );
+      } finally {
+        SonixNativeBindings.freeMultiWaveformResult(resultPointer);
+      }
+    } catch (e) {
+      if (e is SonixException || e is ArgumentError) {
+        rethrow;
+      }
+      SonixLogger.native('generateWaveforms', 'Native waveform generation failed: ${e.toString()}', level: 2);
+      throw DecodingException('Native waveform generation failed', 'Error during FFI operation.\nError: $e');
+    } finally {
+      malloc.free(pathPointer);
+      malloc.free(configPointer);
+    }
+  }
+
+  /// Read stream properties of an audio file without decoding it
+  ///
+  /// Opens the container and reads its headers only. The duration comes from
+  /// container metadata and may be zero for streams that do not declare it.
+  ///
+  /// Throws [DecodingException] if the file cannot be opened.
+  static ({Duration duration, int sampleRate, int channels}) probeFile(String filePath) {
+    _ensureInitialized();
+
+    final pathPointer = filePath.toNativeUtf8();
+    final durationPointer = malloc<ffi.Uint32>();
+    final sampleRatePointer = malloc<ffi.Uint32>();
+    final channelsPointer = malloc<ffi.Uint32>();
+    ffi.Pointer<SonixChunkedDecoder> decoder = ffi.nullptr;
+
+    try {
+      decoder = SonixNativeBindings.initChunkedDecoder(SONIX_FORMAT_UNKNOWN, pathPointer.cast<ffi.Char>());
+      if (decoder == ffi.nullptr) {
+        throw DecodingException('Failed to probe audio file', 'Error: ${_getLastErrorMessage()}');
+      }
+
+      final status = SonixNativeBindings.getDecoderMediaInfo(decoder, durationPointer, sampleRatePointer, channelsPointer);
+      if (status != SONIX_OK) {
+        throw DecodingException('Failed to read media info', 'Error: ${_getLastErrorMessage()}');
+      }
+
+      return (duration: Duration(milliseconds: durationPointer.value), sampleRate: sampleRatePointer.value, channels: channelsPointer.value);
+    } finally {
+      if (decoder != ffi.nullptr) {
+        SonixNativeBindings.cleanupChunkedDecoder(decoder);
+      }
+      malloc.free(pathPointer);
+      malloc.free(durationPointer);
+      malloc.free(sampleRatePointer);
+      malloc.free(channelsPointer);
+    }
+  }
+
+  /// Decode a whole file to interleaved float PCM in [scratchPath]
+  ///
+  /// Decoded frames are streamed to disk one at a time, so the heap never
+  /// holds more than a single frame. The scratch file is removed if decoding
+  /// fails.
+  ///
+  /// Throws [DecodingException] if the file cannot be decoded or written.
+  static ({int frameCount, int sampleRate, int channels, Duration duration}) decodeToScratchFile(String filePath, String scratchPath) {
+    _ensureInitialized();
+
+    final pathPointer = filePath.toNativeUtf8();
+    final scratchPointer = scratchPath.toNativeUtf8();
+    final infoPointer = calloc<SonixScratchInfo>();
+
+    try {
+      final status = SonixNativeBindings.decodeToScratchFile(pathPointer.cast<ffi.Char>(), scratchPointer.cast<ffi.Char>(), infoPointer);
+      if (status != SONIX_OK) {
+        throw DecodingException('Failed to decode audio to scratch file', 'Error: ${_getLastErrorMessage()}');
+      }
+
+      final info = infoPointer.ref;
+      return (frameCount: info.frame_count, sampleRate: info.sample_rate, channels: info.channels, duration: Duration(milliseconds: info.duration_ms));
+    } finally {
+      malloc.free(pathPointer);
+      malloc.free(scratchPointer);
+      calloc.free(infoPointer);
+    }
+  }
+
+  /// Map a scratch file written by [decodeToScratchFile] into memory
+  ///
+  /// The mapping is copy-on-write: writes to the returned memory never reach
+  /// the file. Release it with [unmapScratchFile].
+  ///
+  /// Throws [DecodingException] if the file cannot be mapped.
+  static ({ffi.Pointer<ffi.Float> data, int byteSize}) mapScratchFile(String scratchPath) {
+    _ensureInitialized();
+
+    final scratchPointer = scratchPath.toNativeUtf8();
+    final sizePointer = malloc<ffi.Uint64>();
+
+    try {
+      final data = SonixNativeBindings.mapScratchFile(scratchPointer.cast<ffi.Char>(), sizePointer);
+      if (data == ffi.nullptr) {
+        throw DecodingException('Failed to map scratch file', 'Error: ${_getLastErrorMessage()}');
+      }
+      return (data: data, byteSize: sizePointer.value);
+    } finally {
+      malloc.free(scratchPointer);
+      malloc.free(sizePointer);
+    }
+  }
+
+  /// Release a mapping returned by [mapScratchFile]
+  static void unmapScratchFile(ffi.Pointer<ffi.Float> data, int byteSize) {
+    SonixNativeBindings.unmapScratchFile(data, byteSize);
+  }
+
+  /// Map a scratch file and take ownership of it
+  ///
+  /// Maps like [mapScratchFile]. On POSIX the file is unlinked right away,
+  /// so it disappears even if the process dies; on Windows it is deleted by
+  /// [releaseScratchMapping]. Release the handle with [releaseScratchMapping]
+  /// (or attach [SonixNativeBindings.releaseScratchMappingFinalizer]).
+  ///
+  /// Throws [DecodingException] if the file cannot be mapped; the file is
+  /// left in place.
+  static ffi.Pointer<SonixScratchMapping> openScratchMapping(String scratchPath) {
+    _ensureInitialized();
+
+    final scratchPointer = scratchPath.toNativeUtf8();
+    try {
+      final mapping = SonixNativeBindings.openScratchMapping(scratchPointer.cast<ffi.Char>());
+      if (mapping == ffi.nullptr) {
+        throw DecodingException('Failed to map scratch file', 'Error: ${_getLastErrorMessage()}');
+      }
+      return mapping;
+    } finally {
+      malloc.free(scratchPointer);
+    }
+  }
+
+  /// Release a handle returned by [openScratchMapping]
+  static void releaseScratchMapping(ffi.Pointer<SonixScratchMapping> mapping) {
+    SonixNativeBindings.releaseScratchMapping(mapping);
+  }
+
+  /// Map a binary waveform file into memory for random access
+  ///
+  /// The mapping is copy-on-write like [mapScratchFile], but without
+  /// read-ahead: only the pages that are read are loaded. Release it with
+  /// [unmapWaveformFile].
+  ///
+  /// Throws [FileAccessException] if the file cannot be mapped.
+  static ({ffi.Pointer<ffi.Uint8> data, int byteSize}) mapWaveformFile(String path) {
+    _ensureInitialized();
+
+    final pathPointer = path.toNativeUtf8();
+    final sizePointer = malloc<ffi.Uint64>();
+
+    try {
+      final data = SonixNativeBindings.mapWaveformFile(pathPointer.cast<ffi.Char>(), sizePointer);
+      if (data == ffi.nullptr) {
+        throw FileAccessException(path, 'Failed to map waveform file', 'Error: ${_getLastErrorMessage()}');
+      }
+      return (data: data, byteSize: sizePointer.value);
+    } finally {
+      malloc.free(pathPointer);
+      malloc.free(sizePointer);
+    }
+  }
+
+  /// Release a mapping returned by [mapWaveformFile]
+  static void unmapWaveformFile(ffi.Pointer<ffi.Uint8> data, int byteSize) {
+    SonixNativeBindings.unmapWaveformFile(data, byteSize);
+  }
+
+  /// Live native resources: decoded audio, chunk results, chunked decoders,
+  /// waveform results, FFmpeg contexts and file mappings
+  ///
+  /// Counts cover every isolate and return to zero once everything is
+  /// released. Audio adopted by Dart (see [adoptNativeAudioData]) drops
+  /// when it is disposed, or after garbage collection if it never is; every
+  /// other count drops as soon as the owner is done.
+  static ({
+    int audioData,
+    int chunkResults,
+    int chunkedDecoders,
+    int multiWaveformResults,
+    int ffmpegContexts,
+    int mappings,
+    int mappedBytes,
+  })
+  resourceCounters() {
+    _ensureInitialized();
+
+    final counters = calloc<SonixResourceCounters>();
+    try {
+      SonixNativeBindings.getResourceCounters(counters);
+      final ref = counters.ref;
+      return (
+        audioData: ref.audio_data,
+        chunkResults: ref.chunk_results,
+        chunkedDecoders: ref.chunked_decoders,
+        multiWaveformResults: ref.multi_waveform_results,
+        ffmpegContexts: ref.ffmpeg_contexts,
+        mappings: ref.mappings,
+        mappedBytes: ref.mapped_bytes,
+      );
+    } finally {
+      calloc.free(counters);
+    }
+  }
+
+  /// Whether [config] can be reduced by the native decode-once pipeline
+  ///
+  /// Median reduction, min/max/RMS bins and pyramids are only computed in Dart.
+  static bool supportsNativeReduction(WaveformConfig config) {
+    return config.algorithm != DownsamplingAlgorithm.median && !config.generateBins && !config.generatePyramid;
+  }
+
+  /// Convert a downsampling algorithm to its native reducer code
+  static int _reducerAlgorithmCode(DownsamplingAlgorithm algorithm) {
+    switch (algorithm) {
+      case DownsamplingAlgorithm.rms:
+        return SONIX_REDUCER_RMS;
+      case DownsamplingAlgorithm.peak:
+        return SONIX_REDUCER_PEAK;
+      case DownsamplingAlgorithm.average:
+        return SONIX_REDUCER_AVERAGE;
+      case DownsamplingAlgorithm.median:
+        throw ArgumentError('Median downsampling cannot be reduced natively');
+    }
+  }
+
+  /// Convert a channel mode to its native code
+  static int _channelModeCode(WaveformChannelMode mode) {
+    switch (mode) {
+      case WaveformChannelMode.mixed:
+        return SONIX_CHANNEL_MODE_MIXED;
+      case WaveformChannelMode.perChannel:
+        return SONIX_CHANNEL_MODE_PER_CHANNEL;
+      case WaveformChannelMode.midSide:
+        return SONIX_CHANNEL_MODE_MID_SIDE;
+    }
+  }
+
   /// Check if memory pressure would be exceeded for given data size
   static bool wouldExceedMemoryPressure(int dataSize) {
     return dataSize > _memoryPressureThreshold;
@@ -382,25 +711,64 @@ class NativeAudioBindings {
     }
   }
 
-  /// Convert native audio data to Dart AudioData
-  static AudioData _convertNativeAudioData(SonixAudioData nativeData) {
-    if (nativeData.samples == ffi.nullptr || nativeData.sample_count == 0) {
-      throw DecodingException('Invalid native audio data');
+  /// Map a native decode error message to a descriptive [DecodingException]
+  static DecodingException _decodeFailure(String errorMsg) {
+    if (errorMsg.contains('not found') || errorMsg.contains('download')) {
+      return DecodingException(
+        'FFMPEG libraries not found',
+        'FFMPEG libraries are required but not properly installed. '
+            'Install system FFmpeg (e.g., macOS: brew install ffmpeg)\n'
+            'Error: $errorMsg',
+      );
+    } else if (errorMsg.contains('probe')) {
+      return DecodingException(
+        'FFMPEG format probing failed',
+        'The file format could not be detected by FFMPEG. '
+            'The file may be corrupted or use an unsupported format variant.\n'
+            'Error: $errorMsg',
+      );
+    } else if (errorMsg.contains('codec')) {
+      return DecodingException(
+        'FFMPEG codec not found',
+        'The required codec for this audio format is not available in the FFMPEG build.\n'
+            'Error: $errorMsg',
+      );
+    } else if (errorMsg.contains('decode')) {
+      return DecodingException(
+        'FFMPEG decoding failed',
+        'FFMPEG could not decode the audio data. The file may be corrupted.\n'
+            'Error: $errorMsg',
+      );
+    } else {
+      return DecodingException(
+        'FFMPEG audio decoding failed',
+        'FFMPEG failed to decode the audio data.\n'
+            'Error: $errorMsg',
+      );
     }
+  }
 
-    // Convert native float array to a typed list efficiently.
-    // We must copy because the native memory is freed after conversion.
-    final nativeView = nativeData.samples.asTypedList(nativeData.sample_count);
-    final samples = Float32List.fromList(nativeView);
+  /// Wrap native audio data as [AudioData] without copying the samples
+  ///
+  /// Takes ownership of [pointer]; see [NativeAudioData] for how the buffer
+  /// is released. The caller must not free [pointer] (or a chunk result
+  /// still referencing it) afterwards.
+  static NativeAudioData adoptNativeAudioData(ffi.Pointer<SonixAudioData> pointer) => NativeAudioData.adopt(pointer);
 
-    return AudioData(
-      samples: samples,
-      sampleRate: nativeData.sample_rate,
-      channels: nativeData.channels,
-      duration: Duration(milliseconds: nativeData.duration_ms),
-    );
+  /// Remember that [samples] is a view of the native buffer [data]
+  ///
+  /// The association is weak: it lives exactly as long as [samples].
+  static void trackNativeSamples(Float32List samples, ffi.Pointer<ffi.Float> data) {
+    _nativeSamples[samples] = data;
   }
 
+  /// Native buffer behind [samples], or null if the list lives on the Dart heap
+  ///
+  /// Set for samples of decoded and memory-mapped audio. Other isolates can
+  /// read the buffer through `Pointer.fromAddress` while the [AudioData]
+  /// owning [samples] is kept alive and not disposed.
+  static ffi.Pointer<ffi.Float>? nativeSamplesOf(List<double> samples) => _nativeSamples[samples];
+
   /// Allocate native memory for Uint8List
   static ffi.Pointer<ffi.Uint8> _allocateUint8Array(Uint8List data) {
     final pointer = malloc<ffi.Uint8>(data.length);
@@ -41,6 +41,16 @@ const int SONIX_ERROR_FFMPEG_FRAME_DECODE_FAILED = -27;
 const int SONIX_ERROR_FFMPEG_RESAMPLE_FAILED = -28;
 const int SONIX_ERROR_FFMPEG_NOT_AVAILABLE = -100;
 
+/// Waveform reducer algorithms for the decode-once pipeline
+const int SONIX_REDUCER_RMS = 0;
+const int SONIX_REDUCER_PEAK = 1;
+const int SONIX_REDUCER_AVERAGE = 2;
+
+/// Reducer channel modes (mixed output is always produced)
+const int SONIX_CHANNEL_MODE_MIXED = 0;
+const int SONIX_CHANNEL_MODE_PER_CHANNEL = 1;
+const int SONIX_CHANNEL_MODE_MID_SIDE = 2;
+
 /// FFMPEG backend availability flag
 const int SONIX_BACKEND_LEGACY = 0;
 const int SONIX_BACKEND_FFMPEG = 1;
@@ -98,6 +108,75 @@ final class SonixChunkResult extends ffi.Struct {
 /// Opaque chunked decoder handle
 final class SonixChunkedDecoder extends ffi.Opaque {}
 
+/// Decode-once waveform pipeline structures
+final class SonixReducerConfig extends ffi.Struct {
+  @ffi.Uint32()
+  external int resolution;
+  @ffi.Int32()
+  external int algorithm;
+  @ffi.Int32()
+  external int channel_mode;
+}
+
+final class SonixReducerOutput extends ffi.Struct {
+  external ffi.Pointer<ffi.Float> values;
+  @ffi.Uint32()
+  external int resolution;
+  external ffi.Pointer<ffi.Float> channel_values; // planar, NULL for mixed mode
+  @ffi.Uint32()
+  external int channel_count;
+}
+
+final class SonixMultiWaveformResult extends ffi.Struct {
+  external ffi.Pointer<SonixReducerOutput> outputs;
+  @ffi.Uint32()
+  external int output_count;
+  @ffi.Uint32()
+  external int sample_rate;
+  @ffi.Uint32()
+  external int channels;
+  @ffi.Uint32()
+  external int duration_ms;
+}
+
+/// Stream properties of a file decoded to a scratch file
+final class SonixScratchInfo extends ffi.Struct {
+  @ffi.Uint64()
+  external int frame_count;
+  @ffi.Uint32()
+  external int sample_rate;
+  @ffi.Uint32()
+  external int channels;
+  @ffi.Uint32()
+  external int duration_ms;
+}
+
+/// Mapped scratch file owned by one handle of `sonix_open_scratch_mapping`
+final class SonixScratchMapping extends ffi.Struct {
+  external ffi.Pointer<ffi.Float> data;
+  @ffi.Uint64()
+  external int byte_size;
+  external ffi.Pointer<ffi.Char> path;
+}
+
+/// Live native resource counts reported by `sonix_get_resource_counters`
+final class SonixResourceCounters extends ffi.Struct {
+  @ffi.Int64()
+  external int audio_data;
+  @ffi.Int64()
+  external int chunk_results;
+  @ffi.Int64()
+  external int chunked_decoders;
+  @ffi.Int64()
+  external int multi_waveform_results;
+  @ffi.Int64()
+  external int ffmpeg_contexts;
+  @ffi.Int64()
+  external int mappings;
+  @ffi.Int64()
+  external int mapped_bytes;
+}
+
 typedef SonixGetLastMp3DebugStatsNative = ffi.Pointer<SonixMp3DebugStats> Function();
 typedef SonixGetLastMp3DebugStatsDart = ffi.Pointer<SonixMp3DebugStats> Function();
 
@@ -136,6 +215,38 @@ typedef SonixGetDecoderMediaInfoDart =
       ffi.Pointer<ffi.Uint32> channels,
     );
 
+// Decode-once waveform pipeline
+typedef SonixGenerateWaveformsNative =
+    ffi.Pointer<SonixMultiWaveformResult> Function(ffi.Pointer<ffi.Char> filePath, ffi.Pointer<SonixReducerConfig> configs, ffi.Uint32 configCount);
+typedef SonixGenerateWaveformsDart =
+    ffi.Pointer<SonixMultiWaveformResult> Function(ffi.Pointer<ffi.Char> filePath, ffi.Pointer<SonixReducerConfig> configs, int configCount);
+
+typedef SonixFreeMultiWaveformResultNative = ffi.Void Function(ffi.Pointer<SonixMultiWaveformResult> result);
+typedef SonixFreeMultiWaveformResultDart = void Function(ffi.Pointer<SonixMultiWaveformResult> result);
+
+// Scratch-file decoding
+typedef SonixDecodeToScratchFileNative = ffi.Int32 Function(ffi.Pointer<ffi.Char> filePath, ffi.Pointer<ffi.Char> scratchPath, ffi.Pointer<SonixScratchInfo> info);
+typedef SonixDecodeToScratchFileDart = int Function(ffi.Pointer<ffi.Char> filePath, ffi.Pointer<ffi.Char> scratchPath, ffi.Pointer<SonixScratchInfo> info);
+
+typedef SonixMapScratchFileNative = ffi.Pointer<ffi.Float> Function(ffi.Pointer<ffi.Char> scratchPath, ffi.Pointer<ffi.Uint64> byteSize);
+typedef SonixMapScratchFileDart = ffi.Pointer<ffi.Float> Function(ffi.Pointer<ffi.Char> scratchPath, ffi.Pointer<ffi.Uint64> byteSize);
+
+typedef SonixUnmapScratchFileNative = ffi.Void Function(ffi.Pointer<ffi.Float> data, ffi.Uint64 byteSize);
+typedef SonixUnmapScratchFileDart = void Function(ffi.Pointer<ffi.Float> data, int byteSize);
+
+typedef SonixOpenScratchMappingNative = ffi.Pointer<SonixScratchMapping> Function(ffi.Pointer<ffi.Char> scratchPath);
+typedef SonixOpenScratchMappingDart = ffi.Pointer<SonixScratchMapping> Function(ffi.Pointer<ffi.Char> scratchPath);
+
+typedef SonixReleaseScratchMappingNative = ffi.Void Function(ffi.Pointer<SonixScratchMapping> mapping);
+typedef SonixReleaseScratchMappingDart = void Function(ffi.Pointer<SonixScratchMapping> mapping);
+
+// Binary waveform files
+typedef SonixMapWaveformFileNative = ffi.Pointer<ffi.Uint8> Function(ffi.Pointer<ffi.Char> path, ffi.Pointer<ffi.Uint64> byteSize);
+typedef SonixMapWaveformFileDart = ffi.Pointer<ffi.Uint8> Function(ffi.Pointer<ffi.Char> path, ffi.Pointer<ffi.Uint64> byteSize);
+
+typedef SonixUnmapWaveformFileNative = ffi.Void Function(ffi.Pointer<ffi.Uint8> data, ffi.Uint64 byteSize);
+typedef SonixUnmapWaveformFileDart = void Function(ffi.Pointer<ffi.Uint8> data, int byteSize);
+
 /// Function signatures for native library
 typedef SonixDetectFormatNative = ffi.Int32 Function(ffi.Pointer<ffi.Uint8> data, ffi.Size size);
 
@@ -145,6 +256,10 @@ typedef SonixDecodeAudioNative = ffi.Pointer<SonixAudioData> Function(ffi.Pointe
 
 typedef SonixDecodeAudioDart = ffi.Pointer<SonixAudioData> Function(ffi.Pointer<ffi.Uint8> data, int size, int format);
 
+typedef SonixDecodeFileNative = ffi.Pointer<SonixAudioData> Function(ffi.Pointer<ffi.Char> filePath);
+
+typedef SonixDecodeFileDart = ffi.Pointer<SonixAudioData> Function(ffi.Pointer<ffi.Char> filePath);
+
 typedef SonixFreeAudioDataNative = ffi.Void Function(ffi.Pointer<SonixAudioData> audioData);
 
 typedef SonixFreeAudioDataDart = void Function(ffi.Pointer<SonixAudioData> audioData);
@@ -153,6 +268,10 @@ typedef SonixGetErrorMessageNative = ffi.Pointer<ffi.Char> Function();
 
 typedef SonixGetErrorMessageDart = ffi.Pointer<ffi.Char> Function();
 
+typedef SonixGetResourceCountersNative = ffi.Void Function(ffi.Pointer<SonixResourceCounters> counters);
+
+typedef SonixGetResourceCountersDart = void Function(ffi.Pointer<SonixResourceCounters> counters);
+
 // FFMPEG-specific function signatures
 typedef SonixGetBackendTypeNative = ffi.Int32 Function();
 
@@ -280,12 +399,25 @@ class SonixNativeBindings {
   /// Decode audio data from memory
   static final SonixDecodeAudioDart decodeAudio = lib.lookup<ffi.NativeFunction<SonixDecodeAudioNative>>('sonix_decode_audio').asFunction();
 
+  /// Decode a whole audio file by path
+  static final SonixDecodeFileDart decodeFile = lib.lookup<ffi.NativeFunction<SonixDecodeFileNative>>('sonix_decode_file').asFunction();
+
   /// Free audio data allocated by decode_audio
   static final SonixFreeAudioDataDart freeAudioData = lib.lookup<ffi.NativeFunction<SonixFreeAudioDataNative>>('sonix_free_audio_data').asFunction();
 
+  /// `sonix_free_audio_data` as a finalizer for native-backed typed lists
+  static final ffi.Pointer<ffi.NativeFinalizerFunction> freeAudioDataFinalizer = lib
+      .lookup<ffi.NativeFunction<SonixFreeAudioDataNative>>('sonix_free_audio_data')
+      .cast<ffi.NativeFinalizerFunction>();
+
   /// Get error message for the last error
   static final SonixGetErrorMessageDart getErrorMessage = lib.lookup<ffi.NativeFunction<SonixGetErrorMessageNative>>('sonix_get_error_message').asFunction();
 
+  /// Snapshot the live native resource counts
+  static final SonixGetResourceCountersDart getResourceCounters = lib
+      .lookup<ffi.NativeFunction<SonixGetResourceCountersNative>>('sonix_get_resource_counters')
+      .asFunction();
+
   // Debug: MP3 stats accessor (may return nullptr if not applicable)
   static final SonixGetLastMp3DebugStatsDart getLastMp3DebugStats = lib
       .lookup<ffi.NativeFunction<SonixGetLastMp3DebugStatsNative>>('sonix_get_last_mp3_debug_stats')
@@ -324,6 +456,62 @@ class SonixNativeBindings {
       .lookup<ffi.NativeFunction<SonixGetDecoderMediaInfoNative>>('sonix_get_decoder_media_info')
       .asFunction();
 
+  // Decode-once waveform pipeline
+
+  /// Decode a file once and run several waveform reducers over the same frames
+  static final SonixGenerateWaveformsDart generateWaveforms = lib
+      .lookup<ffi.NativeFunction<SonixGenerateWaveformsNative>>('sonix_generate_waveforms')
+      .asFunction();
+
+  /// Free a result returned by generateWaveforms
+  static final SonixFreeMultiWaveformResultDart freeMultiWaveformResult = lib
+      .lookup<ffi.NativeFunction<SonixFreeMultiWaveformResultNative>>('sonix_free_multi_waveform_result')
+      .asFunction();
+
+  // Scratch-file decoding
+
+  /// Decode a whole file to interleaved float PCM in a scratch file
+  static final SonixDecodeToScratchFileDart decodeToScratchFile = lib
+      .lookup<ffi.NativeFunction<SonixDecodeToScratchFileNative>>('sonix_decode_to_scratch_file')
+      .asFunction();
+
+  /// Map a scratch file into memory (copy-on-write)
+  static final SonixMapScratchFileDart mapScratchFile = lib
+      .lookup<ffi.NativeFunction<SonixMapScratchFileNative>>('sonix_map_scratch_file')
+      .asFunction();
+
+  /// Unmap a scratch file mapped by mapScratchFile
+  static final SonixUnmapScratchFileDart unmapScratchFile = lib
+      .lookup<ffi.NativeFunction<SonixUnmapScratchFileNative>>('sonix_unmap_scratch_file')
+      .asFunction();
+
+  /// Map a scratch file and take ownership of it (unlinked at once on POSIX)
+  static final SonixOpenScratchMappingDart openScratchMapping = lib
+      .lookup<ffi.NativeFunction<SonixOpenScratchMappingNative>>('sonix_open_scratch_mapping')
+      .asFunction();
+
+  /// Unmap a handle of openScratchMapping (and delete its file on Windows)
+  static final SonixReleaseScratchMappingDart releaseScratchMapping = lib
+      .lookup<ffi.NativeFunction<SonixReleaseScratchMappingNative>>('sonix_release_scratch_mapping')
+      .asFunction();
+
+  /// `sonix_release_scratch_mapping` as a finalizer for mapped audio
+  static final ffi.Pointer<ffi.NativeFinalizerFunction> releaseScratchMappingFinalizer = lib
+      .lookup<ffi.NativeFunction<SonixReleaseScratchMappingNative>>('sonix_release_scratch_mapping')
+      .cast<ffi.NativeFinalizerFunction>();
+
+  // Binary waveform files
+
+  /// Map a binary waveform file into memory (copy-on-write, random access)
+  static final SonixMapWaveformFileDart mapWaveformFile = lib
+      .lookup<ffi.NativeFunction<SonixMapWaveformFileNative>>('sonix_map_waveform_file')
+      .asFunction();
+
+  /// Unmap a waveform file mapped by mapWaveformFile
+  static final SonixUnmapWaveformFileDart unmapWaveformFile = lib
+      .lookup<ffi.NativeFunction<SonixUnmapWaveformFileNative>>('sonix_unmap_waveform_file')
+      .asFunction();
+
   // FFMPEG-specific functions
 
   /// Get the current backend type (legacy or FFMPEG)
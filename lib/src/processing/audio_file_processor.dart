@@ -1,40 +1,78 @@
 import 'dart:async';
+import 'dart:io';
+import 'dart:typed_data';
 
 import '../models/audio_data.dart';
+import '../models/mapped_audio_data.dart';
+import '../models/waveform_data.dart';
 import '../decoders/audio_file_decoder.dart';
+import '../exceptions/sonix_exceptions.dart';
+import '../native/native_audio_bindings.dart';
 import '../utils/audio_file_validator.dart';
+import '../utils/sonix_logger.dart';
+import 'audio_processing_strategy.dart';
+import 'cooperative_waveform_generator.dart';
+import 'streaming_waveform_generator.dart';
+import 'waveform_config.dart';
+import 'waveform_generator.dart';
 
 /// Processes audio files and returns decoded audio data.
 ///
-/// This class orchestrates file decoding by selecting the appropriate
-/// strategy based on file size:
-/// - Small files: Uses [SimpleAudioFileDecoder] for full load
-/// - Large files: Uses [StreamingAudioFileDecoder] for chunked processing
+/// This class orchestrates file decoding by selecting an
+/// [AudioProcessingStrategy] from a cheap header probe of the decoded size
+/// (duration × sample rate × channels) against [scratchBudget]:
+/// - Fits the budget: Uses [SimpleAudioFileDecoder], which decodes by path in one shot
+/// - Exceeds the budget: Decodes to a memory-mapped scratch file ([MappedAudioData]),
+///   or, for [generateWaveform], folds chunks straight into the waveform
 ///
 /// Callers don't need to know about memory limits or chunking.
 /// The processor automatically selects the best strategy.
 class AudioFileProcessor {
-  /// Size threshold for switching to chunked processing.
-  /// Files larger than this use streaming to avoid memory issues.
+  /// Compressed size above which files of unknown decoded size are treated
+  /// as exceeding the memory budget.
   static const int defaultChunkThreshold = 50 * 1024 * 1024; // 50MB
 
+  /// Decoded size above which audio is no longer held on the heap.
+  static const int defaultScratchBudget = 512 * 1024 * 1024; // 512MB
+
+  /// Upper bound on decoded float PCM bytes per encoded byte (low-bitrate Opus).
+  /// Files that cannot exceed the budget even at this ratio are never probed.
+  static const int _maxDecodedExpansion = 48;
+
+  static int _scratchCounter = 0;
+
+  /// Compressed size in bytes above which a file whose duration cannot be
+  /// probed is decoded as if it exceeded [scratchBudget].
   final int chunkThreshold;
 
+  /// Decoded size in bytes the heap may hold for one file. Larger files go
+  /// to a scratch file instead (or are streamed by [generateWaveform]).
+  /// Zero or less keeps all decoded audio on the heap.
+  final int scratchBudget;
+
+  /// Directory for scratch files (default: the system temp directory)
+  final Directory? scratchDirectory;
+
   /// Create an AudioFileProcessor with optional custom thresholds.
   ///
-  /// [chunkThreshold] - Files larger than this will use streaming (default: 50MB)
-  AudioFileProcessor({this.chunkThreshold = defaultChunkThreshold});
+  /// [chunkThreshold] - Compressed size above which unprobeable files count as large (default: 50MB)
+  /// [scratchBudget] - Decoded sizes above this leave the heap (default: 512MB)
+  /// [scratchDirectory] - Where scratch files are created (default: system temp)
+  AudioFileProcessor({this.chunkThreshold = defaultChunkThreshold, this.scratchBudget = defaultScratchBudget, this.scratchDirectory});
 
   /// Process an audio file and return decoded audio data.
   ///
-  /// Automatically selects the appropriate strategy based on file size:
-  /// - Small files: Load entirely into memory and decode in one shot
-  /// - Large files: Stream in chunks and accumulate results
+  /// Automatically selects the appropriate strategy based on decoded size:
+  /// - Within [scratchBudget]: Decode by path in one shot (FFmpeg reads the file itself)
+  /// - Beyond [scratchBudget]: Decode to a memory-mapped scratch file
   ///
   /// The caller never needs to worry about memory limits or exceptions.
   ///
   /// [filePath] - Path to the audio file to process
-  /// Returns [AudioData] containing all decoded samples and metadata.
+  /// Returns [AudioData] containing all decoded samples and metadata. The
+  /// result is a [MappedAudioData] when the decoded size exceeds
+  /// [scratchBudget]; always call [AudioData.dispose] when done so the
+  /// scratch file is released.
   ///
   /// Throws [FileSystemException] if the file cannot be read.
   /// Throws [DecodingException] if the file cannot be decoded.
@@ -43,23 +81,144 @@ class AudioFileProcessor {
     // Validate file and get size in one call
     final fileSize = await AudioFileValidator.validateAndGetSize(filePath);
 
-    if (fileSize <= chunkThreshold) {
-      // SMALL FILE: Use simple decoder
-      final decoder = SimpleAudioFileDecoder();
+    final plan = _plan(filePath, fileSize, null);
+    if (plan.strategy == AudioProcessingStrategy.scratchFile) {
+      return _decodeToScratch(filePath);
+    }
+    return _decodeInMemory(filePath);
+  }
+
+  /// Generate a waveform from an audio file.
+  ///
+  /// Files whose decoded size fits [scratchBudget] are decoded in one shot
+  /// and reduced by [WaveformGenerator.generateInMemory]. Larger files are
+  /// streamed through a [StreamingWaveformGenerator]: each decoded chunk is
+  /// folded into bins sized from the probed duration and dropped, so peak
+  /// memory is one chunk plus the bins instead of the decoded PCM. Configs
+  /// the streaming generator cannot fold (median downsampling) and files
+  /// whose duration cannot be probed are decoded to a scratch file instead.
+  ///
+  /// With a [sliceBudget], the reduction yields to the event loop every
+  /// [sliceBudget] and reports snapshots through [onPartial]: decoded audio
+  /// is reduced by [CooperativeWaveformGenerator] instead, and streamed
+  /// chunks are folded in slices (see [StreamingWaveformGenerator.generate]).
+  /// Decoding itself still runs in one native call per file (or per streamed
+  /// chunk).
+  ///
+  /// [filePath] - Path to the audio file to process
+  /// [config] - Configuration for waveform generation
+  /// [sliceBudget] - Longest uninterrupted reduction on the calling isolate
+  /// [onPartial] - Receives snapshots while a [sliceBudget] reduction runs
+  ///
+  /// Throws [FileSystemException] if the file cannot be read.
+  /// Throws [DecodingException] if the file cannot be decoded.
+  /// Throws [UnsupportedError] if the format is not supported.
+  Future<WaveformData> generateWaveform(
+    String filePath, {
+    WaveformConfig config = const WaveformConfig(),
+    Duration? sliceBudget,
+    void Function(WaveformData partial)? onPartial,
+  }) async {
+    final fileSize = await AudioFileValidator.validateAndGetSize(filePath);
+
+    final plan = _plan(filePath, fileSize, config);
+    if (plan.strategy == AudioProcessingStrategy.streaming) {
+      final decoder = StreamingAudioFileDecoder();
       try {
-        return await decoder.decode(filePath);
+        return await StreamingWaveformGenerator.generate(
+          decoder.decodeStreaming(filePath),
+          expectedFrames: plan.expectedFrames,
+          config: config,
+          sliceBudget: sliceBudget,
+          onPartial: onPartial,
+        );
       } finally {
         decoder.dispose();
       }
-    } else {
-      // LARGE FILE: Use streaming decoder
-      // The native FFmpeg decoder handles chunking internally (100 packets per chunk)
-      final decoder = StreamingAudioFileDecoder();
+    }
+
+    final audioData = plan.strategy == AudioProcessingStrategy.scratchFile ? await _decodeToScratch(filePath) : await _decodeInMemory(filePath);
+    try {
+      if (sliceBudget != null) {
+        return await CooperativeWaveformGenerator.generate(audioData, config: config, sliceBudget: sliceBudget, onPartial: onPartial);
+      }
+      return await WaveformGenerator.generateInMemory(audioData, config: config);
+    } finally {
+      // Releases scratch files of memory-mapped audio
+      audioData.dispose();
+    }
+  }
+
+  /// The strategy [process] (or, with a [config], [generateWaveform]) uses for [filePath]
+  ///
+  /// Throws [FileSystemException] if the file cannot be read.
+  /// Throws [UnsupportedError] if the format is not supported.
+  Future<AudioProcessingStrategy> selectStrategy(String filePath, {WaveformConfig? config}) async {
+    final fileSize = await AudioFileValidator.validateAndGetSize(filePath);
+    return _plan(filePath, fileSize, config).strategy;
+  }
+
+  /// Picks the strategy for [filePath]; [config] is null when the decoded audio itself is needed
+  ({AudioProcessingStrategy strategy, int expectedFrames}) _plan(String filePath, int fileSize, WaveformConfig? config) {
+    // Budget disabled, or even the densest codec cannot exceed it: skip the probe
+    if (scratchBudget <= 0 || fileSize * _maxDecodedExpansion <= scratchBudget) {
+      return (strategy: AudioProcessingStrategy.inMemory, expectedFrames: 0);
+    }
+
+    final info = _probe(filePath);
+    final expectedFrames = info == null ? 0 : info.duration.inMicroseconds * info.sampleRate ~/ Duration.microsecondsPerSecond;
+    if (info == null || expectedFrames <= 0) {
+      // Unknown decoded size: only the compressed size is left to go by. A
+      // scratch file grows on disk, so it is the safe choice for large inputs.
+      final strategy = fileSize > chunkThreshold ? AudioProcessingStrategy.scratchFile : AudioProcessingStrategy.inMemory;
+      return (strategy: strategy, expectedFrames: 0);
+    }
+
+    final decodedBytes = expectedFrames * info.channels * Float32List.bytesPerElement;
+    if (decodedBytes <= scratchBudget) {
+      return (strategy: AudioProcessingStrategy.inMemory, expectedFrames: expectedFrames);
+    }
+    if (config != null && StreamingWaveformGenerator.supports(config)) {
+      return (strategy: AudioProcessingStrategy.streaming, expectedFrames: expectedFrames);
+    }
+    return (strategy: AudioProcessingStrategy.scratchFile, expectedFrames: expectedFrames);
+  }
+
+  Future<AudioData> _decodeInMemory(String filePath) async {
+    // Decode by path without loading the compressed bytes
+    final decoder = SimpleAudioFileDecoder();
+    try {
+      return await decoder.decode(filePath);
+    } finally {
+      decoder.dispose();
+    }
+  }
+
+  /// Duration and format of [filePath], or null if it cannot be probed
+  ({Duration duration, int sampleRate, int channels})? _probe(String filePath) {
+    try {
+      return NativeAudioBindings.probeFile(filePath);
+    } on SonixException catch (e) {
+      // Let the decode report the actual error
+      SonixLogger.debug('Probe failed for $filePath, using the full decode: ${e.message}');
+      return null;
+    }
+  }
+
+  Future<AudioData> _decodeToScratch(String filePath) async {
+    final directory = scratchDirectory ?? Directory.systemTemp;
+    final scratchPath = '${directory.path}${Platform.pathSeparator}sonix_${pid}_${DateTime.now().microsecondsSinceEpoch}_${_scratchCounter++}.pcm';
+
+    final info = NativeAudioBindings.decodeToScratchFile(filePath, scratchPath);
+    try {
+      return MappedAudioData.open(scratchPath, sampleRate: info.sampleRate, channels: info.channels, duration: info.duration);
+    } catch (_) {
       try {
-        return await decoder.decode(filePath);
-      } finally {
-        decoder.dispose();
+        File(scratchPath).deleteSync();
+      } on FileSystemException {
+        // Ignore.
       }
+      rethrow;
     }
   }
 
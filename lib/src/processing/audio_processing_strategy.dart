@@ -0,0 +1,19 @@
+/// How `AudioFileProcessor` decodes a file
+///
+/// Chosen from a header probe of the decoded size (duration × sample rate ×
+/// channels × 4 bytes) against the processor's memory budget rather than
+/// from the compressed file size, which says little about decoded size: a
+/// 45MB Opus file can decode to several GB while a 60MB WAV stays at 120MB.
+enum AudioProcessingStrategy {
+  /// Decode the whole file onto the heap in one shot
+  inMemory,
+
+  /// Fold decoded chunks into the waveform as they arrive
+  ///
+  /// Only used for waveform generation; the decoded audio is never held as a
+  /// whole.
+  streaming,
+
+  /// Decode to a memory-mapped scratch file
+  scratchFile,
+}
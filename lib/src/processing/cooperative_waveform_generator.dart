@@ -0,0 +1,174 @@
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:sonix/src/models/audio_data.dart';
+import 'package:sonix/src/models/waveform_bins.dart';
+import 'package:sonix/src/models/waveform_data.dart';
+import 'package:sonix/src/models/waveform_pyramid.dart';
+import 'waveform_algorithms.dart';
+import 'waveform_config.dart';
+import 'waveform_generator.dart';
+
+/// Generates waveforms on the calling isolate without blocking it
+///
+/// [WaveformGenerator.generateInMemory] returns a future but reduces every
+/// sample in one synchronous loop, so on the UI isolate a long file drops
+/// frames until it is done. This generator reduces the bins in slices sized
+/// to a time budget and yields to the event loop between slices, so frames,
+/// input and timers keep running:
+///
+/// ```
+/// generateInMemory:  [████████████████████ reduce all ████████████████████]
+/// cooperative:       [██] yield [██] yield [██] yield ... [██] post-process
+///                    ≤ sliceBudget each
+/// ```
+///
+/// Slice sizes adapt to the measured throughput, so each slice takes about
+/// [defaultSliceBudget] (or the given budget) whatever the device speed.
+/// [onPartial] receives snapshots of the waveform while it fills in from the
+/// left, for progressive display.
+///
+/// Use it where spawning an isolate is not an option (e.g. the web, or
+/// plugins that must stay on the root isolate); elsewhere
+/// `Sonix.generateWaveformInIsolate` keeps the UI isolate free entirely.
+/// Bin boundaries are those of [WaveformGenerator.generateInMemory] and the
+/// result matches it for every config (see
+/// [WaveformAlgorithms.downsampleChannelsRange] for mixed amplitudes).
+///
+/// ## Example Usage
+///
+/// ```dart
+/// final waveform = await CooperativeWaveformGenerator.generate(
+///   audioData,
+///   config: const WaveformConfig(resolution: 2000),
+///   onPartial: (partial) => setState(() => preview = partial),
+/// );
+/// ```
+class CooperativeWaveformGenerator {
+  CooperativeWaveformGenerator._();
+
+  /// Default time spent reducing before yielding; a quarter of a 60Hz frame
+  static const Duration defaultSliceBudget = Duration(milliseconds: 4);
+
+  /// Default minimum time between two [generate] `onPartial` snapshots
+  static const Duration defaultPartialInterval = Duration(milliseconds: 100);
+
+  /// Frames reduced by the first slice, before any throughput is known
+  static const int _initialSliceFrames = 1 << 14;
+
+  /// Generate a waveform from [audioData], yielding every [sliceBudget]
+  ///
+  /// [onPartial] is called at most every [partialInterval] with the mixed
+  /// amplitudes reduced so far, post-processed like the final result; bins
+  /// not reduced yet are silent. Building a snapshot costs a pass over the
+  /// amplitudes, so keep the interval well above the budget.
+  ///
+  /// Throws [ArgumentError] if [audioData] is empty or [config] is invalid.
+  static Future<WaveformData> generate(
+    AudioData audioData, {
+    WaveformConfig config = const WaveformConfig(),
+    Duration sliceBudget = defaultSliceBudget,
+    void Function(WaveformData partial)? onPartial,
+    Duration partialInterval = defaultPartialInterval,
+  }) async {
+    if (audioData.samples.isEmpty) {
+      throw ArgumentError('Audio data cannot be empty');
+    }
+    WaveformGenerator.validateConfig(config);
+
+    final samples = audioData.samples;
+    final channels = audioData.channels;
+    final frames = channels > 0 ? samples.length ~/ channels : 0;
+    final resolution = config.resolution;
+    if (resolution >= frames) {
+      // Passed through without binning; nothing worth slicing
+      return WaveformGenerator.generateInMemory(audioData, config: config);
+    }
+
+    final channelCount = config.channelMode.outputChannelCount(channels);
+    final mixed = Float64List(resolution);
+    final channelAmplitudes = Float32List(channelCount * resolution);
+    final bins = config.generateBins ? WaveformBins.allocate(resolution) : null;
+
+    final budgetMicros = math.max(1, sliceBudget.inMicroseconds);
+    final slice = Stopwatch();
+    final sincePartial = Stopwatch()..start();
+    double framesPerMicro = 0.0;
+
+    /// Frames the next slice can reduce within the budget
+    int sliceFrames() => framesPerMicro > 0 ? math.max(1, (framesPerMicro * budgetMicros).floor()) : _initialSliceFrames;
+
+    /// Records the throughput of the slice just finished and yields
+    Future<void> endSlice(int slicedFrames) async {
+      final elapsed = slice.elapsedMicroseconds;
+      if (elapsed > 0) {
+        framesPerMicro = slicedFrames / elapsed;
+      } else if (framesPerMicro == 0) {
+        framesPerMicro = slicedFrames.toDouble();
+      }
+      await Future<void>.delayed(Duration.zero);
+    }
+
+    final framesPerBin = frames / resolution;
+    for (int startBin = 0; startBin < resolution;) {
+      slice
+        ..reset()
+        ..start();
+      final endBin = math.min(resolution, startBin + math.max(1, (sliceFrames() / framesPerBin).floor()));
+      WaveformAlgorithms.downsampleChannelsRange(
+        samples,
+        resolution,
+        startBin,
+        endBin,
+        algorithm: config.algorithm,
+        channels: channels,
+        mode: config.channelMode,
+        mixed: mixed,
+        channelAmplitudes: channelAmplitudes,
+        bins: bins,
+      );
+      slice.stop();
+      final slicedFrames = ((endBin - startBin) * framesPerBin).ceil();
+      startBin = endBin;
+
+      if (onPartial != null && startBin < resolution && sincePartial.elapsed >= partialInterval) {
+        onPartial(
+          WaveformGenerator.fromRawAmplitudes(Float64List.fromList(mixed), duration: audioData.duration, sampleRate: audioData.sampleRate, config: config),
+        );
+        sincePartial
+          ..reset()
+          ..start();
+      }
+      await endSlice(slicedFrames);
+    }
+
+    WaveformPyramid? pyramid;
+    if (config.generatePyramid) {
+      const pyramidFramesPerBin = WaveformPyramid.defaultBaseFramesPerBin;
+      final pyramidBins = WaveformBins.allocate(WaveformAlgorithms.fixedBinCount(frames, pyramidFramesPerBin));
+      for (int startBin = 0; startBin < pyramidBins.length;) {
+        slice
+          ..reset()
+          ..start();
+        final endBin = math.min(pyramidBins.length, startBin + math.max(1, sliceFrames() ~/ pyramidFramesPerBin));
+        WaveformAlgorithms.downsampleFixedBinsRange(samples, pyramidFramesPerBin, startBin, endBin, channels: channels, bins: pyramidBins);
+        slice.stop();
+        final slicedFrames = (endBin - startBin) * pyramidFramesPerBin;
+        startBin = endBin;
+        await endSlice(slicedFrames);
+      }
+      pyramid = WaveformPyramid.fromBaseLevel(pyramidBins, sampleRate: audioData.sampleRate, totalFrames: frames);
+    }
+
+    return WaveformGenerator.fromRawAmplitudes(
+      mixed,
+      duration: audioData.duration,
+      sampleRate: audioData.sampleRate,
+      config: config,
+      rawChannelAmplitudes: channelCount > 0 ? channelAmplitudes : null,
+      channelCount: channelCount,
+      rawBins: bins,
+      rawPyramid: pyramid,
+    );
+  }
+}
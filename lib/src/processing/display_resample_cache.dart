@@ -0,0 +1,103 @@
+import 'package:sonix/src/models/waveform_bins.dart';
+import 'package:sonix/src/models/waveform_data.dart';
+import 'display_sampler.dart';
+import 'downsample_method.dart';
+import 'upsample_method.dart';
+
+/// Memoized [DisplaySampler] results per [WaveformData]
+///
+/// A painter resamples the same waveform to the same display resolution on
+/// every playback tick and animation frame. This cache keeps the results on
+/// the waveform itself (through an [Expando]), so every painter showing the
+/// same [WaveformData] shares them and they are released together with the
+/// waveform. Each waveform keeps its [maxEntriesPerWaveform] most recently
+/// used resolutions, which covers a few widths during a resize.
+///
+/// Results are shared and must not be modified.
+///
+/// ## Example Usage
+///
+/// ```dart
+/// final displayAmplitudes = DisplayResampleCache.amplitudes(waveformData, targetCount: 200);
+/// ```
+class DisplayResampleCache {
+  DisplayResampleCache._();
+
+  /// Resolutions remembered per waveform
+  static const int maxEntriesPerWaveform = 4;
+
+  static final Expando<_WaveformDisplayCache> _caches = Expando('displayResampleCache');
+
+  /// [DisplaySampler.resampleForDisplay] of the amplitudes of [waveform], memoized
+  static List<double> amplitudes(
+    WaveformData waveform, {
+    required int targetCount,
+    DownsampleMethod downsampleMethod = DownsampleMethod.max,
+    UpsampleMethod upsampleMethod = UpsampleMethod.linear,
+  }) {
+    final cache = _cacheFor(waveform);
+    final key = (targetCount, downsampleMethod, upsampleMethod);
+    return cache.lookup(
+      cache.amplitudes,
+      key,
+      () => DisplaySampler.resampleForDisplay(
+        sourceAmplitudes: waveform.amplitudes,
+        targetCount: targetCount,
+        downsampleMethod: downsampleMethod,
+        upsampleMethod: upsampleMethod,
+      ),
+    );
+  }
+
+  /// [DisplaySampler.resampleBinsForDisplay] of the bins of [waveform], memoized
+  ///
+  /// Returns empty bins if [waveform] has none.
+  static WaveformBins bins(WaveformData waveform, {required int targetCount}) {
+    final sourceBins = waveform.bins;
+    if (sourceBins == null) {
+      return WaveformBins.allocate(0);
+    }
+    final cache = _cacheFor(waveform);
+    return cache.lookup(cache.bins, targetCount, () => DisplaySampler.resampleBinsForDisplay(sourceBins: sourceBins, targetCount: targetCount));
+  }
+
+  /// Forget all results of [waveform]
+  static void invalidate(WaveformData waveform) {
+    _caches[waveform] = null;
+  }
+
+  static _WaveformDisplayCache _cacheFor(WaveformData waveform) {
+    final cache = _caches[waveform];
+    // dispose() swaps the amplitude buffer, which invalidates the results
+    if (cache != null && identical(cache.source, waveform.amplitudes)) {
+      return cache;
+    }
+    return _caches[waveform] = _WaveformDisplayCache(waveform.amplitudes);
+  }
+}
+
+class _WaveformDisplayCache {
+  /// Amplitude buffer the results were computed from
+  final List<double> source;
+
+  // Insertion-ordered; lookups move hits to the end
+  final Map<(int, DownsampleMethod, UpsampleMethod), List<double>> amplitudes = {};
+  final Map<int, WaveformBins> bins = {};
+
+  _WaveformDisplayCache(this.source);
+
+  V lookup<K, V>(Map<K, V> entries, K key, V Function() compute) {
+    final cached = entries.remove(key);
+    if (cached != null) {
+      entries[key] = cached;
+      return cached;
+    }
+
+    final value = compute();
+    if (entries.length >= DisplayResampleCache.maxEntriesPerWaveform) {
+      entries.remove(entries.keys.first);
+    }
+    entries[key] = value;
+    return value;
+  }
+}
@@ -1,4 +1,5 @@
 import 'dart:math' as math;
+import 'package:sonix/src/models/waveform_bins.dart';
 import 'package:sonix/src/models/waveform_type.dart';
 import 'downsample_method.dart';
 import 'upsample_method.dart';
@@ -71,7 +72,63 @@ class DisplaySampler {
     }
   }
 
+  /// Resample min/max/RMS bins to match target display resolution
+  ///
+  /// When reducing, each display bin takes the smallest min and largest max
+  /// of its source bins, so no peak is lost, and the RMS of the combined
+  /// source bins. When enlarging, source bins are repeated; interpolating
+  /// would invent envelope values that were never in the signal.
+  ///
+  /// [sourceBins] - Bins produced during waveform generation
+  /// [targetCount] - Desired number of display points
+  static WaveformBins resampleBinsForDisplay({required WaveformBins sourceBins, required int targetCount}) {
+    if (sourceBins.isEmpty || targetCount <= 0) {
+      return WaveformBins.allocate(0);
+    }
+
+    final sourceCount = sourceBins.length;
+    final source = sourceBins.data;
+    final result = WaveformBins.allocate(targetCount);
+    final target = result.data;
+
+    if (sourceCount <= targetCount) {
+      final ratio = sourceCount / targetCount;
+      for (int i = 0; i < targetCount; i++) {
+        final sourceIndex = (i * ratio).floor().clamp(0, sourceCount - 1);
+        target[i] = source[sourceIndex];
+        target[targetCount + i] = source[sourceCount + sourceIndex];
+        target[2 * targetCount + i] = source[2 * sourceCount + sourceIndex];
+      }
+      return result;
+    }
+
+    final groupSize = sourceCount / targetCount;
+    for (int i = 0; i < targetCount; i++) {
+      final startIdx = (i * groupSize).floor();
+      final endIdx = ((i + 1) * groupSize).ceil().clamp(startIdx + 1, sourceCount);
+
+      double minValue = double.infinity;
+      double maxValue = double.negativeInfinity;
+      double sumOfSquares = 0.0;
+      for (int j = startIdx; j < endIdx; j++) {
+        minValue = math.min(minValue, source[j]);
+        maxValue = math.max(maxValue, source[sourceCount + j]);
+        final rms = source[2 * sourceCount + j];
+        sumOfSquares += rms * rms;
+      }
+
+      target[i] = minValue;
+      target[targetCount + i] = maxValue;
+      target[2 * targetCount + i] = math.sqrt(sumOfSquares / (endIdx - startIdx));
+    }
+
+    return result;
+  }
+
   /// Downsample amplitude data to fewer points
+  ///
+  /// Reduces each group of source points in place instead of copying it out,
+  /// so the only allocation is the result.
   static List<double> _downsample(List<double> amplitudes, int targetCount, DownsampleMethod method) {
     final result = <double>[];
     final groupSize = amplitudes.length / targetCount;
@@ -79,28 +136,37 @@ class DisplaySampler {
     for (int i = 0; i < targetCount; i++) {
       final startIdx = (i * groupSize).floor();
       final endIdx = ((i + 1) * groupSize).ceil().clamp(0, amplitudes.length);
-      final group = amplitudes.sublist(startIdx, endIdx);
+      final count = endIdx - startIdx;
 
-      if (group.isEmpty) continue;
+      if (count <= 0) continue;
 
       switch (method) {
         case DownsampleMethod.max:
-          result.add(group.reduce(math.max));
+        case DownsampleMethod.minMax:
+          // For minMax, unsigned amplitudes only carry the upper edge of the
+          // envelope; the signed envelope comes from resampleBinsForDisplay
+          double maxValue = amplitudes[startIdx];
+          for (int j = startIdx + 1; j < endIdx; j++) {
+            maxValue = math.max(maxValue, amplitudes[j]);
+          }
+          result.add(maxValue);
           break;
 
         case DownsampleMethod.rms:
-          final sumOfSquares = group.fold(0.0, (sum, amp) => sum + amp * amp);
-          result.add(math.sqrt(sumOfSquares / group.length));
+          double sumOfSquares = 0.0;
+          for (int j = startIdx; j < endIdx; j++) {
+            final amp = amplitudes[j];
+            sumOfSquares += amp * amp;
+          }
+          result.add(math.sqrt(sumOfSquares / count));
           break;
 
         case DownsampleMethod.average:
-          final sum = group.fold(0.0, (sum, amp) => sum + amp);
-          result.add(sum / group.length);
-          break;
-
-        case DownsampleMethod.minMax:
-          // For minMax, we store the max (min information could be added later if needed)
-          result.add(group.reduce(math.max));
+          double sum = 0.0;
+          for (int j = startIdx; j < endIdx; j++) {
+            sum += amplitudes[j];
+          }
+          result.add(sum / count);
           break;
       }
     }
@@ -9,6 +9,9 @@ enum DownsampleMethod {
   /// Use average amplitude of each group (smooth representation)
   average,
 
-  /// Use both min and max to preserve dynamic range (returns pairs)
+  /// Use both min and max to preserve dynamic range
+  ///
+  /// With `WaveformConfig.generateBins` the painter draws the signed min/max
+  /// envelope; plain amplitudes fall back to the group maximum.
   minMax,
 }
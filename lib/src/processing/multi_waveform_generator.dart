@@ -0,0 +1,104 @@
+import 'dart:async';
+
+import 'package:sonix/src/models/waveform_data.dart';
+import 'package:sonix/src/native/native_audio_bindings.dart';
+import 'package:sonix/src/utils/audio_file_validator.dart';
+import 'audio_file_processor.dart';
+import 'waveform_config.dart';
+import 'waveform_generator.dart';
+
+/// Generates several waveforms from one audio file with a single decode
+///
+/// Apps often need more than one waveform per file: an overview strip and a
+/// detailed view, or an RMS body with a peak outline. Generating each one
+/// separately decodes the file once per waveform, and decoding dominates the
+/// cost. This generator decodes once and runs every requested reduction over
+/// the same decoded frames.
+///
+/// ## Strategy
+///
+/// - **Native pipeline** (default): the native layer decodes the file frame by
+///   frame and feeds each frame to one reducer per config. No decoded audio
+///   buffer is ever materialized, so memory stays flat regardless of file
+///   length.
+/// - **Decode-once fallback**: `DownsamplingAlgorithm.median` cannot be reduced
+///   in a single streaming pass, and min/max/RMS bins and pyramids
+///   ([WaveformConfig.generateBins], [WaveformConfig.generatePyramid]) are
+///   only computed in Dart. If any config requests either, the file is
+///   decoded once into memory and every config is generated from that buffer.
+///
+/// In both cases smoothing, normalization and scaling are applied per config
+/// exactly as [WaveformGenerator.generateInMemory] does.
+///
+/// Example:
+/// ```dart
+/// final waveforms = await MultiWaveformGenerator.generate('song.mp3', [
+///   const WaveformConfig(resolution: 200),
+///   const WaveformConfig(resolution: 4000, algorithm: DownsamplingAlgorithm.peak),
+/// ]);
+/// final overview = waveforms[0];
+/// final detail = waveforms[1];
+/// ```
+class MultiWaveformGenerator {
+  MultiWaveformGenerator._();
+
+  /// Generate one waveform per entry in [configs] from a single decode of [filePath]
+  ///
+  /// Results are returned in the same order as [configs]. The decode-once
+  /// fallback holds at most [scratchBudget] bytes of decoded audio on the
+  /// heap and maps larger files (see [AudioFileProcessor.scratchBudget]).
+  ///
+  /// Throws [ArgumentError] if [configs] is empty or contains an invalid config.
+  /// Throws [FileSystemException] if the file does not exist.
+  /// Throws [DecodingException] if the file cannot be decoded.
+  static Future<List<WaveformData>> generate(
+    String filePath,
+    List<WaveformConfig> configs, {
+    int scratchBudget = AudioFileProcessor.defaultScratchBudget,
+  }) async {
+    if (configs.isEmpty) {
+      throw ArgumentError('At least one waveform configuration is required');
+    }
+
+    // Validate everything up front so a bad config never costs a decode
+    for (final config in configs) {
+      WaveformGenerator.validateConfig(config);
+    }
+
+    await AudioFileValidator.validate(filePath);
+
+    if (configs.every(NativeAudioBindings.supportsNativeReduction)) {
+      return _generateNative(filePath, configs);
+    }
+
+    return _generateFromDecodedAudio(filePath, configs, scratchBudget);
+  }
+
+  /// Reduce all configs in the native decode-once pipeline
+  static List<WaveformData> _generateNative(String filePath, List<WaveformConfig> configs) {
+    final result = NativeAudioBindings.generateWaveforms(filePath, configs);
+
+    return [
+      for (int i = 0; i < configs.length; i++)
+        WaveformGenerator.fromRawAmplitudes(
+          result.reductions[i].amplitudes,
+          duration: result.duration,
+          sampleRate: result.sampleRate,
+          config: configs[i],
+          rawChannelAmplitudes: result.reductions[i].channelAmplitudes,
+          channelCount: result.reductions[i].channelCount,
+        ),
+    ];
+  }
+
+  /// Decode once into memory and generate every config from the same buffer
+  static Future<List<WaveformData>> _generateFromDecodedAudio(String filePath, List<WaveformConfig> configs, int scratchBudget) async {
+    final audioData = await AudioFileProcessor(scratchBudget: scratchBudget).process(filePath);
+
+    try {
+      return [for (final config in configs) await WaveformGenerator.generateInMemory(audioData, config: config)];
+    } finally {
+      audioData.dispose();
+    }
+  }
+}
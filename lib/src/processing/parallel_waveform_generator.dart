@@ -0,0 +1,215 @@
+import 'dart:ffi' as ffi;
+import 'dart:io';
+import 'dart:isolate';
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:ffi/ffi.dart';
+import 'package:sonix/src/models/audio_data.dart';
+import 'package:sonix/src/models/waveform_bins.dart';
+import 'package:sonix/src/models/waveform_data.dart';
+import 'package:sonix/src/models/waveform_pyramid.dart';
+import 'package:sonix/src/native/native_audio_bindings.dart';
+import 'waveform_algorithms.dart';
+import 'waveform_config.dart';
+import 'waveform_generator.dart';
+
+/// Generates waveforms from decoded audio on several isolates at once
+///
+/// [WaveformGenerator.generateInMemory] walks every sample on one thread,
+/// which dominates re-generating long sessions at new resolutions. This
+/// generator partitions the bin range across worker isolates instead:
+///
+/// ```
+/// samples (native memory) ──┬── worker 0: bins [0, n/k)      ──┐
+///                           ├── worker 1: bins [n/k, 2n/k)   ──┼── output buffers (native memory)
+///                           └── ...                           ──┘
+/// ```
+///
+/// Workers share the samples and the output buffers through native memory by
+/// address, so nothing is copied between isolates and every worker writes its
+/// bins in place. Samples of decoded or memory-mapped audio are already
+/// native (see [NativeAudioBindings.nativeSamplesOf]); samples on the Dart
+/// heap are copied to native memory once.
+///
+/// Bin boundaries do not depend on the partitioning, so for 32-bit float
+/// samples (what the decoders produce) the result matches
+/// [WaveformGenerator.generateInMemory] for every config, including
+/// per-channel amplitudes, min/max/RMS bins and the pyramid (see
+/// [WaveformAlgorithms.downsampleChannelsRange] for mixed amplitudes).
+/// Inputs too short to be worth the isolate start-up use
+/// [WaveformGenerator.generateInMemory] directly.
+///
+/// ## Example Usage
+///
+/// ```dart
+/// final audioData = await AudioFileProcessor().process('session.flac');
+/// try {
+///   final overview = await ParallelWaveformGenerator.generate(audioData, config: const WaveformConfig(resolution: 2000));
+///   final detail = await ParallelWaveformGenerator.generate(audioData, config: const WaveformConfig(resolution: 200000));
+/// } finally {
+///   audioData.dispose();
+/// }
+/// ```
+class ParallelWaveformGenerator {
+  ParallelWaveformGenerator._();
+
+  /// Fewest frames a worker is given; shorter inputs use fewer workers
+  static const int minFramesPerWorker = 1 << 20;
+
+  /// Generate a waveform from [audioData] using up to [workers] isolates
+  ///
+  /// [workers] defaults to the number of processors.
+  ///
+  /// Throws [ArgumentError] if [audioData] is empty or [config] is invalid.
+  static Future<WaveformData> generate(AudioData audioData, {WaveformConfig config = const WaveformConfig(), int? workers}) async {
+    if (audioData.samples.isEmpty) {
+      throw ArgumentError('Audio data cannot be empty');
+    }
+    WaveformGenerator.validateConfig(config);
+
+    final channels = audioData.channels;
+    final frames = channels > 0 ? audioData.samples.length ~/ channels : 0;
+    final workerCount = workerCountFor(frames, config.resolution, workers ?? Platform.numberOfProcessors);
+    if (workerCount <= 1) {
+      return WaveformGenerator.generateInMemory(audioData, config: config);
+    }
+
+    final samples = audioData.samples;
+    final resolution = config.resolution;
+    final channelCount = config.channelMode.outputChannelCount(channels);
+    final pyramidBinCount = config.generatePyramid ? WaveformAlgorithms.fixedBinCount(frames, WaveformPyramid.defaultBaseFramesPerBin) : 0;
+
+    final nativeSamples = NativeAudioBindings.nativeSamplesOf(samples);
+    final ownedSamples = nativeSamples == null ? malloc<ffi.Float>(samples.length) : null;
+    if (ownedSamples != null) {
+      ownedSamples.asTypedList(samples.length).setAll(0, samples);
+    }
+
+    final mixed = calloc<ffi.Double>(resolution);
+    final channelAmplitudes = channelCount > 0 ? calloc<ffi.Float>(channelCount * resolution) : ffi.nullptr;
+    final bins = config.generateBins ? calloc<ffi.Float>(resolution * WaveformBins.valuesPerBin) : ffi.nullptr;
+    final pyramid = pyramidBinCount > 0 ? calloc<ffi.Float>(pyramidBinCount * WaveformBins.valuesPerBin) : ffi.nullptr;
+
+    try {
+      final tasks = [
+        for (int worker = 0; worker < workerCount; worker++)
+          _BinRangeTask(
+            samplesAddress: (nativeSamples ?? ownedSamples!).address,
+            sampleCount: samples.length,
+            channels: channels,
+            config: config,
+            startBin: resolution * worker ~/ workerCount,
+            endBin: resolution * (worker + 1) ~/ workerCount,
+            mixedAddress: mixed.address,
+            channelAddress: channelAmplitudes.address,
+            binsAddress: bins.address,
+            pyramidAddress: pyramid.address,
+            pyramidBinCount: pyramidBinCount,
+            pyramidStartBin: pyramidBinCount * worker ~/ workerCount,
+            pyramidEndBin: pyramidBinCount * (worker + 1) ~/ workerCount,
+          ),
+      ];
+
+      // Waits for every worker even if one fails, so none outlives the buffers
+      await Future.wait([for (final task in tasks) Isolate.run(task.run)]);
+
+      return WaveformGenerator.fromRawAmplitudes(
+        Float64List.fromList(mixed.asTypedList(resolution)),
+        duration: audioData.duration,
+        sampleRate: audioData.sampleRate,
+        config: config,
+        rawChannelAmplitudes: channelCount > 0 ? Float32List.fromList(channelAmplitudes.asTypedList(channelCount * resolution)) : null,
+        channelCount: channelCount,
+        rawBins: config.generateBins ? WaveformBins(Float32List.fromList(bins.asTypedList(resolution * WaveformBins.valuesPerBin))) : null,
+        rawPyramid: pyramidBinCount > 0
+            ? WaveformPyramid.fromBaseLevel(
+                WaveformBins(Float32List.fromList(pyramid.asTypedList(pyramidBinCount * WaveformBins.valuesPerBin))),
+                sampleRate: audioData.sampleRate,
+                totalFrames: frames,
+              )
+            : null,
+      );
+    } finally {
+      if (ownedSamples != null) malloc.free(ownedSamples);
+      calloc.free(mixed);
+      if (channelAmplitudes != ffi.nullptr) calloc.free(channelAmplitudes);
+      if (bins != ffi.nullptr) calloc.free(bins);
+      if (pyramid != ffi.nullptr) calloc.free(pyramid);
+    }
+  }
+
+  /// Number of workers used for [frames] frames at [resolution] bins
+  ///
+  /// At most [maxWorkers], one per [minFramesPerWorker] frames and one per
+  /// bin. Resolutions at or above the frame count return 1: the in-memory
+  /// path passes such samples through without binning.
+  static int workerCountFor(int frames, int resolution, int maxWorkers) {
+    if (resolution >= frames) return 1;
+    return math.max(1, math.min(maxWorkers, math.min(frames ~/ minFramesPerWorker, resolution)));
+  }
+}
+
+/// One worker's share of the bins, addressing the shared buffers by address
+class _BinRangeTask {
+  final int samplesAddress;
+  final int sampleCount;
+  final int channels;
+  final WaveformConfig config;
+  final int startBin;
+  final int endBin;
+  final int mixedAddress;
+  final int channelAddress;
+  final int binsAddress;
+  final int pyramidAddress;
+  final int pyramidBinCount;
+  final int pyramidStartBin;
+  final int pyramidEndBin;
+
+  const _BinRangeTask({
+    required this.samplesAddress,
+    required this.sampleCount,
+    required this.channels,
+    required this.config,
+    required this.startBin,
+    required this.endBin,
+    required this.mixedAddress,
+    required this.channelAddress,
+    required this.binsAddress,
+    required this.pyramidAddress,
+    required this.pyramidBinCount,
+    required this.pyramidStartBin,
+    required this.pyramidEndBin,
+  });
+
+  /// Runs in the worker isolate
+  void run() {
+    final resolution = config.resolution;
+    final channelCount = config.channelMode.outputChannelCount(channels);
+    final samples = ffi.Pointer<ffi.Float>.fromAddress(samplesAddress).asTypedList(sampleCount);
+
+    WaveformAlgorithms.downsampleChannelsRange(
+      samples,
+      resolution,
+      startBin,
+      endBin,
+      algorithm: config.algorithm,
+      channels: channels,
+      mode: config.channelMode,
+      mixed: ffi.Pointer<ffi.Double>.fromAddress(mixedAddress).asTypedList(resolution),
+      channelAmplitudes: channelCount > 0 ? ffi.Pointer<ffi.Float>.fromAddress(channelAddress).asTypedList(channelCount * resolution) : Float32List(0),
+      bins: binsAddress == 0 ? null : WaveformBins(ffi.Pointer<ffi.Float>.fromAddress(binsAddress).asTypedList(resolution * WaveformBins.valuesPerBin)),
+    );
+
+    if (pyramidAddress != 0) {
+      WaveformAlgorithms.downsampleFixedBinsRange(
+        samples,
+        WaveformPyramid.defaultBaseFramesPerBin,
+        pyramidStartBin,
+        pyramidEndBin,
+        channels: channels,
+        bins: WaveformBins(ffi.Pointer<ffi.Float>.fromAddress(pyramidAddress).asTypedList(pyramidBinCount * WaveformBins.valuesPerBin)),
+      );
+    }
+  }
+}
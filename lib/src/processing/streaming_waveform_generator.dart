@@ -0,0 +1,376 @@
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:sonix/src/models/audio_data.dart';
+import 'package:sonix/src/models/waveform_bins.dart';
+import 'package:sonix/src/models/waveform_channel_mode.dart';
+import 'package:sonix/src/models/waveform_data.dart';
+import 'package:sonix/src/models/waveform_pyramid.dart';
+import 'cooperative_waveform_generator.dart';
+import 'downsampling_algorithm.dart';
+import 'waveform_algorithms.dart';
+import 'waveform_config.dart';
+import 'waveform_generator.dart';
+
+/// Generates a waveform from decoded audio chunks as they arrive
+///
+/// [WaveformGenerator.generateInMemory] needs every sample of the file at
+/// once. This generator instead folds each chunk into bins that are sized up
+/// front from the expected frame count (the probed duration), so decoding
+/// never holds more than one chunk plus the bins in memory:
+///
+/// ```
+/// in memory:  decode all chunks -> concatenate -> downsample   (~2x PCM)
+/// streaming:  decode chunk -> fold into bins -> drop chunk     (1 chunk)
+/// ```
+///
+/// Bin boundaries are identical to the in-memory path when the expected frame
+/// count is exact. Probed durations are estimates: frames beyond the expected
+/// count are folded into the last bin, and bins past the end of a shorter
+/// stream stay silent.
+///
+/// Everything except [DownsamplingAlgorithm.median] can be folded
+/// incrementally, including per-channel amplitudes, min/max/RMS bins and the
+/// pyramid; use [supports] to check a config.
+///
+/// ## Example Usage
+///
+/// ```dart
+/// final info = NativeAudioBindings.probeFile(path);
+/// final waveform = await StreamingWaveformGenerator.generate(
+///   StreamingAudioFileDecoder().decodeStreaming(path),
+///   expectedFrames: info.duration.inMicroseconds * info.sampleRate ~/ Duration.microsecondsPerSecond,
+///   config: const WaveformConfig(resolution: 2000),
+/// );
+/// ```
+class StreamingWaveformGenerator {
+  /// Configuration of the generated waveform
+  final WaveformConfig config;
+
+  /// Frame count the bin boundaries are computed from
+  final int expectedFrames;
+
+  /// Number of interleaved channels per chunk
+  final int channels;
+
+  /// Sample rate of the audio in Hz
+  final int sampleRate;
+
+  final int _channelCount;
+  final int _streamCount;
+  final double _framesPerBin;
+  final Float64List _frameValues;
+  final Float64List _accumulators;
+  final Float64List _mixed;
+  final Float32List _channelAmplitudes;
+  final WaveformBins? _bins;
+
+  int _frame = 0;
+  int _bin = 0;
+  int _binEnd;
+  int _binFrames = 0;
+  double _binMin = double.infinity;
+  double _binMax = double.negativeInfinity;
+  double _binSumSquares = 0.0;
+
+  // Finest pyramid level, interleaved min/max/RMS per bin until [finish]
+  Float32List? _pyramidValues;
+  int _pyramidBins = 0;
+  int _pyramidFrames = 0;
+  double _pyramidMin = double.infinity;
+  double _pyramidMax = double.negativeInfinity;
+  double _pyramidSumSquares = 0.0;
+
+  bool _finished = false;
+
+  /// Creates a generator for a stream of [expectedFrames] frames
+  ///
+  /// Throws [ArgumentError] if the config is invalid or not [supports]ed, or
+  /// if [expectedFrames] or [channels] is not positive.
+  factory StreamingWaveformGenerator({required int expectedFrames, required int channels, required int sampleRate, WaveformConfig config = const WaveformConfig()}) {
+    WaveformGenerator.validateConfig(config);
+    if (!supports(config)) {
+      throw ArgumentError('Median downsampling needs every sample of a bin and cannot be streamed');
+    }
+    if (expectedFrames <= 0 || channels <= 0) {
+      throw ArgumentError('Expected frames ($expectedFrames) and channels ($channels) must be positive');
+    }
+    return StreamingWaveformGenerator._(expectedFrames, channels, sampleRate, config, config.channelMode.outputChannelCount(channels));
+  }
+
+  StreamingWaveformGenerator._(this.expectedFrames, this.channels, this.sampleRate, this.config, this._channelCount)
+    : _streamCount = _channelCount + 1, // Stream 0 is the mixed signal
+      _framesPerBin = expectedFrames / config.resolution,
+      _frameValues = Float64List(_channelCount + 1),
+      _accumulators = Float64List(_channelCount + 1),
+      _mixed = Float64List(config.resolution),
+      _channelAmplitudes = Float32List(_channelCount * config.resolution),
+      _bins = config.generateBins ? WaveformBins.allocate(config.resolution) : null,
+      _binEnd = (expectedFrames / config.resolution).floor(),
+      _pyramidValues = config.generatePyramid ? Float32List(_pyramidBinCount(expectedFrames) * WaveformBins.valuesPerBin) : null;
+
+  /// Frames folded by the first slice, before any throughput is known
+  static const int _initialSliceFrames = 1 << 14;
+
+  /// Whether [config] can be generated incrementally
+  static bool supports(WaveformConfig config) => config.algorithm != DownsamplingAlgorithm.median;
+
+  /// Folds every chunk of [chunks] into a waveform
+  ///
+  /// The generator is created from the sample rate and channel count of the
+  /// first chunk.
+  ///
+  /// With a [sliceBudget], chunks are folded in slices sized to the budget
+  /// from the measured throughput, yielding to the event loop between
+  /// slices as [CooperativeWaveformGenerator] does, and [onPartial] receives
+  /// a [snapshot] at most every [partialInterval]. Without one, each chunk is
+  /// folded in one go and [onPartial] is never called.
+  ///
+  /// Throws [StateError] if [chunks] is empty.
+  static Future<WaveformData> generate(
+    Stream<AudioData> chunks, {
+    required int expectedFrames,
+    WaveformConfig config = const WaveformConfig(),
+    Duration? sliceBudget,
+    void Function(WaveformData partial)? onPartial,
+    Duration partialInterval = CooperativeWaveformGenerator.defaultPartialInterval,
+  }) async {
+    StreamingWaveformGenerator? generator;
+    final slice = Stopwatch();
+    final sincePartial = Stopwatch()..start();
+    int sliceFrames = _initialSliceFrames;
+
+    await for (final chunk in chunks) {
+      final current = generator ??= StreamingWaveformGenerator(
+        expectedFrames: expectedFrames,
+        channels: chunk.channels,
+        sampleRate: chunk.sampleRate,
+        config: config,
+      );
+      final samples = chunk.samples;
+      if (sliceBudget == null) {
+        current.add(samples);
+        continue;
+      }
+
+      final budgetMicros = math.max(1, sliceBudget.inMicroseconds);
+      final channels = current.channels;
+      final frames = samples.length ~/ channels;
+      for (int start = 0; start < frames;) {
+        final end = math.min(frames, start + sliceFrames);
+        slice
+          ..reset()
+          ..start();
+        current.add(samples is Float32List ? Float32List.sublistView(samples, start * channels, end * channels) : samples.sublist(start * channels, end * channels));
+        slice.stop();
+
+        // Size the next slice from the throughput of this one
+        final elapsed = slice.elapsedMicroseconds;
+        sliceFrames = elapsed > 0 ? math.max(1, (end - start) * budgetMicros ~/ elapsed) : (end - start) * 2;
+        start = end;
+
+        if (onPartial != null && sincePartial.elapsed >= partialInterval) {
+          onPartial(current.snapshot());
+          sincePartial
+            ..reset()
+            ..start();
+        }
+        await Future<void>.delayed(Duration.zero);
+      }
+    }
+    if (generator == null) {
+      throw StateError('No audio data decoded');
+    }
+    return generator.finish();
+  }
+
+  /// Number of frames folded so far
+  int get framesProcessed => _frame;
+
+  /// Folds interleaved [samples] (whole frames) into the bins
+  ///
+  /// [samples] is not retained and can be released or reused afterwards.
+  void add(List<double> samples) {
+    if (_finished) {
+      throw StateError('Cannot add samples after finish()');
+    }
+
+    final frames = samples.length ~/ channels;
+    final lastBin = config.resolution - 1;
+    final mode = config.channelMode;
+    final algorithm = config.algorithm;
+    final buildPyramid = _pyramidValues != null;
+    final frameValues = _frameValues;
+    final accumulators = _accumulators;
+
+    for (int i = 0; i < frames; i++) {
+      while (_frame >= _binEnd && _bin < lastBin) {
+        _closeBin();
+      }
+
+      WaveformAlgorithms.readFrameStreams(samples, i * channels, channels, mode, frameValues);
+
+      final value = frameValues[0];
+      if (_bins != null) {
+        if (value < _binMin) _binMin = value;
+        if (value > _binMax) _binMax = value;
+        _binSumSquares += value * value;
+      }
+
+      for (int stream = 0; stream < _streamCount; stream++) {
+        final streamValue = frameValues[stream];
+        switch (algorithm) {
+          case DownsamplingAlgorithm.rms:
+            accumulators[stream] += streamValue * streamValue;
+            break;
+          case DownsamplingAlgorithm.peak:
+            final absValue = streamValue.abs();
+            if (absValue > accumulators[stream]) accumulators[stream] = absValue;
+            break;
+          case DownsamplingAlgorithm.average:
+            accumulators[stream] += streamValue.abs();
+            break;
+          case DownsamplingAlgorithm.median:
+            break; // Rejected by the constructor
+        }
+      }
+      _binFrames++;
+
+      if (buildPyramid) {
+        if (value < _pyramidMin) _pyramidMin = value;
+        if (value > _pyramidMax) _pyramidMax = value;
+        _pyramidSumSquares += value * value;
+        if (++_pyramidFrames == WaveformPyramid.defaultBaseFramesPerBin) {
+          _closePyramidBin();
+        }
+      }
+
+      _frame++;
+    }
+  }
+
+  /// Mixed amplitudes of the bins completed so far, post-processed like [finish]
+  ///
+  /// Bins not reached yet are silent and the duration is that of
+  /// [expectedFrames]; per-channel amplitudes, bins and the pyramid are only
+  /// part of the final result.
+  WaveformData snapshot() {
+    return WaveformGenerator.fromRawAmplitudes(
+      Float64List.fromList(_mixed),
+      duration: Duration(microseconds: sampleRate > 0 ? expectedFrames * Duration.microsecondsPerSecond ~/ sampleRate : 0),
+      sampleRate: sampleRate,
+      config: config,
+    );
+  }
+
+  /// Completes the waveform after the last chunk
+  ///
+  /// [duration] defaults to the duration of the frames actually added.
+  WaveformData finish({Duration? duration}) {
+    if (_finished) {
+      throw StateError('finish() was already called');
+    }
+    _finished = true;
+
+    _closeBin();
+    if (_pyramidFrames > 0) {
+      _closePyramidBin();
+    }
+
+    final pyramidValues = _pyramidValues;
+    return WaveformGenerator.fromRawAmplitudes(
+      _mixed,
+      duration: duration ?? Duration(microseconds: sampleRate > 0 ? _frame * Duration.microsecondsPerSecond ~/ sampleRate : 0),
+      sampleRate: sampleRate,
+      config: config,
+      rawChannelAmplitudes: config.channelMode == WaveformChannelMode.mixed ? null : _channelAmplitudes,
+      channelCount: config.channelMode == WaveformChannelMode.mixed ? 0 : _channelCount,
+      rawBins: _bins,
+      rawPyramid: pyramidValues == null
+          ? null
+          : WaveformPyramid.fromBaseLevel(_planarBins(pyramidValues, _pyramidBins), sampleRate: sampleRate, totalFrames: _frame),
+    );
+  }
+
+  /// Writes the accumulated values of the current bin and moves to the next
+  void _closeBin() {
+    final count = _binFrames;
+    final bin = _bin;
+    final resolution = config.resolution;
+
+    final bins = _bins;
+    if (bins != null && count > 0) {
+      bins.data[bin] = _binMin;
+      bins.data[resolution + bin] = _binMax;
+      bins.data[2 * resolution + bin] = math.sqrt(_binSumSquares / count);
+    }
+
+    for (int stream = 0; stream < _streamCount; stream++) {
+      double value = 0.0;
+      if (count > 0) {
+        switch (config.algorithm) {
+          case DownsamplingAlgorithm.rms:
+            value = math.sqrt(_accumulators[stream] / count);
+            break;
+          case DownsamplingAlgorithm.peak:
+            value = _accumulators[stream];
+            break;
+          case DownsamplingAlgorithm.average:
+            value = _accumulators[stream] / count;
+            break;
+          case DownsamplingAlgorithm.median:
+            break;
+        }
+      }
+
+      if (stream == 0) {
+        _mixed[bin] = value;
+      } else {
+        _channelAmplitudes[(stream - 1) * resolution + bin] = value;
+      }
+    }
+
+    _accumulators.fillRange(0, _streamCount, 0.0);
+    _binFrames = 0;
+    _binMin = double.infinity;
+    _binMax = double.negativeInfinity;
+    _binSumSquares = 0.0;
+    _bin++;
+    _binEnd = ((_bin + 1) * _framesPerBin).floor();
+  }
+
+  void _closePyramidBin() {
+    var values = _pyramidValues!;
+    final offset = _pyramidBins * WaveformBins.valuesPerBin;
+    if (offset + WaveformBins.valuesPerBin > values.length) {
+      // The stream is longer than expected
+      values = Float32List(math.max(values.length * 2, WaveformBins.valuesPerBin))..setAll(0, values);
+      _pyramidValues = values;
+    }
+
+    values[offset] = _pyramidMin;
+    values[offset + 1] = _pyramidMax;
+    values[offset + 2] = math.sqrt(_pyramidSumSquares / _pyramidFrames);
+
+    _pyramidBins++;
+    _pyramidFrames = 0;
+    _pyramidMin = double.infinity;
+    _pyramidMax = double.negativeInfinity;
+    _pyramidSumSquares = 0.0;
+  }
+
+  static int _pyramidBinCount(int frames) => (frames + WaveformPyramid.defaultBaseFramesPerBin - 1) ~/ WaveformPyramid.defaultBaseFramesPerBin;
+
+  /// Converts interleaved min/max/RMS triples into the planar [WaveformBins] layout
+  static WaveformBins _planarBins(Float32List interleaved, int binCount) {
+    final bins = WaveformBins.allocate(binCount);
+    final data = bins.data;
+    for (int bin = 0; bin < binCount; bin++) {
+      final offset = bin * WaveformBins.valuesPerBin;
+      data[bin] = interleaved[offset];
+      data[binCount + bin] = interleaved[offset + 1];
+      data[2 * binCount + bin] = interleaved[offset + 2];
+    }
+    return bins;
+  }
+}
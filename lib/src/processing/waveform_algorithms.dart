@@ -1,5 +1,10 @@
 import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:sonix/src/models/waveform_bins.dart';
+import 'package:sonix/src/models/waveform_channel_mode.dart';
 import 'downsampling_algorithm.dart';
+import 'float32_simd.dart';
 import 'normalization_method.dart';
 import 'scaling_curve.dart';
 
@@ -9,8 +14,13 @@ class WaveformAlgorithms {
   ///
   /// RMS provides a better representation of perceived loudness compared to peak values
   /// Formula: RMS = sqrt(sum(x^2) / n)
+  ///
+  /// [Float32List] input is reduced with [Float32Simd].
   static double calculateRMS(List<double> samples) {
     if (samples.isEmpty) return 0.0;
+    if (samples is Float32List) {
+      return math.sqrt(Float32Simd(samples).sumOfSquares(0, samples.length) / samples.length);
+    }
 
     double sumOfSquares = 0.0;
     for (final sample in samples) {
@@ -25,6 +35,9 @@ class WaveformAlgorithms {
   /// Returns the maximum absolute value in the segment
   static double calculatePeak(List<double> samples) {
     if (samples.isEmpty) return 0.0;
+    if (samples is Float32List) {
+      return Float32Simd(samples).peak(0, samples.length);
+    }
 
     double peak = 0.0;
     for (final sample in samples) {
@@ -42,6 +55,10 @@ class WaveformAlgorithms {
   /// More efficient than calling both methods separately
   static ({double rms, double peak}) calculateRMSAndPeak(List<double> samples) {
     if (samples.isEmpty) return (rms: 0.0, peak: 0.0);
+    if (samples is Float32List) {
+      final simd = Float32Simd(samples);
+      return (rms: math.sqrt(simd.sumOfSquares(0, samples.length) / samples.length), peak: simd.peak(0, samples.length));
+    }
 
     double sumOfSquares = 0.0;
     double peak = 0.0;
@@ -65,6 +82,9 @@ class WaveformAlgorithms {
   /// [targetResolution] - Desired number of output data points
   /// [algorithm] - Algorithm to use for downsampling
   /// [channels] - Number of audio channels (for proper handling)
+  ///
+  /// Mono and stereo [Float32List] input is reduced with [Float32Simd]
+  /// (except for median).
   static List<double> downsample(List<double> samples, int targetResolution, {DownsamplingAlgorithm algorithm = DownsamplingAlgorithm.rms, int channels = 1}) {
     if (samples.isEmpty || targetResolution <= 0) {
       return <double>[];
@@ -75,6 +95,10 @@ class WaveformAlgorithms {
       return List<double>.from(samples);
     }
 
+    if (samples is Float32List && (channels == 1 || channels == 2) && algorithm != DownsamplingAlgorithm.median) {
+      return _downsampleFloat32(samples, targetResolution, algorithm, channels);
+    }
+
     final result = <double>[];
     final samplesPerChannel = samples.length ~/ channels;
     final samplesPerBin = samplesPerChannel / targetResolution;
@@ -185,6 +209,300 @@ class WaveformAlgorithms {
     return result;
   }
 
+  /// [downsample] for mono or stereo [Float32List] input
+  static List<double> _downsampleFloat32(Float32List samples, int targetResolution, DownsamplingAlgorithm algorithm, int channels) {
+    final simd = Float32Simd(samples);
+    final stereo = channels == 2;
+    final frames = samples.length ~/ channels;
+    final framesPerBin = frames / targetResolution;
+    final result = List<double>.filled(targetResolution, 0.0);
+
+    for (int i = 0; i < targetResolution; i++) {
+      final startFrame = (i * framesPerBin).floor();
+      final endFrame = math.min(((i + 1) * framesPerBin).floor(), frames);
+      final count = endFrame - startFrame;
+      if (count <= 0) continue;
+
+      switch (algorithm) {
+        case DownsamplingAlgorithm.rms:
+          final sumSquares = stereo ? simd.stereoSumOfSquares(startFrame, endFrame) : simd.sumOfSquares(startFrame, endFrame);
+          result[i] = math.sqrt(sumSquares / count);
+          break;
+        case DownsamplingAlgorithm.peak:
+          result[i] = stereo ? simd.stereoPeak(startFrame, endFrame) : simd.peak(startFrame, endFrame);
+          break;
+        case DownsamplingAlgorithm.average:
+          final sumAbs = stereo ? simd.stereoSumAbs(startFrame, endFrame) : simd.sumAbs(startFrame, endFrame);
+          result[i] = sumAbs / count;
+          break;
+        case DownsamplingAlgorithm.median:
+          throw StateError('Median is reduced by the scalar path');
+      }
+    }
+
+    return result;
+  }
+
+  /// Downsample audio into mixed and per-channel amplitudes in a single pass
+  ///
+  /// Every frame is read once and reduced into the mixed amplitude list (the
+  /// channel average, as in [downsample]) plus one amplitude list per
+  /// output channel of [mode]. Per-channel values are returned planar in one
+  /// contiguous buffer: channel `c` occupies `[c * targetResolution, (c + 1) * targetResolution)`.
+  ///
+  /// [samples] - Interleaved input audio samples
+  /// [targetResolution] - Desired number of output data points per channel
+  /// [algorithm] - Algorithm to use for downsampling
+  /// [channels] - Number of interleaved channels in [samples]
+  /// [mode] - Per-channel layout to produce
+  /// [computeBins] - Whether to also collect signed min/max/RMS bins of the
+  /// mixed signal in the same pass
+  static ({List<double> mixed, Float32List channelAmplitudes, int channelCount, WaveformBins? bins}) downsampleChannels(
+    List<double> samples,
+    int targetResolution, {
+    DownsamplingAlgorithm algorithm = DownsamplingAlgorithm.rms,
+    int channels = 1,
+    WaveformChannelMode mode = WaveformChannelMode.perChannel,
+    bool computeBins = false,
+  }) {
+    final channelCount = mode.outputChannelCount(channels);
+    if (samples.isEmpty || targetResolution <= 0 || channels <= 0) {
+      return (mixed: <double>[], channelAmplitudes: Float32List(0), channelCount: channelCount, bins: computeBins ? WaveformBins.allocate(0) : null);
+    }
+
+    final mixed = List<double>.filled(targetResolution, 0.0);
+    final channelAmplitudes = Float32List(channelCount * targetResolution);
+    final bins = computeBins ? WaveformBins.allocate(targetResolution) : null;
+
+    downsampleChannelsRange(
+      samples,
+      targetResolution,
+      0,
+      targetResolution,
+      algorithm: algorithm,
+      channels: channels,
+      mode: mode,
+      mixed: mixed,
+      channelAmplitudes: channelAmplitudes,
+      bins: bins,
+    );
+
+    return (mixed: mixed, channelAmplitudes: channelAmplitudes, channelCount: channelCount, bins: bins);
+  }
+
+  /// Reduce bins `[startBin, endBin)` of [downsampleChannels] into caller-owned buffers
+  ///
+  /// Bin boundaries depend only on the frame count and [targetResolution], so
+  /// disjoint bin ranges can be reduced independently (for example by
+  /// parallel workers sharing [samples] and the output buffers) and produce
+  /// exactly the values of a single [downsampleChannels] call.
+  ///
+  /// Bins are reduced with scalar double loops. [downsample] reduces
+  /// mixed-only mono and stereo [Float32List] input with [Float32Simd]
+  /// instead, so generators built on bin ranges match it to float rounding
+  /// for mixed amplitudes and exactly for everything else.
+  ///
+  /// [mixed] needs room for [targetResolution] values, [channelAmplitudes]
+  /// for `mode.outputChannelCount(channels) * targetResolution` planar values
+  /// and [bins], when given, for [targetResolution] bins. Values outside the
+  /// range are left untouched.
+  static void downsampleChannelsRange(
+    List<double> samples,
+    int targetResolution,
+    int startBin,
+    int endBin, {
+    DownsamplingAlgorithm algorithm = DownsamplingAlgorithm.rms,
+    int channels = 1,
+    WaveformChannelMode mode = WaveformChannelMode.perChannel,
+    required List<double> mixed,
+    required Float32List channelAmplitudes,
+    WaveformBins? bins,
+  }) {
+    if (samples.isEmpty || targetResolution <= 0 || channels <= 0) {
+      return;
+    }
+    RangeError.checkValidRange(startBin, endBin, targetResolution);
+
+    final channelCount = mode.outputChannelCount(channels);
+    final frames = samples.length ~/ channels;
+    final streamCount = channelCount + 1; // Stream 0 is the mixed signal
+    final framesPerBin = frames / targetResolution;
+
+    final frameValues = Float64List(streamCount);
+    final accumulators = Float64List(streamCount);
+    final binSamples = algorithm == DownsamplingAlgorithm.median ? List.generate(streamCount, (_) => <double>[]) : null;
+
+    for (int bin = startBin; bin < endBin; bin++) {
+      final startFrame = (bin * framesPerBin).floor();
+      final endFrame = math.min(((bin + 1) * framesPerBin).floor(), frames);
+
+      accumulators.fillRange(0, streamCount, 0.0);
+      if (binSamples != null) {
+        for (final list in binSamples) {
+          list.clear();
+        }
+      }
+
+      double binMin = double.infinity;
+      double binMax = double.negativeInfinity;
+      double binSumSquares = 0.0;
+
+      for (int frame = startFrame; frame < endFrame; frame++) {
+        readFrameStreams(samples, frame * channels, channels, mode, frameValues);
+
+        if (bins != null) {
+          final value = frameValues[0];
+          if (value < binMin) binMin = value;
+          if (value > binMax) binMax = value;
+          binSumSquares += value * value;
+        }
+
+        for (int stream = 0; stream < streamCount; stream++) {
+          final value = frameValues[stream];
+          switch (algorithm) {
+            case DownsamplingAlgorithm.rms:
+              accumulators[stream] += value * value;
+              break;
+            case DownsamplingAlgorithm.peak:
+              final absValue = value.abs();
+              if (absValue > accumulators[stream]) accumulators[stream] = absValue;
+              break;
+            case DownsamplingAlgorithm.average:
+              accumulators[stream] += value.abs();
+              break;
+            case DownsamplingAlgorithm.median:
+              binSamples![stream].add(value);
+              break;
+          }
+        }
+      }
+
+      final count = endFrame - startFrame;
+      if (bins != null && count > 0) {
+        bins.data[bin] = binMin;
+        bins.data[targetResolution + bin] = binMax;
+        bins.data[2 * targetResolution + bin] = math.sqrt(binSumSquares / count);
+      }
+
+      for (int stream = 0; stream < streamCount; stream++) {
+        double value;
+        if (count <= 0) {
+          value = 0.0;
+        } else {
+          switch (algorithm) {
+            case DownsamplingAlgorithm.rms:
+              value = math.sqrt(accumulators[stream] / count);
+              break;
+            case DownsamplingAlgorithm.peak:
+              value = accumulators[stream];
+              break;
+            case DownsamplingAlgorithm.average:
+              value = accumulators[stream] / count;
+              break;
+            case DownsamplingAlgorithm.median:
+              value = calculateMedian(binSamples![stream]);
+              break;
+          }
+        }
+
+        if (stream == 0) {
+          mixed[bin] = value;
+        } else {
+          channelAmplitudes[(stream - 1) * targetResolution + bin] = value;
+        }
+      }
+    }
+  }
+
+  /// Reduce audio into signed min/max/RMS bins of a fixed frame count
+  ///
+  /// Unlike [downsampleChannels], the bin width is fixed rather than the bin
+  /// count: every bin covers [framesPerBin] frames of the channel-averaged
+  /// signal, and the last bin covers the remainder. Used for the finest level
+  /// of a `WaveformPyramid`.
+  ///
+  /// [samples] - Interleaved input audio samples
+  /// [framesPerBin] - Number of frames reduced into each bin
+  /// [channels] - Number of interleaved channels in [samples]
+  static WaveformBins downsampleFixedBins(List<double> samples, int framesPerBin, {int channels = 1}) {
+    if (samples.isEmpty || framesPerBin <= 0 || channels <= 0) {
+      return WaveformBins.allocate(0);
+    }
+
+    final bins = WaveformBins.allocate(fixedBinCount(samples.length ~/ channels, framesPerBin));
+    downsampleFixedBinsRange(samples, framesPerBin, 0, bins.length, channels: channels, bins: bins);
+    return bins;
+  }
+
+  /// Number of bins [downsampleFixedBins] produces for [frames] frames
+  static int fixedBinCount(int frames, int framesPerBin) => (frames + framesPerBin - 1) ~/ framesPerBin;
+
+  /// Reduce bins `[startBin, endBin)` of [downsampleFixedBins] into [bins]
+  ///
+  /// [bins] needs room for every bin of the whole signal (see [fixedBinCount]);
+  /// like [downsampleChannelsRange], disjoint ranges can be reduced
+  /// independently.
+  static void downsampleFixedBinsRange(List<double> samples, int framesPerBin, int startBin, int endBin, {int channels = 1, required WaveformBins bins}) {
+    final frames = samples.length ~/ channels;
+    final binCount = bins.length;
+    final data = bins.data;
+    RangeError.checkValidRange(startBin, endBin, binCount);
+
+    for (int bin = startBin; bin < endBin; bin++) {
+      final startFrame = bin * framesPerBin;
+      final endFrame = math.min(startFrame + framesPerBin, frames);
+
+      double binMin = double.infinity;
+      double binMax = double.negativeInfinity;
+      double sumSquares = 0.0;
+      for (int frame = startFrame; frame < endFrame; frame++) {
+        final base = frame * channels;
+        double value = 0.0;
+        for (int ch = 0; ch < channels; ch++) {
+          value += samples[base + ch];
+        }
+        value /= channels;
+
+        if (value < binMin) binMin = value;
+        if (value > binMax) binMax = value;
+        sumSquares += value * value;
+      }
+
+      data[bin] = binMin;
+      data[binCount + bin] = binMax;
+      data[2 * binCount + bin] = math.sqrt(sumSquares / (endFrame - startFrame));
+    }
+  }
+
+  /// Fill [out] with the mixed value followed by the per-channel values of one frame
+  ///
+  /// [out] needs room for `mode.outputChannelCount(channels) + 1` values.
+  static void readFrameStreams(List<double> samples, int base, int channels, WaveformChannelMode mode, Float64List out) {
+    double mixed = 0.0;
+    for (int ch = 0; ch < channels; ch++) {
+      mixed += samples[base + ch];
+    }
+    out[0] = mixed / channels;
+
+    switch (mode) {
+      case WaveformChannelMode.mixed:
+        break;
+      case WaveformChannelMode.perChannel:
+        for (int ch = 0; ch < channels; ch++) {
+          out[ch + 1] = samples[base + ch];
+        }
+        break;
+      case WaveformChannelMode.midSide:
+        final left = samples[base];
+        final right = channels > 1 ? samples[base + 1] : left;
+        out[1] = left;
+        out[2] = right;
+        out[3] = (left + right) * 0.5;
+        out[4] = (left - right) * 0.5;
+        break;
+    }
+  }
+
   /// Calculate average amplitude for a segment
   static double calculateAverage(List<double> samples) {
     if (samples.isEmpty) return 0.0;
@@ -0,0 +1,441 @@
+import 'dart:async';
+import 'dart:io';
+
+import 'package:sonix/src/models/waveform_binary_codec.dart';
+import 'package:sonix/src/models/waveform_data.dart';
+import 'package:sonix/src/utils/file_fingerprint.dart';
+import 'package:sonix/src/utils/memory_manager.dart';
+import 'package:sonix/src/utils/sonix_logger.dart';
+import 'waveform_config.dart';
+
+/// Two-tier cache of generated waveforms for repeat views of the same files
+///
+/// Decoding dominates waveform generation, and most requests are for tracks
+/// that were shown before. This cache answers those without decoding:
+///
+/// ```
+/// get(path, config)
+///   │ stat: same mtime and size as last time? ──no──> re-fingerprint, drop memory entries
+///   ▼
+/// memory  (path, config) -> WaveformData           LRU bounded by memoryBudget bytes
+///   │ miss
+///   ▼
+/// disk    <fingerprint>-<mtime>-<config hash>.snxw  LRU bounded by diskBudget bytes
+///   │ miss
+///   ▼
+/// generate, then store in both tiers
+/// ```
+///
+/// Entries are validated with the modification time of the file and its
+/// [FileFingerprint] (size plus hashes of its head and tail); a change of
+/// either invalidates them. The fingerprint alone misses same-size edits of
+/// the middle of a file, the modification time alone misses replacements
+/// that restore it. Disk entries are keyed by fingerprint, modification time
+/// and `WaveformConfig.stableHash` in the binary waveform format, so they
+/// survive restarts and moves (a rename keeps the modification time), and
+/// entries of changed files age out of the disk budget. Two distinct files
+/// share entries only if they agree in size, both 64KB ends and
+/// modification time.
+///
+/// The memory tier shrinks by half on `MemoryManager` pressure and empties
+/// on critical pressure. Waveforms returned by the cache are deep copies
+/// (`WaveformData.copy`), so disposing or editing one does not affect the
+/// cached entry.
+///
+/// ## Example Usage
+///
+/// ```dart
+/// final cache = WaveformCache(directory: Directory('${support.path}/waveforms'));
+///
+/// final waveform = await cache.getOrGenerate(
+///   'track.mp3',
+///   config,
+///   () => AudioFileProcessor().generateWaveform('track.mp3', config: config),
+/// );
+///
+/// cache.dispose();
+/// ```
+class WaveformCache {
+  /// Default memory budget of generated waveforms (32MB)
+  static const int defaultMemoryBudget = 32 * 1024 * 1024;
+
+  /// Default disk budget of persisted waveforms (256MB)
+  static const int defaultDiskBudget = 256 * 1024 * 1024;
+
+  /// File extension of disk entries
+  static const String entryExtension = '.snxw';
+
+  /// Files whose modification time and fingerprint are remembered
+  static const int _maxTrackedFiles = 1024;
+
+  /// Estimated bytes of a cached waveform besides its buffers
+  static const int _entryOverhead = 512;
+
+  /// Bytes of waveforms kept in memory; 0 disables the memory tier
+  final int memoryBudget;
+
+  /// Directory of the disk tier, or null to keep waveforms in memory only
+  final Directory? directory;
+
+  /// Bytes of disk entries kept in [directory]
+  final int diskBudget;
+
+  /// Precision of disk entries; float32 restores exactly what was generated
+  final WaveformQuantization quantization;
+
+  // Insertion-ordered; lookups move hits to the end
+  final Map<(String, WaveformConfig), _MemoryEntry> _memory = {};
+  final Map<String, _FileVersion> _files = {};
+  final Map<(String, WaveformConfig, _FileVersion), Future<WaveformData>> _inFlight = {};
+  final Set<Future<void>> _diskWrites = {};
+  int _memoryBytes = 0;
+  bool _disposed = false;
+
+  int _memoryHits = 0;
+  int _diskHits = 0;
+  int _misses = 0;
+
+  /// Creates a cache and subscribes it to `MemoryManager` pressure callbacks
+  ///
+  /// Throws [ArgumentError] if a budget is negative
+  WaveformCache({this.memoryBudget = defaultMemoryBudget, this.directory, this.diskBudget = defaultDiskBudget, this.quantization = WaveformQuantization.float32}) {
+    if (memoryBudget < 0) {
+      throw ArgumentError.value(memoryBudget, 'memoryBudget', 'Must not be negative');
+    }
+    if (diskBudget < 0) {
+      throw ArgumentError.value(diskBudget, 'diskBudget', 'Must not be negative');
+    }
+    MemoryManager()
+      ..registerMemoryPressureCallback(_onMemoryPressure)
+      ..registerCriticalMemoryCallback(clearMemory);
+  }
+
+  /// Estimated bytes of the waveforms held in memory
+  int get memoryBytes => _memoryBytes;
+
+  /// Number of waveforms held in memory
+  int get memoryEntries => _memory.length;
+
+  /// Lookups answered from memory
+  int get memoryHits => _memoryHits;
+
+  /// Lookups answered from disk
+  int get diskHits => _diskHits;
+
+  /// Lookups answered by neither tier
+  int get misses => _misses;
+
+  /// Returns the cached waveform of [filePath] for [config], or null
+  ///
+  /// Returns null as well if the file does not exist.
+  Future<WaveformData?> get(String filePath, WaveformConfig config) async {
+    final version = await _version(filePath);
+    if (version == null) return null;
+    return _lookup(filePath, version, config);
+  }
+
+  /// Stores [waveform], generated from [filePath] with [config], in both tiers
+  ///
+  /// Does nothing if the file does not exist. Failing to write the disk entry
+  /// is logged and otherwise ignored.
+  Future<void> put(String filePath, WaveformConfig config, WaveformData waveform) async {
+    final version = await _version(filePath);
+    if (version == null) return;
+    await _store(filePath, version, config, waveform);
+  }
+
+  /// Returns the cached waveform, or calls [generate] and caches its result
+  ///
+  /// The file is fingerprinted before [generate] runs, so a file replaced
+  /// while generating is not cached under its new content. Concurrent misses
+  /// for the same file version and config share one [generate] call, and
+  /// each caller receives its own copy. The disk entry is written in the
+  /// background; [flush] waits for it.
+  Future<WaveformData> getOrGenerate(String filePath, WaveformConfig config, Future<WaveformData> Function() generate) async {
+    final version = await _version(filePath);
+    if (version == null) return generate();
+
+    final cached = await _lookup(filePath, version, config);
+    if (cached != null) return cached;
+
+    final key = (filePath, config, version);
+    final waveform = await (_inFlight[key] ??= _generate(key, generate));
+    return waveform.copy();
+  }
+
+  /// Waits until every disk entry still being written is on disk
+  Future<void> flush() async {
+    while (_diskWrites.isNotEmpty) {
+      await Future.wait(List.of(_diskWrites));
+    }
+  }
+
+  /// Drops the memory entries of [filePath] and forgets its fingerprint
+  ///
+  /// Disk entries are keyed by content and modification time and stay valid
+  /// for unchanged files.
+  void invalidate(String filePath) {
+    _files.remove(filePath);
+    _dropMemory(filePath);
+  }
+
+  /// Drops the least recently used memory entries until at most [budget] bytes remain
+  void trimMemory(int budget) {
+    while (_memoryBytes > budget && _memory.isNotEmpty) {
+      final key = _memory.keys.first;
+      _memoryBytes -= _memory.remove(key)!.bytes;
+    }
+  }
+
+  /// Drops every memory entry
+  void clearMemory() => trimMemory(0);
+
+  /// Drops every memory entry and deletes every disk entry
+  Future<void> clear() async {
+    await flush();
+    clearMemory();
+    _files.clear();
+    for (final entry in await _diskEntries()) {
+      await _delete(entry.file);
+    }
+  }
+
+  /// Unsubscribes from memory pressure and drops the memory tier
+  ///
+  /// Disk entries are kept for the next cache using the same [directory].
+  void dispose() {
+    if (_disposed) return;
+    _disposed = true;
+    MemoryManager()
+      ..removeMemoryPressureCallback(_onMemoryPressure)
+      ..removeCriticalMemoryCallback(clearMemory);
+    clearMemory();
+    _files.clear();
+  }
+
+  Future<WaveformData?> _lookup(String filePath, _FileVersion version, WaveformConfig config) async {
+    final key = (filePath, config);
+    final entry = _memory.remove(key);
+    if (entry != null) {
+      if (entry.version == version) {
+        _memory[key] = entry;
+        _memoryHits++;
+        return entry.waveform.copy();
+      }
+      _memoryBytes -= entry.bytes;
+    }
+
+    final stored = await _readDisk(version, config);
+    if (stored != null) {
+      _diskHits++;
+      _remember(key, version, stored);
+      return stored.copy();
+    }
+
+    _misses++;
+    return null;
+  }
+
+  /// Runs [generate] once for every caller waiting on [key]
+  ///
+  /// The result is only ever handed out as copies, so the memory tier keeps
+  /// it as is.
+  Future<WaveformData> _generate((String, WaveformConfig, _FileVersion) key, Future<WaveformData> Function() generate) async {
+    final (filePath, config, version) = key;
+    try {
+      final waveform = await generate();
+      _remember((filePath, config), version, waveform);
+      final write = _writeDisk(version, config, waveform);
+      _diskWrites.add(write);
+      unawaited(write.whenComplete(() => _diskWrites.remove(write)));
+      return waveform;
+    } finally {
+      _inFlight.remove(key);
+    }
+  }
+
+  Future<void> _store(String filePath, _FileVersion version, WaveformConfig config, WaveformData waveform) async {
+    _remember((filePath, config), version, waveform.copy());
+    await _writeDisk(version, config, waveform);
+  }
+
+  /// Modification time and fingerprint of [filePath]
+  ///
+  /// The fingerprint is recomputed only if the modification time or size
+  /// changed; either change drops the memory entries of the path.
+  Future<_FileVersion?> _version(String filePath) async {
+    final stat = await FileStat.stat(filePath);
+    if (stat.type == FileSystemEntityType.notFound) {
+      invalidate(filePath);
+      return null;
+    }
+
+    final known = _files.remove(filePath);
+    if (known != null && known.modified == stat.modified && known.fingerprint.size == stat.size) {
+      _files[filePath] = known;
+      return known;
+    }
+
+    final fingerprint = await FileFingerprint.compute(filePath);
+    if (fingerprint == null) {
+      invalidate(filePath);
+      return null;
+    }
+    if (known != null) {
+      _dropMemory(filePath);
+    }
+    final version = _FileVersion(stat.modified, fingerprint);
+    _files[filePath] = version;
+    if (_files.length > _maxTrackedFiles) {
+      _files.remove(_files.keys.first);
+    }
+    return version;
+  }
+
+  void _remember((String, WaveformConfig) key, _FileVersion version, WaveformData waveform) {
+    if (_disposed) return;
+    final bytes = _sizeOf(waveform);
+    final previous = _memory.remove(key);
+    if (previous != null) _memoryBytes -= previous.bytes;
+    if (bytes > memoryBudget) return;
+
+    _memory[key] = _MemoryEntry(version, waveform, bytes);
+    _memoryBytes += bytes;
+    trimMemory(memoryBudget);
+  }
+
+  void _dropMemory(String filePath) {
+    _memory.removeWhere((key, entry) {
+      if (key.$1 != filePath) return false;
+      _memoryBytes -= entry.bytes;
+      return true;
+    });
+  }
+
+  void _onMemoryPressure() => trimMemory(_memoryBytes ~/ 2);
+
+  File? _entryFile(_FileVersion version, WaveformConfig config) {
+    final directory = this.directory;
+    if (directory == null || diskBudget == 0) return null;
+    final modified = version.modified.millisecondsSinceEpoch.toRadixString(16);
+    final configHash = config.stableHash.toRadixString(16).padLeft(8, '0');
+    return File('${directory.path}${Platform.pathSeparator}${version.fingerprint.toHex()}-$modified-$configHash$entryExtension');
+  }
+
+  Future<WaveformData?> _readDisk(_FileVersion version, WaveformConfig config) async {
+    final file = _entryFile(version, config);
+    if (file == null) return null;
+
+    try {
+      final bytes = await file.readAsBytes();
+      if (WaveformBinaryCodec.readHeader(bytes).configHash != config.stableHash) return null;
+      final waveform = WaveformData.fromBinary(bytes);
+      // The modification time orders entries for eviction
+      await file.setLastModified(DateTime.now());
+      return waveform;
+    } on FileSystemException {
+      return null;
+    } on FormatException catch (e) {
+      SonixLogger.debug('Discarding unreadable waveform cache entry ${file.path}: ${e.message}');
+      await _delete(file);
+      return null;
+    }
+  }
+
+  Future<void> _writeDisk(_FileVersion version, WaveformConfig config, WaveformData waveform) async {
+    final file = _entryFile(version, config);
+    if (file == null) return;
+
+    try {
+      final bytes = waveform.toBinary(quantization: quantization, configHash: config.stableHash);
+      if (bytes.length > diskBudget) return;
+      await file.parent.create(recursive: true);
+      // Written aside and renamed so readers never see a partial entry
+      final partial = File('${file.path}.tmp');
+      await partial.writeAsBytes(bytes, flush: true);
+      await partial.rename(file.path);
+      await _trimDisk();
+    } on FileSystemException catch (e) {
+      SonixLogger.debug('Failed to write waveform cache entry ${file.path}: ${e.message}');
+    }
+  }
+
+  /// Deletes the least recently used disk entries beyond [diskBudget]
+  Future<void> _trimDisk() async {
+    final entries = await _diskEntries();
+    int total = entries.fold(0, (sum, entry) => sum + entry.size);
+    if (total <= diskBudget) return;
+
+    entries.sort((a, b) => a.modified.compareTo(b.modified));
+    for (final entry in entries) {
+      if (total <= diskBudget) break;
+      await _delete(entry.file);
+      total -= entry.size;
+    }
+  }
+
+  Future<List<_DiskEntry>> _diskEntries() async {
+    final directory = this.directory;
+    if (directory == null || !await directory.exists()) return [];
+
+    final entries = <_DiskEntry>[];
+    await for (final entity in directory.list()) {
+      if (entity is! File || !entity.path.endsWith(entryExtension)) continue;
+      final stat = await entity.stat();
+      if (stat.type == FileSystemEntityType.notFound) continue;
+      entries.add(_DiskEntry(entity, stat.size, stat.modified));
+    }
+    return entries;
+  }
+
+  static Future<void> _delete(File file) async {
+    try {
+      await file.delete();
+    } on FileSystemException {
+      // Already gone
+    }
+  }
+
+  static int _sizeOf(WaveformData waveform) {
+    int bytes = _entryOverhead + waveform.amplitudes.lengthInBytes;
+    bytes += waveform.channelAmplitudes?.lengthInBytes ?? 0;
+    bytes += waveform.bins?.data.lengthInBytes ?? 0;
+    final pyramid = waveform.pyramid;
+    if (pyramid != null) {
+      for (final level in pyramid.levels) {
+        bytes += level.data.lengthInBytes;
+      }
+    }
+    return bytes;
+  }
+}
+
+/// Last seen modification time and fingerprint of a source file
+class _FileVersion {
+  final DateTime modified;
+  final FileFingerprint fingerprint;
+
+  const _FileVersion(this.modified, this.fingerprint);
+
+  @override
+  bool operator ==(Object other) => other is _FileVersion && other.modified == modified && other.fingerprint == fingerprint;
+
+  @override
+  int get hashCode => Object.hash(modified, fingerprint);
+}
+
+class _MemoryEntry {
+  final _FileVersion version;
+  final WaveformData waveform;
+  final int bytes;
+
+  const _MemoryEntry(this.version, this.waveform, this.bytes);
+}
+
+class _DiskEntry {
+  final File file;
+  final int size;
+  final DateTime modified;
+
+  const _DiskEntry(this.file, this.size, this.modified);
+}
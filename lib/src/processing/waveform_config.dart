@@ -1,3 +1,6 @@
+import 'dart:convert';
+
+import 'package:sonix/src/models/waveform_channel_mode.dart';
 import 'package:sonix/src/models/waveform_type.dart';
 import 'downsampling_algorithm.dart';
 import 'normalization_method.dart';
@@ -138,6 +141,31 @@ class WaveformConfig {
   /// - **7-10**: Heavy smoothing, very clean appearance
   final int smoothingWindowSize;
 
+  /// Channel layout of the generated amplitude data.
+  ///
+  /// - [WaveformChannelMode.mixed]: Single mixed-down amplitude list (default)
+  /// - [WaveformChannelMode.perChannel]: Additionally one list per channel
+  /// - [WaveformChannelMode.midSide]: Additionally L, R, mid and side lists
+  ///
+  /// Per-channel lists are generated in the same pass as the mixed list and
+  /// normalized jointly, so relative channel levels are preserved.
+  final WaveformChannelMode channelMode;
+
+  /// Whether to also produce signed min/max/RMS bins in `WaveformData.bins`.
+  ///
+  /// The bins are computed in the same pass as the amplitudes and let the
+  /// painter draw the true signed envelope with
+  /// `DownsampleMethod.minMax`. Costs three floats per bin.
+  final bool generateBins;
+
+  /// Whether to also build a multi-resolution pyramid in `WaveformData.pyramid`.
+  ///
+  /// The finest level holds one min/max/RMS bin per 256 frames and every
+  /// coarser level halves the bin count, so any zoom level can be served by
+  /// slicing a level instead of generating again. Costs roughly 24 bytes per
+  /// 256 frames (about 45 MB for three hours at 44.1 kHz).
+  final bool generatePyramid;
+
   const WaveformConfig({
     this.resolution = 1000,
     this.type = WaveformType.bars,
@@ -148,6 +176,9 @@ class WaveformConfig {
     this.scalingFactor = 1.0,
     this.enableSmoothing = false,
     this.smoothingWindowSize = 3,
+    this.channelMode = WaveformChannelMode.mixed,
+    this.generateBins = false,
+    this.generatePyramid = false,
   });
 
   /// Convert to JSON for serialization
@@ -162,6 +193,9 @@ class WaveformConfig {
       'scalingFactor': scalingFactor,
       'enableSmoothing': enableSmoothing,
       'smoothingWindowSize': smoothingWindowSize,
+      'channelMode': channelMode.name,
+      'generateBins': generateBins,
+      'generatePyramid': generatePyramid,
     };
   }
 
@@ -177,6 +211,9 @@ class WaveformConfig {
       scalingFactor: (json['scalingFactor'] as num?)?.toDouble() ?? 1.0,
       enableSmoothing: json['enableSmoothing'] as bool? ?? false,
       smoothingWindowSize: json['smoothingWindowSize'] as int? ?? 3,
+      channelMode: WaveformChannelMode.values.firstWhere((e) => e.name == json['channelMode'], orElse: () => WaveformChannelMode.mixed),
+      generateBins: json['generateBins'] as bool? ?? false,
+      generatePyramid: json['generatePyramid'] as bool? ?? false,
     );
   }
 
@@ -190,6 +227,9 @@ class WaveformConfig {
     double? scalingFactor,
     bool? enableSmoothing,
     int? smoothingWindowSize,
+    WaveformChannelMode? channelMode,
+    bool? generateBins,
+    bool? generatePyramid,
   }) {
     return WaveformConfig(
       resolution: resolution ?? this.resolution,
@@ -201,6 +241,58 @@ class WaveformConfig {
       scalingFactor: scalingFactor ?? this.scalingFactor,
       enableSmoothing: enableSmoothing ?? this.enableSmoothing,
       smoothingWindowSize: smoothingWindowSize ?? this.smoothingWindowSize,
+      channelMode: channelMode ?? this.channelMode,
+      generateBins: generateBins ?? this.generateBins,
+      generatePyramid: generatePyramid ?? this.generatePyramid,
+    );
+  }
+
+  /// 32-bit hash of all settings that is stable across runs and platforms
+  ///
+  /// Unlike [hashCode], the value can be persisted, e.g. in the header of a
+  /// binary waveform cache entry to detect entries generated with other settings.
+  int get stableHash {
+    // FNV-1a over the canonical JSON encoding
+    int hash = 0x811c9dc5;
+    for (final byte in utf8.encode(jsonEncode(toJson()))) {
+      hash = ((hash ^ byte) * 0x01000193) & 0xffffffff;
+    }
+    return hash;
+  }
+
+  @override
+  bool operator ==(Object other) {
+    if (identical(this, other)) return true;
+    return other is WaveformConfig &&
+        other.resolution == resolution &&
+        other.type == type &&
+        other.normalize == normalize &&
+        other.algorithm == algorithm &&
+        other.normalizationMethod == normalizationMethod &&
+        other.scalingCurve == scalingCurve &&
+        other.scalingFactor == scalingFactor &&
+        other.enableSmoothing == enableSmoothing &&
+        other.smoothingWindowSize == smoothingWindowSize &&
+        other.channelMode == channelMode &&
+        other.generateBins == generateBins &&
+        other.generatePyramid == generatePyramid;
+  }
+
+  @override
+  int get hashCode {
+    return Object.hash(
+      resolution,
+      type,
+      normalize,
+      algorithm,
+      normalizationMethod,
+      scalingCurve,
+      scalingFactor,
+      enableSmoothing,
+      smoothingWindowSize,
+      channelMode,
+      generateBins,
+      generatePyramid,
     );
   }
 }
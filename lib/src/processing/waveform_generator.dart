@@ -3,10 +3,14 @@ import 'dart:math' as math;
 import 'dart:typed_data';
 
 import 'package:sonix/src/models/audio_data.dart';
+import 'package:sonix/src/models/waveform_bins.dart';
+import 'package:sonix/src/models/waveform_channel_mode.dart';
 import 'package:sonix/src/models/waveform_data.dart';
 import 'package:sonix/src/models/waveform_metadata.dart';
+import 'package:sonix/src/models/waveform_pyramid.dart';
 import 'waveform_algorithms.dart';
 import 'waveform_config.dart';
+import 'waveform_post_processor.dart';
 import 'waveform_use_case.dart';
 import 'downsampling_algorithm.dart';
 import 'scaling_curve.dart';
@@ -91,31 +95,186 @@ class WaveformGenerator {
     }
 
     // Validate configuration
-    _validateConfig(config);
+    validateConfig(config);
+
+    // Per-channel output and min/max/RMS bins: one pass produces everything
+    if (_needsSinglePass(config)) {
+      return _generateWithChannels(audioData, config);
+    }
 
     // Step 1: Downsample the audio data
     final amplitudes = WaveformAlgorithms.downsample(audioData.samples, config.resolution, algorithm: config.algorithm, channels: audioData.channels);
 
-    // Step 2: Apply smoothing if enabled
-    List<double> processedAmplitudes = amplitudes;
-    if (config.enableSmoothing) {
-      processedAmplitudes = WaveformAlgorithms.smoothAmplitudes(processedAmplitudes, windowSize: config.smoothingWindowSize);
+    // Steps 2-4: smoothing, normalization and scaling
+    return _buildWaveformData(
+      amplitudes,
+      duration: audioData.duration,
+      sampleRate: audioData.sampleRate,
+      config: config,
+      pyramid: config.generatePyramid ? buildPyramid(audioData, config) : null,
+    );
+  }
+
+  /// Build waveform data from amplitudes that were downsampled elsewhere
+  ///
+  /// Used when the per-bin reduction already happened outside of Dart, for
+  /// example by the native decode-once pipeline behind
+  /// `MultiWaveformGenerator`. Applies the same smoothing, normalization and
+  /// scaling steps as [generateInMemory], so both paths produce identical
+  /// output for identical raw amplitudes.
+  ///
+  /// [rawAmplitudes] - One un-normalized amplitude per bin
+  /// [duration] - Duration of the source audio
+  /// [sampleRate] - Sample rate of the source audio
+  /// [config] - Configuration the amplitudes were reduced with
+  ///
+  /// [rawChannelAmplitudes] - Optional planar per-channel amplitudes laid out
+  /// as described by [WaveformData.channelAmplitudes]
+  /// [channelCount] - Number of channels in [rawChannelAmplitudes]
+  /// [rawBins] - Optional un-normalized min/max/RMS bins
+  /// [rawPyramid] - Optional un-normalized pyramid
+  static WaveformData fromRawAmplitudes(
+    List<double> rawAmplitudes, {
+    required Duration duration,
+    required int sampleRate,
+    WaveformConfig config = const WaveformConfig(),
+    Float32List? rawChannelAmplitudes,
+    int channelCount = 0,
+    WaveformBins? rawBins,
+    WaveformPyramid? rawPyramid,
+  }) {
+    validateConfig(config);
+    return _buildWaveformData(
+      rawAmplitudes,
+      duration: duration,
+      sampleRate: sampleRate,
+      config: config,
+      channelAmplitudes: rawChannelAmplitudes,
+      channelCount: channelCount,
+      bins: rawBins,
+      pyramid: rawPyramid == null ? null : applyPyramidPostProcessing(rawPyramid, config),
+    );
+  }
+
+  /// Apply the configured post-processing steps to downsampled amplitudes
+  ///
+  /// Order matters: smoothing, then normalization, then amplitude scaling.
+  /// The steps run fused in [WaveformPostProcessor] into one new
+  /// [Float32List], which [WaveformData] keeps without copying.
+  static Float32List applyPostProcessing(List<double> amplitudes, WaveformConfig config) {
+    return WaveformPostProcessor.process(amplitudes, config);
+  }
+
+  /// Apply post-processing to planar per-channel amplitudes in place
+  ///
+  /// Smoothing runs within each channel so it never bleeds across channel
+  /// boundaries. Normalization uses one reference for the whole buffer so the
+  /// relative level of the channels is preserved.
+  static Float32List applyChannelPostProcessing(Float32List channelAmplitudes, int channelCount, WaveformConfig config) {
+    if (channelCount <= 0 || channelAmplitudes.isEmpty) {
+      return channelAmplitudes;
     }
 
-    // Step 3: Normalize if requested
-    if (config.normalize) {
-      processedAmplitudes = WaveformAlgorithms.normalize(processedAmplitudes, method: config.normalizationMethod);
+    return WaveformPostProcessor.process(channelAmplitudes, config, segmentLength: channelAmplitudes.length ~/ channelCount, output: channelAmplitudes);
+  }
+
+  /// Apply post-processing to min/max/RMS bins in place
+  ///
+  /// Smoothing and scaling curves would distort the signed envelope, so only
+  /// the linear steps apply: the bins are divided by their peak absolute value
+  /// when normalizing (RMS shares the same reference so it stays inside the
+  /// envelope) and multiplied by [WaveformConfig.scalingFactor].
+  static WaveformBins applyBinsPostProcessing(WaveformBins bins, WaveformConfig config) {
+    final factor = _binsScaleFactor(bins.peak, config);
+    if (factor != 1.0) {
+      bins.scale(factor);
     }
+    return bins;
+  }
+
+  /// Build the multi-resolution pyramid for [audioData]
+  ///
+  /// The finest level is reduced at [WaveformPyramid.defaultBaseFramesPerBin]
+  /// frames per bin, then post-processed like [applyBinsPostProcessing]. The
+  /// peak of the finest level equals the peak of every coarser level, so one
+  /// factor normalizes all of them.
+  static WaveformPyramid buildPyramid(AudioData audioData, WaveformConfig config) {
+    final channels = math.max(1, audioData.channels);
+    final base = WaveformAlgorithms.downsampleFixedBins(audioData.samples, WaveformPyramid.defaultBaseFramesPerBin, channels: channels);
+    final pyramid = WaveformPyramid.fromBaseLevel(base, sampleRate: audioData.sampleRate, totalFrames: audioData.samples.length ~/ channels);
+    return applyPyramidPostProcessing(pyramid, config);
+  }
 
-    // Step 4: Apply amplitude scaling
-    if (config.scalingCurve != ScalingCurve.linear || config.scalingFactor != 1.0) {
-      processedAmplitudes = WaveformAlgorithms.scaleAmplitudes(processedAmplitudes, scalingCurve: config.scalingCurve, factor: config.scalingFactor);
+  /// Apply post-processing to every level of [pyramid] in place
+  ///
+  /// Same linear steps as [applyBinsPostProcessing], with the peak of the
+  /// finest level as the normalization reference.
+  static WaveformPyramid applyPyramidPostProcessing(WaveformPyramid pyramid, WaveformConfig config) {
+    final factor = _binsScaleFactor(pyramid.levels.first.peak, config);
+    if (factor != 1.0) {
+      pyramid.scale(factor);
     }
+    return pyramid;
+  }
+
+  static double _binsScaleFactor(double peak, WaveformConfig config) {
+    double factor = config.scalingFactor;
+    if (config.normalize && peak > 0.0) {
+      factor /= peak;
+    }
+    return factor;
+  }
+
+  static bool _needsSinglePass(WaveformConfig config) => config.channelMode != WaveformChannelMode.mixed || config.generateBins;
+
+  static Future<WaveformData> _generateWithChannels(AudioData audioData, WaveformConfig config) async {
+    final downsampled = WaveformAlgorithms.downsampleChannels(
+      audioData.samples,
+      config.resolution,
+      algorithm: config.algorithm,
+      channels: audioData.channels,
+      mode: config.channelMode,
+      computeBins: config.generateBins,
+    );
+
+    return _buildWaveformData(
+      downsampled.mixed,
+      duration: audioData.duration,
+      sampleRate: audioData.sampleRate,
+      config: config,
+      channelAmplitudes: downsampled.channelAmplitudes,
+      channelCount: downsampled.channelCount,
+      bins: downsampled.bins,
+      pyramid: config.generatePyramid ? buildPyramid(audioData, config) : null,
+    );
+  }
+
+  static WaveformData _buildWaveformData(
+    List<double> amplitudes, {
+    required Duration duration,
+    required int sampleRate,
+    required WaveformConfig config,
+    Float32List? channelAmplitudes,
+    int channelCount = 0,
+    WaveformBins? bins,
+    WaveformPyramid? pyramid,
+  }) {
+    final processedAmplitudes = applyPostProcessing(amplitudes, config);
+    final hasChannels = channelAmplitudes != null && channelCount > 0;
 
-    // Create metadata
     final metadata = WaveformMetadata(resolution: processedAmplitudes.length, type: config.type, normalized: config.normalize, generatedAt: DateTime.now());
 
-    return WaveformData(amplitudes: processedAmplitudes, duration: audioData.duration, sampleRate: audioData.sampleRate, metadata: metadata);
+    return WaveformData(
+      amplitudes: processedAmplitudes,
+      duration: duration,
+      sampleRate: sampleRate,
+      metadata: metadata,
+      channelAmplitudes: hasChannels ? applyChannelPostProcessing(channelAmplitudes, channelCount, config) : null,
+      channelCount: hasChannels ? channelCount : 0,
+      channelMode: hasChannels ? config.channelMode : WaveformChannelMode.mixed,
+      bins: bins == null ? null : applyBinsPostProcessing(bins, config),
+      pyramid: pyramid,
+    );
   }
 
   /// Generate waveform using chunked processing for memory efficiency
@@ -143,7 +302,12 @@ class WaveformGenerator {
       throw ArgumentError('Audio data cannot be empty');
     }
 
-    _validateConfig(config);
+    validateConfig(config);
+
+    // Per-channel output and min/max/RMS bins need every frame in one pass
+    if (_needsSinglePass(config)) {
+      return _generateWithChannels(audioData, config);
+    }
 
     // Calculate chunk size based on memory constraints.
     // Note: Typed lists (e.g. Float32List) use fewer bytes per element.
@@ -255,27 +419,19 @@ class WaveformGenerator {
     }
 
     // Apply post-processing
-    List<double> processedAmplitudes = allAmplitudes;
-
-    if (config.enableSmoothing) {
-      processedAmplitudes = WaveformAlgorithms.smoothAmplitudes(processedAmplitudes, windowSize: config.smoothingWindowSize);
-    }
-
-    if (config.normalize) {
-      processedAmplitudes = WaveformAlgorithms.normalize(processedAmplitudes, method: config.normalizationMethod);
-    }
-
-    if (config.scalingCurve != ScalingCurve.linear || config.scalingFactor != 1.0) {
-      processedAmplitudes = WaveformAlgorithms.scaleAmplitudes(processedAmplitudes, scalingCurve: config.scalingCurve, factor: config.scalingFactor);
-    }
-
-    final metadata = WaveformMetadata(resolution: processedAmplitudes.length, type: config.type, normalized: config.normalize, generatedAt: DateTime.now());
-
-    return WaveformData(amplitudes: processedAmplitudes, duration: audioData.duration, sampleRate: audioData.sampleRate, metadata: metadata);
+    return _buildWaveformData(
+      allAmplitudes,
+      duration: audioData.duration,
+      sampleRate: audioData.sampleRate,
+      config: config,
+      pyramid: config.generatePyramid ? buildPyramid(audioData, config) : null,
+    );
   }
 
   /// Validate waveform generation configuration
-  static void _validateConfig(WaveformConfig config) {
+  ///
+  /// Throws [ArgumentError] if the configuration cannot be used.
+  static void validateConfig(WaveformConfig config) {
     if (config.resolution <= 0) {
       throw ArgumentError('Resolution must be positive');
     }
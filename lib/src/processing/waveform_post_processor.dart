@@ -0,0 +1,161 @@
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'normalization_method.dart';
+import 'scaling_curve.dart';
+import 'waveform_config.dart';
+
+/// Fused smoothing, normalization and scaling of downsampled amplitudes
+///
+/// Running `WaveformAlgorithms.smoothAmplitudes`, `normalize` and
+/// `scaleAmplitudes` one after another allocates a list per stage, smooths
+/// in O(n·window) and evaluates the curve with a transcendental call per
+/// value. At 100k+ bins that is a visible part of generation. This pipeline
+/// produces the same values in two passes over one [Float32List]:
+///
+/// ```
+/// pass 1: moving average (running sum, O(n))  -> output   + peak / sum of squares
+/// pass 2: × 1/reference -> curve (table) × scalingFactor -> clamp     (in place)
+/// ```
+///
+/// The logarithmic curve is read from a lookup table with linear
+/// interpolation (within 1e-7 of `math.log`); the square and square-root
+/// curves are single instructions and are computed directly.
+///
+/// ## Example Usage
+///
+/// ```dart
+/// final amplitudes = WaveformPostProcessor.process(rawAmplitudes, config);
+/// ```
+class WaveformPostProcessor {
+  WaveformPostProcessor._();
+
+  /// Intervals of the logarithmic curve table over `[0, 1]`
+  static const int _curveTableSize = 8192;
+
+  static final Float64List _logarithmicTable = Float64List.fromList([for (int i = 0; i <= _curveTableSize; i++) _logarithmic(i / _curveTableSize)]);
+
+  /// Smooth, normalize and scale [amplitudes] as configured by [config]
+  ///
+  /// Smoothing restarts every [segmentLength] values (e.g. per channel of a
+  /// planar buffer) so it never bleeds across segments; normalization uses
+  /// one reference for the whole buffer. The result is written to [output],
+  /// which may be [amplitudes] itself, or to a new [Float32List].
+  ///
+  /// Throws [ArgumentError] if [output] does not match the length of [amplitudes].
+  static Float32List process(List<double> amplitudes, WaveformConfig config, {int? segmentLength, Float32List? output}) {
+    final length = amplitudes.length;
+    final out = output ?? Float32List(length);
+    if (out.length != length) {
+      throw ArgumentError.value(out.length, 'output', 'Must hold $length values');
+    }
+    if (length == 0) return out;
+
+    // Pass 1: smoothing (or a copy), gathering the normalization reference
+    final window = config.enableSmoothing ? config.smoothingWindowSize : 1;
+    final segment = segmentLength == null || segmentLength <= 0 ? length : segmentLength;
+    double peak = double.negativeInfinity;
+    double sumSquares = 0.0;
+    if (window >= 3 && window.isOdd) {
+      for (int start = 0; start < length; start += segment) {
+        _smoothSegment(amplitudes, out, start, math.min(start + segment, length), window ~/ 2);
+      }
+      for (int i = 0; i < length; i++) {
+        final value = out[i];
+        if (value > peak) peak = value;
+        sumSquares += value * value;
+      }
+    } else {
+      for (int i = 0; i < length; i++) {
+        final value = amplitudes[i];
+        out[i] = value;
+        if (value > peak) peak = value;
+        sumSquares += value * value;
+      }
+    }
+
+    double normalization = 1.0;
+    if (config.normalize) {
+      final reference = config.normalizationMethod == NormalizationMethod.peak ? peak : math.sqrt(sumSquares / length);
+      if (reference == 0.0) {
+        return out..fillRange(0, length, 0.0);
+      }
+      normalization = 1.0 / reference;
+    }
+
+    // Pass 2: normalization, curve, factor and clamp in place
+    final curve = config.scalingCurve;
+    final factor = config.scalingFactor;
+    if (curve == ScalingCurve.linear && factor == 1.0) {
+      if (normalization != 1.0) {
+        for (int i = 0; i < length; i++) {
+          out[i] *= normalization;
+        }
+      }
+      return out;
+    }
+
+    for (int i = 0; i < length; i++) {
+      final value = out[i] * normalization;
+      double scaled;
+      switch (curve) {
+        case ScalingCurve.linear:
+          scaled = value;
+          break;
+        case ScalingCurve.logarithmic:
+          scaled = value > 0 ? _logarithmicCurve(value) : 0.0;
+          break;
+        case ScalingCurve.exponential:
+          scaled = value * value;
+          break;
+        case ScalingCurve.sqrt:
+          scaled = math.sqrt(value);
+          break;
+      }
+      out[i] = math.max(0.0, math.min(1.0, scaled * factor));
+    }
+    return out;
+  }
+
+  /// Centered moving average of `[start, end)`, shrinking at the edges
+  ///
+  /// Keeps the last `halfWindow + 1` input values in a ring, so [to] may be
+  /// [from] itself.
+  static void _smoothSegment(List<double> from, Float32List to, int start, int end, int halfWindow) {
+    final ring = Float64List(halfWindow + 1);
+    double sum = 0.0;
+    int count = 0;
+    for (int j = start; j < math.min(end, start + halfWindow + 1); j++) {
+      sum += from[j];
+      count++;
+    }
+
+    for (int i = start; i < end; i++) {
+      ring[(i - start) % ring.length] = from[i];
+      to[i] = sum / count;
+
+      final entering = i + halfWindow + 1;
+      if (entering < end) {
+        sum += from[entering];
+        count++;
+      }
+      final leaving = i - halfWindow;
+      if (leaving >= start) {
+        sum -= ring[(leaving - start) % ring.length];
+        count--;
+      }
+    }
+  }
+
+  static double _logarithmicCurve(double value) {
+    if (value >= 1.0) return _logarithmic(value);
+    final position = value * _curveTableSize;
+    final index = position.floor();
+    final fraction = position - index;
+    final table = _logarithmicTable;
+    return table[index] + (table[index + 1] - table[index]) * fraction;
+  }
+
+  /// Curve of `ScalingCurve.logarithmic`, as in `WaveformAlgorithms.scaleAmplitudes`
+  static double _logarithmic(double value) => value > 0 ? math.log(1 + value * 9) / math.ln10 : 0.0;
+}
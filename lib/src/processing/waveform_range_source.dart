@@ -0,0 +1,283 @@
+import 'dart:async';
+import 'dart:ffi' as ffi;
+import 'dart:isolate';
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:sonix/src/models/audio_data.dart';
+import 'package:sonix/src/models/mapped_audio_data.dart';
+import 'package:sonix/src/models/waveform_bins.dart';
+import 'package:sonix/src/models/waveform_data.dart';
+import 'package:sonix/src/native/native_audio_bindings.dart';
+import 'waveform_algorithms.dart';
+
+/// Min/max/RMS bins of any frame range of a recording, on demand
+///
+/// A viewport that shows a few seconds of a three-hour timeline only needs
+/// the bins under the screen. A range source serves exactly those, at the
+/// bin size the current zoom level asks for, so nothing has to be computed
+/// or painted for the rest of the recording.
+///
+/// - [WaveformDataRangeSource] slices an already generated [WaveformData],
+///   using its pyramid when it has one
+/// - [AudioRangeSource] reduces decoded audio on demand, reading only the
+///   requested frames (e.g. through a memory-mapped scratch file)
+///
+/// ## Example Usage
+///
+/// ```dart
+/// final source = WaveformDataRangeSource(waveformData);
+/// // 256 bins of 512 frames each, starting one minute in
+/// final bins = await source.loadBins(60 * source.sampleRate, 512, 256);
+/// ```
+abstract class WaveformRangeSource {
+  /// Total number of audio frames covered by the source
+  int get totalFrames;
+
+  /// Sample rate of the source audio in Hz
+  int get sampleRate;
+
+  /// Bins `[0, binCount)` of [framesPerBin] frames each, starting at [startFrame]
+  ///
+  /// [startFrame] must not be negative. Always returns [binCount] bins;
+  /// bins past [totalFrames] are silent. Sources that can answer
+  /// immediately return the bins synchronously.
+  FutureOr<WaveformBins> loadBins(int startFrame, int framesPerBin, int binCount);
+}
+
+/// [WaveformRangeSource] over the amplitudes, bins or pyramid of a [WaveformData]
+///
+/// Slices come from the coarsest pyramid level that still has the requested
+/// detail when the waveform carries a pyramid, from its signed bins
+/// otherwise, and from its amplitudes (as a symmetric envelope) as a last
+/// resort. Zooming in past the detail of the waveform repeats its bins.
+class WaveformDataRangeSource implements WaveformRangeSource {
+  /// The sliced waveform
+  final WaveformData waveformData;
+
+  @override
+  final int totalFrames;
+
+  /// Symmetric envelope built from the amplitudes, when there are no bins
+  WaveformBins? _amplitudeBins;
+
+  /// Creates a source over [waveformData]
+  ///
+  /// Waveforms without a known length (zero duration) are treated as one
+  /// frame per amplitude.
+  WaveformDataRangeSource(this.waveformData) : totalFrames = _frameCountOf(waveformData);
+
+  @override
+  int get sampleRate => waveformData.sampleRate;
+
+  @override
+  WaveformBins loadBins(int startFrame, int framesPerBin, int binCount) {
+    final pyramid = waveformData.pyramid;
+    if (pyramid != null) {
+      final level = pyramid.levelForSpan(framesPerBin * binCount, binCount);
+      return resampleBins(pyramid.levels[level], pyramid.framesPerBin(level).toDouble(), startFrame, framesPerBin, binCount, totalFrames);
+    }
+
+    final bins = waveformData.bins ?? (_amplitudeBins ??= _symmetricBins(waveformData.amplitudes));
+    if (bins.isEmpty) return WaveformBins.allocate(binCount);
+    return resampleBins(bins, totalFrames / bins.length, startFrame, framesPerBin, binCount, totalFrames);
+  }
+
+  /// Merges the [source] bins under each output bin into [binCount] bins
+  ///
+  /// [sourceFramesPerBin] is the number of frames one [source] bin covers.
+  /// Output bins take the smallest minimum, the largest maximum and the RMS
+  /// of the RMS values of every source bin they overlap.
+  static WaveformBins resampleBins(WaveformBins source, double sourceFramesPerBin, int startFrame, int framesPerBin, int binCount, int totalFrames) {
+    final result = WaveformBins.allocate(binCount);
+    final sourceLength = source.length;
+    if (sourceLength == 0 || sourceFramesPerBin <= 0) return result;
+
+    final from = source.data;
+    final to = result.data;
+    for (int bin = 0; bin < binCount; bin++) {
+      final start = startFrame + bin * framesPerBin;
+      if (start >= totalFrames) break;
+      final end = math.min(start + framesPerBin, totalFrames);
+
+      final first = math.min((start / sourceFramesPerBin).floor(), sourceLength - 1);
+      final last = math.max(first + 1, math.min((end / sourceFramesPerBin).ceil(), sourceLength));
+
+      double binMin = double.infinity;
+      double binMax = double.negativeInfinity;
+      double sumSquares = 0.0;
+      for (int i = first; i < last; i++) {
+        final min = from[i];
+        final max = from[sourceLength + i];
+        final rms = from[2 * sourceLength + i];
+        if (min < binMin) binMin = min;
+        if (max > binMax) binMax = max;
+        sumSquares += rms * rms;
+      }
+
+      to[bin] = binMin;
+      to[binCount + bin] = binMax;
+      to[2 * binCount + bin] = math.sqrt(sumSquares / (last - first));
+    }
+    return result;
+  }
+
+  static int _frameCountOf(WaveformData waveformData) {
+    final pyramid = waveformData.pyramid;
+    if (pyramid != null) return pyramid.totalFrames;
+
+    final frames = waveformData.duration.inMicroseconds * waveformData.sampleRate ~/ Duration.microsecondsPerSecond;
+    return frames > 0 ? frames : waveformData.amplitudes.length;
+  }
+
+  /// Envelope from `-amplitude` to `+amplitude` with the amplitude as RMS
+  static WaveformBins _symmetricBins(List<double> amplitudes) {
+    final length = amplitudes.length;
+    final bins = WaveformBins.allocate(length);
+    final data = bins.data;
+    for (int i = 0; i < length; i++) {
+      final amplitude = amplitudes[i];
+      data[i] = -amplitude;
+      data[length + i] = amplitude;
+      data[2 * length + i] = amplitude;
+    }
+    return bins;
+  }
+
+  @override
+  bool operator ==(Object other) => other is WaveformDataRangeSource && identical(other.waveformData, waveformData);
+
+  @override
+  int get hashCode => identityHashCode(waveformData);
+}
+
+/// [WaveformRangeSource] reducing decoded audio on demand
+///
+/// Only the frames of a requested range are read, through [readFrames], and
+/// reduced to min/max/RMS bins of the channel mix. Pair it with
+/// [MappedAudioData] (see [AudioRangeSource.fromAudioData]) so a three-hour
+/// recording is paged in tile by tile, or with any other decoder that can
+/// produce a frame range.
+///
+/// Loads of up to [maxInlineFrames] frames are reduced on the calling
+/// isolate. Zoomed-out tiles span far more, so those are reduced on a
+/// background isolate and the UI keeps running: straight from native memory
+/// when the samples are native (decoded or memory-mapped audio, see
+/// [NativeAudioBindings.nativeSamplesOf]), otherwise from a copy of what
+/// [readFrames] returned. Every zoomed-out tile still reads all of its
+/// frames; for overviews that are shown often prefer a
+/// [WaveformDataRangeSource] over a waveform with a pyramid.
+class AudioRangeSource implements WaveformRangeSource {
+  /// Most frames a load reduces on the calling isolate
+  static const int maxInlineFrames = 1 << 16;
+
+  @override
+  final int totalFrames;
+
+  @override
+  final int sampleRate;
+
+  /// Number of interleaved channels returned by [readFrames]
+  final int channels;
+
+  /// Returns the interleaved samples of frames `[startFrame, endFrame)`
+  final FutureOr<List<double>> Function(int startFrame, int endFrame) readFrames;
+
+  /// Address of native interleaved samples of every frame, or 0
+  final int _samplesAddress;
+
+  /// Owner of the memory at [_samplesAddress], which frees it when collected
+  final ffi.Finalizable? _samplesOwner;
+
+  AudioRangeSource({required int totalFrames, required int sampleRate, required int channels, required FutureOr<List<double>> Function(int, int) readFrames})
+    : this._(totalFrames: totalFrames, sampleRate: sampleRate, channels: channels, readFrames: readFrames);
+
+  AudioRangeSource._({
+    required this.totalFrames,
+    required this.sampleRate,
+    required this.channels,
+    required this.readFrames,
+    int samplesAddress = 0,
+    ffi.Finalizable? samplesOwner,
+  }) : _samplesAddress = samplesAddress,
+       _samplesOwner = samplesOwner {
+    if (channels <= 0) {
+      throw ArgumentError.value(channels, 'channels', 'Must be positive');
+    }
+  }
+
+  /// Creates a source reading frame ranges of [audioData] without copying
+  ///
+  /// [audioData] must not be disposed while the source is used, including
+  /// while a load is still running on a background isolate. The source and
+  /// its running loads keep it from being garbage collected.
+  factory AudioRangeSource.fromAudioData(AudioData audioData) {
+    final channels = audioData.channels;
+    final samples = audioData.samples;
+    // Native samples are only read in the background while their owner can be held
+    final owner = audioData is ffi.Finalizable ? audioData as ffi.Finalizable : null;
+    return AudioRangeSource._(
+      totalFrames: channels > 0 ? samples.length ~/ channels : 0,
+      sampleRate: audioData.sampleRate,
+      channels: channels,
+      readFrames: (startFrame, endFrame) {
+        if (audioData is MappedAudioData) {
+          return audioData.frameRange(startFrame, endFrame);
+        }
+        if (samples is Float32List) {
+          return Float32List.sublistView(samples, startFrame * channels, endFrame * channels);
+        }
+        return samples.sublist(startFrame * channels, endFrame * channels);
+      },
+      samplesAddress: owner == null ? 0 : NativeAudioBindings.nativeSamplesOf(samples)?.address ?? 0,
+      samplesOwner: owner,
+    );
+  }
+
+  @override
+  Future<WaveformBins> loadBins(int startFrame, int framesPerBin, int binCount) async {
+    RangeError.checkNotNegative(startFrame, 'startFrame');
+    final end = math.min(startFrame + framesPerBin * binCount, totalFrames);
+    if (startFrame >= end) return WaveformBins.allocate(binCount);
+
+    final owner = _samplesOwner;
+    if (end - startFrame > maxInlineFrames && _samplesAddress != 0 && owner != null) {
+      return _holding(owner, _reduceNative(_samplesAddress, totalFrames * channels, channels, startFrame, end, framesPerBin, binCount));
+    }
+
+    final samples = await readFrames(startFrame, end);
+    if (end - startFrame > maxInlineFrames) {
+      return _reduceInBackground(samples, channels, framesPerBin, binCount);
+    }
+    return _reduce(samples, channels, framesPerBin, binCount);
+  }
+
+  /// Awaits [reduction] while keeping [owner] reachable
+  ///
+  /// Finalizable parameters stay alive until the end of their scope, so the
+  /// native samples cannot be freed while the background isolate reads them
+  /// even if the source and the audio are dropped meanwhile.
+  static Future<WaveformBins> _holding(ffi.Finalizable owner, Future<WaveformBins> reduction) async {
+    return await reduction;
+  }
+
+  // Static so the isolate closures capture nothing but their arguments
+
+  static Future<WaveformBins> _reduceNative(int address, int sampleCount, int channels, int startFrame, int endFrame, int framesPerBin, int binCount) {
+    return Isolate.run(() {
+      final samples = ffi.Pointer<ffi.Float>.fromAddress(address).asTypedList(sampleCount);
+      return _reduce(Float32List.sublistView(samples, startFrame * channels, endFrame * channels), channels, framesPerBin, binCount);
+    });
+  }
+
+  static Future<WaveformBins> _reduceInBackground(List<double> samples, int channels, int framesPerBin, int binCount) {
+    return Isolate.run(() => _reduce(samples, channels, framesPerBin, binCount));
+  }
+
+  static WaveformBins _reduce(List<double> samples, int channels, int framesPerBin, int binCount) {
+    final bins = WaveformBins.allocate(binCount);
+    final frames = samples.length ~/ channels;
+    WaveformAlgorithms.downsampleFixedBinsRange(samples, framesPerBin, 0, math.min(WaveformAlgorithms.fixedBinCount(frames, framesPerBin), binCount), channels: channels, bins: bins);
+    return bins;
+  }
+}
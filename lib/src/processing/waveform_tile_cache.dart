@@ -0,0 +1,138 @@
+import 'package:sonix/src/models/waveform_bins.dart';
+import 'waveform_range_source.dart';
+
+/// Fixed-size tiles of bins loaded from a [WaveformRangeSource]
+///
+/// A scrolling viewport asks for the tiles under the screen at the bin size
+/// of the current zoom level. Tiles are [tileBins] bins long and keyed by
+/// `(framesPerBin, index)`, so scrolling reuses every tile that stays on
+/// screen and zooming back returns to tiles already loaded:
+///
+/// ```
+/// frames:  |  tile 0  |  tile 1  |  tile 2  |  tile 3  |  ...
+///                  [ viewport ]                               visible: 0, 1
+///                                                             prefetch: 2
+/// ```
+///
+/// Loads are started on first request and deduplicated while in flight;
+/// [onTileLoaded] is called when an asynchronous load completes. The
+/// [maxTiles] most recently used tiles are kept.
+///
+/// ## Example Usage
+///
+/// ```dart
+/// final cache = WaveformTileCache(WaveformDataRangeSource(waveformData), onTileLoaded: repaint);
+/// final bins = cache.tile(512, 3); // null until loaded
+/// cache.prefetch(512, 4);
+/// ```
+class WaveformTileCache {
+  /// Default number of bins per tile
+  static const int defaultTileBins = 256;
+
+  /// Default number of tiles kept
+  static const int defaultMaxTiles = 64;
+
+  /// Source the tiles are loaded from
+  final WaveformRangeSource source;
+
+  /// Number of bins per tile
+  final int tileBins;
+
+  /// Number of tiles kept before the least recently used one is dropped
+  final int maxTiles;
+
+  /// Called after a tile finished loading asynchronously
+  void Function()? onTileLoaded;
+
+  // Insertion-ordered; lookups move hits to the end
+  final Map<(int, int), WaveformBins> _tiles = {};
+  final Set<(int, int)> _pending = {};
+
+  /// Bumped by [clear] so loads started before it are discarded
+  int _generation = 0;
+
+  WaveformTileCache(this.source, {this.tileBins = defaultTileBins, this.maxTiles = defaultMaxTiles, this.onTileLoaded}) {
+    if (tileBins <= 0 || maxTiles <= 0) {
+      throw ArgumentError('Tile bins ($tileBins) and max tiles ($maxTiles) must be positive');
+    }
+  }
+
+  /// Number of tiles currently held
+  int get length => _tiles.length;
+
+  /// Number of frames covered by one tile of [framesPerBin] frames per bin
+  int tileFrames(int framesPerBin) => framesPerBin * tileBins;
+
+  /// Number of tiles needed to cover the source at [framesPerBin]
+  int tileCount(int framesPerBin) {
+    final frames = tileFrames(framesPerBin);
+    return (source.totalFrames + frames - 1) ~/ frames;
+  }
+
+  /// Whether tile [index] at [framesPerBin] is loaded
+  bool contains(int framesPerBin, int index) => _tiles.containsKey((framesPerBin, index));
+
+  /// Tile [index] at [framesPerBin], or null while it is loading
+  ///
+  /// Starts loading the tile if it is neither held nor in flight. Indices
+  /// outside `[0, tileCount)` return null.
+  WaveformBins? tile(int framesPerBin, int index) {
+    final key = (framesPerBin, index);
+    final cached = _tiles.remove(key);
+    if (cached != null) {
+      _tiles[key] = cached;
+      return cached;
+    }
+    return _load(framesPerBin, index);
+  }
+
+  /// Starts loading tile [index] at [framesPerBin] without touching its recency
+  void prefetch(int framesPerBin, int index) {
+    if (!_tiles.containsKey((framesPerBin, index))) {
+      _load(framesPerBin, index);
+    }
+  }
+
+  /// Drops every tile and discards loads in flight
+  void clear() {
+    _tiles.clear();
+    _pending.clear();
+    _generation++;
+  }
+
+  WaveformBins? _load(int framesPerBin, int index) {
+    final key = (framesPerBin, index);
+    if (framesPerBin <= 0 || index < 0 || index >= tileCount(framesPerBin) || _pending.contains(key)) {
+      return null;
+    }
+
+    final result = source.loadBins(index * tileFrames(framesPerBin), framesPerBin, tileBins);
+    if (result is WaveformBins) {
+      _store(key, result);
+      return result;
+    }
+
+    _pending.add(key);
+    final generation = _generation;
+    result.then(
+      (bins) {
+        if (generation != _generation) return;
+        _pending.remove(key);
+        _store(key, bins);
+        onTileLoaded?.call();
+      },
+      onError: (Object _) {
+        // Left unloaded; the next request retries
+        if (generation == _generation) _pending.remove(key);
+      },
+    );
+    return null;
+  }
+
+  void _store((int, int) key, WaveformBins bins) {
+    if (_tiles.length >= maxTiles) {
+      _tiles.remove(_tiles.keys.first);
+    }
+    _tiles[key] = bins;
+  }
+}
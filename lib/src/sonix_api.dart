@@ -5,15 +5,21 @@
 library;
 
 import 'dart:async';
+import 'dart:io';
 
 import 'config/sonix_config.dart';
+import 'isolate/adaptive_concurrency_controller.dart';
 import 'isolate/isolate_runner.dart';
+import 'isolate/isolate_worker_pool.dart';
+import 'isolate/waveform_scheduler.dart';
 import 'models/waveform_data.dart';
+import 'models/waveform_priority.dart';
 import 'models/waveform_type.dart';
 import 'processing/waveform_generator.dart';
 import 'processing/waveform_config.dart';
 import 'processing/waveform_use_case.dart';
 import 'processing/audio_file_processor.dart';
+import 'processing/waveform_cache.dart';
 import 'decoders/audio_format_service.dart';
 import 'exceptions/sonix_exceptions.dart';
 import 'native/native_audio_bindings.dart';
@@ -29,6 +35,13 @@ import 'utils/sonix_logger.dart';
 /// - [generateWaveformInIsolate]: Processes audio in a background isolate to prevent
 ///   UI thread blocking. Best for large files or Flutter applications where
 ///   UI responsiveness is important.
+///
+/// Background work runs on a pool of persistent worker isolates owned by the
+/// instance (see [SonixConfig.workerPoolSize]); call [dispose] to shut it down.
+/// Identical concurrent background requests share one decode, and requests
+/// are started in [WaveformPriority] order. Repeat requests for an unchanged
+/// file and config are answered from a [WaveformCache] in memory and, with
+/// [SonixConfig.waveformCacheDirectory], on disk.
 class Sonix {
   /// Configuration for this Sonix instance
   final SonixConfig config;
@@ -36,6 +49,15 @@ class Sonix {
   /// Whether this instance has been disposed
   bool _isDisposed = false;
 
+  /// Worker pool for isolate processing, started on first use
+  IsolateWorkerPool? _workerPool;
+
+  /// Deduplicating priority scheduler in front of the background isolates
+  WaveformScheduler? _scheduler;
+
+  /// Cache of generated waveforms, created on first use
+  WaveformCache? _cache;
+
   /// Create a new Sonix instance with the specified configuration
   ///
   /// [config] - Configuration options for this instance. If not provided,
@@ -72,14 +94,22 @@ class Sonix {
   ///
   /// **Warning**: This method will block the calling thread during processing.
   /// For Flutter apps, use [generateWaveformInIsolate] to keep the UI responsive.
+  /// Where isolates are not an option, pass a [sliceBudget]: the reduction
+  /// then yields to the event loop every [sliceBudget] (see
+  /// `CooperativeWaveformGenerator`) and [onPartial] receives snapshots of the
+  /// waveform as it fills in. Decoding itself is not sliced.
   ///
   /// [filePath] - Path to the audio file
   /// [resolution] - Number of data points in the waveform (default: 1000)
   /// [type] - Type of waveform visualization (default: bars)
   /// [normalize] - Whether to normalize amplitude values (default: true)
   /// [config] - Advanced configuration options (optional)
+  /// [sliceBudget] - Longest uninterrupted reduction, e.g. 4ms (optional)
+  /// [onPartial] - Receives partial waveforms while a [sliceBudget] reduction runs
   ///
-  /// Returns [WaveformData] containing amplitude values and metadata
+  /// Returns [WaveformData] containing amplitude values and metadata. Repeat
+  /// requests for the same unchanged file and config are served from the
+  /// waveform cache without decoding (and without [onPartial] snapshots).
   ///
   /// Throws [StateError] if this instance has been disposed
   /// Throws [UnsupportedFormatException] if the audio format is not supported
@@ -97,6 +127,8 @@ class Sonix {
     WaveformType type = WaveformType.bars,
     bool normalize = true,
     WaveformConfig? config,
+    Duration? sliceBudget,
+    void Function(WaveformData partial)? onPartial,
   }) async {
     _ensureNotDisposed();
 
@@ -112,11 +144,11 @@ class Sonix {
     // Create waveform configuration
     final waveformConfig = config ?? WaveformConfig(resolution: resolution, type: type, normalize: normalize);
 
-    // Use AudioFileProcessor to handle decoding (automatically handles large files)
-    final processor = AudioFileProcessor();
-    final audioData = await processor.process(filePath);
-    final waveformData = await WaveformGenerator.generateInMemory(audioData, config: waveformConfig);
-    return waveformData;
+    // Use AudioFileProcessor to handle decoding (streams large files into the waveform)
+    final processor = AudioFileProcessor(scratchBudget: this.config.maxMemoryUsage);
+    Future<WaveformData> generate() => processor.generateWaveform(filePath, config: waveformConfig, sliceBudget: sliceBudget, onPartial: onPartial);
+    final cache = _ensureCache();
+    return cache == null ? generate() : cache.getOrGenerate(filePath, waveformConfig, generate);
   }
 
   /// Generate waveform data from an audio file in a background isolate
@@ -130,8 +162,11 @@ class Sonix {
   /// [type] - Type of waveform visualization (default: bars)
   /// [normalize] - Whether to normalize amplitude values (default: true)
   /// [config] - Advanced configuration options (optional)
+  /// [priority] - Scheduling priority relative to other background requests
   ///
-  /// Returns [WaveformData] containing amplitude values and metadata
+  /// Returns [WaveformData] containing amplitude values and metadata. Concurrent
+  /// requests for the same unchanged file and config share one result, and
+  /// repeat requests are served from the waveform cache without decoding.
   ///
   /// Throws [StateError] if this instance has been disposed
   /// Throws [UnsupportedFormatException] if the audio format is not supported
@@ -142,6 +177,9 @@ class Sonix {
   /// ```dart
   /// final sonix = Sonix();
   /// final waveformData = await sonix.generateWaveformInIsolate('audio.mp3');
+  ///
+  /// // Waveform of a list item that is on screen
+  /// final visible = await sonix.generateWaveformInIsolate('track.mp3', priority: WaveformPriority.visible);
   /// ```
   Future<WaveformData> generateWaveformInIsolate(
     String filePath, {
@@ -149,6 +187,7 @@ class Sonix {
     WaveformType type = WaveformType.bars,
     bool normalize = true,
     WaveformConfig? config,
+    WaveformPriority priority = WaveformPriority.normal,
   }) async {
     _ensureNotDisposed();
 
@@ -165,13 +204,68 @@ class Sonix {
     final waveformConfig = config ?? WaveformConfig(resolution: resolution, type: type, normalize: normalize);
 
     // Run in a background isolate
-    const runner = IsolateRunner();
-    return runner.run(filePath, waveformConfig);
+    Future<WaveformData> generate() async => (await _ensureScheduler().schedule(filePath, [waveformConfig], priority: priority)).single;
+    final cache = _ensureCache();
+    return cache == null ? generate() : cache.getOrGenerate(filePath, waveformConfig, generate);
+  }
+
+  /// Generate several waveforms from one audio file with a single decode
+  ///
+  /// Decoding dominates the cost of waveform generation. When an app needs
+  /// multiple waveforms of the same file (for example a low-resolution
+  /// overview and a high-resolution detail view, or RMS and peak variants),
+  /// this method decodes the file once in a background isolate and runs
+  /// every configuration over the same decoded frames.
+  ///
+  /// [filePath] - Path to the audio file
+  /// [configs] - One configuration per waveform to generate
+  /// [priority] - Scheduling priority relative to other background requests
+  ///
+  /// Returns one [WaveformData] per config, in the same order as [configs]
+  ///
+  /// Throws [StateError] if this instance has been disposed
+  /// Throws [ArgumentError] if [configs] is empty
+  /// Throws [UnsupportedFormatException] if the audio format is not supported
+  /// Throws [DecodingException] if audio decoding fails
+  /// Throws [FileSystemException] if the file cannot be accessed
+  ///
+  /// Example:
+  /// ```dart
+  /// final sonix = Sonix();
+  /// final waveforms = await sonix.generateWaveforms('audio.mp3', [
+  ///   const WaveformConfig(resolution: 200),
+  ///   const WaveformConfig(resolution: 4000, algorithm: DownsamplingAlgorithm.peak),
+  /// ]);
+  /// ```
+  Future<List<WaveformData>> generateWaveforms(
+    String filePath,
+    List<WaveformConfig> configs, {
+    WaveformPriority priority = WaveformPriority.normal,
+  }) async {
+    _ensureNotDisposed();
+
+    if (configs.isEmpty) {
+      throw ArgumentError('At least one waveform configuration is required');
+    }
+
+    // Validate file format
+    if (!AudioFormatService.isFileSupported(filePath)) {
+      final extension = _getFileExtension(filePath);
+      throw UnsupportedFormatException(
+        extension,
+        'Unsupported audio format: $extension. Supported formats: ${AudioFormatService.getSupportedFormatNames().join(', ')}',
+      );
+    }
+
+    return _ensureScheduler().schedule(filePath, configs, priority: priority);
   }
 
   /// Dispose of this Sonix instance
   ///
   /// After calling dispose, this instance cannot be used for any operations.
+  /// Waveforms still being generated in the background complete normally;
+  /// the worker isolates exit once they are done. The memory tier of the
+  /// waveform cache is released; its disk entries are kept.
   ///
   /// Example:
   /// ```dart
@@ -181,6 +275,12 @@ class Sonix {
   /// ```
   void dispose() {
     _isDisposed = true;
+    _scheduler?.close();
+    _scheduler = null;
+    _workerPool?.close();
+    _workerPool = null;
+    _cache?.dispose();
+    _cache = null;
   }
 
   /// Check if this instance has been disposed
@@ -193,6 +293,41 @@ class Sonix {
     }
   }
 
+  /// Returns the scheduler, creating it and the worker pool on first use
+  ///
+  /// Without a pool ([SonixConfig.workerPoolSize] is 0) every job spawns its
+  /// own isolate and the number of concurrent jobs is not limited.
+  WaveformScheduler _ensureScheduler() {
+    final scheduler = _scheduler;
+    if (scheduler != null) return scheduler;
+
+    if (config.workerPoolSize == 0) {
+      final runner = IsolateRunner(scratchBudget: config.maxMemoryUsage);
+      return _scheduler = WaveformScheduler(runner.runMany);
+    }
+    final pool = _workerPool = IsolateWorkerPool(size: config.workerPoolSize, scratchBudget: config.maxMemoryUsage);
+    final controller = config.adaptiveConcurrency
+        ? AdaptiveConcurrencyController(maxConcurrency: pool.size, memoryBudget: config.maxMemoryUsage)
+        : null;
+    return _scheduler = WaveformScheduler(pool.runMany, maxConcurrent: pool.size, controller: controller);
+  }
+
+  /// Returns the waveform cache, or null if both of its tiers are disabled
+  WaveformCache? _ensureCache() {
+    final cache = _cache;
+    if (cache != null) return cache;
+
+    final directory = config.waveformCacheDirectory;
+    if (config.waveformCacheSize == 0 && (directory == null || config.waveformDiskCacheSize == 0)) {
+      return null;
+    }
+    return _cache = WaveformCache(
+      memoryBudget: config.waveformCacheSize,
+      directory: directory == null ? null : Directory(directory),
+      diskBudget: config.waveformDiskCacheSize,
+    );
+  }
+
   /// Extract file extension from a file path
   String _getFileExtension(String filePath) {
     final lastDot = filePath.lastIndexOf('.');
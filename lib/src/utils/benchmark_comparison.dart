@@ -0,0 +1,90 @@
+/// One measure of one scenario compared against a baseline run
+class BenchmarkDelta {
+  /// Scenario key, as in `BenchmarkResult.results`
+  final String scenario;
+
+  /// What was compared: `median_time_ms` or a metric name
+  final String measure;
+
+  /// Value in the baseline run
+  final double baseline;
+
+  /// Value in the current run
+  final double current;
+
+  const BenchmarkDelta({required this.scenario, required this.measure, required this.baseline, required this.current});
+
+  /// Relative change from [baseline] to [current] (0.25 = 25% larger)
+  double get change {
+    if (baseline == 0) return current == 0 ? 0 : double.infinity;
+    return (current - baseline) / baseline.abs();
+  }
+
+  Map<String, dynamic> toJson() => {'scenario': scenario, 'measure': measure, 'baseline': baseline, 'current': current, 'change': change};
+
+  @override
+  String toString() {
+    final sign = change >= 0 ? '+' : '';
+    return '$scenario $measure: ${baseline.toStringAsFixed(2)} -> ${current.toStringAsFixed(2)} ($sign${(change * 100).toStringAsFixed(1)}%)';
+  }
+}
+
+/// Outcome of comparing a benchmark run against a baseline run
+///
+/// Produced by `BenchmarkResult.compareWith`. Only [regressions] should fail
+/// a run: scenarios that were added or removed since the baseline are listed
+/// so the baseline can be refreshed, not treated as slower.
+class BenchmarkComparison {
+  /// Relative change beyond which a measure counts (0.1 = 10%)
+  final double threshold;
+
+  /// Measures that got worse by more than [threshold]
+  final List<BenchmarkDelta> regressions;
+
+  /// Measures that got better by more than [threshold]
+  final List<BenchmarkDelta> improvements;
+
+  /// Scenarios of the current run that the baseline does not have
+  final List<String> addedScenarios;
+
+  /// Scenarios of the baseline that the current run did not run
+  final List<String> missingScenarios;
+
+  const BenchmarkComparison({
+    required this.threshold,
+    required this.regressions,
+    required this.improvements,
+    required this.addedScenarios,
+    required this.missingScenarios,
+  });
+
+  /// Whether any measure regressed beyond [threshold]
+  bool get hasRegressions => regressions.isNotEmpty;
+
+  Map<String, dynamic> toJson() {
+    return {
+      'threshold': threshold,
+      'regressions': regressions.map((d) => d.toJson()).toList(),
+      'improvements': improvements.map((d) => d.toJson()).toList(),
+      'added_scenarios': addedScenarios,
+      'missing_scenarios': missingScenarios,
+    };
+  }
+
+  @override
+  String toString() {
+    final buffer = StringBuffer();
+    buffer.writeln('=== Baseline comparison (threshold ${(threshold * 100).toStringAsFixed(0)}%) ===');
+    buffer.writeln('Regressions: ${regressions.length}');
+    for (final delta in regressions) {
+      buffer.writeln('  $delta');
+    }
+    buffer.writeln('Improvements: ${improvements.length}');
+    for (final delta in improvements) {
+      buffer.writeln('  $delta');
+    }
+    if (addedScenarios.isNotEmpty) buffer.writeln('Not in baseline: ${addedScenarios.join(', ')}');
+    if (missingScenarios.isNotEmpty) buffer.writeln('Not run: ${missingScenarios.join(', ')}');
+    return buffer.toString();
+  }
+}
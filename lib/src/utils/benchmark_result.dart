@@ -1,23 +1,141 @@
 import 'dart:math' as math;
 
+import 'benchmark_comparison.dart';
+
 /// Result from a benchmark test
 ///
 /// Contains comprehensive benchmark results including timing data for
 /// multiple test scenarios and statistical analysis of performance.
+///
+/// Results serialize to JSON with [toJson] so a run can be stored as the
+/// baseline of later runs; [compareWith] reports the scenarios that got
+/// slower (or heavier) than that baseline beyond a threshold.
 class BenchmarkResult {
+  /// Audio seconds processed per wall-clock second (higher is better)
+  static const String throughputMetric = 'audio_seconds_per_second';
+
+  /// Process resident set size high-water mark after the scenario, in bytes
+  static const String peakRssMetric = 'peak_rss_bytes';
+
+  /// Largest resident set growth over one iteration, in bytes
+  ///
+  /// Depends on when the garbage collector last ran, so it is reported but
+  /// not compared against baselines.
+  static const String allocatedMetric = 'allocated_bytes';
+
+  /// Metrics for which a larger value is an improvement
+  static const Set<String> higherIsBetter = {throughputMetric};
+
+  /// Metrics [compareWith] ignores
+  static const Set<String> informational = {allocatedMetric};
+
   /// Name of the benchmark test
   final String testName;
 
   /// Map of test scenarios to their timing results (in milliseconds)
   final Map<String, List<double>> results;
 
+  /// Map of test scenarios to further measurements, keyed by metric name
+  /// (for example [throughputMetric] or [peakRssMetric])
+  final Map<String, Map<String, double>> metrics;
+
   /// Number of iterations performed per test
   final int iterations;
 
   /// When the benchmark was completed
   final DateTime completedAt;
 
-  const BenchmarkResult({required this.testName, required this.results, required this.iterations, required this.completedAt});
+  const BenchmarkResult({required this.testName, required this.results, this.metrics = const {}, required this.iterations, required this.completedAt});
+
+  /// Restores a result written by [toJson]
+  ///
+  /// **Throws:** [FormatException] if [json] is not a serialized result.
+  factory BenchmarkResult.fromJson(Map<String, dynamic> json) {
+    try {
+      final scenarios = (json['scenarios'] as Map<String, dynamic>).cast<String, Map<String, dynamic>>();
+      return BenchmarkResult(
+        testName: json['test_name'] as String,
+        results: {for (final entry in scenarios.entries) entry.key: (entry.value['times_ms'] as List).map((v) => (v as num).toDouble()).toList()},
+        metrics: {
+          for (final entry in scenarios.entries)
+            entry.key: (entry.value['metrics'] as Map<String, dynamic>? ?? const {}).map((name, value) => MapEntry(name, (value as num).toDouble())),
+        },
+        iterations: json['iterations'] as int,
+        completedAt: DateTime.parse(json['completed_at'] as String),
+      );
+    } on TypeError catch (e) {
+      throw FormatException('Not a serialized benchmark result: $e');
+    }
+  }
+
+  /// Median time of [scenario] in milliseconds, or null if it was not run
+  double? medianTime(String scenario) {
+    final values = results[scenario];
+    if (values == null || values.isEmpty) return null;
+    final sorted = List<double>.of(values)..sort();
+    final middle = sorted.length ~/ 2;
+    return sorted.length.isOdd ? sorted[middle] : (sorted[middle - 1] + sorted[middle]) / 2;
+  }
+
+  /// Compares this run against [baseline]
+  ///
+  /// A scenario regresses when its median time, or one of its [metrics],
+  /// is worse than the baseline by more than [threshold] (0.1 = 10%).
+  /// Medians use the middle of all iterations, so one outlier does not
+  /// fail a run. Time differences below [minimumTimeDelta] milliseconds
+  /// are timer noise on fast scenarios and never count.
+  BenchmarkComparison compareWith(BenchmarkResult baseline, {double threshold = 0.1, double minimumTimeDelta = 1.0}) {
+    if (threshold < 0) {
+      throw ArgumentError.value(threshold, 'threshold', 'must not be negative');
+    }
+
+    final regressions = <BenchmarkDelta>[];
+    final improvements = <BenchmarkDelta>[];
+    void classify(BenchmarkDelta delta, bool higherIsBetter) {
+      final change = higherIsBetter ? -delta.change : delta.change;
+      if (change > threshold) {
+        regressions.add(delta);
+      } else if (change < -threshold) {
+        improvements.add(delta);
+      }
+    }
+
+    for (final scenario in results.keys.where(baseline.results.containsKey)) {
+      final current = medianTime(scenario);
+      final previous = baseline.medianTime(scenario);
+      if (current != null && previous != null && (current - previous).abs() >= minimumTimeDelta) {
+        classify(BenchmarkDelta(scenario: scenario, measure: 'median_time_ms', baseline: previous, current: current), false);
+      }
+
+      final previousMetrics = baseline.metrics[scenario] ?? const {};
+      for (final metric in (metrics[scenario] ?? const <String, double>{}).entries) {
+        final previousValue = previousMetrics[metric.key];
+        if (previousValue == null || informational.contains(metric.key)) continue;
+        classify(BenchmarkDelta(scenario: scenario, measure: metric.key, baseline: previousValue, current: metric.value), higherIsBetter.contains(metric.key));
+      }
+    }
+
+    return BenchmarkComparison(
+      threshold: threshold,
+      regressions: regressions,
+      improvements: improvements,
+      addedScenarios: results.keys.where((s) => !baseline.results.containsKey(s)).toList(),
+      missingScenarios: baseline.results.keys.where((s) => !results.containsKey(s)).toList(),
+    );
+  }
+
+  /// Converts the result to JSON for storage as a baseline
+  Map<String, dynamic> toJson() {
+    return {
+      'test_name': testName,
+      'iterations': iterations,
+      'completed_at': completedAt.toIso8601String(),
+      'scenarios': {
+        for (final entry in results.entries)
+          entry.key: {'median_time_ms': medianTime(entry.key), 'times_ms': entry.value, if (metrics[entry.key] != null) 'metrics': metrics[entry.key]},
+      },
+    };
+  }
 
   @override
   String toString() {
@@ -36,6 +154,14 @@ class BenchmarkResult {
       buffer.writeln('${entry.key}:');
       buffer.writeln('  Average: ${avg.toStringAsFixed(2)}ms');
       buffer.writeln('  Range: ${min.toStringAsFixed(2)}ms - ${max.toStringAsFixed(2)}ms');
+      final throughput = metrics[entry.key]?[throughputMetric];
+      if (throughput != null) {
+        buffer.writeln('  Throughput: ${throughput.toStringAsFixed(1)}x realtime');
+      }
+      final peakRss = metrics[entry.key]?[peakRssMetric];
+      if (peakRss != null) {
+        buffer.writeln('  Peak RSS: ${(peakRss / 1024 / 1024).toStringAsFixed(1)}MB');
+      }
     }
 
     return buffer.toString();
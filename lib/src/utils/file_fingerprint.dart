@@ -0,0 +1,87 @@
+import 'dart:io';
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+/// Cheap content fingerprint of a file: its size and hashes of its ends
+///
+/// Hashing a whole 100MB track to validate a cached waveform would cost a
+/// good part of decoding it. Re-encodes, trims and tag edits change the size
+/// or the first or last [sampleBytes], so hashing only those is enough to
+/// tell a replaced file from an unchanged one:
+///
+/// ```
+/// file:  [ head 64KB ][.................. not read ..................][ tail 64KB ]
+///        FNV-1a ─────┘                                                └───── FNV-1a
+/// ```
+///
+/// Edits that keep the size and touch only the middle of the file are not
+/// detected; pair the fingerprint with the modification time where that
+/// matters.
+///
+/// ## Example Usage
+///
+/// ```dart
+/// final fingerprint = await FileFingerprint.compute('track.mp3');
+/// if (fingerprint != null && fingerprint == cachedFingerprint) {
+///   // The file still holds the same content
+/// }
+/// ```
+class FileFingerprint {
+  /// Bytes hashed at each end of the file
+  static const int sampleBytes = 64 * 1024;
+
+  /// File size in bytes
+  final int size;
+
+  /// FNV-1a hash of the first [sampleBytes] (or the whole file if smaller)
+  final int headHash;
+
+  /// FNV-1a hash of the last [sampleBytes] after the head (0 for small files)
+  final int tailHash;
+
+  const FileFingerprint({required this.size, required this.headHash, required this.tailHash});
+
+  /// Fingerprints the file at [filePath], or returns null if it does not exist
+  ///
+  /// Reads at most `2 * sampleBytes` bytes whatever the size of the file.
+  static Future<FileFingerprint?> compute(String filePath) async {
+    final file = File(filePath);
+    if (!await file.exists()) return null;
+
+    final handle = await file.open();
+    try {
+      final size = await handle.length();
+      final head = await handle.read(math.min(size, sampleBytes));
+      Uint8List tail = Uint8List(0);
+      final tailStart = math.max(head.length, size - sampleBytes);
+      if (tailStart < size) {
+        await handle.setPosition(tailStart);
+        tail = await handle.read(size - tailStart);
+      }
+      return FileFingerprint(size: size, headHash: _fnv1a(head), tailHash: tail.isEmpty ? 0 : _fnv1a(tail));
+    } finally {
+      await handle.close();
+    }
+  }
+
+  /// Lowercase hex of size and hashes, usable in file names
+  String toHex() => '${size.toRadixString(16)}-${headHash.toRadixString(16).padLeft(8, '0')}${tailHash.toRadixString(16).padLeft(8, '0')}';
+
+  /// 32-bit FNV-1a, as `WaveformConfig.stableHash`
+  static int _fnv1a(Uint8List bytes) {
+    int hash = 0x811c9dc5;
+    for (int i = 0; i < bytes.length; i++) {
+      hash = ((hash ^ bytes[i]) * 0x01000193) & 0xffffffff;
+    }
+    return hash;
+  }
+
+  @override
+  bool operator ==(Object other) => other is FileFingerprint && other.size == size && other.headHash == headHash && other.tailHash == tailHash;
+
+  @override
+  int get hashCode => Object.hash(size, headHash, tailHash);
+
+  @override
+  String toString() => 'FileFingerprint(${toHex()})';
+}
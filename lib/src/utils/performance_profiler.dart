@@ -1,15 +1,21 @@
 import 'dart:async';
+import 'dart:io';
 import 'dart:math' as math;
+import 'dart:ui' as ui;
 
 import 'package:sonix/src/models/waveform_data.dart';
 import 'package:sonix/src/models/waveform_type.dart';
 import 'package:sonix/src/models/waveform_metadata.dart';
-import 'package:sonix/src/models/audio_data.dart';
+import 'package:sonix/src/processing/downsampling_algorithm.dart';
+import 'package:sonix/src/widgets/waveform_painter.dart';
+import 'package:sonix/src/widgets/waveform_style.dart';
+import 'package:sonix/src/widgets/waveform_style_presets.dart';
 
 import 'profiled_operation.dart';
 import 'operation_statistics.dart';
 import 'performance_report.dart';
 import 'benchmark_result.dart';
+import 'waveform_benchmark.dart';
 
 /// Comprehensive performance profiler for Sonix operations
 class PerformanceProfiler {
@@ -223,37 +229,34 @@ class PerformanceProfiler {
     return {'operations': _operations.map((op) => op.toJson()).toList(), 'metrics': _metrics, 'exportedAt': DateTime.now().toIso8601String()};
   }
 
-  /// Benchmark waveform generation performance
-  Future<BenchmarkResult> benchmarkWaveformGeneration({required List<int> resolutions, required List<double> durations, int iterations = 3}) async {
-    final results = <String, List<double>>{};
-
-    for (final duration in durations) {
-      for (final resolution in resolutions) {
-        final key = 'duration_${duration}s_resolution_$resolution';
-        final times = <double>[];
-
-        for (int i = 0; i < iterations; i++) {
-          final audioData = _createTestAudioData(duration);
-
-          final stopwatch = Stopwatch()..start();
-          // This would call the actual waveform generation
-          // For now, simulate the operation
-          await Future.delayed(Duration(milliseconds: (duration * resolution / 1000).round()));
-          stopwatch.stop();
-
-          times.add(stopwatch.elapsedMilliseconds.toDouble());
-          audioData.dispose();
-        }
-
-        results[key] = times;
-      }
-    }
-
-    return BenchmarkResult(testName: 'Waveform Generation Benchmark', results: results, iterations: iterations, completedAt: DateTime.now());
+  /// Benchmark decoding and waveform generation of real audio files
+  ///
+  /// Runs [WaveformBenchmark.run] over [filePaths]: every file is decoded and
+  /// reduced at each of [resolutions] and [algorithms], in each of [modes].
+  /// Use [WaveformBenchmark.writeTestWav] to benchmark long files.
+  Future<BenchmarkResult> benchmarkWaveformGeneration({
+    required List<String> filePaths,
+    required List<int> resolutions,
+    List<DownsamplingAlgorithm> algorithms = const [DownsamplingAlgorithm.rms],
+    List<BenchmarkMode> modes = BenchmarkMode.values,
+    int iterations = 3,
+  }) {
+    return WaveformBenchmark.run(filePaths, resolutions: resolutions, algorithms: algorithms, modes: modes, iterations: iterations);
   }
 
   /// Benchmark widget rendering performance
-  Future<BenchmarkResult> benchmarkWidgetRendering({required List<int> amplitudeCounts, int iterations = 5}) async {
+  ///
+  /// Paints a [WaveformPainter] of each amplitude count into a picture of
+  /// [size] and records the time (in milliseconds) to paint and finish the
+  /// recording. Every iteration paints fresh waveform data, so the painter's
+  /// layer cache never answers; rasterization is left to the engine and not
+  /// included.
+  Future<BenchmarkResult> benchmarkWidgetRendering({
+    required List<int> amplitudeCounts,
+    int iterations = 5,
+    ui.Size size = const ui.Size(1200, 200),
+    WaveformStyle style = WaveformStylePresets.soundCloud,
+  }) async {
     final results = <String, List<double>>{};
 
     for (final count in amplitudeCounts) {
@@ -262,13 +265,16 @@ class PerformanceProfiler {
 
       for (int i = 0; i < iterations; i++) {
         final waveformData = _createTestWaveformData(count);
+        final painter = WaveformPainter(waveformData: waveformData, style: style, playbackPosition: 0.5);
+        final recorder = ui.PictureRecorder();
 
         final stopwatch = Stopwatch()..start();
-        // Simulate widget rendering time
-        await Future.delayed(Duration(microseconds: count ~/ 10));
+        painter.paint(ui.Canvas(recorder), size);
+        final picture = recorder.endRecording();
         stopwatch.stop();
 
-        times.add(stopwatch.elapsedMicroseconds.toDouble());
+        times.add(stopwatch.elapsedMicroseconds / 1000);
+        picture.dispose();
         waveformData.dispose();
       }
 
@@ -287,10 +293,7 @@ class PerformanceProfiler {
     }
   }
 
-  int _getCurrentMemoryUsage() {
-    // Memory usage tracking removed with caching system
-    return 0;
-  }
+  int _getCurrentMemoryUsage() => ProcessInfo.currentRss;
 
   double _calculateAverage(List<double> values) {
     if (values.isEmpty) return 0.0;
@@ -315,18 +318,6 @@ class PerformanceProfiler {
     return math.sqrt(variance);
   }
 
-  AudioData _createTestAudioData(double durationSeconds) {
-    final sampleRate = 44100;
-    final samples = List.generate((sampleRate * durationSeconds).round(), (i) => math.sin(2 * math.pi * 440 * i / sampleRate) * 0.5);
-
-    return AudioData(
-      samples: samples,
-      sampleRate: sampleRate,
-      channels: 1,
-      duration: Duration(milliseconds: (durationSeconds * 1000).round()),
-    );
-  }
-
   WaveformData _createTestWaveformData(int amplitudeCount) {
     final amplitudes = List.generate(amplitudeCount, (i) => math.sin(2 * math.pi * i / amplitudeCount) * 0.5 + 0.5);
 
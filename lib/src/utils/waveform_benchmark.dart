@@ -0,0 +1,191 @@
+import 'dart:io';
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:sonix/src/config/sonix_config.dart';
+import 'package:sonix/src/models/waveform_data.dart';
+import 'package:sonix/src/processing/audio_file_processor.dart';
+import 'package:sonix/src/processing/downsampling_algorithm.dart';
+import 'package:sonix/src/processing/waveform_config.dart';
+import 'package:sonix/src/sonix_api.dart';
+
+import 'benchmark_result.dart';
+
+/// Where [WaveformBenchmark] generates waveforms
+enum BenchmarkMode {
+  /// `AudioFileProcessor.generateWaveform` on the calling isolate
+  inProcess,
+
+  /// `Sonix.generateWaveformInIsolate` on the background worker pool
+  isolate,
+}
+
+/// End-to-end waveform generation benchmark over real audio files
+///
+/// Every scenario decodes a file and generates a waveform from it through
+/// the same code paths applications use, once per combination of file,
+/// [BenchmarkMode], algorithm and resolution:
+///
+/// ```
+/// for file × mode × algorithm × resolution:
+///   warm-up runs (pool spawn, FFmpeg init, JIT)   -> discarded
+///   measured runs                                 -> times_ms
+///   audio duration / median time                  -> audio_seconds_per_second
+///   process RSS high-water mark afterwards        -> peak_rss_bytes
+///   largest RSS growth of one run                 -> allocated_bytes
+/// ```
+///
+/// The waveform cache is disabled, so every run decodes. Peak RSS is the
+/// high-water mark of the whole process up to the end of the scenario, so it
+/// is only comparable between runs of the same scenario list in the same
+/// order; list long files last so they do not hide the footprint of short
+/// ones. Use [writeTestWav] for files longer than the bundled test assets.
+///
+/// ## Example Usage
+///
+/// ```dart
+/// final long = await WaveformBenchmark.writeTestWav('build/long.wav', const Duration(minutes: 30));
+/// final result = await WaveformBenchmark.run(['test/assets/test_medium.mp3', long.path], resolutions: [1000, 8000]);
+/// await File('benchmark.json').writeAsString(jsonEncode(result.toJson()));
+/// ```
+class WaveformBenchmark {
+  WaveformBenchmark._();
+
+  /// Runs every combination of [filePaths], [modes], [algorithms] and [resolutions]
+  ///
+  /// Each scenario runs [warmupIterations] unmeasured times, then
+  /// [iterations] measured times. Scenario keys have the form
+  /// `<file name>/<mode>/<algorithm>/<resolution>`.
+  ///
+  /// **Throws:** [ArgumentError] if [iterations] is less than 1, and whatever
+  /// generation throws for a file that cannot be decoded.
+  static Future<BenchmarkResult> run(
+    List<String> filePaths, {
+    List<int> resolutions = const [1000],
+    List<DownsamplingAlgorithm> algorithms = const [DownsamplingAlgorithm.rms],
+    List<BenchmarkMode> modes = BenchmarkMode.values,
+    int iterations = 3,
+    int warmupIterations = 1,
+    String testName = 'Waveform Generation Benchmark',
+  }) async {
+    if (iterations < 1) {
+      throw ArgumentError.value(iterations, 'iterations', 'must be at least 1');
+    }
+
+    // Without the cache repeats would be answered without decoding
+    const sonixConfig = SonixConfig(waveformCacheSize: 0);
+    final sonix = modes.contains(BenchmarkMode.isolate) ? Sonix(sonixConfig) : null;
+    // Both modes hold the same decoded size on the heap, so they take the same strategy
+    final processor = AudioFileProcessor(scratchBudget: sonixConfig.maxMemoryUsage);
+    final results = <String, List<double>>{};
+    final metrics = <String, Map<String, double>>{};
+
+    try {
+      for (final filePath in filePaths) {
+        for (final mode in modes) {
+          for (final algorithm in algorithms) {
+            for (final resolution in resolutions) {
+              final config = WaveformConfig(resolution: resolution, algorithm: algorithm);
+              Future<WaveformData> generate() => mode == BenchmarkMode.isolate
+                  ? sonix!.generateWaveformInIsolate(filePath, config: config)
+                  : processor.generateWaveform(filePath, config: config);
+
+              for (int i = 0; i < warmupIterations; i++) {
+                (await generate()).dispose();
+              }
+
+              final times = <double>[];
+              double audioSeconds = 0;
+              int allocated = 0;
+              for (int i = 0; i < iterations; i++) {
+                final rssBefore = ProcessInfo.currentRss;
+                final stopwatch = Stopwatch()..start();
+                final waveform = await generate();
+                stopwatch.stop();
+
+                allocated = math.max(allocated, ProcessInfo.currentRss - rssBefore);
+                times.add(stopwatch.elapsedMicroseconds / 1000);
+                audioSeconds = waveform.duration.inMicroseconds / Duration.microsecondsPerSecond;
+                waveform.dispose();
+              }
+
+              final key = scenarioKey(filePath, mode, algorithm, resolution);
+              results[key] = times;
+              metrics[key] = {
+                BenchmarkResult.throughputMetric: audioSeconds / (math.max(_median(times), 0.001) / 1000),
+                BenchmarkResult.peakRssMetric: ProcessInfo.maxRss.toDouble(),
+                BenchmarkResult.allocatedMetric: allocated.toDouble(),
+              };
+            }
+          }
+        }
+      }
+    } finally {
+      sonix?.dispose();
+    }
+
+    return BenchmarkResult(testName: testName, results: results, metrics: metrics, iterations: iterations, completedAt: DateTime.now());
+  }
+
+  /// Key of the scenario [run] reports for these parameters
+  static String scenarioKey(String filePath, BenchmarkMode mode, DownsamplingAlgorithm algorithm, int resolution) {
+    final name = filePath.split(RegExp(r'[/\\]')).last;
+    return '$name/${mode.name}/${algorithm.name}/$resolution';
+  }
+
+  /// Writes a 16-bit PCM WAV file of [duration] to [path]
+  ///
+  /// The signal is a 220Hz tone under a slow swell, so normalization and
+  /// every downsampling algorithm have real work to do. Samples are written
+  /// one second at a time; hours of audio never sit in memory.
+  static Future<File> writeTestWav(String path, Duration duration, {int sampleRate = 44100, int channels = 2}) async {
+    if (duration <= Duration.zero) {
+      throw ArgumentError.value(duration, 'duration', 'must be positive');
+    }
+
+    final totalFrames = duration.inMicroseconds * sampleRate ~/ Duration.microsecondsPerSecond;
+    final dataBytes = totalFrames * channels * 2;
+    final header = ByteData(44)
+      ..setUint32(0, 0x52494646) // RIFF
+      ..setUint32(4, 36 + dataBytes, Endian.little)
+      ..setUint32(8, 0x57415645) // WAVE
+      ..setUint32(12, 0x666d7420) // fmt
+      ..setUint32(16, 16, Endian.little)
+      ..setUint16(20, 1, Endian.little) // PCM
+      ..setUint16(22, channels, Endian.little)
+      ..setUint32(24, sampleRate, Endian.little)
+      ..setUint32(28, sampleRate * channels * 2, Endian.little)
+      ..setUint16(32, channels * 2, Endian.little)
+      ..setUint16(34, 16, Endian.little)
+      ..setUint32(36, 0x64617461) // data
+      ..setUint32(40, dataBytes, Endian.little);
+
+    final file = File(path);
+    final handle = await file.open(mode: FileMode.write);
+    try {
+      await handle.writeFrom(header.buffer.asUint8List());
+      for (int start = 0; start < totalFrames; start += sampleRate) {
+        final frames = math.min(sampleRate, totalFrames - start);
+        final block = ByteData(frames * channels * 2);
+        for (int i = 0; i < frames; i++) {
+          final t = (start + i) / sampleRate;
+          final swell = 0.3 + 0.25 * (1 + math.sin(2 * math.pi * 0.1 * t));
+          final sample = (math.sin(2 * math.pi * 220 * t) * swell * 32767).round();
+          for (int c = 0; c < channels; c++) {
+            block.setInt16((i * channels + c) * 2, sample, Endian.little);
+          }
+        }
+        await handle.writeFrom(block.buffer.asUint8List());
+      }
+    } finally {
+      await handle.close();
+    }
+    return file;
+  }
+
+  static double _median(List<double> values) {
+    final sorted = List<double>.of(values)..sort();
+    final middle = sorted.length ~/ 2;
+    return sorted.length.isOdd ? sorted[middle] : (sorted[middle - 1] + sorted[middle]) / 2;
+  }
+}
@@ -0,0 +1,525 @@
+import 'dart:math' as math;
+
+import 'package:flutter/gestures.dart';
+import 'package:flutter/material.dart';
+import 'package:sonix/src/models/waveform_bins.dart';
+import 'package:sonix/src/models/waveform_data.dart';
+import 'package:sonix/src/models/waveform_type.dart';
+import 'package:sonix/src/processing/downsample_method.dart';
+import 'package:sonix/src/processing/waveform_range_source.dart';
+import 'package:sonix/src/processing/waveform_tile_cache.dart';
+import 'waveform_controller.dart';
+import 'waveform_style.dart';
+import 'waveform_viewport_controller.dart';
+
+/// A scrolling, zooming waveform that only computes and paints what is on screen.
+///
+/// `WaveformWidget` fits the whole waveform into its width. This widget
+/// instead shows a window into a timeline that can be far longer than the
+/// screen: drag to scroll, pinch or use the mouse wheel to zoom. Bins are
+/// pulled from a [WaveformRangeSource] in fixed-size tiles at the bin size of
+/// the current zoom level, and only the tiles intersecting the viewport
+/// (plus [prefetchTiles] on each side) are ever loaded or painted:
+///
+/// ```
+///  tiles:  ... | t3 | t4 | t5 | t6 | t7 | ...
+///                   [  viewport  ]
+///              prefetch         prefetch
+/// ```
+///
+/// Bin sizes are powers of two frames, so tiles are reused while zooming
+/// within a factor of two and when zooming back.
+///
+/// ## Basic Usage
+///
+/// ```dart
+/// ScrollableWaveformWidget(
+///   source: WaveformDataRangeSource(waveformData), // ideally generated with generatePyramid: true
+///   viewportController: viewport,
+///   controller: playback,
+///   onSeek: (position) => audioPlayer.seek(waveformData.duration * position),
+/// )
+/// ```
+///
+/// ## On-Demand Decoding
+///
+/// ```dart
+/// final audio = await AudioFileProcessor().process('three_hours.flac'); // memory-mapped when large
+/// // Zoomed-out tiles are reduced from the mapping on a background isolate
+/// ScrollableWaveformWidget(source: AudioRangeSource.fromAudioData(audio));
+/// ```
+class ScrollableWaveformWidget extends StatefulWidget {
+  /// Source of the bins under the viewport
+  final WaveformRangeSource source;
+
+  /// Controller for the visible range; one is created internally if omitted
+  final WaveformViewportController? viewportController;
+
+  /// Controller for the playback position, as in `WaveformWidget`
+  final WaveformController? controller;
+
+  /// Playback position as a fraction of the whole source (0.0 to 1.0)
+  ///
+  /// **Note:** If a [controller] is provided, it takes precedence over this parameter.
+  final double? playbackPosition;
+
+  /// Visual styling configuration for the waveform
+  final WaveformStyle style;
+
+  /// Callback invoked when the user taps a position, as a fraction of the whole source
+  final Function(double)? onSeek;
+
+  /// Tiles loaded ahead on each side of the viewport
+  final int prefetchTiles;
+
+  /// Number of bins per tile
+  final int tileBins;
+
+  /// Number of tiles kept in memory
+  final int maxCachedTiles;
+
+  const ScrollableWaveformWidget({
+    super.key,
+    required this.source,
+    this.viewportController,
+    this.controller,
+    this.playbackPosition,
+    this.style = const WaveformStyle(),
+    this.onSeek,
+    this.prefetchTiles = 1,
+    this.tileBins = WaveformTileCache.defaultTileBins,
+    this.maxCachedTiles = WaveformTileCache.defaultMaxTiles,
+  });
+
+  /// Shows [waveformData], using its pyramid for zoomed-out views when it has one
+  ScrollableWaveformWidget.fromWaveformData(
+    WaveformData waveformData, {
+    Key? key,
+    WaveformViewportController? viewportController,
+    WaveformController? controller,
+    double? playbackPosition,
+    WaveformStyle style = const WaveformStyle(),
+    Function(double)? onSeek,
+  }) : this(
+         key: key,
+         source: WaveformDataRangeSource(waveformData),
+         viewportController: viewportController,
+         controller: controller,
+         playbackPosition: playbackPosition,
+         style: style,
+         onSeek: onSeek,
+       );
+
+  @override
+  State<ScrollableWaveformWidget> createState() => _ScrollableWaveformWidgetState();
+}
+
+class _ScrollableWaveformWidgetState extends State<ScrollableWaveformWidget> {
+  late WaveformTileCache _cache;
+  WaveformViewportController? _ownViewport;
+
+  /// Bumped whenever a tile finishes loading, to repaint
+  int _tileGeneration = 0;
+
+  double _scaleStartFramesPerPixel = 1.0;
+
+  WaveformViewportController get _viewport => widget.viewportController ?? (_ownViewport ??= WaveformViewportController());
+
+  @override
+  void initState() {
+    super.initState();
+    _cache = _createCache();
+    _viewport.addListener(_onChanged);
+    widget.controller?.addListener(_onChanged);
+  }
+
+  @override
+  void didUpdateWidget(ScrollableWaveformWidget oldWidget) {
+    super.didUpdateWidget(oldWidget);
+
+    if (widget.source != oldWidget.source || widget.tileBins != oldWidget.tileBins || widget.maxCachedTiles != oldWidget.maxCachedTiles) {
+      _cache.onTileLoaded = null;
+      _cache = _createCache();
+    }
+
+    if (widget.viewportController != oldWidget.viewportController) {
+      (oldWidget.viewportController ?? _ownViewport)?.removeListener(_onChanged);
+      _viewport.addListener(_onChanged);
+    }
+
+    if (widget.controller != oldWidget.controller) {
+      oldWidget.controller?.removeListener(_onChanged);
+      widget.controller?.addListener(_onChanged);
+    }
+  }
+
+  @override
+  void dispose() {
+    _cache.onTileLoaded = null;
+    _viewport.removeListener(_onChanged);
+    widget.controller?.removeListener(_onChanged);
+    _ownViewport?.dispose();
+    super.dispose();
+  }
+
+  WaveformTileCache _createCache() {
+    return WaveformTileCache(widget.source, tileBins: widget.tileBins, maxTiles: widget.maxCachedTiles, onTileLoaded: _onTileLoaded);
+  }
+
+  void _onTileLoaded() {
+    if (mounted) {
+      setState(() => _tileGeneration++);
+    }
+  }
+
+  void _onChanged() {
+    if (mounted) {
+      setState(() {});
+    }
+  }
+
+  void _handleScaleStart(ScaleStartDetails details) {
+    _scaleStartFramesPerPixel = _viewport.framesPerPixel;
+  }
+
+  void _handleScaleUpdate(ScaleUpdateDetails details) {
+    final focalPixel = details.localFocalPoint.dx - widget.style.padding.left;
+    if (details.pointerCount > 1 && details.scale > 0) {
+      _viewport.zoomTo(_scaleStartFramesPerPixel / details.scale, focalPixel: focalPixel);
+    }
+    _viewport.scrollBy(-details.focalPointDelta.dx);
+  }
+
+  void _handlePointerSignal(PointerSignalEvent event) {
+    if (event is PointerScrollEvent) {
+      // Vertical wheel zooms around the pointer, horizontal wheel scrolls
+      if (event.scrollDelta.dy != 0) {
+        _viewport.zoomBy(math.exp(-event.scrollDelta.dy / 200), focalPixel: event.localPosition.dx - widget.style.padding.left);
+      }
+      if (event.scrollDelta.dx != 0) {
+        _viewport.scrollBy(event.scrollDelta.dx);
+      }
+    }
+  }
+
+  void _handleTap(TapUpDetails details) {
+    final totalFrames = widget.source.totalFrames;
+    if (widget.onSeek == null || totalFrames <= 0) return;
+
+    final frame = _viewport.startFrame + (details.localPosition.dx - widget.style.padding.left) * _viewport.framesPerPixel;
+    final position = (frame / totalFrames).clamp(0.0, 1.0);
+    widget.controller?.updatePosition(position);
+    widget.onSeek!(position);
+  }
+
+  @override
+  Widget build(BuildContext context) {
+    return LayoutBuilder(
+      builder: (context, constraints) {
+        final style = widget.style;
+        final size = Size(constraints.maxWidth - style.margin.horizontal, style.height);
+        final viewport = _viewport..updateExtent(widget.source.totalFrames, math.max(0.0, size.width - style.padding.horizontal));
+
+        final position = widget.controller?.position ?? widget.playbackPosition;
+        Widget waveformChild = Listener(
+          onPointerSignal: _handlePointerSignal,
+          child: GestureDetector(
+            onTapUp: _handleTap,
+            onScaleStart: _handleScaleStart,
+            onScaleUpdate: _handleScaleUpdate,
+            child: CustomPaint(
+              size: size,
+              painter: _ViewportWaveformPainter(
+                cache: _cache,
+                style: style,
+                startFrame: viewport.startFrame,
+                framesPerPixel: viewport.framesPerPixel,
+                playbackFrame: position == null ? null : position * widget.source.totalFrames,
+                prefetchTiles: widget.prefetchTiles,
+                tileGeneration: _tileGeneration,
+              ),
+            ),
+          ),
+        );
+
+        // Apply decorations (border, shadow, etc.)
+        if (style.border != null || style.boxShadow != null) {
+          waveformChild = Container(
+            width: size.width,
+            height: size.height,
+            decoration: BoxDecoration(border: style.border, boxShadow: style.boxShadow, borderRadius: style.borderRadius),
+            child: waveformChild,
+          );
+        }
+
+        // Apply margin
+        if (style.margin != EdgeInsets.zero) {
+          waveformChild = Padding(padding: style.margin, child: waveformChild);
+        }
+
+        return SizedBox(width: constraints.maxWidth, height: style.height + style.margin.vertical, child: waveformChild);
+      },
+    );
+  }
+}
+
+/// Paints the tiles under the viewport
+class _ViewportWaveformPainter extends CustomPainter {
+  final WaveformTileCache cache;
+  final WaveformStyle style;
+  final double startFrame;
+  final double framesPerPixel;
+  final double? playbackFrame;
+  final int prefetchTiles;
+  final int tileGeneration;
+
+  _ViewportWaveformPainter({
+    required this.cache,
+    required this.style,
+    required this.startFrame,
+    required this.framesPerPixel,
+    required this.playbackFrame,
+    required this.prefetchTiles,
+    required this.tileGeneration,
+  });
+
+  /// Frames per bin at the current zoom: a power of two giving each bin at
+  /// least one bar (or, for lines and areas, one pixel)
+  int get framesPerBin {
+    final pixelsPerBin = style.type == WaveformType.bars ? style.barWidth + style.barSpacing : 1.0;
+    final target = framesPerPixel * math.max(1.0, pixelsPerBin);
+    int framesPerBin = 1;
+    while (framesPerBin < target) {
+      framesPerBin <<= 1;
+    }
+    return framesPerBin;
+  }
+
+  @override
+  void paint(Canvas canvas, Size size) {
+    final contentRect = Rect.fromLTWH(style.padding.left, style.padding.top, size.width - style.padding.horizontal, size.height - style.padding.vertical);
+
+    if (style.opacity < 1.0) {
+      canvas.saveLayer(Offset.zero & size, Paint()..color = Colors.white.withValues(alpha: style.opacity));
+    }
+
+    if (style.backgroundColor != Colors.transparent) {
+      canvas.drawRect(Offset.zero & size, Paint()..color = style.backgroundColor);
+    }
+
+    if (style.showCenterLine) {
+      final centerY = contentRect.center.dy;
+      final centerLinePaint = Paint()
+        ..color = style.centerLineColor
+        ..strokeWidth = style.centerLineWidth;
+      canvas.drawLine(Offset(contentRect.left, centerY), Offset(contentRect.right, centerY), centerLinePaint);
+    }
+
+    final totalFrames = cache.source.totalFrames;
+    if (totalFrames > 0 && contentRect.width > 0 && framesPerPixel > 0) {
+      _paintWaveform(canvas, contentRect, totalFrames);
+    }
+
+    if (style.opacity < 1.0) {
+      canvas.restore();
+    }
+  }
+
+  void _paintWaveform(Canvas canvas, Rect contentRect, int totalFrames) {
+    final binFrames = framesPerBin;
+    final tileFrames = cache.tileFrames(binFrames);
+    final endFrame = math.min(startFrame + contentRect.width * framesPerPixel, totalFrames.toDouble());
+    final firstTile = startFrame ~/ tileFrames;
+    final lastTile = math.max(firstTile, (endFrame - 1) ~/ tileFrames);
+
+    final shape = _ShapeBuilder(style, contentRect);
+    for (int tile = firstTile; tile <= lastTile; tile++) {
+      final bins = cache.tile(binFrames, tile);
+      if (bins == null) {
+        // Still loading: leave a gap rather than stretching neighbours over it
+        shape.endSegment();
+        continue;
+      }
+
+      final tileStart = tile * tileFrames;
+      for (int bin = 0; bin < bins.length; bin++) {
+        final frame = tileStart + bin * binFrames;
+        if (frame + binFrames <= startFrame) continue;
+        if (frame >= endFrame) break;
+        shape.add(contentRect.left + (frame - startFrame) / framesPerPixel, bins, bin);
+      }
+    }
+    shape.endSegment();
+
+    for (int i = 1; i <= prefetchTiles; i++) {
+      cache.prefetch(binFrames, firstTile - i);
+      cache.prefetch(binFrames, lastTile + i);
+    }
+
+    final split = playbackFrame == null ? contentRect.left : (contentRect.left + (playbackFrame! - startFrame) / framesPerPixel).clamp(contentRect.left, contentRect.right);
+    final path = shape.path;
+    final stroke = style.type == WaveformType.line;
+
+    if (split > contentRect.left) {
+      canvas.save();
+      canvas.clipRect(Rect.fromLTRB(contentRect.left, contentRect.top, split, contentRect.bottom));
+      canvas.drawPath(path, _shapePaint(contentRect, true, stroke));
+      canvas.restore();
+    }
+    if (split < contentRect.right) {
+      canvas.save();
+      canvas.clipRect(Rect.fromLTRB(split, contentRect.top, contentRect.right, contentRect.bottom));
+      canvas.drawPath(path, _shapePaint(contentRect, false, stroke));
+      canvas.restore();
+    }
+
+    final gradient = style.gradient;
+    if (gradient != null) {
+      canvas.drawRect(
+        contentRect,
+        Paint()
+          ..shader = gradient.createShader(contentRect)
+          ..blendMode = style.gradientBlendMode,
+      );
+    }
+  }
+
+  /// Paint for the played or unplayed shape, honoring gradients
+  Paint _shapePaint(Rect contentRect, bool isPlayed, bool stroke) {
+    final gradient = isPlayed ? style.playedGradient : style.unplayedGradient;
+    final paint = Paint();
+    if (gradient != null) {
+      paint.shader = gradient.createShader(contentRect);
+    } else {
+      paint.color = isPlayed ? style.playedColor : style.unplayedColor;
+    }
+
+    if (stroke) {
+      paint
+        ..style = PaintingStyle.stroke
+        ..strokeWidth = style.strokeWidth
+        ..strokeCap = StrokeCap.round
+        ..strokeJoin = StrokeJoin.round;
+    } else {
+      paint.style = PaintingStyle.fill;
+    }
+    return paint;
+  }
+
+  @override
+  bool shouldRepaint(_ViewportWaveformPainter oldDelegate) {
+    return oldDelegate.cache != cache ||
+        oldDelegate.style != style ||
+        oldDelegate.startFrame != startFrame ||
+        oldDelegate.framesPerPixel != framesPerPixel ||
+        oldDelegate.playbackFrame != playbackFrame ||
+        oldDelegate.tileGeneration != tileGeneration;
+  }
+}
+
+/// Collects visible bins into one path, in contiguous segments
+///
+/// Bars are added as they come. Lines and areas need a whole segment of
+/// points; a segment ends at a tile that is still loading.
+class _ShapeBuilder {
+  final WaveformStyle style;
+  final Rect contentRect;
+  final Path path = Path();
+
+  /// Signed min/max envelope instead of the symmetric peak
+  final bool signed;
+
+  final List<double> _xs = [];
+  final List<double> _tops = [];
+  final List<double> _bottoms = [];
+
+  _ShapeBuilder(this.style, this.contentRect) : signed = style.downsampleMethod == DownsampleMethod.minMax;
+
+  void add(double x, WaveformBins bins, int bin) {
+    final length = bins.length;
+    final data = bins.data;
+    final centerY = contentRect.center.dy;
+    final halfHeight = contentRect.height / 2;
+    final min = data[bin];
+    final max = data[length + bin];
+
+    if (style.type == WaveformType.bars) {
+      double top;
+      double bottom;
+      if (signed) {
+        top = centerY - (max * style.amplitudeScale).clamp(-1.0, 1.0) * halfHeight;
+        bottom = centerY - (min * style.amplitudeScale).clamp(-1.0, 1.0) * halfHeight;
+      } else {
+        // Same proportions as WaveformPainter bars
+        final amplitude = (math.max(-min, max) * style.amplitudeScale).clamp(0.0, 1.0);
+        top = centerY - amplitude * halfHeight / 2;
+        bottom = centerY + amplitude * halfHeight / 2;
+      }
+
+      final barHeight = (bottom - top).clamp(style.minBarHeight, style.maxBarHeight ?? double.infinity);
+      final middle = (top + bottom) / 2;
+      _addBar(Rect.fromLTRB(x, middle - barHeight / 2, x + style.barWidth, middle + barHeight / 2));
+      return;
+    }
+
+    _xs.add(x);
+    if (signed) {
+      _tops.add(centerY - (max * style.amplitudeScale).clamp(-1.0, 1.0) * halfHeight);
+      _bottoms.add(centerY - (min * style.amplitudeScale).clamp(-1.0, 1.0) * halfHeight);
+    } else {
+      _tops.add(centerY - (math.max(-min, max) * style.amplitudeScale).clamp(0.0, 1.0) * halfHeight);
+    }
+  }
+
+  /// Closes the current line or area segment
+  void endSegment() {
+    final count = _xs.length;
+    if (count == 0) return;
+
+    if (signed) {
+      // Upper edge left to right, lower edge back
+      path.moveTo(_xs[0], _tops[0]);
+      for (int i = 1; i < count; i++) {
+        path.lineTo(_xs[i], _tops[i]);
+      }
+      for (int i = count - 1; i >= 0; i--) {
+        path.lineTo(_xs[i], _bottoms[i]);
+      }
+      path.close();
+    } else if (style.type == WaveformType.line) {
+      path.moveTo(_xs[0], _tops[0]);
+      for (int i = 1; i < count; i++) {
+        path.lineTo(_xs[i], _tops[i]);
+      }
+    } else {
+      path.moveTo(_xs[0], contentRect.bottom);
+      for (int i = 0; i < count; i++) {
+        path.lineTo(_xs[i], _tops[i]);
+      }
+      path
+        ..lineTo(_xs[count - 1], contentRect.bottom)
+        ..close();
+    }
+
+    _xs.clear();
+    _tops.clear();
+    _bottoms.clear();
+  }
+
+  void _addBar(Rect rect) {
+    final borderRadius = style.borderRadius;
+    if (borderRadius != null) {
+      path.addRRect(
+        RRect.fromRectAndCorners(
+          rect,
+          topLeft: borderRadius.topLeft,
+          topRight: borderRadius.topRight,
+          bottomLeft: borderRadius.bottomLeft,
+          bottomRight: borderRadius.bottomRight,
+        ),
+      );
+    } else {
+      path.addRect(rect);
+    }
+  }
+}
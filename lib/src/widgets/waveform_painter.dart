@@ -1,10 +1,31 @@
+import 'dart:ui' as ui;
+
 import 'package:flutter/material.dart';
+import 'package:sonix/src/models/waveform_bins.dart';
 import 'package:sonix/src/models/waveform_data.dart';
 import 'package:sonix/src/models/waveform_type.dart';
+import 'package:sonix/src/processing/display_resample_cache.dart';
 import 'package:sonix/src/processing/display_sampler.dart';
+import 'package:sonix/src/processing/downsample_method.dart';
 import 'waveform_style.dart';
 
 /// Custom painter for efficient waveform rendering
+///
+/// The waveform itself is recorded once per waveform, size and style into
+/// two [ui.Picture]s: one rendered entirely in the played style and one in the
+/// unplayed style. Each frame then only replays both, clipped at the
+/// playback position, so progress updates (for example from
+/// `WaveformController.updatePosition`) cost the same on a waveform of 10
+/// bars as on one of 10,000:
+///
+/// ```
+/// [ played picture  |  unplayed picture ]
+///   clip: 0..x         clip: x..width       x = playback position
+/// ```
+///
+/// Bars are batched into a single path, drawn with one [Paint] whose shader
+/// is created once per recording. Recordings are kept on the [WaveformData]
+/// itself and shared by every painter showing the same waveform.
 class WaveformPainter extends CustomPainter {
   /// Waveform data to render
   final WaveformData waveformData;
@@ -18,12 +39,16 @@ class WaveformPainter extends CustomPainter {
   /// Animation value for smooth transitions
   final double animationValue;
 
+  /// Recordings kept per waveform (a few sizes or styles of the same data)
+  static const int _maxLayersPerWaveform = 2;
+
+  static final Expando<List<_WaveformLayers>> _layerCache = Expando('waveformLayers');
+
   const WaveformPainter({required this.waveformData, required this.style, this.playbackPosition, this.animationValue = 1.0});
 
   @override
   void paint(Canvas canvas, Size size) {
-    final sourceAmplitudes = waveformData.amplitudes;
-    if (sourceAmplitudes.isEmpty) return;
+    if (waveformData.amplitudes.isEmpty) return;
 
     // Apply anti-aliasing
     if (style.antiAlias) {
@@ -35,83 +60,184 @@ class WaveformPainter extends CustomPainter {
       canvas.saveLayer(Offset.zero & size, Paint()..color = Colors.white.withValues(alpha: style.opacity));
     }
 
+    final layers = _layersFor(size);
+    final contentRect = layers.contentRect;
+    final playedWidth = playbackPosition != null ? contentRect.width * playbackPosition! * animationValue : 0.0;
+    final split = contentRect.left + playedWidth.clamp(0.0, contentRect.width);
+
+    // Only the clip boundary depends on the playback position
+    if (playedWidth > 0) {
+      canvas.save();
+      canvas.clipRect(Rect.fromLTRB(0, 0, split, size.height));
+      canvas.drawPicture(layers.played);
+      canvas.restore();
+
+      canvas.save();
+      canvas.clipRect(Rect.fromLTRB(split, 0, size.width, size.height));
+      canvas.drawPicture(layers.unplayed);
+      canvas.restore();
+    } else {
+      canvas.drawPicture(layers.unplayed);
+    }
+
+    // Apply gradient overlay if specified
+    final overlayPaint = layers.overlayPaint;
+    if (overlayPaint != null) {
+      canvas.drawRect(contentRect, overlayPaint);
+    }
+
+    // Restore opacity layer
+    if (style.opacity < 1.0) {
+      canvas.restore();
+    }
+  }
+
+  /// Cached recordings for the current waveform, size and style
+  _WaveformLayers _layersFor(Size size) {
+    final cached = _layerCache[waveformData] ??= <_WaveformLayers>[];
+    for (final layers in cached) {
+      if (layers.matches(waveformData, style, size)) {
+        return layers;
+      }
+    }
+
+    final layers = _record(size);
+    if (cached.length >= _maxLayersPerWaveform) {
+      cached.removeAt(0).dispose();
+    }
+    cached.add(layers);
+    return layers;
+  }
+
+  /// Record the played and unplayed renderings of the waveform
+  _WaveformLayers _record(Size size) {
     // Calculate content area (accounting for padding)
     final contentRect = Rect.fromLTWH(style.padding.left, style.padding.top, size.width - style.padding.horizontal, size.height - style.padding.vertical);
 
-    // Draw background
-    if (style.backgroundColor != Colors.transparent) {
-      final backgroundPaint = Paint()..color = style.backgroundColor;
-      canvas.drawRect(Offset.zero & size, backgroundPaint);
+    // Calculate display resolution based on style and available width
+    final sourceAmplitudes = waveformData.amplitudes;
+    final displayResolution = style.autoDisplayResolution
+        ? (style.fixedDisplayResolution ??
+              DisplaySampler.calculateDisplayResolution(
+                availableWidth: contentRect.width,
+                barWidth: style.barWidth,
+                barSpacing: style.barSpacing,
+                displayDensity: style.displayDensity,
+                waveformType: style.type,
+              ))
+        : (style.fixedDisplayResolution ?? sourceAmplitudes.length);
+
+    // Signed min/max envelope when the waveform carries bins
+    final bins = waveformData.bins;
+    final useEnvelope = style.downsampleMethod == DownsampleMethod.minMax && bins != null && !bins.isEmpty;
+
+    // The shape is the same for both renderings; only the paint differs
+    final Path shape;
+    final bool stroke;
+    if (useEnvelope) {
+      final displayBins = DisplayResampleCache.bins(waveformData, targetCount: displayResolution);
+      if (style.type == WaveformType.bars) {
+        shape = _envelopeBarsPath(contentRect, displayBins);
+        stroke = false;
+      } else {
+        shape = _envelopeAreaPath(contentRect, displayBins);
+        stroke = style.type == WaveformType.line;
+      }
+    } else {
+      // Resample amplitudes to match display resolution; memoized per
+      // waveform, so other sizes and painters reuse the result
+      final displayAmplitudes = DisplayResampleCache.amplitudes(
+        waveformData,
+        targetCount: displayResolution,
+        downsampleMethod: style.downsampleMethod,
+        upsampleMethod: style.upsampleMethod,
+      );
+      switch (style.type) {
+        case WaveformType.bars:
+          shape = _barsPath(contentRect, displayAmplitudes);
+          stroke = false;
+          break;
+        case WaveformType.line:
+          shape = _linePath(contentRect, displayAmplitudes);
+          stroke = true;
+          break;
+        case WaveformType.filled:
+          shape = _filledPath(contentRect, displayAmplitudes);
+          stroke = false;
+          break;
+      }
     }
 
-    // Calculate display resolution based on style and available width
-    final displayResolution = style.autoDisplayResolution 
-      ? (style.fixedDisplayResolution ?? DisplaySampler.calculateDisplayResolution(
-          availableWidth: contentRect.width,
-          barWidth: style.barWidth,
-          barSpacing: style.barSpacing,
-          displayDensity: style.displayDensity,
-          waveformType: style.type,
-        ))
-      : (style.fixedDisplayResolution ?? sourceAmplitudes.length);
-
-    // Resample amplitudes to match display resolution
-    final displayAmplitudes = DisplaySampler.resampleForDisplay(
-      sourceAmplitudes: sourceAmplitudes,
-      targetCount: displayResolution,
-      downsampleMethod: style.downsampleMethod,
-      upsampleMethod: style.upsampleMethod,
-    );
+    ui.Picture recordLayer(bool isPlayed) {
+      final recorder = ui.PictureRecorder();
+      final canvas = Canvas(recorder);
 
-    // Calculate dimensions
-    final centerY = contentRect.center.dy;
-    final playedWidth = playbackPosition != null ? contentRect.width * playbackPosition! * animationValue : 0.0;
+      // Draw background
+      if (style.backgroundColor != Colors.transparent) {
+        canvas.drawRect(Offset.zero & size, Paint()..color = style.backgroundColor);
+      }
 
-    // Draw center line if enabled
-    if (style.showCenterLine) {
-      final centerLinePaint = Paint()
-        ..color = style.centerLineColor
-        ..strokeWidth = style.centerLineWidth;
-      canvas.drawLine(Offset(contentRect.left, centerY), Offset(contentRect.right, centerY), centerLinePaint);
-    }
+      // Draw center line if enabled
+      if (style.showCenterLine) {
+        final centerY = contentRect.center.dy;
+        final centerLinePaint = Paint()
+          ..color = style.centerLineColor
+          ..strokeWidth = style.centerLineWidth;
+        canvas.drawLine(Offset(contentRect.left, centerY), Offset(contentRect.right, centerY), centerLinePaint);
+      }
 
-    // Render based on waveform type using display-sampled amplitudes
-    switch (style.type) {
-      case WaveformType.bars:
-        _paintBars(canvas, contentRect, displayAmplitudes, centerY, playedWidth);
-        break;
-      case WaveformType.line:
-        _paintLine(canvas, contentRect, displayAmplitudes, centerY, playedWidth);
-        break;
-      case WaveformType.filled:
-        _paintFilled(canvas, contentRect, displayAmplitudes, centerY, playedWidth);
-        break;
+      canvas.drawPath(shape, _shapePaint(contentRect, isPlayed, stroke));
+      return recorder.endRecording();
     }
 
-    // Apply gradient overlay if specified
-    if (style.gradient != null) {
-      final gradientPaint = Paint()
-        ..shader = style.gradient!.createShader(contentRect)
-        ..blendMode = style.gradientBlendMode;
-      canvas.drawRect(contentRect, gradientPaint);
+    final gradient = style.gradient;
+    return _WaveformLayers(
+      source: sourceAmplitudes,
+      style: style,
+      size: size,
+      contentRect: contentRect,
+      played: recordLayer(true),
+      unplayed: recordLayer(false),
+      overlayPaint: gradient == null
+          ? null
+          : (Paint()
+              ..shader = gradient.createShader(contentRect)
+              ..blendMode = style.gradientBlendMode),
+    );
+  }
+
+  /// Paint for the played or unplayed shape, honoring gradients
+  Paint _shapePaint(Rect contentRect, bool isPlayed, bool stroke) {
+    final gradient = isPlayed ? style.playedGradient : style.unplayedGradient;
+    final paint = Paint();
+    if (gradient != null) {
+      paint.shader = gradient.createShader(contentRect);
+    } else {
+      paint.color = isPlayed ? style.playedColor : style.unplayedColor;
     }
 
-    // Restore opacity layer
-    if (style.opacity < 1.0) {
-      canvas.restore();
+    if (stroke) {
+      paint
+        ..style = PaintingStyle.stroke
+        ..strokeWidth = style.strokeWidth
+        ..strokeCap = StrokeCap.round
+        ..strokeJoin = StrokeJoin.round;
+    } else {
+      paint.style = PaintingStyle.fill;
     }
+    return paint;
   }
 
-  /// Paint waveform as bars
-  void _paintBars(Canvas canvas, Rect contentRect, List<double> amplitudes, double centerY, double playedWidth) {
-    final barCount = amplitudes.length;
-    if (barCount == 0) return;
+  /// All bars of the waveform in one path
+  Path _barsPath(Rect contentRect, List<double> amplitudes) {
+    final path = Path();
+    final centerY = contentRect.center.dy;
 
     // Use exact user-specified bar width and spacing
     // The display sampling already calculated the optimal number of bars
     final barUnit = style.barWidth + style.barSpacing;
-    
-    for (int i = 0; i < barCount; i++) {
+
+    for (int i = 0; i < amplitudes.length; i++) {
       final x = contentRect.left + i * barUnit;
       final amplitude = (amplitudes[i] * style.amplitudeScale).clamp(0.0, 1.0);
 
@@ -119,181 +245,118 @@ class WaveformPainter extends CustomPainter {
       var barHeight = amplitude * (contentRect.height / 2);
       barHeight = barHeight.clamp(style.minBarHeight, style.maxBarHeight ?? double.infinity);
 
-      // Determine color/gradient based on playback position
-      final isPlayed = (x - contentRect.left) < playedWidth;
-
-      Paint paint;
-      if (isPlayed && style.playedGradient != null) {
-        paint = Paint()
-          ..shader = style.playedGradient!.createShader(contentRect)
-          ..style = PaintingStyle.fill;
-      } else if (!isPlayed && style.unplayedGradient != null) {
-        paint = Paint()
-          ..shader = style.unplayedGradient!.createShader(contentRect)
-          ..style = PaintingStyle.fill;
-      } else {
-        final color = isPlayed ? style.playedColor : style.unplayedColor;
-        paint = Paint()
-          ..color = color
-          ..style = PaintingStyle.fill;
-      }
+      // Bar centered around centerY using exact user-specified width
+      _addBar(path, Rect.fromLTWH(x, centerY - barHeight / 2, style.barWidth, barHeight));
+    }
+    return path;
+  }
+
+  /// The signed min/max envelope as bars in one path
+  ///
+  /// Each bar spans from the bin minimum to the bin maximum, so asymmetric
+  /// signals are drawn off-center the way they really are.
+  Path _envelopeBarsPath(Rect contentRect, WaveformBins bins) {
+    final path = Path();
+    final centerY = contentRect.center.dy;
+    final halfHeight = contentRect.height / 2;
+    final barUnit = style.barWidth + style.barSpacing;
+    final minValues = bins.min;
+    final maxValues = bins.max;
 
-      // Draw bar (centered around centerY) using exact user-specified width
-      final rect = Rect.fromLTWH(x, centerY - barHeight / 2, style.barWidth, barHeight);
+    for (int i = 0; i < bins.length; i++) {
+      final x = contentRect.left + i * barUnit;
+      var top = centerY - (maxValues[i] * style.amplitudeScale).clamp(-1.0, 1.0) * halfHeight;
+      var bottom = centerY - (minValues[i] * style.amplitudeScale).clamp(-1.0, 1.0) * halfHeight;
 
-      if (style.borderRadius != null) {
-        final rrect = RRect.fromRectAndCorners(
+      // Apply min/max height constraints around the middle of the bar
+      final barHeight = (bottom - top).clamp(style.minBarHeight, style.maxBarHeight ?? double.infinity);
+      final middle = (top + bottom) / 2;
+      top = middle - barHeight / 2;
+      bottom = middle + barHeight / 2;
+
+      _addBar(path, Rect.fromLTRB(x, top, x + style.barWidth, bottom));
+    }
+    return path;
+  }
+
+  void _addBar(Path path, Rect rect) {
+    final borderRadius = style.borderRadius;
+    if (borderRadius != null) {
+      path.addRRect(
+        RRect.fromRectAndCorners(
           rect,
-          topLeft: style.borderRadius!.topLeft,
-          topRight: style.borderRadius!.topRight,
-          bottomLeft: style.borderRadius!.bottomLeft,
-          bottomRight: style.borderRadius!.bottomRight,
-        );
-        canvas.drawRRect(rrect, paint);
-      } else {
-        canvas.drawRect(rect, paint);
-      }
+          topLeft: borderRadius.topLeft,
+          topRight: borderRadius.topRight,
+          bottomLeft: borderRadius.bottomLeft,
+          bottomRight: borderRadius.bottomRight,
+        ),
+      );
+    } else {
+      path.addRect(rect);
     }
   }
 
-  /// Paint waveform as a continuous line
-  void _paintLine(Canvas canvas, Rect contentRect, List<double> amplitudes, double centerY, double playedWidth) {
-    if (amplitudes.length < 2) return;
+  /// The signed min/max envelope as a closed outline (line) or area (filled)
+  ///
+  /// The upper edge follows the bin maxima left to right and the lower edge
+  /// follows the bin minima back.
+  Path _envelopeAreaPath(Rect contentRect, WaveformBins bins) {
+    final count = bins.length;
+    final centerY = contentRect.center.dy;
+    final halfHeight = contentRect.height / 2;
+    final minValues = bins.min;
+    final maxValues = bins.max;
+    double xAt(int i) => count == 1 ? contentRect.left : contentRect.left + (i / (count - 1)) * contentRect.width;
+
+    final path = Path()..moveTo(xAt(0), centerY - (maxValues[0] * style.amplitudeScale).clamp(-1.0, 1.0) * halfHeight);
+    for (int i = 1; i < count; i++) {
+      path.lineTo(xAt(i), centerY - (maxValues[i] * style.amplitudeScale).clamp(-1.0, 1.0) * halfHeight);
+    }
+    for (int i = count - 1; i >= 0; i--) {
+      path.lineTo(xAt(i), centerY - (minValues[i] * style.amplitudeScale).clamp(-1.0, 1.0) * halfHeight);
+    }
+    return path..close();
+  }
 
+  /// The waveform as a continuous line
+  Path _linePath(Rect contentRect, List<double> amplitudes) {
     final path = Path();
-    final playedPath = Path();
+    if (amplitudes.length < 2) return path;
 
-    // Calculate points
-    final points = <Offset>[];
+    final centerY = contentRect.center.dy;
     for (int i = 0; i < amplitudes.length; i++) {
       final x = contentRect.left + (i / (amplitudes.length - 1)) * contentRect.width;
       final amplitude = (amplitudes[i] * style.amplitudeScale).clamp(0.0, 1.0);
       final y = centerY - (amplitude * (contentRect.height / 2));
-      points.add(Offset(x, y));
-    }
-
-    // Create main path
-    path.moveTo(points[0].dx, points[0].dy);
-    for (int i = 1; i < points.length; i++) {
-      path.lineTo(points[i].dx, points[i].dy);
-    }
-
-    // Create played portion path
-    if (playedWidth > 0) {
-      playedPath.moveTo(points[0].dx, points[0].dy);
-      final playedEndX = contentRect.left + playedWidth;
-
-      for (int i = 1; i < points.length; i++) {
-        if (points[i].dx <= playedEndX) {
-          playedPath.lineTo(points[i].dx, points[i].dy);
-        } else {
-          // Interpolate the exact position at playedWidth
-          final prevPoint = points[i - 1];
-          final currentPoint = points[i];
-          final t = (playedEndX - prevPoint.dx) / (currentPoint.dx - prevPoint.dx);
-          final interpolatedY = prevPoint.dy + (currentPoint.dy - prevPoint.dy) * t;
-          playedPath.lineTo(playedEndX, interpolatedY);
-          break;
-        }
-      }
-    }
-
-    // Draw unplayed portion
-    Paint unplayedPaint;
-    if (style.unplayedGradient != null) {
-      unplayedPaint = Paint()
-        ..shader = style.unplayedGradient!.createShader(contentRect)
-        ..strokeWidth = style.strokeWidth
-        ..style = PaintingStyle.stroke
-        ..strokeCap = StrokeCap.round;
-    } else {
-      unplayedPaint = Paint()
-        ..color = style.unplayedColor
-        ..strokeWidth = style.strokeWidth
-        ..style = PaintingStyle.stroke
-        ..strokeCap = StrokeCap.round;
-    }
-    canvas.drawPath(path, unplayedPaint);
-
-    // Draw played portion
-    if (playedWidth > 0) {
-      Paint playedPaint;
-      if (style.playedGradient != null) {
-        playedPaint = Paint()
-          ..shader = style.playedGradient!.createShader(contentRect)
-          ..strokeWidth = style.strokeWidth
-          ..style = PaintingStyle.stroke
-          ..strokeCap = StrokeCap.round;
+      if (i == 0) {
+        path.moveTo(x, y);
       } else {
-        playedPaint = Paint()
-          ..color = style.playedColor
-          ..strokeWidth = style.strokeWidth
-          ..style = PaintingStyle.stroke
-          ..strokeCap = StrokeCap.round;
+        path.lineTo(x, y);
       }
-      canvas.drawPath(playedPath, playedPaint);
     }
+    return path;
   }
 
-  /// Paint waveform as filled area
-  void _paintFilled(Canvas canvas, Rect contentRect, List<double> amplitudes, double centerY, double playedWidth) {
-    if (amplitudes.isEmpty) return;
+  /// The waveform as a filled area down to the bottom edge
+  Path _filledPath(Rect contentRect, List<double> amplitudes) {
+    final path = Path();
+    if (amplitudes.isEmpty) return path;
 
-    final unplayedPath = Path();
-    final playedPath = Path();
+    final centerY = contentRect.center.dy;
 
     // Start from bottom left
-    unplayedPath.moveTo(contentRect.left, contentRect.bottom);
-    playedPath.moveTo(contentRect.left, contentRect.bottom);
+    path.moveTo(contentRect.left, contentRect.bottom);
 
     // Create waveform outline
     for (int i = 0; i < amplitudes.length; i++) {
-      final x = contentRect.left + (i / (amplitudes.length - 1)) * contentRect.width;
+      final x = amplitudes.length == 1 ? contentRect.left : contentRect.left + (i / (amplitudes.length - 1)) * contentRect.width;
       final amplitude = (amplitudes[i] * style.amplitudeScale).clamp(0.0, 1.0);
       final y = centerY - (amplitude * (contentRect.height / 2));
-
-      unplayedPath.lineTo(x, y);
-      if ((x - contentRect.left) <= playedWidth) {
-        playedPath.lineTo(x, y);
-      }
+      path.lineTo(x, y);
     }
 
-    // Close paths
-    unplayedPath.lineTo(contentRect.right, contentRect.bottom);
-    unplayedPath.close();
-
-    if (playedWidth > 0) {
-      playedPath.lineTo(contentRect.left + playedWidth, contentRect.bottom);
-      playedPath.close();
-    }
-
-    // Draw unplayed area
-    Paint unplayedPaint;
-    if (style.unplayedGradient != null) {
-      unplayedPaint = Paint()
-        ..shader = style.unplayedGradient!.createShader(contentRect)
-        ..style = PaintingStyle.fill;
-    } else {
-      unplayedPaint = Paint()
-        ..color = style.unplayedColor
-        ..style = PaintingStyle.fill;
-    }
-    canvas.drawPath(unplayedPath, unplayedPaint);
-
-    // Draw played area
-    if (playedWidth > 0) {
-      Paint playedPaint;
-      if (style.playedGradient != null) {
-        playedPaint = Paint()
-          ..shader = style.playedGradient!.createShader(contentRect)
-          ..style = PaintingStyle.fill;
-      } else {
-        playedPaint = Paint()
-          ..color = style.playedColor
-          ..style = PaintingStyle.fill;
-      }
-      canvas.drawPath(playedPath, playedPaint);
-    }
+    path.lineTo(contentRect.right, contentRect.bottom);
+    return path..close();
   }
 
   @override
@@ -304,3 +367,38 @@ class WaveformPainter extends CustomPainter {
         oldDelegate.animationValue != animationValue;
   }
 }
+
+/// Played and unplayed recordings of one waveform at one size and style
+class _WaveformLayers {
+  /// Amplitude buffer the recordings were made from
+  final List<double> source;
+  final WaveformStyle style;
+  final Size size;
+  final Rect contentRect;
+  final ui.Picture played;
+  final ui.Picture unplayed;
+  final Paint? overlayPaint;
+
+  _WaveformLayers({
+    required this.source,
+    required this.style,
+    required this.size,
+    required this.contentRect,
+    required this.played,
+    required this.unplayed,
+    required this.overlayPaint,
+  });
+
+  /// Whether these recordings show [waveformData] in [style] at [size]
+  ///
+  /// `WaveformData.dispose()` swaps the amplitude buffer, which invalidates
+  /// the recordings.
+  bool matches(WaveformData waveformData, WaveformStyle style, Size size) {
+    return identical(source, waveformData.amplitudes) && this.size == size && this.style == style;
+  }
+
+  void dispose() {
+    played.dispose();
+    unplayed.dispose();
+  }
+}
@@ -0,0 +1,118 @@
+import 'dart:math' as math;
+
+import 'package:flutter/foundation.dart';
+
+/// Controller for the visible range of a `ScrollableWaveformWidget`.
+///
+/// The viewport is described in audio frames: [startFrame] is the frame at
+/// the left edge and [framesPerPixel] the zoom level. The widget reports the
+/// length of its source and its width through [updateExtent], after which
+/// scrolling and zooming are clamped so the viewport never leaves the audio
+/// and never zooms out past the whole recording.
+///
+/// ## Basic Usage
+///
+/// ```dart
+/// final viewport = WaveformViewportController();
+///
+/// ScrollableWaveformWidget(source: WaveformDataRangeSource(waveformData), viewportController: viewport);
+///
+/// // Show ten seconds around the one hour mark
+/// viewport.showRange(3600.0 * 44100, 3610.0 * 44100);
+/// ```
+class WaveformViewportController extends ChangeNotifier {
+  double _startFrame;
+  double? _framesPerPixel;
+  int _totalFrames = 0;
+  double _viewportWidth = 0.0;
+
+  /// Closest zoom level, in frames per pixel
+  final double minFramesPerPixel;
+
+  /// Creates a controller, optionally starting at [startFrame] and [framesPerPixel]
+  ///
+  /// Without [framesPerPixel] the whole recording is shown once the widget
+  /// has been laid out.
+  WaveformViewportController({double startFrame = 0.0, double? framesPerPixel, this.minFramesPerPixel = 1.0})
+    : _startFrame = math.max(0.0, startFrame),
+      _framesPerPixel = framesPerPixel;
+
+  /// Frame at the left edge of the viewport
+  double get startFrame => _startFrame;
+
+  /// Zoom level in audio frames per logical pixel
+  ///
+  /// Before the widget has been laid out this is [minFramesPerPixel] unless
+  /// a zoom level was given.
+  double get framesPerPixel => _framesPerPixel ?? minFramesPerPixel;
+
+  /// Frame at the right edge of the viewport
+  double get endFrame => _startFrame + _viewportWidth * framesPerPixel;
+
+  /// Total number of frames reported by the widget
+  int get totalFrames => _totalFrames;
+
+  /// Width of the viewport in logical pixels reported by the widget
+  double get viewportWidth => _viewportWidth;
+
+  /// Furthest zoom level: the whole recording fits the viewport
+  double get maxFramesPerPixel => _viewportWidth > 0 ? math.max(minFramesPerPixel, _totalFrames / _viewportWidth) : minFramesPerPixel;
+
+  /// Called by the widget with the length of its source and its width
+  ///
+  /// Does not notify listeners; the widget is already rebuilding.
+  void updateExtent(int totalFrames, double viewportWidth) {
+    _totalFrames = totalFrames;
+    _viewportWidth = viewportWidth;
+    _framesPerPixel = (_framesPerPixel ?? maxFramesPerPixel).clamp(minFramesPerPixel, maxFramesPerPixel);
+    _startFrame = _clampStart(_startFrame);
+  }
+
+  /// Scrolls so [frame] is at the left edge
+  void scrollTo(double frame) {
+    _update(frame, _framesPerPixel);
+  }
+
+  /// Scrolls by [pixels] logical pixels; positive values move later in time
+  void scrollBy(double pixels) {
+    _update(_startFrame + pixels * framesPerPixel, _framesPerPixel);
+  }
+
+  /// Zooms to [framesPerPixel], keeping the frame under [focalPixel] in place
+  void zoomTo(double framesPerPixel, {double focalPixel = 0.0}) {
+    final focalFrame = _startFrame + focalPixel * this.framesPerPixel;
+    final zoom = _viewportWidth > 0 ? framesPerPixel.clamp(minFramesPerPixel, maxFramesPerPixel) : math.max(minFramesPerPixel, framesPerPixel);
+    _update(focalFrame - focalPixel * zoom, zoom);
+  }
+
+  /// Zooms in by [factor] (greater than 1) or out (less than 1) around [focalPixel]
+  void zoomBy(double factor, {double focalPixel = 0.0}) {
+    if (factor <= 0) return;
+    zoomTo(framesPerPixel / factor, focalPixel: focalPixel);
+  }
+
+  /// Scrolls and zooms so frames `[startFrame, endFrame)` fill the viewport
+  void showRange(double startFrame, double endFrame) {
+    if (_viewportWidth <= 0 || endFrame <= startFrame) {
+      _update(startFrame, _framesPerPixel);
+      return;
+    }
+    _update(startFrame, ((endFrame - startFrame) / _viewportWidth).clamp(minFramesPerPixel, maxFramesPerPixel));
+  }
+
+  void _update(double startFrame, double? framesPerPixel) {
+    final previousStart = _startFrame;
+    final previousZoom = _framesPerPixel;
+    _framesPerPixel = framesPerPixel;
+    _startFrame = _clampStart(startFrame);
+    if (_startFrame != previousStart || _framesPerPixel != previousZoom) {
+      notifyListeners();
+    }
+  }
+
+  double _clampStart(double frame) {
+    if (_viewportWidth <= 0) return math.max(0.0, frame);
+    final maxStart = math.max(0.0, _totalFrames - _viewportWidth * framesPerPixel);
+    return frame.clamp(0.0, maxStart);
+  }
+}
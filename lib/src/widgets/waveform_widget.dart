@@ -118,6 +118,12 @@ import 'waveform_controller.dart';
 ///   },
 /// )
 /// ```
+///
+/// ## Long Timelines
+///
+/// This widget fits the whole waveform into its width. For recordings that
+/// should be scrolled and zoomed, use `ScrollableWaveformWidget`, which only
+/// computes and paints the part under the viewport.
 class WaveformWidget extends StatefulWidget {
   /// The waveform data to visualize.
   ///
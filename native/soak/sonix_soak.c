@@ -0,0 +1,418 @@
+// Soak/leak harness for the native decoding layer.
+//
+// Runs decode, in-memory decode, chunked decode, seek, cancel, decode-once
+// waveform and scratch-file jobs over the given files from many threads,
+// including corrupt and truncated files, and fails if any native resource is
+// still live at the end or the resident set keeps growing after warm-up.
+//
+// Build with -DSONIX_BUILD_SOAK=ON, then for example:
+//   ./sonix_soak --threads 8 --iterations 20000 test/assets/*.* test/assets/real_audio/*
+//
+// Exit status: 0 clean, 1 leak detected, 2 usage error.
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "sonix_native.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#endif
+
+enum
+{
+    OP_DECODE_FILE,
+    OP_DECODE_MEMORY,
+    OP_CHUNKED,
+    OP_SEEK,
+    OP_CANCEL,
+    OP_WAVEFORMS,
+    OP_SCRATCH,
+    OP_COUNT
+};
+
+static const char *const k_op_names[OP_COUNT] = {"decode_file", "decode_memory", "chunked", "seek", "cancel", "waveforms", "scratch"};
+
+// Guard against decoders that never report a final chunk
+#define MAX_CHUNKS 100000
+
+typedef struct
+{
+    const char **files;
+    int file_count;
+    long iterations;
+    long warmup;
+    long report_every;
+    const char *scratch_dir;
+} SoakOptions;
+
+static SoakOptions g_options;
+static long g_next_iteration = 0;
+static long g_succeeded[OP_COUNT];
+static long g_failed[OP_COUNT];
+static uint64_t g_warm_rss = 0;
+static pthread_mutex_t g_report_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static uint64_t current_rss_bytes(void)
+{
+#if defined(__APPLE__)
+    struct mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) != KERN_SUCCESS)
+    {
+        return 0;
+    }
+    return (uint64_t)info.resident_size;
+#else
+    long total_pages = 0;
+    long resident_pages = 0;
+    FILE *statm = fopen("/proc/self/statm", "r");
+    if (!statm)
+    {
+        return 0;
+    }
+    if (fscanf(statm, "%ld %ld", &total_pages, &resident_pages) != 2)
+    {
+        resident_pages = 0;
+    }
+    fclose(statm);
+    return (uint64_t)resident_pages * (uint64_t)sysconf(_SC_PAGESIZE);
+#endif
+}
+
+// xorshift32: per-thread, so seek targets and cancel points need no lock
+static uint32_t next_random(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+static int run_decode_file(const char *path)
+{
+    SonixAudioData *audio = sonix_decode_file(path);
+    if (!audio)
+    {
+        return 0;
+    }
+    sonix_free_audio_data(audio);
+    return 1;
+}
+
+static int run_decode_memory(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (!file)
+    {
+        return 0;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    uint8_t *data = size > 0 ? (uint8_t *)malloc((size_t)size) : NULL;
+    size_t read = data ? fread(data, 1, (size_t)size, file) : 0;
+    fclose(file);
+
+    SonixAudioData *audio = NULL;
+    if (data && read == (size_t)size)
+    {
+        audio = sonix_decode_audio(data, read, sonix_detect_format(data, read));
+    }
+    free(data);
+
+    if (!audio)
+    {
+        return 0;
+    }
+    sonix_free_audio_data(audio);
+    return 1;
+}
+
+// Decodes up to max_chunks chunks (all of them if negative); returns 1 if no chunk failed
+static int decode_chunks(SonixChunkedDecoder *decoder, long max_chunks, uint32_t *chunk_index)
+{
+    for (long i = 0; (max_chunks < 0 || i < max_chunks) && *chunk_index < MAX_CHUNKS; i++)
+    {
+        SonixFileChunk chunk = {0, 0, (*chunk_index)++};
+        SonixChunkResult *result = sonix_process_file_chunk(decoder, &chunk);
+        if (!result)
+        {
+            return 0;
+        }
+        int ok = result->success;
+        int final = result->is_final_chunk;
+        sonix_free_chunk_result(result);
+        if (!ok)
+        {
+            return 0;
+        }
+        if (final)
+        {
+            break;
+        }
+    }
+    return 1;
+}
+
+static int run_chunked(const char *path, int op, uint32_t *rng)
+{
+    SonixChunkedDecoder *decoder = sonix_init_chunked_decoder(SONIX_FORMAT_UNKNOWN, path);
+    if (!decoder)
+    {
+        return 0;
+    }
+
+    uint32_t chunk_index = 0;
+    int ok = 1;
+    if (op == OP_CHUNKED)
+    {
+        ok = decode_chunks(decoder, -1, &chunk_index);
+    }
+    else if (op == OP_SEEK)
+    {
+        uint32_t duration_ms = 0, sample_rate = 0, channels = 0;
+        sonix_get_decoder_media_info(decoder, &duration_ms, &sample_rate, &channels);
+        ok = sonix_seek_to_time(decoder, duration_ms > 0 ? next_random(rng) % duration_ms : 0) == SONIX_OK && decode_chunks(decoder, 2, &chunk_index);
+        ok = ok && sonix_seek_to_time(decoder, 0) == SONIX_OK && decode_chunks(decoder, 1, &chunk_index);
+    }
+    else
+    {
+        // Cancel: abandon the decoder part-way through the file
+        ok = decode_chunks(decoder, next_random(rng) % 4, &chunk_index);
+    }
+
+    sonix_cleanup_chunked_decoder(decoder);
+    return ok;
+}
+
+static int run_waveforms(const char *path)
+{
+    const SonixReducerConfig configs[] = {
+        {1000, SONIX_REDUCER_RMS, SONIX_CHANNEL_MODE_MIXED},
+        {200, SONIX_REDUCER_PEAK, SONIX_CHANNEL_MODE_PER_CHANNEL},
+        {50, SONIX_REDUCER_AVERAGE, SONIX_CHANNEL_MODE_MID_SIDE},
+    };
+    SonixMultiWaveformResult *result = sonix_generate_waveforms(path, configs, sizeof(configs) / sizeof(configs[0]));
+    if (!result)
+    {
+        return 0;
+    }
+    sonix_free_multi_waveform_result(result);
+    return 1;
+}
+
+static int run_scratch(const char *path, long thread_index)
+{
+    char scratch_path[4096];
+    snprintf(scratch_path, sizeof(scratch_path), "%s/sonix_soak_%ld_%ld.f32", g_options.scratch_dir, (long)getpid(), thread_index);
+
+    SonixScratchInfo info;
+    if (sonix_decode_to_scratch_file(path, scratch_path, &info) != SONIX_OK)
+    {
+        return 0;
+    }
+
+    uint64_t byte_size = 0;
+    float *data = sonix_map_scratch_file(scratch_path, &byte_size);
+    int ok = data != NULL;
+    if (data)
+    {
+        // Touch first and last pages so the mapping is really populated
+        volatile float sink = data[0] + data[byte_size / sizeof(float) - 1];
+        (void)sink;
+        sonix_unmap_scratch_file(data, byte_size);
+    }
+    remove(scratch_path);
+    return ok;
+}
+
+static void print_status(long iteration, const char *label)
+{
+    SonixResourceCounters counters;
+    sonix_get_resource_counters(&counters);
+    printf("%-8s iteration=%ld rss_mb=%.1f audio_data=%lld chunk_results=%lld decoders=%lld waveform_results=%lld "
+           "ffmpeg_contexts=%lld mappings=%lld\n",
+           label, iteration, current_rss_bytes() / (1024.0 * 1024.0), (long long)counters.audio_data, (long long)counters.chunk_results,
+           (long long)counters.chunked_decoders, (long long)counters.multi_waveform_results, (long long)counters.ffmpeg_contexts,
+           (long long)counters.mappings);
+    fflush(stdout);
+}
+
+static void *soak_thread(void *arg)
+{
+    long thread_index = (long)(intptr_t)arg;
+    uint32_t rng = 0x9e3779b9u ^ (uint32_t)(thread_index * 2654435761u);
+    if (rng == 0)
+    {
+        rng = 1;
+    }
+
+    for (;;)
+    {
+        long iteration = __atomic_fetch_add(&g_next_iteration, 1, __ATOMIC_RELAXED);
+        if (iteration >= g_options.iterations)
+        {
+            break;
+        }
+
+        // Every (file, operation) pair comes up once per OP_COUNT * file_count iterations
+        const int op = (int)(iteration % OP_COUNT);
+        const char *path = g_options.files[(iteration / OP_COUNT) % g_options.file_count];
+
+        int ok;
+        switch (op)
+        {
+        case OP_DECODE_FILE:
+            ok = run_decode_file(path);
+            break;
+        case OP_DECODE_MEMORY:
+            ok = run_decode_memory(path);
+            break;
+        case OP_WAVEFORMS:
+            ok = run_waveforms(path);
+            break;
+        case OP_SCRATCH:
+            ok = run_scratch(path, thread_index);
+            break;
+        default:
+            ok = run_chunked(path, op, &rng);
+            break;
+        }
+
+        // Failures are expected for corrupt and truncated files; only leaks fail the soak
+        __atomic_fetch_add(ok ? &g_succeeded[op] : &g_failed[op], 1, __ATOMIC_RELAXED);
+
+        long done = iteration + 1;
+        if (done == g_options.warmup || done % g_options.report_every == 0)
+        {
+            pthread_mutex_lock(&g_report_lock);
+            if (done == g_options.warmup)
+            {
+                g_warm_rss = current_rss_bytes();
+            }
+            print_status(done, done == g_options.warmup ? "warm" : "progress");
+            pthread_mutex_unlock(&g_report_lock);
+        }
+    }
+    return NULL;
+}
+
+static void usage(const char *program)
+{
+    fprintf(stderr,
+            "usage: %s [--threads N] [--iterations N] [--warmup N] [--report-every N] [--max-rss-growth-mb N] [--scratch-dir DIR] FILE...\n",
+            program);
+}
+
+int main(int argc, char **argv)
+{
+    long threads = 8;
+    double max_rss_growth_mb = 64;
+    g_options.iterations = 10000;
+    g_options.warmup = -1;
+    g_options.report_every = 1000;
+    g_options.scratch_dir = "/tmp";
+
+    int first_file = argc;
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const int has_value = i + 1 < argc;
+        if (strcmp(arg, "--threads") == 0 && has_value)
+            threads = atol(argv[++i]);
+        else if (strcmp(arg, "--iterations") == 0 && has_value)
+            g_options.iterations = atol(argv[++i]);
+        else if (strcmp(arg, "--warmup") == 0 && has_value)
+            g_options.warmup = atol(argv[++i]);
+        else if (strcmp(arg, "--report-every") == 0 && has_value)
+            g_options.report_every = atol(argv[++i]);
+        else if (strcmp(arg, "--max-rss-growth-mb") == 0 && has_value)
+            max_rss_growth_mb = atof(argv[++i]);
+        else if (strcmp(arg, "--scratch-dir") == 0 && has_value)
+            g_options.scratch_dir = argv[++i];
+        else if (arg[0] == '-')
+        {
+            usage(argv[0]);
+            return 2;
+        }
+        else
+        {
+            first_file = i;
+            break;
+        }
+    }
+
+    g_options.files = (const char **)(argv + first_file);
+    g_options.file_count = argc - first_file;
+    if (g_options.file_count == 0 || threads < 1 || g_options.iterations < 1 || g_options.report_every < 1)
+    {
+        usage(argv[0]);
+        return 2;
+    }
+    if (g_options.warmup < 0 || g_options.warmup >= g_options.iterations)
+    {
+        // Allocator pools and FFmpeg's static tables settle in the first tenth
+        g_options.warmup = g_options.iterations / 10;
+    }
+
+    // Initialize once up front instead of racing the first decodes
+    if (sonix_init_ffmpeg() != SONIX_OK)
+    {
+        fprintf(stderr, "FFmpeg initialization failed: %s\n", sonix_get_error_message());
+        return 2;
+    }
+
+    printf("Soaking %d files with %ld threads for %ld iterations (warm-up %ld)\n", g_options.file_count, threads, g_options.iterations, g_options.warmup);
+    print_status(0, "start");
+
+    pthread_t *workers = (pthread_t *)calloc((size_t)threads, sizeof(pthread_t));
+    if (!workers)
+    {
+        return 2;
+    }
+    for (long t = 0; t < threads; t++)
+    {
+        pthread_create(&workers[t], NULL, soak_thread, (void *)(intptr_t)t);
+    }
+    for (long t = 0; t < threads; t++)
+    {
+        pthread_join(workers[t], NULL);
+    }
+    free(workers);
+
+    print_status(g_options.iterations, "end");
+    for (int op = 0; op < OP_COUNT; op++)
+    {
+        printf("  %-14s ok=%ld failed=%ld\n", k_op_names[op], g_succeeded[op], g_failed[op]);
+    }
+
+    int leaked = 0;
+    SonixResourceCounters counters;
+    sonix_get_resource_counters(&counters);
+    if (counters.audio_data != 0 || counters.chunk_results != 0 || counters.chunked_decoders != 0 || counters.multi_waveform_results != 0 ||
+        counters.ffmpeg_contexts != 0 || counters.mappings != 0 || counters.mapped_bytes != 0)
+    {
+        printf("LEAK: native resources still live after all jobs finished\n");
+        leaked = 1;
+    }
+
+    const double growth_mb = ((double)current_rss_bytes() - (double)g_warm_rss) / (1024.0 * 1024.0);
+    printf("RSS growth after warm-up: %.1f MB (limit %.1f MB)\n", growth_mb, max_rss_growth_mb);
+    if (g_warm_rss > 0 && growth_mb > max_rss_growth_mb)
+    {
+        printf("LEAK: resident set kept growing after warm-up\n");
+        leaked = 1;
+    }
+
+    sonix_cleanup_ffmpeg();
+    printf("%s\n", leaked ? "FAILED" : "PASSED");
+    return leaked ? 1 : 0;
+}
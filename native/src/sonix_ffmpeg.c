@@ -11,28 +11,53 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
+#include <math.h>
 
-// Global error message buffer
-static char g_error_message[512] = {0};
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(_MSC_VER)
+#define SONIX_THREAD_LOCAL __declspec(thread)
+#else
+#define SONIX_THREAD_LOCAL __thread
+#endif
+
+// Error message of the last failing call, per thread: decodes run on several
+// threads at once (one per isolate), and a shared buffer let one thread's error
+// overwrite another's, or fail a decode that succeeded on its own thread
+static SONIX_THREAD_LOCAL char g_error_message[512] = {0};
 static int g_ffmpeg_initialized = 0;
 // Controls whether FFmpeg logs are forwarded to stderr (console).
 // Default is disabled to prevent noisy logs from leaking to consuming apps.
 static int g_forward_ffmpeg_logs = 0;
 
-// Memory management tracking for debugging
-#ifdef DEBUG
-static int g_active_contexts = 0;
-static int g_active_decoders = 0;
-#define TRACK_CONTEXT_ALLOC() (g_active_contexts++)
-#define TRACK_CONTEXT_FREE() (g_active_contexts--)
-#define TRACK_DECODER_ALLOC() (g_active_decoders++)
-#define TRACK_DECODER_FREE() (g_active_decoders--)
+// Live resource counts (sonix_get_resource_counters), updated atomically from
+// whichever thread allocates or frees
+static SonixResourceCounters g_resource_counters = {0};
+
+static void track_resource(int64_t *counter, int64_t delta)
+{
+#if defined(_MSC_VER)
+    InterlockedExchangeAdd64((volatile LONG64 *)counter, delta);
+#else
+    __atomic_fetch_add(counter, delta, __ATOMIC_RELAXED);
+#endif
+}
+
+static int64_t read_resource(int64_t *counter)
+{
+#if defined(_MSC_VER)
+    return InterlockedCompareExchange64((volatile LONG64 *)counter, 0, 0);
 #else
-#define TRACK_CONTEXT_ALLOC()
-#define TRACK_CONTEXT_FREE()
-#define TRACK_DECODER_ALLOC()
-#define TRACK_DECODER_FREE()
+    return __atomic_load_n(counter, __ATOMIC_RELAXED);
 #endif
+}
 
 // FFMPEG context structures for chunked processing (implementation)
 struct SonixChunkedDecoder
@@ -204,13 +229,15 @@ void sonix_cleanup_ffmpeg(void)
 
 #ifdef DEBUG
         // Check for resource leaks in debug mode
-        if (g_active_contexts > 0)
+        int64_t active_contexts = read_resource(&g_resource_counters.ffmpeg_contexts);
+        int64_t active_decoders = read_resource(&g_resource_counters.chunked_decoders);
+        if (active_contexts > 0)
         {
-            printf("WARNING: %d FFMPEG contexts still active during cleanup\n", g_active_contexts);
+            printf("WARNING: %lld FFMPEG contexts still active during cleanup\n", (long long)active_contexts);
         }
-        if (g_active_decoders > 0)
+        if (active_decoders > 0)
         {
-            printf("WARNING: %d chunked decoders still active during cleanup\n", g_active_decoders);
+            printf("WARNING: %lld chunked decoders still active during cleanup\n", (long long)active_decoders);
         }
 #endif
 
@@ -291,16 +318,53 @@ const char *sonix_get_error_message(void)
     return g_error_message;
 }
 
+// Snapshot of the live resource counts
+void sonix_get_resource_counters(SonixResourceCounters *counters)
+{
+    if (!counters)
+    {
+        return;
+    }
+
+    counters->audio_data = read_resource(&g_resource_counters.audio_data);
+    counters->chunk_results = read_resource(&g_resource_counters.chunk_results);
+    counters->chunked_decoders = read_resource(&g_resource_counters.chunked_decoders);
+    counters->multi_waveform_results = read_resource(&g_resource_counters.multi_waveform_results);
+    counters->ffmpeg_contexts = read_resource(&g_resource_counters.ffmpeg_contexts);
+    counters->mappings = read_resource(&g_resource_counters.mappings);
+    counters->mapped_bytes = read_resource(&g_resource_counters.mapped_bytes);
+}
+
+// Allocates a zeroed SonixAudioData, counted until sonix_free_audio_data
+static SonixAudioData *alloc_audio_data(const char *context)
+{
+    SonixAudioData *audio_data = (SonixAudioData *)safe_malloc(sizeof(SonixAudioData), context);
+    if (audio_data)
+    {
+        memset(audio_data, 0, sizeof(SonixAudioData));
+        track_resource(&g_resource_counters.audio_data, 1);
+    }
+    return audio_data;
+}
+
 // Memory debugging function (only available in debug builds)
 #ifdef DEBUG
 void sonix_debug_memory_status(void)
 {
+    SonixResourceCounters counters;
+    sonix_get_resource_counters(&counters);
+
     printf("FFMPEG Memory Status:\n");
-    printf("  Active contexts: %d\n", g_active_contexts);
-    printf("  Active decoders: %d\n", g_active_decoders);
+    printf("  Active contexts: %lld\n", (long long)counters.ffmpeg_contexts);
+    printf("  Active decoders: %lld\n", (long long)counters.chunked_decoders);
+    printf("  Audio data: %lld\n", (long long)counters.audio_data);
+    printf("  Chunk results: %lld\n", (long long)counters.chunk_results);
+    printf("  Waveform results: %lld\n", (long long)counters.multi_waveform_results);
+    printf("  Mappings: %lld (%lld bytes)\n", (long long)counters.mappings, (long long)counters.mapped_bytes);
     printf("  FFMPEG initialized: %s\n", g_ffmpeg_initialized ? "Yes" : "No");
 
-    if (g_active_contexts > 0 || g_active_decoders > 0)
+    if (counters.ffmpeg_contexts > 0 || counters.chunked_decoders > 0 || counters.audio_data > 0 || counters.chunk_results > 0 ||
+        counters.multi_waveform_results > 0 || counters.mappings > 0)
     {
         printf("  WARNING: Memory leaks detected!\n");
     }
@@ -501,8 +565,6 @@ SonixAudioData *sonix_decode_audio(const uint8_t *data, size_t size, int32_t for
     AVFrame *frame = NULL;
     SonixAudioData *audio_data = NULL;
 
-    TRACK_CONTEXT_ALLOC();
-
     // Create a copy of the data buffer for FFMPEG to manage
     // FFMPEG expects to own the buffer, so we need to allocate it properly
     const size_t input_buffer_size = size + AV_INPUT_BUFFER_PADDING_SIZE;
@@ -542,9 +604,11 @@ SonixAudioData *sonix_decode_audio(const uint8_t *data, size_t size, int32_t for
     int ret = avformat_open_input(&fmt_ctx, NULL, NULL, NULL);
     if (ret < 0)
     {
+        // avformat_open_input frees the context on failure
         set_ffmpeg_error(ret, "Failed to open input");
         goto cleanup;
     }
+    track_resource(&g_resource_counters.ffmpeg_contexts, 1);
 
     // Find stream info
     ret = avformat_find_stream_info(fmt_ctx, NULL);
@@ -588,6 +652,7 @@ SonixAudioData *sonix_decode_audio(const uint8_t *data, size_t size, int32_t for
         set_error_message("Failed to allocate codec context");
         goto cleanup;
     }
+    track_resource(&g_resource_counters.ffmpeg_contexts, 1);
 
     // Copy codec parameters
     ret = avcodec_parameters_to_context(codec_ctx, audio_stream->codecpar);
@@ -703,21 +768,18 @@ SonixAudioData *sonix_decode_audio(const uint8_t *data, size_t size, int32_t for
     }
 
     // Allocate audio data structure
-    audio_data = (SonixAudioData *)safe_malloc(sizeof(SonixAudioData), "audio data structure");
+    audio_data = alloc_audio_data("audio data structure");
     if (!audio_data)
     {
         goto cleanup;
     }
 
-    // Initialize audio data structure
-    memset(audio_data, 0, sizeof(SonixAudioData));
-
     // Allocate sample buffer with generous safety margin
     const size_t buffer_size = estimated_samples * sizeof(float);
     audio_data->samples = (float *)safe_malloc(buffer_size, "sample buffer");
     if (!audio_data->samples)
     {
-        free(audio_data);
+        sonix_free_audio_data(audio_data);
         audio_data = NULL;
         goto cleanup;
     }
@@ -732,6 +794,7 @@ SonixAudioData *sonix_decode_audio(const uint8_t *data, size_t size, int32_t for
         set_error_message("Failed to allocate resampler");
         goto cleanup;
     }
+    track_resource(&g_resource_counters.ffmpeg_contexts, 1);
 
     // Set resampler options
     av_opt_set_chlayout(swr_ctx, "in_chlayout", &codec_ctx->ch_layout, 0);
@@ -975,22 +1038,23 @@ cleanup:
     if (swr_ctx)
     {
         swr_free(&swr_ctx);
+        track_resource(&g_resource_counters.ffmpeg_contexts, -1);
     }
     if (codec_ctx)
     {
         avcodec_free_context(&codec_ctx);
+        track_resource(&g_resource_counters.ffmpeg_contexts, -1);
     }
     if (fmt_ctx)
     {
         avformat_close_input(&fmt_ctx);
+        track_resource(&g_resource_counters.ffmpeg_contexts, -1);
     }
     if (avio_ctx)
     {
         avio_context_free(&avio_ctx);
     }
 
-    TRACK_CONTEXT_FREE();
-
     // If we failed and allocated audio_data, clean it up
     if (!audio_data || g_error_message[0] != '\0')
     {
@@ -1025,6 +1089,7 @@ void sonix_free_audio_data(SonixAudioData *audio_data)
     audio_data->duration_ms = 0;
 
     free(audio_data);
+    track_resource(&g_resource_counters.audio_data, -1);
 }
 
 // MP3 debug stats - not applicable for FFMPEG backend
@@ -1063,16 +1128,14 @@ SonixChunkedDecoder *sonix_init_chunked_decoder(int32_t format, const char *file
     decoder->total_samples = 0;
     decoder->current_sample = 0;
 
-    TRACK_DECODER_ALLOC();
-
     // Copy file path safely
     decoder->file_path = safe_strdup(file_path, "file path");
     if (!decoder->file_path)
     {
         free(decoder);
-        TRACK_DECODER_FREE();
         return NULL;
     }
+    track_resource(&g_resource_counters.chunked_decoders, 1);
 
     // Open format context
     int ret = avformat_open_input(&decoder->format_ctx, file_path, NULL, NULL);
@@ -1081,6 +1144,7 @@ SonixChunkedDecoder *sonix_init_chunked_decoder(int32_t format, const char *file
         set_ffmpeg_error(ret, "Failed to open input file");
         goto init_cleanup;
     }
+    track_resource(&g_resource_counters.ffmpeg_contexts, 1);
 
     // Find stream info
     ret = avformat_find_stream_info(decoder->format_ctx, NULL);
@@ -1121,6 +1185,7 @@ SonixChunkedDecoder *sonix_init_chunked_decoder(int32_t format, const char *file
         set_error_message("Failed to allocate codec context");
         goto init_cleanup;
     }
+    track_resource(&g_resource_counters.ffmpeg_contexts, 1);
 
     ret = avcodec_parameters_to_context(decoder->codec_ctx, audio_stream->codecpar);
     if (ret < 0)
@@ -1157,6 +1222,7 @@ SonixChunkedDecoder *sonix_init_chunked_decoder(int32_t format, const char *file
         set_error_message("Failed to allocate resampler");
         goto init_cleanup;
     }
+    track_resource(&g_resource_counters.ffmpeg_contexts, 1);
 
     av_opt_set_chlayout(decoder->swr_ctx, "in_chlayout", &decoder->codec_ctx->ch_layout, 0);
     av_opt_set_int(decoder->swr_ctx, "in_sample_rate", decoder->codec_ctx->sample_rate, 0);
@@ -1189,21 +1255,24 @@ init_cleanup:
     if (decoder->swr_ctx)
     {
         swr_free(&decoder->swr_ctx);
+        track_resource(&g_resource_counters.ffmpeg_contexts, -1);
     }
     if (decoder->codec_ctx)
     {
         avcodec_free_context(&decoder->codec_ctx);
+        track_resource(&g_resource_counters.ffmpeg_contexts, -1);
     }
     if (decoder->format_ctx)
     {
         avformat_close_input(&decoder->format_ctx);
+        track_resource(&g_resource_counters.ffmpeg_contexts, -1);
     }
     if (decoder->file_path)
     {
         free(decoder->file_path);
     }
     free(decoder);
-    TRACK_DECODER_FREE();
+    track_resource(&g_resource_counters.chunked_decoders, -1);
     return NULL;
 }
 
@@ -1226,6 +1295,7 @@ SonixChunkResult *sonix_process_file_chunk(SonixChunkedDecoder *decoder, SonixFi
 
     // Initialize result structure
     memset(result, 0, sizeof(SonixChunkResult));
+    track_resource(&g_resource_counters.chunk_results, 1);
     result->chunk_index = file_chunk->chunk_index;
     result->success = 0;
     result->is_final_chunk = 0;
@@ -1248,13 +1318,12 @@ SonixChunkResult *sonix_process_file_chunk(SonixChunkedDecoder *decoder, SonixFi
     const uint32_t buffer_size = estimated_samples_per_chunk * channels;
 
     // Allocate audio data for this chunk
-    result->audio_data = (SonixAudioData *)safe_malloc(sizeof(SonixAudioData), "chunk audio data");
+    result->audio_data = alloc_audio_data("chunk audio data");
     if (!result->audio_data)
     {
         goto chunk_cleanup;
     }
 
-    memset(result->audio_data, 0, sizeof(SonixAudioData));
     result->audio_data->samples = (float *)safe_malloc(buffer_size * sizeof(float), "chunk samples");
     if (!result->audio_data->samples)
     {
@@ -1550,6 +1619,7 @@ void sonix_cleanup_chunked_decoder(SonixChunkedDecoder *decoder)
     {
         swr_free(&decoder->swr_ctx);
         decoder->swr_ctx = NULL;
+        track_resource(&g_resource_counters.ffmpeg_contexts, -1);
     }
 
     if (decoder->codec_ctx)
@@ -1568,12 +1638,14 @@ void sonix_cleanup_chunked_decoder(SonixChunkedDecoder *decoder)
 
         avcodec_free_context(&decoder->codec_ctx);
         decoder->codec_ctx = NULL;
+        track_resource(&g_resource_counters.ffmpeg_contexts, -1);
     }
 
     if (decoder->format_ctx)
     {
         avformat_close_input(&decoder->format_ctx);
         decoder->format_ctx = NULL;
+        track_resource(&g_resource_counters.ffmpeg_contexts, -1);
     }
 
     if (decoder->file_path)
@@ -1589,7 +1661,7 @@ void sonix_cleanup_chunked_decoder(SonixChunkedDecoder *decoder)
     decoder->current_sample = 0;
 
     free(decoder);
-    TRACK_DECODER_FREE();
+    track_resource(&g_resource_counters.chunked_decoders, -1);
 }
 
 // Free chunk result with comprehensive cleanup
@@ -1618,4 +1690,1128 @@ void sonix_free_chunk_result(SonixChunkResult *result)
     result->success = 0;
 
     free(result);
-}
\ No newline at end of file
+    track_resource(&g_resource_counters.chunk_results, -1);
+}
+// ---------------------------------------------------------------------------
+// Decode-once waveform pipeline
+// ---------------------------------------------------------------------------
+
+// Receives blocks of interleaved float frames from decode_all_frames().
+// Returns SONIX_OK to keep decoding; any other value aborts the decode.
+typedef int32_t (*SonixFrameSink)(void *sink_ctx, const float *samples, int frame_count, int channels);
+
+// Point input planes at the frame data, skipping frame_offset samples (encoder delay)
+static void offset_frame_planes(const AVFrame *frame, enum AVSampleFormat sample_fmt, int channels,
+                                int frame_offset, const uint8_t **input_data)
+{
+    int bytes_per_sample = av_get_bytes_per_sample(sample_fmt);
+    int plane_offset = av_sample_fmt_is_planar(sample_fmt)
+                           ? frame_offset * bytes_per_sample
+                           : frame_offset * channels * bytes_per_sample;
+
+    for (int i = 0; i < AV_NUM_DATA_POINTERS; i++)
+    {
+        input_data[i] = frame->data[i] ? frame->data[i] + plane_offset : NULL;
+    }
+}
+
+// Convert one decoded frame to interleaved float and hand it to the sink
+static int32_t deliver_decoded_frame(SonixChunkedDecoder *decoder, const AVFrame *frame,
+                                     float **scratch, int *scratch_frames,
+                                     SonixFrameSink sink, void *sink_ctx)
+{
+    const int channels = decoder->codec_ctx->ch_layout.nb_channels;
+    int samples_in_frame = frame->nb_samples;
+    int frame_offset = 0;
+
+    // Skip priming samples introduced by the encoder
+    if (decoder->samples_skipped < decoder->encoder_delay)
+    {
+        int64_t skip_from_frame = decoder->encoder_delay - decoder->samples_skipped;
+        if (skip_from_frame >= samples_in_frame)
+        {
+            decoder->samples_skipped += samples_in_frame;
+            return SONIX_OK;
+        }
+        frame_offset = (int)skip_from_frame;
+        samples_in_frame -= frame_offset;
+        decoder->samples_skipped += skip_from_frame;
+    }
+
+    // Grow the conversion buffer only when a larger frame shows up
+    if (samples_in_frame > *scratch_frames)
+    {
+        float *grown = (float *)realloc(*scratch, (size_t)samples_in_frame * channels * sizeof(float));
+        if (!grown)
+        {
+            set_error_message("Memory allocation failed: waveform decode buffer");
+            return SONIX_ERROR_OUT_OF_MEMORY;
+        }
+        *scratch = grown;
+        *scratch_frames = samples_in_frame;
+    }
+
+    const uint8_t *input_data[AV_NUM_DATA_POINTERS];
+    offset_frame_planes(frame, decoder->codec_ctx->sample_fmt, channels, frame_offset, input_data);
+
+    uint8_t *output_buffer = (uint8_t *)*scratch;
+    int converted = swr_convert(decoder->swr_ctx, &output_buffer, samples_in_frame, input_data, samples_in_frame);
+    if (converted < 0)
+    {
+        set_ffmpeg_error(converted, "Error during waveform resampling");
+        return SONIX_ERROR_FFMPEG_DECODE_FAILED;
+    }
+
+    decoder->current_sample += (int64_t)converted * channels;
+    return converted > 0 ? sink(sink_ctx, *scratch, converted, channels) : SONIX_OK;
+}
+
+// Decode every remaining frame of an initialized decoder and stream it into the sink.
+// Only one frame worth of samples is ever held in memory.
+static int32_t decode_all_frames(SonixChunkedDecoder *decoder, SonixFrameSink sink, void *sink_ctx)
+{
+    AVPacket *packet = av_packet_alloc();
+    AVFrame *frame = av_frame_alloc();
+    float *scratch = NULL;
+    int scratch_frames = 0;
+    int32_t status = SONIX_OK;
+    int draining = 0;
+    int finished = 0;
+
+    if (!packet || !frame)
+    {
+        set_error_message("Failed to allocate packet or frame for waveform generation");
+        status = SONIX_ERROR_OUT_OF_MEMORY;
+        goto decode_cleanup;
+    }
+
+    while (status == SONIX_OK && !finished)
+    {
+        if (!draining)
+        {
+            int ret = av_read_frame(decoder->format_ctx, packet);
+            if (ret < 0)
+            {
+                // End of file (or unreadable trailing data, which sonix_decode_audio
+                // also tolerates): flush whatever the decoder still buffers
+                draining = 1;
+                avcodec_send_packet(decoder->codec_ctx, NULL);
+            }
+            else if (packet->stream_index != decoder->audio_stream_index)
+            {
+                av_packet_unref(packet);
+                continue;
+            }
+            else
+            {
+                ret = avcodec_send_packet(decoder->codec_ctx, packet);
+                av_packet_unref(packet);
+                if (ret < 0)
+                {
+                    continue; // Skip undecodable packets
+                }
+            }
+        }
+
+        for (;;)
+        {
+            int ret = avcodec_receive_frame(decoder->codec_ctx, frame);
+            if (ret == AVERROR_EOF || (ret == AVERROR(EAGAIN) && draining))
+            {
+                finished = 1;
+                break;
+            }
+            if (ret == AVERROR(EAGAIN))
+            {
+                break;
+            }
+            if (ret < 0)
+            {
+                set_ffmpeg_error(ret, "Error receiving frame during waveform generation");
+                status = SONIX_ERROR_FFMPEG_DECODE_FAILED;
+                break;
+            }
+
+            status = deliver_decoded_frame(decoder, frame, &scratch, &scratch_frames, sink, sink_ctx);
+            if (status != SONIX_OK)
+            {
+                break;
+            }
+        }
+    }
+
+decode_cleanup:
+    free(scratch);
+    if (packet)
+    {
+        av_packet_free(&packet);
+    }
+    if (frame)
+    {
+        av_frame_free(&frame);
+    }
+    return status;
+}
+
+// Estimate the number of frames (samples per channel) in the decoder's audio stream.
+// Uses container metadata first and falls back to summing packet durations, which only
+// demuxes and is far cheaper than decoding. Returns 0 if the length cannot be determined.
+static uint64_t estimate_total_frames(SonixChunkedDecoder *decoder)
+{
+    AVStream *audio_stream = decoder->format_ctx->streams[decoder->audio_stream_index];
+    const double sample_rate = decoder->codec_ctx->sample_rate;
+    double frames = 0.0;
+
+    if (audio_stream->duration != AV_NOPTS_VALUE && audio_stream->duration > 0 && audio_stream->time_base.den > 0)
+    {
+        frames = (double)audio_stream->duration * audio_stream->time_base.num / audio_stream->time_base.den * sample_rate;
+    }
+    else if (decoder->format_ctx->duration != AV_NOPTS_VALUE && decoder->format_ctx->duration > 0)
+    {
+        frames = (double)decoder->format_ctx->duration / AV_TIME_BASE * sample_rate;
+    }
+
+    if (frames >= 1.0)
+    {
+        // Encoder priming samples are part of the container duration but never delivered
+        double delivered = frames - (double)decoder->encoder_delay;
+        return (uint64_t)(delivered >= 1.0 ? delivered : frames);
+    }
+
+    // No usable metadata: sum packet durations, then rewind for the real decode
+    AVPacket *packet = av_packet_alloc();
+    if (!packet)
+    {
+        return 0;
+    }
+
+    int64_t total_duration = 0;
+    while (av_read_frame(decoder->format_ctx, packet) >= 0)
+    {
+        if (packet->stream_index == decoder->audio_stream_index && packet->duration > 0)
+        {
+            total_duration += packet->duration;
+        }
+        av_packet_unref(packet);
+    }
+    av_packet_free(&packet);
+
+    if (av_seek_frame(decoder->format_ctx, decoder->audio_stream_index, 0, AVSEEK_FLAG_BACKWARD) < 0)
+    {
+        return 0;
+    }
+    avcodec_flush_buffers(decoder->codec_ctx);
+
+    if (total_duration <= 0 || audio_stream->time_base.den <= 0)
+    {
+        return 0;
+    }
+
+    frames = (double)total_duration * audio_stream->time_base.num / audio_stream->time_base.den * sample_rate;
+    return (uint64_t)frames;
+}
+
+// Per-reducer accumulation state. Stream 0 is the mixed signal, streams
+// 1..stream_count-1 are the channel outputs of the reducer's channel mode.
+typedef struct
+{
+    SonixReducerConfig config;
+    uint32_t stream_count;
+    uint32_t channel_offset; // Index of the first channel stream in the per-frame value table
+    double *accumulators;    // [stream][bin]: sum of squares (RMS) or magnitudes (average)
+    uint32_t *counts;        // Frames accumulated per bin (shared by all streams)
+    float *values;           // [stream][bin]: running peak; final values after finalize
+    uint32_t bin;
+    uint64_t next_bin_start;
+} SonixReducerState;
+
+// Per-frame value table layout: [mixed, ch0..chN-1, left, right, mid, side]
+typedef struct
+{
+    SonixReducerState *reducers;
+    uint32_t reducer_count;
+    uint64_t total_frames;
+    uint64_t frame_index;
+    double *frame_values;
+    int channels;
+} SonixReducerPipeline;
+
+// First frame of a bin. Matches the Dart downsampler: floor(bin * frames / resolution)
+static uint64_t reducer_bin_start(uint64_t bin, uint32_t resolution, uint64_t total_frames)
+{
+    return (bin * total_frames) / resolution;
+}
+
+// Number of channel outputs a reducer produces for a channel mode
+static uint32_t reducer_channel_count(int32_t channel_mode, int channels)
+{
+    switch (channel_mode)
+    {
+    case SONIX_CHANNEL_MODE_PER_CHANNEL:
+        return (uint32_t)channels;
+    case SONIX_CHANNEL_MODE_MID_SIDE:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+static void reducer_accumulate(SonixReducerState *state, uint32_t stream, double value)
+{
+    const size_t index = (size_t)stream * state->config.resolution + state->bin;
+    switch (state->config.algorithm)
+    {
+    case SONIX_REDUCER_PEAK:
+    {
+        const double magnitude = fabs(value);
+        if (magnitude > state->values[index])
+        {
+            state->values[index] = (float)magnitude;
+        }
+        break;
+    }
+    case SONIX_REDUCER_AVERAGE:
+        state->accumulators[index] += fabs(value);
+        break;
+    default:
+        state->accumulators[index] += value * value;
+        break;
+    }
+}
+
+// Frame sink feeding the mixed signal and channel streams to every reducer
+static int32_t reducer_pipeline_sink(void *sink_ctx, const float *samples, int frame_count, int channels)
+{
+    SonixReducerPipeline *pipeline = (SonixReducerPipeline *)sink_ctx;
+    double *values = pipeline->frame_values;
+    const double channel_scale = 1.0 / channels;
+
+    for (int f = 0; f < frame_count; f++)
+    {
+        const float *frame = samples + (size_t)f * channels;
+        double mixed = 0.0;
+        for (int ch = 0; ch < channels; ch++)
+        {
+            values[1 + ch] = frame[ch];
+            mixed += frame[ch];
+        }
+        values[0] = mixed * channel_scale;
+
+        // Mono is treated as dual mono for mid/side
+        const double left = frame[0];
+        const double right = channels > 1 ? frame[1] : frame[0];
+        values[1 + channels] = left;
+        values[2 + channels] = right;
+        values[3 + channels] = (left + right) * 0.5;
+        values[4 + channels] = (left - right) * 0.5;
+
+        for (uint32_t r = 0; r < pipeline->reducer_count; r++)
+        {
+            SonixReducerState *state = &pipeline->reducers[r];
+
+            // Frames past the estimated length land in the last bin
+            while (pipeline->frame_index >= state->next_bin_start && state->bin + 1 < state->config.resolution)
+            {
+                state->bin++;
+                state->next_bin_start = reducer_bin_start(state->bin + 1, state->config.resolution, pipeline->total_frames);
+            }
+
+            reducer_accumulate(state, 0, values[0]);
+            for (uint32_t stream = 1; stream < state->stream_count; stream++)
+            {
+                reducer_accumulate(state, stream, values[state->channel_offset + stream - 1]);
+            }
+            state->counts[state->bin]++;
+        }
+
+        pipeline->frame_index++;
+    }
+
+    return SONIX_OK;
+}
+
+static void free_reducer_states(SonixReducerState *reducers, uint32_t count)
+{
+    if (!reducers)
+    {
+        return;
+    }
+    for (uint32_t i = 0; i < count; i++)
+    {
+        free(reducers[i].accumulators);
+        free(reducers[i].counts);
+        free(reducers[i].values);
+    }
+    free(reducers);
+}
+
+// Free a multi-waveform result and all reducer outputs
+void sonix_free_multi_waveform_result(SonixMultiWaveformResult *result)
+{
+    if (!result)
+    {
+        return;
+    }
+
+    if (result->outputs)
+    {
+        for (uint32_t i = 0; i < result->output_count; i++)
+        {
+            free(result->outputs[i].values);
+        }
+        free(result->outputs);
+    }
+
+    free(result);
+    track_resource(&g_resource_counters.multi_waveform_results, -1);
+}
+
+// Decode a file once and run every requested reducer over the same frames
+SonixMultiWaveformResult *sonix_generate_waveforms(const char *file_path,
+                                                   const SonixReducerConfig *configs,
+                                                   uint32_t config_count)
+{
+    if (!file_path || !configs || config_count == 0)
+    {
+        set_error_message("Invalid arguments for waveform generation");
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < config_count; i++)
+    {
+        if (configs[i].resolution == 0)
+        {
+            set_error_message("Waveform resolution must be positive");
+            return NULL;
+        }
+        if (configs[i].algorithm != SONIX_REDUCER_RMS && configs[i].algorithm != SONIX_REDUCER_PEAK &&
+            configs[i].algorithm != SONIX_REDUCER_AVERAGE)
+        {
+            set_error_message("Unsupported waveform reducer algorithm");
+            return NULL;
+        }
+        if (configs[i].channel_mode != SONIX_CHANNEL_MODE_MIXED && configs[i].channel_mode != SONIX_CHANNEL_MODE_PER_CHANNEL &&
+            configs[i].channel_mode != SONIX_CHANNEL_MODE_MID_SIDE)
+        {
+            set_error_message("Unsupported waveform channel mode");
+            return NULL;
+        }
+    }
+
+    SonixChunkedDecoder *decoder = sonix_init_chunked_decoder(SONIX_FORMAT_UNKNOWN, file_path);
+    if (!decoder)
+    {
+        return NULL; // Error message already set
+    }
+
+    clear_error_message();
+
+    SonixMultiWaveformResult *result = NULL;
+    SonixReducerPipeline pipeline;
+    memset(&pipeline, 0, sizeof(pipeline));
+
+    pipeline.total_frames = estimate_total_frames(decoder);
+    if (pipeline.total_frames == 0)
+    {
+        set_error_message("Unable to determine audio length for waveform generation");
+        goto generate_cleanup;
+    }
+
+    pipeline.channels = decoder->codec_ctx->ch_layout.nb_channels;
+    pipeline.frame_values = (double *)calloc((size_t)pipeline.channels + 5, sizeof(double));
+    pipeline.reducers = (SonixReducerState *)calloc(config_count, sizeof(SonixReducerState));
+    if (!pipeline.frame_values || !pipeline.reducers)
+    {
+        set_error_message("Memory allocation failed: waveform reducers");
+        goto generate_cleanup;
+    }
+    pipeline.reducer_count = config_count;
+
+    for (uint32_t i = 0; i < config_count; i++)
+    {
+        SonixReducerState *state = &pipeline.reducers[i];
+        const uint32_t resolution = configs[i].resolution;
+        state->config = configs[i];
+        state->stream_count = 1 + reducer_channel_count(configs[i].channel_mode, pipeline.channels);
+        state->channel_offset = configs[i].channel_mode == SONIX_CHANNEL_MODE_MID_SIDE ? 1 + (uint32_t)pipeline.channels : 1;
+
+        const size_t bins = (size_t)resolution * state->stream_count;
+        state->accumulators = (double *)calloc(bins, sizeof(double));
+        state->counts = (uint32_t *)calloc(resolution, sizeof(uint32_t));
+        state->values = (float *)calloc(bins, sizeof(float));
+        if (!state->accumulators || !state->counts || !state->values)
+        {
+            set_error_message("Memory allocation failed: waveform reducer bins");
+            goto generate_cleanup;
+        }
+        state->bin = 0;
+        state->next_bin_start = reducer_bin_start(1, resolution, pipeline.total_frames);
+    }
+
+    if (decode_all_frames(decoder, reducer_pipeline_sink, &pipeline) != SONIX_OK)
+    {
+        goto generate_cleanup;
+    }
+
+    if (pipeline.frame_index == 0)
+    {
+        set_error_message("No audio frames decoded for waveform generation");
+        goto generate_cleanup;
+    }
+
+    result = (SonixMultiWaveformResult *)safe_malloc(sizeof(SonixMultiWaveformResult), "multi waveform result");
+    if (!result)
+    {
+        goto generate_cleanup;
+    }
+    memset(result, 0, sizeof(SonixMultiWaveformResult));
+    track_resource(&g_resource_counters.multi_waveform_results, 1);
+
+    result->outputs = (SonixReducerOutput *)calloc(config_count, sizeof(SonixReducerOutput));
+    if (!result->outputs)
+    {
+        set_error_message("Memory allocation failed: waveform outputs");
+        sonix_free_multi_waveform_result(result);
+        result = NULL;
+        goto generate_cleanup;
+    }
+    result->output_count = config_count;
+    result->sample_rate = decoder->codec_ctx->sample_rate;
+    result->channels = decoder->codec_ctx->ch_layout.nb_channels;
+    result->duration_ms = (uint32_t)((pipeline.frame_index * 1000) / result->sample_rate);
+
+    // Finalize each reducer and hand its value buffer over to the result
+    for (uint32_t i = 0; i < config_count; i++)
+    {
+        SonixReducerState *state = &pipeline.reducers[i];
+        const uint32_t resolution = state->config.resolution;
+        if (state->config.algorithm != SONIX_REDUCER_PEAK)
+        {
+            for (uint32_t stream = 0; stream < state->stream_count; stream++)
+            {
+                for (uint32_t bin = 0; bin < resolution; bin++)
+                {
+                    if (state->counts[bin] == 0)
+                    {
+                        continue;
+                    }
+                    const size_t index = (size_t)stream * resolution + bin;
+                    const double mean = state->accumulators[index] / state->counts[bin];
+                    state->values[index] = (float)(state->config.algorithm == SONIX_REDUCER_RMS ? sqrt(mean) : mean);
+                }
+            }
+        }
+
+        result->outputs[i].values = state->values;
+        result->outputs[i].resolution = resolution;
+        result->outputs[i].channel_count = state->stream_count - 1;
+        result->outputs[i].channel_values = state->stream_count > 1 ? state->values + resolution : NULL;
+        state->values = NULL;
+    }
+
+generate_cleanup:
+    free_reducer_states(pipeline.reducers, pipeline.reducer_count);
+    free(pipeline.frame_values);
+    sonix_cleanup_chunked_decoder(decoder);
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// Path-based one-shot decoding
+// ---------------------------------------------------------------------------
+
+typedef struct
+{
+    float *samples;
+    size_t count;    // Samples written
+    size_t capacity; // Samples allocated
+} SonixSampleBuffer;
+
+static int32_t sample_buffer_sink(void *sink_ctx, const float *samples, int frame_count, int channels)
+{
+    SonixSampleBuffer *buffer = (SonixSampleBuffer *)sink_ctx;
+    const size_t count = (size_t)frame_count * channels;
+
+    if (buffer->count + count > buffer->capacity)
+    {
+        // The estimate was short (or missing): grow by half to keep reallocations rare
+        size_t capacity = buffer->capacity > 0 ? buffer->capacity : (size_t)1 << 16;
+        while (capacity < buffer->count + count)
+        {
+            capacity += capacity / 2;
+        }
+        if (capacity > UINT32_MAX)
+        {
+            set_error_message("Decoded audio exceeds the maximum sample count");
+            return SONIX_ERROR_OUT_OF_MEMORY;
+        }
+
+        float *grown = (float *)realloc(buffer->samples, capacity * sizeof(float));
+        if (!grown)
+        {
+            set_error_message("Memory allocation failed: decoded audio buffer");
+            return SONIX_ERROR_OUT_OF_MEMORY;
+        }
+        buffer->samples = grown;
+        buffer->capacity = capacity;
+    }
+
+    memcpy(buffer->samples + buffer->count, samples, count * sizeof(float));
+    buffer->count += count;
+    return SONIX_OK;
+}
+
+SonixAudioData *sonix_decode_file(const char *file_path)
+{
+    if (!file_path)
+    {
+        set_error_message("Invalid file path for decoding");
+        return NULL;
+    }
+
+    // FFmpeg reads the file through its own buffered I/O, so the compressed
+    // data is never copied into memory as a whole
+    SonixChunkedDecoder *decoder = sonix_init_chunked_decoder(SONIX_FORMAT_UNKNOWN, file_path);
+    if (!decoder)
+    {
+        return NULL; // Error message already set
+    }
+
+    clear_error_message();
+
+    const int channels = decoder->codec_ctx->ch_layout.nb_channels;
+    const int sample_rate = decoder->codec_ctx->sample_rate;
+    SonixAudioData *audio_data = NULL;
+    SonixSampleBuffer buffer = {NULL, 0, 0};
+
+    // Size the output from container metadata (plus 1% slack) so most files
+    // decode without reallocating
+    uint64_t expected_frames = estimate_total_frames(decoder);
+    if (expected_frames > 0)
+    {
+        uint64_t capacity = (expected_frames + expected_frames / 100 + 4096) * (uint64_t)channels;
+        if (capacity <= UINT32_MAX)
+        {
+            buffer.samples = (float *)malloc((size_t)capacity * sizeof(float));
+            buffer.capacity = buffer.samples ? (size_t)capacity : 0;
+        }
+    }
+
+    int32_t status = decode_all_frames(decoder, sample_buffer_sink, &buffer);
+    if (status == SONIX_OK && buffer.count == 0)
+    {
+        set_error_message("No audio frames decoded");
+        status = SONIX_ERROR_INVALID_DATA;
+    }
+
+    if (status == SONIX_OK)
+    {
+        audio_data = alloc_audio_data("audio data structure");
+    }
+
+    if (audio_data)
+    {
+        // Return the unused slack
+        float *shrunk = (float *)realloc(buffer.samples, buffer.count * sizeof(float));
+        audio_data->samples = shrunk ? shrunk : buffer.samples;
+        audio_data->sample_count = (uint32_t)buffer.count;
+        audio_data->sample_rate = (uint32_t)sample_rate;
+        audio_data->channels = (uint32_t)channels;
+        audio_data->duration_ms = (uint32_t)(((uint64_t)buffer.count * 1000) / ((uint64_t)sample_rate * channels));
+        buffer.samples = NULL;
+    }
+
+    free(buffer.samples);
+    sonix_cleanup_chunked_decoder(decoder);
+    return audio_data;
+}
+
+// ---------------------------------------------------------------------------
+// Scratch-file decoding (memory-mapped PCM)
+// ---------------------------------------------------------------------------
+
+typedef struct
+{
+    FILE *file;
+    uint64_t frames;
+} SonixScratchWriter;
+
+static int32_t scratch_writer_sink(void *sink_ctx, const float *samples, int frame_count, int channels)
+{
+    SonixScratchWriter *writer = (SonixScratchWriter *)sink_ctx;
+    const size_t count = (size_t)frame_count * channels;
+
+    if (fwrite(samples, sizeof(float), count, writer->file) != count)
+    {
+        set_error_message("Failed to write decoded audio to scratch file");
+        return SONIX_ERROR_INVALID_DATA;
+    }
+    writer->frames += (uint64_t)frame_count;
+    return SONIX_OK;
+}
+
+int32_t sonix_decode_to_scratch_file(const char *file_path, const char *scratch_path, SonixScratchInfo *info)
+{
+    if (!file_path || !scratch_path || !info)
+    {
+        set_error_message("Invalid arguments for scratch file decoding");
+        return SONIX_ERROR_INVALID_DATA;
+    }
+    memset(info, 0, sizeof(SonixScratchInfo));
+
+    SonixChunkedDecoder *decoder = sonix_init_chunked_decoder(SONIX_FORMAT_UNKNOWN, file_path);
+    if (!decoder)
+    {
+        return SONIX_ERROR_FFMPEG_DECODE_FAILED; // Error message already set
+    }
+
+    clear_error_message();
+
+    int32_t status = SONIX_OK;
+    SonixScratchWriter writer;
+    writer.frames = 0;
+    writer.file = fopen(scratch_path, "wb");
+    if (!writer.file)
+    {
+        set_error_message("Failed to create scratch file");
+        status = SONIX_ERROR_FILE_NOT_FOUND;
+        goto scratch_cleanup;
+    }
+
+    // Decoded frames are small; batch them into large sequential writes
+    setvbuf(writer.file, NULL, _IOFBF, 1 << 20);
+
+    status = decode_all_frames(decoder, scratch_writer_sink, &writer);
+
+    if (fclose(writer.file) != 0 && status == SONIX_OK)
+    {
+        set_error_message("Failed to flush scratch file");
+        status = SONIX_ERROR_INVALID_DATA;
+    }
+    writer.file = NULL;
+
+    if (status == SONIX_OK && writer.frames == 0)
+    {
+        set_error_message("No audio frames decoded into scratch file");
+        status = SONIX_ERROR_INVALID_DATA;
+    }
+
+    if (status == SONIX_OK)
+    {
+        info->frame_count = writer.frames;
+        info->sample_rate = decoder->codec_ctx->sample_rate;
+        info->channels = decoder->codec_ctx->ch_layout.nb_channels;
+        info->duration_ms = (uint32_t)((writer.frames * 1000) / info->sample_rate);
+    }
+
+scratch_cleanup:
+    if (writer.file)
+    {
+        fclose(writer.file);
+    }
+    if (status != SONIX_OK)
+    {
+        remove(scratch_path);
+    }
+    sonix_cleanup_chunked_decoder(decoder);
+    return status;
+}
+
+// Maps a whole file copy-on-write: callers get a writable buffer without ever
+// touching the file. `sequential` hints front-to-back reads, otherwise random access.
+// `what` names the file in error messages.
+static void *map_file_copy_on_write(const char *path, uint64_t *byte_size, int sequential, const char *what)
+{
+    char message[128];
+    if (!path || !byte_size)
+    {
+        snprintf(message, sizeof(message), "Invalid arguments for %s mapping", what);
+        set_error_message(message);
+        return NULL;
+    }
+    *byte_size = 0;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | (sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS), NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        snprintf(message, sizeof(message), "Failed to open %s", what);
+        set_error_message(message);
+        return NULL;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0)
+    {
+        CloseHandle(file);
+        snprintf(message, sizeof(message), "Cannot map an empty %s", what);
+        set_error_message(message);
+        return NULL;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    void *data = mapping ? MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0) : NULL;
+
+    // The view keeps the mapping alive on its own
+    if (mapping)
+    {
+        CloseHandle(mapping);
+    }
+    CloseHandle(file);
+
+    if (!data)
+    {
+        snprintf(message, sizeof(message), "Failed to map %s", what);
+        set_error_message(message);
+        return NULL;
+    }
+    *byte_size = (uint64_t)size.QuadPart;
+    track_resource(&g_resource_counters.mappings, 1);
+    track_resource(&g_resource_counters.mapped_bytes, (int64_t)*byte_size);
+    return data;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        snprintf(message, sizeof(message), "Failed to open %s", what);
+        set_error_message(message);
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        close(fd);
+        snprintf(message, sizeof(message), "Cannot map an empty %s", what);
+        set_error_message(message);
+        return NULL;
+    }
+
+    void *data = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping stays valid after the descriptor is closed
+
+    if (data == MAP_FAILED)
+    {
+        snprintf(message, sizeof(message), "Failed to map %s", what);
+        set_error_message(message);
+        return NULL;
+    }
+
+    if (sequential)
+    {
+#ifdef MADV_SEQUENTIAL
+        // Waveform passes read front to back; let the kernel read ahead and drop pages early
+        madvise(data, (size_t)st.st_size, MADV_SEQUENTIAL);
+#endif
+    }
+    else
+    {
+#ifdef MADV_RANDOM
+        // Only the displayed ranges are read; read-ahead would fault in pages nobody looks at
+        madvise(data, (size_t)st.st_size, MADV_RANDOM);
+#endif
+    }
+
+    *byte_size = (uint64_t)st.st_size;
+    track_resource(&g_resource_counters.mappings, 1);
+    track_resource(&g_resource_counters.mapped_bytes, (int64_t)*byte_size);
+    return data;
+#endif
+}
+
+static void unmap_file(void *data, uint64_t byte_size)
+{
+    if (!data)
+    {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+#else
+    munmap(data, (size_t)byte_size);
+#endif
+    track_resource(&g_resource_counters.mappings, -1);
+    track_resource(&g_resource_counters.mapped_bytes, -(int64_t)byte_size);
+}
+
+float *sonix_map_scratch_file(const char *scratch_path, uint64_t *byte_size)
+{
+    return (float *)map_file_copy_on_write(scratch_path, byte_size, 1, "scratch file");
+}
+
+void sonix_unmap_scratch_file(float *data, uint64_t byte_size)
+{
+    unmap_file(data, byte_size);
+}
+
+SonixScratchMapping *sonix_open_scratch_mapping(const char *scratch_path)
+{
+    SonixScratchMapping *mapping = (SonixScratchMapping *)calloc(1, sizeof(SonixScratchMapping));
+    if (!mapping)
+    {
+        set_error_message("Failed to allocate scratch mapping");
+        return NULL;
+    }
+
+    mapping->data = (float *)map_file_copy_on_write(scratch_path, &mapping->byte_size, 1, "scratch file");
+    if (!mapping->data)
+    {
+        free(mapping);
+        return NULL;
+    }
+
+#ifdef _WIN32
+    // Mapped files cannot be deleted; remember the path for the release
+    mapping->path = safe_strdup(scratch_path, "scratch path");
+    if (!mapping->path)
+    {
+        unmap_file(mapping->data, mapping->byte_size);
+        free(mapping);
+        return NULL;
+    }
+#else
+    // The mapping keeps the pages; the file disappears even if the process dies
+    unlink(scratch_path);
+#endif
+    return mapping;
+}
+
+void sonix_release_scratch_mapping(SonixScratchMapping *mapping)
+{
+    if (!mapping)
+    {
+        return;
+    }
+
+    unmap_file(mapping->data, mapping->byte_size);
+#ifdef _WIN32
+    if (mapping->path)
+    {
+        DeleteFileA(mapping->path);
+        free(mapping->path);
+    }
+#endif
+    free(mapping);
+}
+
+uint8_t *sonix_map_waveform_file(const char *path, uint64_t *byte_size)
+{
+    return (uint8_t *)map_file_copy_on_write(path, byte_size, 0, "waveform file");
+}
+
+void sonix_unmap_waveform_file(uint8_t *data, uint64_t byte_size)
+{
+    unmap_file(data, byte_size);
+}
+
+// Binary waveform format, as WaveformBinaryCodec in Dart (little-endian)
+#define WAVEFORM_FILE_MAGIC 0x57584e53u // "SNXW" read as little-endian uint32
+#define WAVEFORM_FILE_VERSION 1
+#define WAVEFORM_FILE_HEADER_SIZE 56
+#define WAVEFORM_FILE_SECTION_HEADER_SIZE 12
+#define WAVEFORM_FILE_FLAG_CHANNELS (1 << 0)
+#define WAVEFORM_FILE_FLAG_BINS (1 << 1)
+#define WAVEFORM_FILE_FLAG_PYRAMID (1 << 2)
+#define WAVEFORM_FILE_FLAG_PYRAMID_LEVELS (1 << 3)
+
+static void put_le16(uint8_t *to, uint16_t value)
+{
+    to[0] = (uint8_t)value;
+    to[1] = (uint8_t)(value >> 8);
+}
+
+static void put_le32(uint8_t *to, uint32_t value)
+{
+    put_le16(to, (uint16_t)value);
+    put_le16(to + 2, (uint16_t)(value >> 16));
+}
+
+static void put_le64(uint8_t *to, uint64_t value)
+{
+    put_le32(to, (uint32_t)value);
+    put_le32(to + 4, (uint32_t)(value >> 32));
+}
+
+// Writes one float32 section: count, signed flag, scale 1.0, then the values.
+// Float32 values are a multiple of 4 bytes, so no padding follows.
+static int write_waveform_section(FILE *file, const float *values, uint64_t count)
+{
+    uint8_t header[WAVEFORM_FILE_SECTION_HEADER_SIZE] = {0};
+    const float one = 1.0f;
+    uint32_t bits;
+    uint8_t is_signed = 0;
+    for (uint64_t i = 0; i < count; i++)
+    {
+        if (values[i] < 0.0f)
+        {
+            is_signed = 1;
+            break;
+        }
+    }
+
+    put_le32(header, (uint32_t)count);
+    header[4] = is_signed;
+    memcpy(&bits, &one, sizeof(bits));
+    put_le32(header + 8, bits);
+    if (fwrite(header, 1, sizeof(header), file) != sizeof(header))
+    {
+        return 0;
+    }
+
+    const uint16_t probe = 1;
+    if (*(const uint8_t *)&probe == 1)
+    {
+        // Little-endian host: the values are already in file order
+        return fwrite(values, sizeof(float), (size_t)count, file) == (size_t)count;
+    }
+
+    uint8_t buffer[4096];
+    for (uint64_t i = 0; i < count;)
+    {
+        size_t n = 0;
+        for (; n < sizeof(buffer) / 4 && i < count; n++, i++)
+        {
+            memcpy(&bits, &values[i], sizeof(bits));
+            put_le32(buffer + 4 * n, bits);
+        }
+        if (fwrite(buffer, 4, n, file) != n)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Merges pairs of min/max/RMS bins into the next coarser level, as WaveformPyramid
+static void merge_bin_pairs(const float *from, uint32_t from_length, float *to, uint32_t length)
+{
+    for (uint32_t i = 0; i < length; i++)
+    {
+        uint32_t a = 2 * i;
+        uint32_t b = a + 1 < from_length ? a + 1 : from_length - 1;
+        to[i] = from[a] < from[b] ? from[a] : from[b];
+        to[length + i] = from[from_length + a] > from[from_length + b] ? from[from_length + a] : from[from_length + b];
+
+        double rms_a = from[2 * from_length + a];
+        double rms_b = from[2 * from_length + b];
+        to[2 * length + i] = (float)sqrt((rms_a * rms_a + rms_b * rms_b) / 2);
+    }
+}
+
+int32_t sonix_write_waveform_file(const char *path, const SonixWaveformFile *waveform)
+{
+    if (!path || !waveform || (!waveform->amplitudes && waveform->bin_count > 0) ||
+        (waveform->channel_count > 0 && !waveform->channel_amplitudes) ||
+        (waveform->bins_length > 0 && !waveform->bins) ||
+        (waveform->pyramid_base_length > 0 && !waveform->pyramid_base))
+    {
+        set_error_message("Invalid arguments for waveform file writing");
+        return SONIX_ERROR_INVALID_DATA;
+    }
+
+    // Coarser pyramid levels are built here so readers never have to
+    float *levels = NULL;
+    uint64_t levels_values = 0;
+    uint32_t length = waveform->pyramid_base_length;
+    while (length > 1)
+    {
+        length = (length + 1) / 2;
+        levels_values += 3 * (uint64_t)length;
+    }
+    if (levels_values > 0)
+    {
+        levels = (float *)malloc((size_t)levels_values * sizeof(float));
+        if (!levels)
+        {
+            set_error_message("Failed to allocate pyramid levels");
+            return SONIX_ERROR_OUT_OF_MEMORY;
+        }
+        const float *from = waveform->pyramid_base;
+        uint32_t from_length = waveform->pyramid_base_length;
+        float *to = levels;
+        while (from_length > 1)
+        {
+            uint32_t to_length = (from_length + 1) / 2;
+            merge_bin_pairs(from, from_length, to, to_length);
+            from = to;
+            from_length = to_length;
+            to += 3 * (size_t)to_length;
+        }
+    }
+
+    uint16_t flags = 0;
+    if (waveform->channel_count > 0)
+    {
+        flags |= WAVEFORM_FILE_FLAG_CHANNELS;
+    }
+    if (waveform->bins)
+    {
+        flags |= WAVEFORM_FILE_FLAG_BINS;
+    }
+    if (waveform->pyramid_base)
+    {
+        flags |= WAVEFORM_FILE_FLAG_PYRAMID | WAVEFORM_FILE_FLAG_PYRAMID_LEVELS;
+    }
+
+    uint8_t header[WAVEFORM_FILE_HEADER_SIZE] = {0};
+    put_le32(header, WAVEFORM_FILE_MAGIC);
+    put_le16(header + 4, WAVEFORM_FILE_VERSION);
+    put_le16(header + 6, flags);
+    header[8] = 0; // float32
+    header[9] = (uint8_t)waveform->waveform_type;
+    header[10] = waveform->normalized ? 1 : 0;
+    header[11] = waveform->channel_count > 0 ? (uint8_t)waveform->channel_mode : SONIX_CHANNEL_MODE_MIXED;
+    put_le32(header + 12, waveform->sample_rate);
+    put_le64(header + 16, (uint64_t)waveform->duration_us);
+    put_le64(header + 24, (uint64_t)waveform->generated_at_us);
+    put_le32(header + 32, waveform->bin_count);
+    put_le32(header + 36, waveform->channel_count);
+    put_le32(header + 40, waveform->config_hash);
+    put_le32(header + 44, waveform->pyramid_base ? waveform->pyramid_base_frames_per_bin : 0);
+    put_le64(header + 48, waveform->pyramid_base ? waveform->pyramid_total_frames : 0);
+
+    FILE *file = fopen(path, "wb");
+    if (!file)
+    {
+        free(levels);
+        set_error_message("Failed to create waveform file");
+        return SONIX_ERROR_FILE_NOT_FOUND;
+    }
+
+    int ok = fwrite(header, 1, sizeof(header), file) == sizeof(header);
+    ok = ok && write_waveform_section(file, waveform->amplitudes, waveform->bin_count);
+    if (waveform->channel_count > 0)
+    {
+        ok = ok && write_waveform_section(file, waveform->channel_amplitudes, (uint64_t)waveform->channel_count * waveform->bin_count);
+    }
+    if (waveform->bins)
+    {
+        ok = ok && write_waveform_section(file, waveform->bins, 3 * (uint64_t)waveform->bins_length);
+    }
+    if (waveform->pyramid_base)
+    {
+        ok = ok && write_waveform_section(file, waveform->pyramid_base, 3 * (uint64_t)waveform->pyramid_base_length);
+        const float *level = levels;
+        for (uint32_t level_length = waveform->pyramid_base_length; ok && level_length > 1;)
+        {
+            level_length = (level_length + 1) / 2;
+            ok = write_waveform_section(file, level, 3 * (uint64_t)level_length);
+            level += 3 * (size_t)level_length;
+        }
+    }
+    free(levels);
+
+    if (fclose(file) != 0)
+    {
+        ok = 0;
+    }
+    if (!ok)
+    {
+        remove(path);
+        set_error_message("Failed to write waveform file");
+        return SONIX_ERROR_INVALID_DATA;
+    }
+    return SONIX_OK;
+}
@@ -45,6 +45,16 @@ extern "C"
 #define SONIX_ERROR_FILE_NOT_FOUND -8
 #define SONIX_ERROR_SEEK_FAILED -9
 
+// Waveform reducer algorithms (decode-once multi-waveform pipeline)
+#define SONIX_REDUCER_RMS 0
+#define SONIX_REDUCER_PEAK 1
+#define SONIX_REDUCER_AVERAGE 2
+
+// Reducer channel modes (mixed output is always produced)
+#define SONIX_CHANNEL_MODE_MIXED 0
+#define SONIX_CHANNEL_MODE_PER_CHANNEL 1
+#define SONIX_CHANNEL_MODE_MID_SIDE 2
+
   // Audio data structure
   typedef struct
   {
@@ -89,11 +99,107 @@ extern "C"
   // Opaque chunked decoder handle
   typedef struct SonixChunkedDecoder SonixChunkedDecoder;
 
+  // Configuration of a single waveform reducer. Every reducer consumes the same
+  // decoded frames, so N waveforms cost one decode.
+  typedef struct
+  {
+    uint32_t resolution;
+    int32_t algorithm;
+    int32_t channel_mode;
+  } SonixReducerConfig;
+
+  // Raw (un-normalized) amplitudes produced by one reducer.
+  // channel_values is planar (channel_count * resolution) and points into the
+  // same allocation as values; it is NULL for SONIX_CHANNEL_MODE_MIXED.
+  typedef struct
+  {
+    float *values;
+    uint32_t resolution;
+    float *channel_values;
+    uint32_t channel_count;
+  } SonixReducerOutput;
+
+  // Result of sonix_generate_waveforms, one output per requested reducer
+  typedef struct
+  {
+    SonixReducerOutput *outputs;
+    uint32_t output_count;
+    uint32_t sample_rate;
+    uint32_t channels;
+    uint32_t duration_ms;
+  } SonixMultiWaveformResult;
+
+  // Stream properties of a file decoded by sonix_decode_to_scratch_file.
+  // The scratch file holds frame_count * channels interleaved 32-bit floats.
+  typedef struct
+  {
+    uint64_t frame_count;
+    uint32_t sample_rate;
+    uint32_t channels;
+    uint32_t duration_ms;
+  } SonixScratchInfo;
+
+  // A mapped scratch file owned by one handle, see sonix_open_scratch_mapping.
+  // path is only set on Windows, where the file can only be deleted once unmapped.
+  typedef struct
+  {
+    float *data;
+    uint64_t byte_size;
+    char *path;
+  } SonixScratchMapping;
+
+  // Waveform written by sonix_write_waveform_file in the binary waveform format
+  // (WaveformBinaryCodec in Dart), with float32 values and every pyramid level so it
+  // can be memory-mapped and opened without work. Arrays follow the layout of
+  // WaveformData: channel_amplitudes is planar (channel_count * bin_count); bins and
+  // pyramid_base are struct-of-arrays min/max/RMS (3 * length). Optional arrays are
+  // NULL when absent.
+  typedef struct
+  {
+    const float *amplitudes;
+    uint32_t bin_count;
+    const float *channel_amplitudes;
+    uint32_t channel_count;
+    int32_t channel_mode; // SONIX_CHANNEL_MODE_*
+    const float *bins;
+    uint32_t bins_length;
+    const float *pyramid_base;
+    uint32_t pyramid_base_length;
+    uint32_t pyramid_base_frames_per_bin;
+    uint64_t pyramid_total_frames;
+    uint32_t sample_rate;
+    int64_t duration_us;
+    int64_t generated_at_us; // Microseconds since the Unix epoch
+    int32_t waveform_type;   // Index of WaveformType (0 = bars, 1 = line, 2 = filled)
+    int32_t normalized;
+    uint32_t config_hash; // WaveformConfig.stableHash, or 0
+  } SonixWaveformFile;
+
+  // Live native resources reported by sonix_get_resource_counters. Every count
+  // returns to zero once all results are freed, chunked decoders cleaned up and
+  // files unmapped, whichever thread allocated them.
+  typedef struct
+  {
+    int64_t audio_data;             // SonixAudioData not yet passed to sonix_free_audio_data
+    int64_t chunk_results;          // SonixChunkResult not yet passed to sonix_free_chunk_result
+    int64_t chunked_decoders;       // Decoders not yet passed to sonix_cleanup_chunked_decoder
+    int64_t multi_waveform_results; // SonixMultiWaveformResult not yet freed
+    int64_t ffmpeg_contexts;        // Open FFmpeg format, codec and resampler contexts
+    int64_t mappings;               // Scratch and waveform file mappings
+    int64_t mapped_bytes;           // Bytes of those mappings
+  } SonixResourceCounters;
+
   // Core API functions
   SONIX_EXPORT int32_t sonix_detect_format(const uint8_t *data, size_t size);
   SONIX_EXPORT SonixAudioData *sonix_decode_audio(const uint8_t *data, size_t size, int32_t format);
+  // Decodes a whole file by path through FFmpeg's own file I/O, without loading the
+  // compressed data into memory first. Returns NULL on failure (see sonix_get_error_message).
+  SONIX_EXPORT SonixAudioData *sonix_decode_file(const char *file_path);
   SONIX_EXPORT void sonix_free_audio_data(SonixAudioData *audio_data);
+  // Error message of the last failing call on the calling thread
   SONIX_EXPORT const char *sonix_get_error_message(void);
+  // Snapshot of the live resource counts, for leak checks under load
+  SONIX_EXPORT void sonix_get_resource_counters(SonixResourceCounters *counters);
 
   // FFMPEG-specific functions
   SONIX_EXPORT int32_t sonix_get_backend_type(void);
@@ -123,6 +229,34 @@ extern "C"
                                                     uint32_t *sample_rate,
                                                     uint32_t *channels);
 
+  // Decode-once waveform generation: decodes the file a single time and feeds
+  // every frame to all reducers. Returns NULL on failure (see sonix_get_error_message).
+  SONIX_EXPORT SonixMultiWaveformResult *sonix_generate_waveforms(const char *file_path,
+                                                                  const SonixReducerConfig *configs,
+                                                                  uint32_t config_count);
+  SONIX_EXPORT void sonix_free_multi_waveform_result(SonixMultiWaveformResult *result);
+
+  // Scratch-file decoding: decodes the whole file to interleaved float PCM on disk
+  // instead of the heap. Returns SONIX_OK on success; the scratch file is removed on failure.
+  SONIX_EXPORT int32_t sonix_decode_to_scratch_file(const char *file_path, const char *scratch_path, SonixScratchInfo *info);
+  // Maps a scratch file copy-on-write. Returns NULL on failure; release with sonix_unmap_scratch_file.
+  SONIX_EXPORT float *sonix_map_scratch_file(const char *scratch_path, uint64_t *byte_size);
+  SONIX_EXPORT void sonix_unmap_scratch_file(float *data, uint64_t byte_size);
+  // Maps a scratch file like sonix_map_scratch_file and takes ownership of it: on
+  // POSIX the file is unlinked right away (the mapping keeps the data), on Windows
+  // it is deleted by sonix_release_scratch_mapping. Returns NULL on failure, leaving
+  // the file in place. The release function has the signature of a Dart NativeFinalizer.
+  SONIX_EXPORT SonixScratchMapping *sonix_open_scratch_mapping(const char *scratch_path);
+  SONIX_EXPORT void sonix_release_scratch_mapping(SonixScratchMapping *mapping);
+
+  // Binary waveform files: sonix_write_waveform_file writes one for server-side
+  // generators (SONIX_OK on success; the file is removed on failure).
+  // sonix_map_waveform_file maps one copy-on-write for random access; release it with
+  // sonix_unmap_waveform_file.
+  SONIX_EXPORT int32_t sonix_write_waveform_file(const char *path, const SonixWaveformFile *waveform);
+  SONIX_EXPORT uint8_t *sonix_map_waveform_file(const char *path, uint64_t *byte_size);
+  SONIX_EXPORT void sonix_unmap_waveform_file(uint8_t *data, uint64_t byte_size);
+
 // Debug functions (only available in debug builds)
 #ifdef DEBUG
   SONIX_EXPORT void sonix_debug_memory_status(void);
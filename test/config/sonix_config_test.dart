@@ -52,6 +52,26 @@ void main() {
       expect(highMemoryConfig.toString(), contains('500.0MB'));
     });
 
+    test('should default to an automatically sized worker pool', () {
+      expect(const SonixConfig().workerPoolSize, isNull);
+      expect(SonixConfig.mobile().workerPoolSize, equals(2));
+      expect(const SonixConfig(workerPoolSize: 0).workerPoolSize, equals(0));
+      expect(const SonixConfig(workerPoolSize: 6).toString(), contains('workerPoolSize: 6'));
+      expect(const SonixConfig().toString(), contains('workerPoolSize: auto'));
+    });
+
+    test('should enable adaptive concurrency by default', () {
+      expect(const SonixConfig().adaptiveConcurrency, isTrue);
+      expect(const SonixConfig(adaptiveConcurrency: false).toString(), contains('adaptiveConcurrency: false'));
+    });
+
+    test('should cache waveforms in memory only by default', () {
+      expect(const SonixConfig().waveformCacheSize, equals(32 * 1024 * 1024));
+      expect(const SonixConfig().waveformCacheDirectory, isNull);
+      expect(SonixConfig.mobile().waveformCacheSize, equals(8 * 1024 * 1024));
+      expect(const SonixConfig(waveformCacheDirectory: '/tmp/waveforms').toString(), contains('waveformCacheDirectory: /tmp/waveforms'));
+    });
+
     test('should handle debug logging flags', () {
       expect(SonixConfig.enableDebugLogging, isFalse);
 
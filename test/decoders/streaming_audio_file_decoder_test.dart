@@ -1,6 +1,8 @@
 // ignore_for_file: avoid_print
 
 import 'dart:io';
+import 'dart:typed_data';
+
 import 'package:flutter_test/flutter_test.dart';
 import 'package:sonix/src/decoders/audio_file_decoder.dart';
 import 'package:sonix/src/models/audio_data.dart';
@@ -279,6 +281,25 @@ void main() {
           expect(firstChunkTime, lessThan(totalTime * 0.8), reason: 'First chunk should arrive before 80% of total processing time');
         }
       });
+
+      test('should hand out native sample buffers that outlive the decoder', () async {
+        final decoder = StreamingAudioFileDecoder();
+        final chunks = <AudioData>[];
+        try {
+          await for (final chunk in decoder.decodeStreaming('test/assets/test_medium.wav')) {
+            chunks.add(chunk);
+          }
+        } finally {
+          decoder.dispose();
+        }
+
+        // The chunk results are freed by now; the samples are owned by the lists
+        expect(chunks, isNotEmpty);
+        for (final chunk in chunks) {
+          expect(chunk.samples, isA<Float32List>());
+          expect(chunk.samples.every((sample) => sample.isFinite && sample.abs() <= 1.5), isTrue);
+        }
+      });
     });
   });
 }
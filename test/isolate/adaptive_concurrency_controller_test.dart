@@ -0,0 +1,114 @@
+/// Tests for the AdaptiveConcurrencyController class
+///
+/// These tests drive the controller with a fake clock and RSS reader to
+/// verify the additive increase, the memory-driven multiplicative decrease
+/// and the saturation back-off.
+library;
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:sonix/src/isolate/adaptive_concurrency_controller.dart';
+
+void main() {
+  group('AdaptiveConcurrencyController', () {
+    const megabyte = 1024 * 1024;
+    late Duration now;
+    late int rss;
+
+    AdaptiveConcurrencyController createController({int maxConcurrency = 8, int initialConcurrency = 2}) {
+      return AdaptiveConcurrencyController(
+        maxConcurrency: maxConcurrency,
+        memoryBudget: 100 * megabyte,
+        initialConcurrency: initialConcurrency,
+        readRss: () => rss,
+        clock: () => now,
+      );
+    }
+
+    /// Completes [count] jobs spread over one second with [running] jobs left
+    void completeWindow(AdaptiveConcurrencyController controller, int count, {int running = 1, bool backlog = true}) {
+      if (backlog) controller.recordBacklog();
+      for (int i = 0; i < count; i++) {
+        now += Duration(microseconds: (Duration.microsecondsPerSecond + count - 1) ~/ count);
+        controller.recordCompletion(running);
+      }
+    }
+
+    setUp(() {
+      now = Duration.zero;
+      rss = 500 * megabyte;
+    });
+
+    test('should start at two jobs within the bounds', () {
+      expect(createController().limit, equals(2));
+      expect(AdaptiveConcurrencyController(maxConcurrency: 1, memoryBudget: megabyte).limit, equals(1));
+    });
+
+    test('should reject invalid bounds', () {
+      expect(() => AdaptiveConcurrencyController(maxConcurrency: 0, memoryBudget: megabyte), throwsArgumentError);
+      expect(() => AdaptiveConcurrencyController(minConcurrency: 4, maxConcurrency: 2, memoryBudget: megabyte), throwsArgumentError);
+    });
+
+    test('should grow by one per window while jobs are waiting', () {
+      final controller = createController();
+
+      completeWindow(controller, 4, running: 2);
+      expect(controller.limit, equals(3));
+      expect(controller.throughput, closeTo(4.0, 1e-9));
+
+      completeWindow(controller, 6, running: 3);
+      expect(controller.limit, equals(4));
+    });
+
+    test('should not grow without a backlog or beyond the maximum', () {
+      final controller = createController(maxConcurrency: 3);
+
+      completeWindow(controller, 4, backlog: false);
+      expect(controller.limit, equals(2));
+
+      completeWindow(controller, 4);
+      completeWindow(controller, 5);
+      expect(controller.limit, equals(3));
+    });
+
+    test('should halve the limit when memory exceeds the budget', () {
+      final controller = createController(initialConcurrency: 8);
+
+      rss += 150 * megabyte;
+      completeWindow(controller, 4, running: 7);
+
+      expect(controller.limit, equals(4));
+    });
+
+    test('should not grow when another job would exceed the memory budget', () {
+      final controller = createController();
+
+      rss += 80 * megabyte; // 40MB per running job, a third job needs 120MB
+      completeWindow(controller, 4, running: 2);
+
+      expect(controller.limit, equals(2));
+    });
+
+    test('should undo an increase that lowered throughput', () {
+      final controller = createController();
+
+      completeWindow(controller, 10, running: 2);
+      expect(controller.limit, equals(3));
+
+      completeWindow(controller, 6, running: 3);
+      expect(controller.limit, equals(2));
+    });
+
+    test('should refuse new jobs above the limit or memory budget', () {
+      final controller = createController();
+
+      expect(controller.canStart(0), isTrue);
+      expect(controller.canStart(1), isTrue);
+      expect(controller.canStart(2), isFalse);
+
+      rss += 120 * megabyte;
+      expect(controller.canStart(1), isFalse);
+      expect(controller.canStart(0), isTrue); // Always make progress
+      expect(controller.memoryInUse, equals(0)); // Idle re-baselines
+    });
+  });
+}
@@ -282,6 +282,28 @@ void main() {
       });
     });
 
+    group('runMany', () {
+      test('should generate one waveform per config from a single decode', () async {
+        final configs = [
+          WaveformConfig(resolution: 40),
+          WaveformConfig(resolution: 250, algorithm: DownsamplingAlgorithm.peak),
+        ];
+
+        final results = await runner.runMany(testAudioPath, configs);
+
+        expect(results, hasLength(2));
+        expect(results[0].amplitudes, hasLength(40));
+        expect(results[1].amplitudes, hasLength(250));
+      });
+
+      test('should reconstruct errors from the isolate', () async {
+        await expectLater(
+          runner.runMany('test/assets/corrupted_header.mp3', [WaveformConfig(resolution: 10), WaveformConfig(resolution: 20)]),
+          throwsA(isA<SonixException>()),
+        );
+      });
+    });
+
     group('edge cases', () {
       test('should handle very low resolution', () async {
         final config = WaveformConfig(resolution: 1);
@@ -0,0 +1,123 @@
+/// Tests for the IsolateWorkerPool class
+///
+/// These tests verify that the pool reuses persistent workers, queues jobs
+/// beyond its size, applies back-pressure, survives failing jobs and shuts
+/// down cleanly.
+library;
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:sonix/src/isolate/isolate_runner.dart';
+import 'package:sonix/src/isolate/isolate_worker_pool.dart';
+import 'package:sonix/src/processing/waveform_config.dart';
+import 'package:sonix/src/processing/downsampling_algorithm.dart';
+import 'package:sonix/src/exceptions/sonix_exceptions.dart';
+import '../ffmpeg/ffmpeg_setup_helper.dart';
+
+void main() {
+  setUpAll(() async {
+    await FFMPEGSetupHelper.setupFFMPEGForTesting();
+  });
+
+  group('IsolateWorkerPool', () {
+    const testAudioPath = 'test/assets/test_mono_44100.wav';
+    late IsolateWorkerPool pool;
+
+    setUp(() {
+      pool = IsolateWorkerPool(size: 2);
+    });
+
+    tearDown(() async {
+      await pool.close();
+    });
+
+    test('should size to the core count by default', () async {
+      final defaultPool = IsolateWorkerPool();
+
+      expect(defaultPool.size, equals(IsolateWorkerPool.defaultSize));
+      expect(defaultPool.size, greaterThanOrEqualTo(1));
+      expect(defaultPool.workerCount, equals(0)); // Spawned lazily
+      await defaultPool.close();
+    });
+
+    test('should reject invalid sizes', () {
+      expect(() => IsolateWorkerPool(size: 0), throwsArgumentError);
+      expect(() => IsolateWorkerPool(size: 2, maxQueueLength: 0), throwsArgumentError);
+    });
+
+    test('should generate waveforms on a worker', () async {
+      final result = await pool.run(testAudioPath, const WaveformConfig(resolution: 100));
+
+      expect(result.amplitudes, hasLength(100));
+      expect(pool.workerCount, equals(1));
+    });
+
+    test('should match the spawn-per-request runner', () async {
+      const config = WaveformConfig(resolution: 120, algorithm: DownsamplingAlgorithm.peak);
+
+      final pooled = await pool.run(testAudioPath, config);
+      final spawned = await const IsolateRunner().run(testAudioPath, config);
+
+      expect(pooled.amplitudes, equals(spawned.amplitudes));
+    });
+
+    test('should reuse workers across many jobs', () async {
+      final results = await Future.wait([for (int i = 0; i < 12; i++) pool.run(testAudioPath, WaveformConfig(resolution: 10 + i))]);
+
+      for (int i = 0; i < results.length; i++) {
+        expect(results[i].amplitudes, hasLength(10 + i));
+      }
+      expect(pool.workerCount, equals(2));
+      expect(pool.activeJobs, equals(0));
+      expect(pool.queuedJobs, equals(0));
+    });
+
+    test('should run several configs from one decode', () async {
+      final results = await pool.runMany(testAudioPath, const [WaveformConfig(resolution: 30), WaveformConfig(resolution: 300)]);
+
+      expect(results[0].amplitudes, hasLength(30));
+      expect(results[1].amplitudes, hasLength(300));
+    });
+
+    test('should apply back-pressure when the queue is full', () async {
+      final smallPool = IsolateWorkerPool(size: 1, maxQueueLength: 1);
+      try {
+        final first = smallPool.run(testAudioPath, const WaveformConfig(resolution: 10));
+        final second = smallPool.run(testAudioPath, const WaveformConfig(resolution: 20));
+        final third = smallPool.run(testAudioPath, const WaveformConfig(resolution: 30));
+        await Future<void>.delayed(Duration.zero);
+
+        // The worker is still starting, so one job waits and the next one waits for space
+        expect(smallPool.queuedJobs, equals(1));
+
+        final results = await Future.wait([first, second, third]);
+        expect(results.map((result) => result.amplitudes.length), equals([10, 20, 30]));
+      } finally {
+        await smallPool.close();
+      }
+    });
+
+    test('should keep serving jobs after a failed job', () async {
+      await expectLater(pool.run('non_existent_file.wav', const WaveformConfig(resolution: 10)), throwsA(isA<SonixException>()));
+
+      final result = await pool.run(testAudioPath, const WaveformConfig(resolution: 10));
+      expect(result.amplitudes, hasLength(10));
+    });
+
+    test('should fail queued jobs and reject new ones after close', () async {
+      final closingPool = IsolateWorkerPool(size: 1);
+      final outcomes = [
+        for (final resolution in [10, 20])
+          closingPool.run(testAudioPath, WaveformConfig(resolution: resolution)).then<Object?>((result) => result, onError: (Object error) => error),
+      ];
+      await Future<void>.delayed(Duration.zero);
+
+      await closingPool.close();
+
+      // Jobs still waiting for the starting worker were failed by close()
+      expect((await Future.wait(outcomes)).whereType<StateError>(), isNotEmpty);
+      await expectLater(closingPool.run(testAudioPath, const WaveformConfig()), throwsStateError);
+      expect(closingPool.isClosed, isTrue);
+      expect(closingPool.workerCount, equals(0));
+    });
+  });
+}
@@ -0,0 +1,184 @@
+/// Tests for the WaveformScheduler class
+///
+/// These tests use a fake executor to verify request deduplication, priority
+/// ordering, promotion of queued jobs and shutdown behavior without spawning
+/// isolates.
+library;
+
+import 'dart:async';
+import 'dart:io';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:sonix/src/isolate/adaptive_concurrency_controller.dart';
+import 'package:sonix/src/isolate/waveform_scheduler.dart';
+import 'package:sonix/src/models/waveform_data.dart';
+import 'package:sonix/src/models/waveform_priority.dart';
+import 'package:sonix/src/processing/waveform_config.dart';
+
+/// Executor that records calls and completes them on demand
+class _FakeExecutor {
+  final List<String> calls = [];
+  final List<Completer<List<WaveformData>>> pending = [];
+
+  Future<List<WaveformData>> call(String filePath, List<WaveformConfig> configs) {
+    calls.add(filePath);
+    final completer = Completer<List<WaveformData>>();
+    pending.add(completer);
+    return completer.future;
+  }
+
+  void completeNext() {
+    pending.removeAt(0).complete([WaveformData.fromAmplitudes(const [0.5])]);
+  }
+}
+
+void main() {
+  group('WaveformScheduler', () {
+    const stereoPath = 'test/assets/test_stereo_44100.wav';
+    const monoPath = 'test/assets/test_mono_44100.wav';
+    late _FakeExecutor executor;
+
+    setUp(() {
+      executor = _FakeExecutor();
+    });
+
+    test('should merge identical in-flight requests', () async {
+      final scheduler = WaveformScheduler(executor.call, maxConcurrent: 2);
+
+      final first = scheduler.schedule(stereoPath, const [WaveformConfig(resolution: 100)]);
+      final second = scheduler.schedule(stereoPath, const [WaveformConfig(resolution: 100)]);
+      await pumpEventQueue();
+
+      expect(executor.calls, hasLength(1));
+      executor.completeNext();
+      final firstWaveform = (await first).single;
+      final secondWaveform = (await second).single;
+      expect(secondWaveform.amplitudes, equals(firstWaveform.amplitudes));
+
+      // Merged callers own separate buffers
+      firstWaveform.dispose();
+      expect(secondWaveform.amplitudes, equals([0.5]));
+    });
+
+    test('should not merge requests with different configs or files', () async {
+      final scheduler = WaveformScheduler(executor.call);
+
+      scheduler.schedule(stereoPath, const [WaveformConfig(resolution: 100)]).ignore();
+      scheduler.schedule(stereoPath, const [WaveformConfig(resolution: 200)]).ignore();
+      scheduler.schedule(monoPath, const [WaveformConfig(resolution: 100)]).ignore();
+      await pumpEventQueue();
+
+      expect(executor.calls, hasLength(3));
+    });
+
+    test('should run a finished request again on the next call', () async {
+      final scheduler = WaveformScheduler(executor.call);
+
+      final first = scheduler.schedule(stereoPath, const [WaveformConfig()]);
+      await pumpEventQueue();
+      executor.completeNext();
+      await first;
+
+      scheduler.schedule(stereoPath, const [WaveformConfig()]).ignore();
+      await pumpEventQueue();
+      expect(executor.calls, hasLength(2));
+    });
+
+    test('should not merge requests for a file modified in between', () async {
+      final directory = await Directory.systemTemp.createTemp('sonix_scheduler_test');
+      addTearDown(() => directory.delete(recursive: true));
+      final file = File('${directory.path}/clip.wav')..writeAsBytesSync(const [0]);
+      final scheduler = WaveformScheduler(executor.call);
+
+      scheduler.schedule(file.path, const [WaveformConfig()]).ignore();
+      await pumpEventQueue();
+      file.setLastModifiedSync(DateTime.now().add(const Duration(hours: 1)));
+      scheduler.schedule(file.path, const [WaveformConfig()]).ignore();
+      await pumpEventQueue();
+
+      expect(executor.calls, hasLength(2));
+    });
+
+    test('should start queued jobs by priority', () async {
+      final scheduler = WaveformScheduler(executor.call, maxConcurrent: 1);
+
+      scheduler.schedule('running.wav', const [WaveformConfig()]).ignore();
+      await pumpEventQueue();
+      scheduler.schedule('prefetch.wav', const [WaveformConfig()], priority: WaveformPriority.prefetch).ignore();
+      scheduler.schedule('normal.wav', const [WaveformConfig()]).ignore();
+      scheduler.schedule('visible.wav', const [WaveformConfig()], priority: WaveformPriority.visible).ignore();
+      await pumpEventQueue();
+      expect(scheduler.queuedJobs, equals(3));
+
+      for (int i = 0; i < 3; i++) {
+        executor.completeNext();
+        await pumpEventQueue();
+      }
+
+      expect(executor.calls, equals(['running.wav', 'visible.wav', 'normal.wav', 'prefetch.wav']));
+    });
+
+    test('should promote a queued job when a duplicate has higher priority', () async {
+      final scheduler = WaveformScheduler(executor.call, maxConcurrent: 1);
+
+      scheduler.schedule('running.wav', const [WaveformConfig()]).ignore();
+      await pumpEventQueue();
+      scheduler.schedule('a.wav', const [WaveformConfig()]).ignore();
+      scheduler.schedule('b.wav', const [WaveformConfig()], priority: WaveformPriority.prefetch).ignore();
+      scheduler.schedule('b.wav', const [WaveformConfig()], priority: WaveformPriority.visible).ignore();
+      await pumpEventQueue();
+
+      executor.completeNext();
+      await pumpEventQueue();
+
+      expect(executor.calls, equals(['running.wav', 'b.wav']));
+    });
+
+    test('should share errors between merged requests', () async {
+      final scheduler = WaveformScheduler(executor.call);
+
+      final first = scheduler.schedule(stereoPath, const [WaveformConfig()]);
+      final second = scheduler.schedule(stereoPath, const [WaveformConfig()]);
+      await pumpEventQueue();
+      final expectations = [expectLater(first, throwsStateError), expectLater(second, throwsStateError)];
+      executor.pending.single.completeError(StateError('decode failed'));
+
+      await Future.wait(expectations);
+    });
+
+    test('should fail queued jobs and reject new ones after close', () async {
+      final scheduler = WaveformScheduler(executor.call, maxConcurrent: 1);
+
+      final running = scheduler.schedule('running.wav', const [WaveformConfig()]);
+      await pumpEventQueue();
+      final queued = scheduler.schedule('queued.wav', const [WaveformConfig()]);
+      await pumpEventQueue();
+
+      final queuedExpectation = expectLater(queued, throwsStateError);
+      scheduler.close();
+      executor.completeNext();
+
+      expect(await running, hasLength(1));
+      await queuedExpectation;
+      await expectLater(scheduler.schedule(stereoPath, const [WaveformConfig()]), throwsStateError);
+    });
+
+    test('should follow the limit of an adaptive controller', () async {
+      final controller = AdaptiveConcurrencyController(maxConcurrency: 4, memoryBudget: 1 << 30, readRss: () => 0);
+      final scheduler = WaveformScheduler(executor.call, maxConcurrent: 4, controller: controller);
+
+      for (int i = 0; i < 5; i++) {
+        scheduler.schedule('clip_$i.wav', const [WaveformConfig()]).ignore();
+      }
+      await pumpEventQueue();
+
+      expect(controller.limit, equals(2));
+      expect(scheduler.runningJobs, equals(2));
+      expect(scheduler.queuedJobs, equals(3));
+    });
+
+    test('should reject non-positive concurrency limits', () {
+      expect(() => WaveformScheduler(executor.call, maxConcurrent: 0), throwsArgumentError);
+    });
+  });
+}
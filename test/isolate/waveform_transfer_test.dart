@@ -0,0 +1,88 @@
+/// Tests for the WaveformTransfer class
+///
+/// These tests verify that waveforms survive packing into a single
+/// transferable buffer, including per-channel data, bins and pyramids, both
+/// within one isolate and across isolates.
+library;
+
+import 'dart:isolate';
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:sonix/src/isolate/waveform_transfer.dart';
+import 'package:sonix/src/models/waveform_bins.dart';
+import 'package:sonix/src/models/waveform_channel_mode.dart';
+import 'package:sonix/src/models/waveform_data.dart';
+import 'package:sonix/src/models/waveform_metadata.dart';
+import 'package:sonix/src/models/waveform_pyramid.dart';
+import 'package:sonix/src/models/waveform_type.dart';
+
+WaveformData _richWaveform() {
+  final bins = WaveformBins(Float32List.fromList([-0.5, -0.25, 0.5, 0.75, 0.3, 0.4]));
+  return WaveformData(
+    amplitudes: [0.25, 0.5],
+    duration: const Duration(milliseconds: 1500),
+    sampleRate: 48000,
+    metadata: WaveformMetadata(resolution: 2, type: WaveformType.line, normalized: false, generatedAt: DateTime(2025, 1, 2)),
+    channelAmplitudes: Float32List.fromList([0.1, 0.2, 0.3, 0.4]),
+    channelCount: 2,
+    channelMode: WaveformChannelMode.perChannel,
+    bins: bins,
+    pyramid: WaveformPyramid.fromBaseLevel(
+      WaveformBins(Float32List.fromList([-0.1, -0.2, -0.3, 0.1, 0.2, 0.3, 0.1, 0.2, 0.3])),
+      sampleRate: 48000,
+      totalFrames: 700,
+      baseFramesPerBin: 256,
+    ),
+  );
+}
+
+void main() {
+  group('WaveformTransfer', () {
+    void expectSameWaveform(WaveformData actual, WaveformData expected) {
+      expect(actual.amplitudes, equals(expected.amplitudes));
+      expect(actual.duration, equals(expected.duration));
+      expect(actual.sampleRate, equals(expected.sampleRate));
+      expect(actual.metadata.type, equals(expected.metadata.type));
+      expect(actual.metadata.normalized, equals(expected.metadata.normalized));
+      expect(actual.channelAmplitudes, equals(expected.channelAmplitudes));
+      expect(actual.channelCount, equals(expected.channelCount));
+      expect(actual.channelMode, equals(expected.channelMode));
+      expect(actual.bins!.data, equals(expected.bins!.data));
+      expect(actual.pyramid!.levelCount, equals(expected.pyramid!.levelCount));
+      for (int i = 0; i < expected.pyramid!.levelCount; i++) {
+        expect(actual.pyramid!.levels[i].data, equals(expected.pyramid!.levels[i].data));
+      }
+      expect(actual.pyramid!.totalFrames, equals(expected.pyramid!.totalFrames));
+    }
+
+    test('should round-trip all waveform buffers', () {
+      final original = _richWaveform();
+      final plain = WaveformData.fromAmplitudes(const [0.0, 1.0, 0.5]);
+
+      final unpacked = WaveformTransfer.pack([original, plain]).unpack();
+
+      expect(unpacked, hasLength(2));
+      expectSameWaveform(unpacked[0], original);
+      expect(unpacked[1].amplitudes, equals([0.0, 1.0, 0.5]));
+      expect(unpacked[1].channelAmplitudes, isNull);
+      expect(unpacked[1].bins, isNull);
+      expect(unpacked[1].pyramid, isNull);
+    });
+
+    test('should expose amplitudes as views over one shared buffer', () {
+      final unpacked = WaveformTransfer.pack([_richWaveform(), _richWaveform()]).unpack();
+
+      final first = unpacked[0].amplitudes;
+      final second = unpacked[1].amplitudes;
+      expect(identical(first.buffer, second.buffer), isTrue);
+      expect(identical(first.buffer, unpacked[0].pyramid!.levels.last.data.buffer), isTrue);
+    });
+
+    test('should transfer waveforms from another isolate', () async {
+      final transfer = await Isolate.run(() => WaveformTransfer.pack([_richWaveform()]));
+
+      expectSameWaveform(transfer.unpack().single, _richWaveform());
+    });
+  });
+}
@@ -0,0 +1,80 @@
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:sonix/src/exceptions/sonix_exceptions.dart';
+import 'package:sonix/src/models/mapped_waveform_data.dart';
+import 'package:sonix/src/models/waveform_bins.dart';
+import 'package:sonix/src/models/waveform_data.dart';
+import 'package:sonix/src/models/waveform_metadata.dart';
+import 'package:sonix/src/models/waveform_pyramid.dart';
+import 'package:sonix/src/models/waveform_type.dart';
+import '../ffmpeg/ffmpeg_setup_helper.dart';
+
+void main() {
+  group('MappedWaveformData', () {
+    late Directory tempDir;
+
+    setUpAll(() async {
+      await FFMPEGSetupHelper.setupFFMPEGForTesting();
+    });
+
+    setUp(() async {
+      tempDir = await Directory.systemTemp.createTemp('mapped_waveform_test');
+    });
+
+    tearDown(() async {
+      await tempDir.delete(recursive: true);
+    });
+
+    WaveformData waveformWithPyramid() {
+      const baseBins = 1000;
+      final base = WaveformBins.allocate(baseBins);
+      for (int i = 0; i < baseBins; i++) {
+        base.min[i] = -i / baseBins;
+        base.max[i] = i / baseBins;
+        base.rms[i] = i / (2 * baseBins);
+      }
+      return WaveformData(
+        amplitudes: List.generate(200, (i) => i / 200),
+        duration: const Duration(seconds: 6),
+        sampleRate: 44100,
+        metadata: WaveformMetadata(resolution: 200, type: WaveformType.bars, normalized: true, generatedAt: DateTime.utc(2025)),
+        pyramid: WaveformPyramid.fromBaseLevel(base, sampleRate: 44100, totalFrames: 256 * baseBins),
+      );
+    }
+
+    test('should serve a saved waveform from the mapping', () async {
+      final original = waveformWithPyramid();
+      final path = '${tempDir.path}/track.snxw';
+      await MappedWaveformData.save(original, path, configHash: 0x1234);
+
+      final mapped = MappedWaveformData.open(path);
+      try {
+        expect(mapped.amplitudes, equals(original.amplitudes));
+        expect(mapped.duration, equals(original.duration));
+        expect(mapped.pyramid!.levelCount, equals(original.pyramid!.levelCount));
+        for (int i = 0; i < original.pyramid!.levelCount; i++) {
+          expect(mapped.pyramid!.levels[i].data, equals(original.pyramid!.levels[i].data), reason: 'level $i');
+        }
+        // Views of one mapping, not copies
+        expect(mapped.pyramid!.levels.last.data.buffer, same(mapped.amplitudes.buffer));
+      } finally {
+        mapped.dispose();
+      }
+      expect(mapped.isDisposed, isTrue);
+      expect(mapped.amplitudes, isEmpty);
+    });
+
+    test('should reject files that are not binary waveforms', () async {
+      final path = '${tempDir.path}/bogus.snxw';
+      await File(path).writeAsBytes(Uint8List(128));
+
+      expect(() => MappedWaveformData.open(path), throwsFormatException);
+    });
+
+    test('should report files that cannot be mapped', () {
+      expect(() => MappedWaveformData.open('${tempDir.path}/missing.snxw'), throwsA(isA<FileAccessException>()));
+    });
+  });
+}
@@ -0,0 +1,143 @@
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:sonix/src/models/waveform_binary_codec.dart';
+import 'package:sonix/src/models/waveform_bins.dart';
+import 'package:sonix/src/models/waveform_channel_mode.dart';
+import 'package:sonix/src/models/waveform_data.dart';
+import 'package:sonix/src/models/waveform_metadata.dart';
+import 'package:sonix/src/models/waveform_pyramid.dart';
+import 'package:sonix/src/models/waveform_type.dart';
+
+void main() {
+  group('WaveformBinaryCodec', () {
+    WaveformData richWaveform() => WaveformData(
+      amplitudes: [0.1, 0.5, 0.8, 0.3],
+      duration: const Duration(milliseconds: 2500),
+      sampleRate: 44100,
+      metadata: WaveformMetadata(resolution: 4, type: WaveformType.line, normalized: false, generatedAt: DateTime.utc(2024, 5, 6)),
+      channelAmplitudes: Float32List.fromList([0.1, 0.4, 0.8, 0.2, 0.2, 0.6, 0.7, 0.4]),
+      channelCount: 2,
+      channelMode: WaveformChannelMode.perChannel,
+      bins: WaveformBins(Float32List.fromList([-0.5, -0.25, -0.75, 0.5, 0.5, 0.25, 0.3, 0.4, 0.2])),
+      pyramid: WaveformPyramid.fromBaseLevel(
+        WaveformBins(Float32List.fromList([-0.1, -0.5, -0.2, -0.9, 0.2, 0.4, 0.1, 0.8, 0.1, 0.3, 0.1, 0.6])),
+        sampleRate: 44100,
+        totalFrames: 1000,
+        baseFramesPerBin: 256,
+      ),
+    );
+
+    void expectClose(List<double> actual, List<double> expected, double tolerance) {
+      expect(actual, hasLength(expected.length));
+      for (int i = 0; i < expected.length; i++) {
+        expect(actual[i], closeTo(expected[i], tolerance), reason: 'index $i');
+      }
+    }
+
+    test('should round-trip all sections losslessly as float32', () {
+      final original = richWaveform();
+      final restored = WaveformData.fromBinary(original.toBinary());
+
+      expect(restored.amplitudes, equals(original.amplitudes));
+      expect(restored.duration, equals(original.duration));
+      expect(restored.sampleRate, equals(44100));
+      expect(restored.metadata.type, equals(WaveformType.line));
+      expect(restored.metadata.normalized, isFalse);
+      expect(restored.metadata.generatedAt, equals(original.metadata.generatedAt));
+      expect(restored.channelAmplitudes, equals(original.channelAmplitudes));
+      expect(restored.channelCount, equals(2));
+      expect(restored.channelMode, equals(WaveformChannelMode.perChannel));
+      expect(restored.bins!.data, equals(original.bins!.data));
+      expect(restored.pyramid!.levelCount, equals(original.pyramid!.levelCount));
+      expect(restored.pyramid!.levels.last.data, equals(original.pyramid!.levels.last.data));
+      expect(restored.pyramid!.totalFrames, equals(1000));
+      expect(restored.pyramid!.baseFramesPerBin, equals(256));
+    });
+
+    test('should decode float32 sections as views of the input', () {
+      final bytes = WaveformData.fromAmplitudes([0.25, 0.5]).toBinary();
+
+      expect(WaveformData.fromBinary(bytes).amplitudes.buffer, same(bytes.buffer));
+    });
+
+    test('should store every pyramid level when asked and decode them as views', () {
+      final original = richWaveform();
+      final bytes = original.toBinary(allPyramidLevels: true);
+
+      final restored = WaveformData.fromBinary(bytes);
+
+      expect(bytes.length, greaterThan(original.toBinary().length));
+      expect(restored.pyramid!.levelCount, equals(original.pyramid!.levelCount));
+      for (int i = 0; i < original.pyramid!.levelCount; i++) {
+        expect(restored.pyramid!.levels[i].data, equals(original.pyramid!.levels[i].data), reason: 'level $i');
+        expect(restored.pyramid!.levels[i].data.buffer, same(bytes.buffer), reason: 'level $i');
+      }
+    });
+
+    test('should reject stored pyramid levels of the wrong size', () {
+      final bytes = richWaveform().toBinary(allPyramidLevels: true);
+      // Levels of 4, 2 and 1 bins end the file; claim the 2-bin level holds 1 bin
+      final middleLevel = bytes.length - (12 + 3 * 4) - (12 + 6 * 4);
+      ByteData.sublistView(bytes).setUint32(middleLevel, 3, Endian.little);
+
+      expect(() => WaveformData.fromBinary(bytes), throwsFormatException);
+    });
+
+    test('should round-trip quantized data within the step size', () {
+      final original = richWaveform();
+
+      for (final (quantization, tolerance) in [(WaveformQuantization.bits16, 1e-4), (WaveformQuantization.bits8, 1e-2)]) {
+        final restored = WaveformData.fromBinary(original.toBinary(quantization: quantization));
+
+        expectClose(restored.amplitudes, original.amplitudes, tolerance);
+        expectClose(restored.channelAmplitudes!, original.channelAmplitudes!, tolerance);
+        expectClose(restored.bins!.data, original.bins!.data, tolerance);
+        expectClose(restored.pyramid!.levels.first.data, original.pyramid!.levels.first.data, tolerance);
+      }
+    });
+
+    test('should shrink the encoding with coarser quantization', () {
+      final waveform = WaveformData.fromAmplitudes(List.generate(1000, (i) => i / 1000));
+
+      final float32 = waveform.toBinary().length;
+      final bits16 = waveform.toBinary(quantization: WaveformQuantization.bits16).length;
+      final bits8 = waveform.toBinary(quantization: WaveformQuantization.bits8).length;
+
+      expect(float32, equals(WaveformBinaryCodec.headerSize + 12 + 4000));
+      expect(bits16, equals(WaveformBinaryCodec.headerSize + 12 + 2000));
+      expect(bits8, equals(WaveformBinaryCodec.headerSize + 12 + 1000));
+    });
+
+    test('should read the header without decoding', () {
+      final bytes = richWaveform().toBinary(quantization: WaveformQuantization.bits8, configHash: 0xdeadbeef);
+      final header = WaveformBinaryCodec.readHeader(bytes);
+
+      expect(header.version, equals(WaveformBinaryCodec.version));
+      expect(header.quantization, equals(WaveformQuantization.bits8));
+      expect(header.sampleRate, equals(44100));
+      expect(header.duration, equals(const Duration(milliseconds: 2500)));
+      expect(header.binCount, equals(4));
+      expect(header.channelCount, equals(2));
+      expect(header.configHash, equals(0xdeadbeef));
+    });
+
+    test('should omit absent sections', () {
+      final restored = WaveformData.fromBinary(WaveformData.fromAmplitudes([0.0, 1.0]).toBinary());
+
+      expect(restored.amplitudes, equals([0.0, 1.0]));
+      expect(restored.channelAmplitudes, isNull);
+      expect(restored.bins, isNull);
+      expect(restored.pyramid, isNull);
+    });
+
+    test('should reject malformed input', () {
+      final bytes = richWaveform().toBinary();
+
+      expect(() => WaveformData.fromBinary(Uint8List(10)), throwsFormatException);
+      expect(() => WaveformData.fromBinary(Uint8List(WaveformBinaryCodec.headerSize)), throwsFormatException);
+      expect(() => WaveformData.fromBinary(Uint8List.sublistView(bytes, 0, bytes.length - 8)), throwsFormatException);
+      expect(() => WaveformData.fromBinary(Uint8List.fromList(bytes)..[4] = 99), throwsFormatException);
+    });
+  });
+}
@@ -0,0 +1,92 @@
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:sonix/src/models/waveform_bins.dart';
+import 'package:sonix/src/models/waveform_pyramid.dart';
+
+void main() {
+  group('WaveformPyramid', () {
+    // 5 base bins of 4 frames each (last bin covers 2 frames): min | max | rms
+    WaveformBins baseLevel() => WaveformBins(
+      Float32List.fromList([-0.1, -0.5, -0.2, -0.9, -0.3, 0.2, 0.4, 0.1, 0.8, 0.6, 0.1, 0.3, 0.1, 0.6, 0.4]),
+    );
+
+    WaveformPyramid buildPyramid() => WaveformPyramid.fromBaseLevel(baseLevel(), sampleRate: 8, totalFrames: 18, baseFramesPerBin: 4);
+
+    test('should halve the bin count per level down to a single bin', () {
+      final pyramid = buildPyramid();
+
+      expect(pyramid.levels.map((level) => level.length), equals([5, 3, 2, 1]));
+      expect(pyramid.framesPerBin(0), equals(4));
+      expect(pyramid.framesPerBin(3), equals(32));
+    });
+
+    test('should merge min, max and RMS of neighbouring bins', () {
+      final level1 = buildPyramid().levels[1];
+
+      expect(level1.min[0], closeTo(-0.5, 1e-6));
+      expect(level1.max[0], closeTo(0.4, 1e-6));
+      expect(level1.rms[0], closeTo(0.2236068, 1e-6)); // sqrt((0.01 + 0.09) / 2)
+      expect(level1.min[2], closeTo(-0.3, 1e-6)); // Odd bin carried over
+      expect(level1.rms[2], closeTo(0.4, 1e-6));
+
+      final top = buildPyramid().levels.last;
+      expect(top.min[0], closeTo(-0.9, 1e-6));
+      expect(top.max[0], closeTo(0.8, 1e-6));
+    });
+
+    test('should pick the coarsest level with enough bins', () {
+      final pyramid = buildPyramid();
+
+      expect(pyramid.levelForSpan(18, 18), equals(0)); // Finer than level 0
+      expect(pyramid.levelForSpan(16, 2), equals(1)); // 8 frames per bin
+      expect(pyramid.levelForSpan(18, 1), equals(2)); // 16 <= 18 < 32
+      expect(pyramid.levelForSpan(0, 10), equals(0));
+    });
+
+    test('should slice a frame range from the chosen level', () {
+      final slice = buildPyramid().sliceFrames(4, 12, 2);
+
+      // Level 0 has 2 bins covering frames 4..12
+      expect(slice.length, equals(2));
+      expect(slice.min, equals(Float32List.fromList([-0.5, -0.2])));
+      expect(slice.max, equals(Float32List.fromList([0.4, 0.1])));
+    });
+
+    test('should slice by time', () {
+      final pyramid = buildPyramid();
+
+      final slice = pyramid.slice(Duration.zero, const Duration(seconds: 1), 1);
+      expect(slice.length, equals(1));
+      expect(slice.min[0], closeTo(-0.5, 1e-6));
+      expect(pyramid.duration, equals(const Duration(milliseconds: 2250)));
+    });
+
+    test('should clamp slices to the covered range', () {
+      final pyramid = buildPyramid();
+
+      expect(pyramid.sliceFrames(-10, 1000, 100).length, equals(5));
+      expect(pyramid.sliceFrames(100, 200, 10).isEmpty, isTrue);
+    });
+
+    test('should scale every level', () {
+      final pyramid = buildPyramid()..scale(2.0);
+
+      expect(pyramid.levels.first.min[3], closeTo(-1.8, 1e-6));
+      expect(pyramid.levels.last.max[0], closeTo(1.6, 1e-6));
+    });
+
+    test('should rebuild all levels from JSON', () {
+      final restored = WaveformPyramid.fromJson(buildPyramid().toJson());
+
+      expect(restored.levelCount, equals(4));
+      expect(restored.baseFramesPerBin, equals(4));
+      expect(restored.totalFrames, equals(18));
+      expect(restored.levels[1].rms[0], closeTo(0.2236068, 1e-6));
+    });
+
+    test('should reject non-positive frames per bin', () {
+      expect(() => WaveformPyramid.fromBaseLevel(baseLevel(), sampleRate: 8, totalFrames: 18, baseFramesPerBin: 0), throwsArgumentError);
+    });
+  });
+}
@@ -4,6 +4,7 @@ import 'package:flutter_test/flutter_test.dart';
 import 'package:sonix/src/native/native_audio_bindings.dart';
 import 'package:sonix/src/decoders/audio_decoder.dart';
 import 'package:sonix/src/native/sonix_bindings.dart';
+import 'package:sonix/src/exceptions/sonix_exceptions.dart';
 import '../ffmpeg/ffmpeg_setup_helper.dart';
 
 void main() {
@@ -263,4 +264,51 @@ void main() {
       });
     });
   });
+  group('NativeAudioBindings.decodeFile', () {
+    setUpAll(() async {
+      final available = await FFMPEGSetupHelper.setupFFMPEGForTesting();
+      if (!available) {
+        throw Exception('FFMPEG libraries not available for testing');
+      }
+      NativeAudioBindings.initialize();
+    });
+
+    for (final (path, format) in [
+      ('test/assets/test_stereo_44100.wav', AudioFormat.wav),
+      ('test/assets/test_short.mp3', AudioFormat.mp3),
+      ('test/assets/test_sample.flac', AudioFormat.flac),
+    ]) {
+      test('should decode $path by path like the in-memory decoder', () async {
+        final fromPath = NativeAudioBindings.decodeFile(path);
+        final fromBytes = NativeAudioBindings.decodeAudio(await File(path).readAsBytes(), format);
+
+        expect(fromPath.samples, isA<Float32List>());
+        expect(fromPath.sampleRate, equals(fromBytes.sampleRate));
+        expect(fromPath.channels, equals(fromBytes.channels));
+        // Both decode with the same FFmpeg pipeline; allow for a difference in trailing padding
+        expect((fromPath.samples.length - fromBytes.samples.length).abs(), lessThanOrEqualTo(fromBytes.channels * 2048));
+        final length = fromPath.samples.length < fromBytes.samples.length ? fromPath.samples.length : fromBytes.samples.length;
+        for (int i = 0; i < length; i += 101) {
+          expect(fromPath.samples[i], closeTo(fromBytes.samples[i], 1e-4), reason: 'sample $i');
+        }
+      });
+    }
+
+    test('should free the decoded audio on dispose', () {
+      final audioData = NativeAudioBindings.decodeFile('test/assets/test_short.mp3');
+      // Finalizers of earlier decodes may run at any time, so only a drop is exact
+      final live = NativeAudioBindings.resourceCounters().audioData;
+
+      audioData.dispose();
+      audioData.dispose();
+      expect(NativeAudioBindings.resourceCounters().audioData, lessThanOrEqualTo(live - 1));
+      expect(audioData.isDisposed, isTrue);
+      expect(() => audioData.samples, throwsStateError);
+    });
+
+    test('should throw DecodingException for unreadable files', () {
+      expect(() => NativeAudioBindings.decodeFile('test/assets/empty_file.mp3'), throwsA(isA<DecodingException>()));
+      expect(() => NativeAudioBindings.decodeFile('/non/existent/file.wav'), throwsA(isA<DecodingException>()));
+    });
+  });
 }
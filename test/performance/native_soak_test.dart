@@ -0,0 +1,140 @@
+// ignore_for_file: avoid_print
+
+/// Native Soak/Leak Test
+///
+/// Runs whole-file decodes, in-memory decodes, streamed decodes (read to the
+/// end or cancelled part-way), decode-once waveforms and scratch-file decodes
+/// over every test asset - corrupt and truncated ones included - from several
+/// isolates at once, through the same FFI bindings the package uses. Afterwards
+/// every explicitly released native resource must be gone and the resident
+/// set must not have kept growing after warm-up.
+///
+/// The default run is short enough for CI. For a real soak:
+///   SONIX_SOAK_ITERATIONS=10000 SONIX_SOAK_ISOLATES=8 flutter test test/performance/native_soak_test.dart
+///
+/// The native harness in native/soak/sonix_soak.c covers the same jobs plus
+/// seeks on raw threads, without the Dart heap in the picture.
+///
+/// Run with: flutter test test/performance/native_soak_test.dart
+library;
+
+import 'dart:io';
+import 'dart:isolate';
+import 'dart:math' as math;
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:sonix/src/decoders/audio_file_decoder.dart';
+import 'package:sonix/src/native/native_audio_bindings.dart';
+import 'package:sonix/src/processing/downsampling_algorithm.dart';
+import 'package:sonix/src/processing/waveform_config.dart';
+import '../ffmpeg/ffmpeg_setup_helper.dart';
+
+/// Runs [iterations] jobs, cycling through jobs and [files]; returns the number that failed
+int _soak(List<String> files, int iterations, int seed, String scratchDirectory) {
+  const jobCount = 4;
+  const configs = [WaveformConfig(resolution: 1000), WaveformConfig(resolution: 200, algorithm: DownsamplingAlgorithm.peak)];
+  int failures = 0;
+
+  for (int i = 0; i < iterations; i++) {
+    final path = files[(i ~/ jobCount + seed) % files.length];
+    try {
+      switch (i % jobCount) {
+        case 0:
+          NativeAudioBindings.decodeFile(path).dispose();
+        case 1:
+          final data = File(path).readAsBytesSync();
+          NativeAudioBindings.decodeAudio(data, NativeAudioBindings.detectFormat(data)).dispose();
+        case 2:
+          NativeAudioBindings.generateWaveforms(path, configs);
+        case 3:
+          final scratch = '$scratchDirectory/soak_$seed.f32';
+          try {
+            NativeAudioBindings.decodeToScratchFile(path, scratch);
+            NativeAudioBindings.releaseScratchMapping(NativeAudioBindings.openScratchMapping(scratch));
+          } finally {
+            final file = File(scratch);
+            if (file.existsSync()) file.deleteSync();
+          }
+      }
+    } catch (_) {
+      // Corrupt and truncated files are expected to fail; only leaks count
+      failures++;
+    }
+  }
+  return failures;
+}
+
+/// Runs one round of jobs on [isolates] isolates, with streamed decodes on separate isolates
+Future<int> _round(List<String> files, int isolates, int iterationsPerIsolate, String scratchDirectory) async {
+  final results = await Future.wait([
+    for (int seed = 0; seed < isolates; seed++) ...[
+      Isolate.run(() => _soak(files, iterationsPerIsolate, seed, scratchDirectory)),
+      Isolate.run(() => _soakStreaming(files, iterationsPerIsolate ~/ 4, seed)),
+    ],
+  ]);
+  return results.fold<int>(0, (sum, failures) => sum + failures);
+}
+
+/// Streams [iterations] decodes, cancelling every other one after a few chunks
+Future<int> _soakStreaming(List<String> files, int iterations, int seed) async {
+  int failures = 0;
+  for (int i = 0; i < iterations; i++) {
+    final decoder = StreamingAudioFileDecoder();
+    try {
+      final stream = decoder.decodeStreaming(files[(i + seed) % files.length]);
+      // Cancelling the subscription runs the decoder's cleanup mid-file
+      await (i.isEven ? stream : stream.take(1 + i % 3)).forEach((chunk) => chunk.dispose());
+    } catch (_) {
+      failures++;
+    } finally {
+      decoder.dispose();
+    }
+  }
+  return failures;
+}
+
+void main() {
+  final environment = Platform.environment;
+  final iterations = int.parse(environment['SONIX_SOAK_ITERATIONS'] ?? '500');
+  final isolates = int.parse(environment['SONIX_SOAK_ISOLATES'] ?? '4');
+  final maxRssGrowthMb = double.parse(environment['SONIX_SOAK_MAX_RSS_GROWTH_MB'] ?? '96');
+
+  setUpAll(() async {
+    await FFMPEGSetupHelper.setupFFMPEGForTesting();
+  });
+
+  test('SOAK: native resources are released under concurrent load', () async {
+    final files = Directory('test/assets').listSync().whereType<File>().map((f) => f.path).where((p) => !p.endsWith('.md') && !p.endsWith('.json')).toList()
+      ..sort();
+    final tempDir = await Directory.systemTemp.createTemp('sonix_soak');
+
+    String describe(({int audioData, int chunkResults, int chunkedDecoders, int multiWaveformResults, int ffmpegContexts, int mappings, int mappedBytes}) c) =>
+        'audio_data=${c.audioData} chunk_results=${c.chunkResults} decoders=${c.chunkedDecoders} '
+        'waveform_results=${c.multiWaveformResults} ffmpeg_contexts=${c.ffmpegContexts} mappings=${c.mappings}';
+
+    try {
+      // Warm-up: allocator pools, FFmpeg tables and isolate spawning settle
+      await _round(files, isolates, math.max(iterations ~/ 10, files.length), tempDir.path);
+      final warmRss = ProcessInfo.currentRss;
+
+      final failures = await _round(files, isolates, iterations, tempDir.path);
+      final counters = NativeAudioBindings.resourceCounters();
+      final growthMb = (ProcessInfo.currentRss - warmRss) / (1024 * 1024);
+
+      print('');
+      print('Soaked ${files.length} files, $isolates isolates x $iterations jobs ($failures expected failures)');
+      print('Live: ${describe(counters)}');
+      print('RSS growth after warm-up: ${growthMb.toStringAsFixed(1)} MB (limit $maxRssGrowthMb MB)');
+
+      expect(counters.audioData, equals(0), reason: describe(counters));
+      expect(counters.chunkResults, equals(0), reason: describe(counters));
+      expect(counters.chunkedDecoders, equals(0), reason: describe(counters));
+      expect(counters.multiWaveformResults, equals(0), reason: describe(counters));
+      expect(counters.ffmpegContexts, equals(0), reason: describe(counters));
+      expect(counters.mappings, equals(0), reason: describe(counters));
+      expect(growthMb, lessThan(maxRssGrowthMb));
+    } finally {
+      await tempDir.delete(recursive: true);
+    }
+  }, timeout: const Timeout(Duration(hours: 2)));
+}
@@ -0,0 +1,86 @@
+// ignore_for_file: avoid_print
+
+/// Float32x4 SIMD Micro-Benchmarks
+///
+/// These benchmarks compare the generic `List<double>` loops of
+/// WaveformAlgorithms with the Float32Simd paths taken for `Float32List`
+/// input, on mono and interleaved stereo signals.
+///
+/// Run with: flutter test test/performance/simd_benchmark_test.dart
+library;
+
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:sonix/src/processing/downsampling_algorithm.dart';
+import 'package:sonix/src/processing/waveform_algorithms.dart';
+
+void main() {
+  group('Float32x4 SIMD Benchmarks', () {
+    const sampleCount = 4 * 1024 * 1024;
+    const iterations = 10;
+
+    final typed = Float32List(sampleCount);
+    for (int i = 0; i < sampleCount; i++) {
+      typed[i] = math.sin(i * 0.01) * 0.8;
+    }
+    // Same values behind the generic List<double> path
+    final generic = List<double>.of(typed);
+
+    /// Best time in microseconds of [iterations] runs after one warm-up
+    int bestOf(Object? Function() run) {
+      run();
+      var best = 1 << 62;
+      for (var i = 0; i < iterations; i++) {
+        final stopwatch = Stopwatch()..start();
+        run();
+        stopwatch.stop();
+        best = math.min(best, stopwatch.elapsedMicroseconds);
+      }
+      return best;
+    }
+
+    void report(String name, int scalarMicros, int simdMicros) {
+      print('  ${name.padRight(28)} scalar ${scalarMicros.toString().padLeft(7)} µs   simd ${simdMicros.toString().padLeft(7)} µs   '
+          '${(scalarMicros / math.max(1, simdMicros)).toStringAsFixed(1)}x');
+    }
+
+    test('BENCHMARK: RMS and peak over 4M samples', () {
+      print('');
+      print('═══════════════════════════════════════════════════════════');
+      print('Whole-buffer reductions ($sampleCount samples, best of $iterations)');
+      print('───────────────────────────────────────────────────────────');
+      report('calculateRMS', bestOf(() => WaveformAlgorithms.calculateRMS(generic)), bestOf(() => WaveformAlgorithms.calculateRMS(typed)));
+      report('calculatePeak', bestOf(() => WaveformAlgorithms.calculatePeak(generic)), bestOf(() => WaveformAlgorithms.calculatePeak(typed)));
+      report('calculateRMSAndPeak', bestOf(() => WaveformAlgorithms.calculateRMSAndPeak(generic)), bestOf(() => WaveformAlgorithms.calculateRMSAndPeak(typed)));
+      print('═══════════════════════════════════════════════════════════');
+
+      // Just ensure both paths agree - this is a benchmark, not a pass/fail test
+      expect(WaveformAlgorithms.calculateRMS(typed), closeTo(WaveformAlgorithms.calculateRMS(generic), 1e-6));
+    });
+
+    test('BENCHMARK: downsample to 2000 bins', () {
+      print('');
+      print('═══════════════════════════════════════════════════════════');
+      print('downsample ($sampleCount samples -> 2000 bins, best of $iterations)');
+      print('───────────────────────────────────────────────────────────');
+      for (final channels in [1, 2]) {
+        for (final algorithm in [DownsamplingAlgorithm.rms, DownsamplingAlgorithm.peak, DownsamplingAlgorithm.average]) {
+          report(
+            '${algorithm.name}, ${channels == 1 ? 'mono' : 'stereo'}',
+            bestOf(() => WaveformAlgorithms.downsample(generic, 2000, algorithm: algorithm, channels: channels)),
+            bestOf(() => WaveformAlgorithms.downsample(typed, 2000, algorithm: algorithm, channels: channels)),
+          );
+        }
+      }
+      print('═══════════════════════════════════════════════════════════');
+
+      final simd = WaveformAlgorithms.downsample(typed, 2000, channels: 2);
+      final scalar = WaveformAlgorithms.downsample(generic, 2000, channels: 2);
+      for (int i = 0; i < scalar.length; i++) {
+        expect(simd[i], closeTo(scalar[i], 1e-6));
+      }
+    });
+  });
+}
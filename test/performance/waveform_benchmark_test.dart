@@ -0,0 +1,92 @@
+// ignore_for_file: avoid_print
+
+/// End-to-End Waveform Benchmark Suite
+///
+/// Decodes and generates waveforms from the same track in every bundled
+/// format, optionally plus generated long WAV files, across resolutions,
+/// algorithms and in-process vs. isolate generation. Results are written as
+/// JSON; when a baseline is given the suite fails on regressions beyond the
+/// threshold.
+///
+/// The default run only uses the bundled assets and is short enough for CI.
+/// Long files take hundreds of MB of disk and minutes per scenario:
+///   SONIX_BENCHMARK_MINUTES=10,60 flutter test test/performance/waveform_benchmark_test.dart
+///
+/// Run with: flutter test test/performance/waveform_benchmark_test.dart
+///
+/// Environment:
+///   SONIX_BENCHMARK_OUTPUT     result file (default: build/benchmarks/waveform_benchmark.json)
+///   SONIX_BENCHMARK_BASELINE   result file of an earlier run to compare against
+///   SONIX_BENCHMARK_THRESHOLD  allowed relative regression (default: 0.10)
+///   SONIX_BENCHMARK_MINUTES    comma-separated long file lengths (default: none)
+///
+/// Record a baseline on the reference machine, then compare later runs:
+///   SONIX_BENCHMARK_OUTPUT=baseline.json flutter test test/performance/waveform_benchmark_test.dart
+///   SONIX_BENCHMARK_BASELINE=baseline.json flutter test test/performance/waveform_benchmark_test.dart
+library;
+
+import 'dart:convert';
+import 'dart:io';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:sonix/src/processing/downsampling_algorithm.dart';
+import 'package:sonix/src/utils/benchmark_result.dart';
+import 'package:sonix/src/utils/waveform_benchmark.dart';
+import '../ffmpeg/ffmpeg_setup_helper.dart';
+
+void main() {
+  final environment = Platform.environment;
+  final outputPath = environment['SONIX_BENCHMARK_OUTPUT'] ?? 'build/benchmarks/waveform_benchmark.json';
+  final baselinePath = environment['SONIX_BENCHMARK_BASELINE'];
+  final threshold = double.parse(environment['SONIX_BENCHMARK_THRESHOLD'] ?? '0.10');
+  final longMinutes = (environment['SONIX_BENCHMARK_MINUTES'] ?? '').split(',').where((m) => m.trim().isNotEmpty).map((m) => int.parse(m.trim())).toList();
+
+  // The same track in every format, so results differ by codec only
+  const formats = ['wav', 'mp3', 'flac', 'ogg', 'opus', 'mp4'];
+  const trackName = 'test/assets/Double-F the King - Your Blessing';
+
+  late Directory tempDir;
+
+  setUpAll(() async {
+    await FFMPEGSetupHelper.setupFFMPEGForTesting();
+    tempDir = await Directory.systemTemp.createTemp('sonix_benchmark');
+  });
+
+  tearDownAll(() async {
+    await tempDir.delete(recursive: true);
+  });
+
+  test('BENCHMARK: decode and generate per format, resolution, algorithm and mode', () async {
+    final files = [for (final format in formats) '$trackName.$format'].where((path) => File(path).existsSync()).toList();
+    // Long files last: peak RSS is a high-water mark of the whole run
+    for (final minutes in longMinutes) {
+      final file = await WaveformBenchmark.writeTestWav('${tempDir.path}/long_${minutes}min.wav', Duration(minutes: minutes));
+      files.add(file.path);
+    }
+
+    final result = await WaveformBenchmark.run(
+      files,
+      resolutions: const [1000, 10000],
+      algorithms: const [DownsamplingAlgorithm.rms, DownsamplingAlgorithm.peak, DownsamplingAlgorithm.median],
+      iterations: 3,
+    );
+
+    print('');
+    print(result);
+    final output = File(outputPath);
+    await output.parent.create(recursive: true);
+    await output.writeAsString(const JsonEncoder.withIndent('  ').convert(result.toJson()));
+    print('Results written to ${output.path}');
+
+    expect(result.results, hasLength(files.length * 2 * 3 * BenchmarkMode.values.length));
+
+    if (baselinePath != null) {
+      final baseline = BenchmarkResult.fromJson(jsonDecode(await File(baselinePath).readAsString()) as Map<String, dynamic>);
+      final comparison = result.compareWith(baseline, threshold: threshold);
+      print(comparison);
+      await File('${output.path}.comparison.json').writeAsString(const JsonEncoder.withIndent('  ').convert(comparison.toJson()));
+
+      expect(comparison.regressions, isEmpty, reason: comparison.toString());
+    }
+  }, timeout: const Timeout(Duration(hours: 2)));
+}
@@ -1,7 +1,12 @@
 import 'dart:io';
 import 'package:flutter_test/flutter_test.dart';
 import 'package:sonix/src/processing/audio_file_processor.dart';
+import 'package:sonix/src/processing/audio_processing_strategy.dart';
 import 'package:sonix/src/decoders/audio_file_decoder.dart';
+import 'package:sonix/src/models/mapped_audio_data.dart';
+import 'package:sonix/src/processing/downsampling_algorithm.dart';
+import 'package:sonix/src/processing/waveform_config.dart';
+import '../ffmpeg/ffmpeg_setup_helper.dart';
 
 void main() {
   group('AudioFileProcessor', () {
@@ -15,6 +20,10 @@ void main() {
       expect(processor.chunkThreshold, equals(50 * 1024 * 1024)); // 50MB
     });
 
+    test('should use a 512MB scratch budget by default', () {
+      expect(processor.scratchBudget, equals(512 * 1024 * 1024));
+    });
+
     test('should create processor with custom thresholds', () {
       final customProcessor = AudioFileProcessor(chunkThreshold: 100 * 1024 * 1024);
 
@@ -81,4 +90,132 @@ void main() {
       expect(() async => await decoder.decode('/non/existent/file.mp3'), throwsA(isA<FileSystemException>()));
     });
   });
+
+  group('AudioFileProcessor scratch files', () {
+    const stereoPath = 'test/assets/test_stereo_44100.wav';
+    late Directory scratchDirectory;
+
+    setUpAll(() async {
+      await FFMPEGSetupHelper.setupFFMPEGForTesting();
+    });
+
+    setUp(() async {
+      scratchDirectory = await Directory.systemTemp.createTemp('sonix_scratch_test');
+    });
+
+    tearDown(() async {
+      await scratchDirectory.delete(recursive: true);
+    });
+
+    test('should map decoded audio when it exceeds the scratch budget', () async {
+      final mapped = await AudioFileProcessor(scratchBudget: 1, scratchDirectory: scratchDirectory).process(stereoPath);
+      final inMemory = await AudioFileProcessor(scratchBudget: 0).process(stereoPath);
+
+      try {
+        expect(mapped, isA<MappedAudioData>());
+        expect(inMemory, isNot(isA<MappedAudioData>()));
+        expect(mapped.sampleRate, equals(inMemory.sampleRate));
+        expect(mapped.channels, equals(inMemory.channels));
+        expect(mapped.samples.length, equals(inMemory.samples.length));
+        for (int i = 0; i < inMemory.samples.length; i += 97) {
+          expect(mapped.samples[i], closeTo(inMemory.samples[i], 1e-6), reason: 'sample $i');
+        }
+      } finally {
+        mapped.dispose();
+      }
+    });
+
+    test('should serve frame ranges as views and remove the scratch file', () async {
+      final audioData = await AudioFileProcessor(scratchBudget: 1, scratchDirectory: scratchDirectory).process(stereoPath) as MappedAudioData;
+
+      final range = audioData.frameRange(10, 20);
+      expect(range.length, equals(10 * audioData.channels));
+      expect(range[0], equals(audioData.samples[10 * audioData.channels]));
+      // Unlinked once mapped, except on Windows where mapped files cannot be deleted
+      expect(File(audioData.scratchPath).existsSync(), equals(Platform.isWindows));
+
+      audioData.dispose();
+
+      expect(audioData.isDisposed, isTrue);
+      expect(File(audioData.scratchPath).existsSync(), isFalse);
+      expect(() => audioData.samples, throwsStateError);
+      expect(() => audioData.frameRange(0, 1), throwsStateError);
+    });
+  });
+  group('AudioFileProcessor.selectStrategy', () {
+    const stereoPath = 'test/assets/test_stereo_44100.wav';
+    const streamable = WaveformConfig(resolution: 100);
+    const median = WaveformConfig(resolution: 100, algorithm: DownsamplingAlgorithm.median);
+
+    setUpAll(() async {
+      await FFMPEGSetupHelper.setupFFMPEGForTesting();
+    });
+
+    test('should decode in memory when the decoded size fits the budget', () async {
+      // Far above the compressed size: the decoded size decides, not the 0-byte chunk threshold
+      final processor = AudioFileProcessor(chunkThreshold: 0, scratchBudget: 1024 * 1024 * 1024);
+
+      expect(await processor.selectStrategy(stereoPath), equals(AudioProcessingStrategy.inMemory));
+      expect(await processor.selectStrategy(stereoPath, config: streamable), equals(AudioProcessingStrategy.inMemory));
+    });
+
+    test('should compare the probed decoded size against the budget', () async {
+      final audioData = await AudioFileProcessor().process(stereoPath);
+      final decodedBytes = audioData.samples.length * 4;
+      audioData.dispose();
+
+      final fits = AudioFileProcessor(scratchBudget: decodedBytes * 2);
+      final exceeds = AudioFileProcessor(scratchBudget: decodedBytes ~/ 2);
+
+      expect(await fits.selectStrategy(stereoPath), equals(AudioProcessingStrategy.inMemory));
+      expect(await exceeds.selectStrategy(stereoPath), equals(AudioProcessingStrategy.scratchFile));
+    });
+
+    test('should stream waveforms beyond the budget unless the config needs all samples', () async {
+      final processor = AudioFileProcessor(scratchBudget: 1);
+
+      expect(await processor.selectStrategy(stereoPath, config: streamable), equals(AudioProcessingStrategy.streaming));
+      expect(await processor.selectStrategy(stereoPath, config: median), equals(AudioProcessingStrategy.scratchFile));
+      expect(await processor.selectStrategy(stereoPath), equals(AudioProcessingStrategy.scratchFile));
+    });
+
+    test('should keep everything in memory when the budget is disabled', () async {
+      final processor = AudioFileProcessor(chunkThreshold: 0, scratchBudget: 0);
+
+      expect(await processor.selectStrategy(stereoPath, config: streamable), equals(AudioProcessingStrategy.inMemory));
+    });
+  });
+  group('AudioFileProcessor.generateWaveform', () {
+    const stereoPath = 'test/assets/test_stereo_44100.wav';
+
+    setUpAll(() async {
+      await FFMPEGSetupHelper.setupFFMPEGForTesting();
+    });
+
+    test('should stream files beyond the memory budget into the same waveform as the in-memory path', () async {
+      const config = WaveformConfig(resolution: 200, generateBins: true);
+
+      final streamed = await AudioFileProcessor(scratchBudget: 1).generateWaveform(stereoPath, config: config);
+      final inMemory = await AudioFileProcessor().generateWaveform(stereoPath, config: config);
+
+      expect(streamed.amplitudes, hasLength(200));
+      expect(streamed.sampleRate, equals(inMemory.sampleRate));
+      // The probed duration may differ from the decoded length by a few frames
+      for (int i = 0; i < 200; i++) {
+        expect(streamed.amplitudes[i], closeTo(inMemory.amplitudes[i], 0.05), reason: 'bin $i');
+      }
+    });
+
+    test('should fall back to a full decode for median downsampling', () async {
+      const config = WaveformConfig(resolution: 50, algorithm: DownsamplingAlgorithm.median);
+
+      final waveform = await AudioFileProcessor(scratchBudget: 1).generateWaveform(stereoPath, config: config);
+
+      expect(waveform.amplitudes, hasLength(50));
+    });
+
+    test('should throw FileSystemException for non-existent file', () async {
+      await expectLater(AudioFileProcessor().generateWaveform('/non/existent/file.mp3'), throwsA(isA<FileSystemException>()));
+    });
+  });
 }
@@ -0,0 +1,73 @@
+import 'dart:async';
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:sonix/src/models/audio_data.dart';
+import 'package:sonix/src/models/waveform_data.dart';
+import 'package:sonix/src/processing/cooperative_waveform_generator.dart';
+import 'package:sonix/src/processing/waveform_config.dart';
+import 'package:sonix/src/processing/waveform_generator.dart';
+import '../test_helpers/waveform_test_signal.dart';
+
+void main() {
+  group('CooperativeWaveformGenerator', () {
+    const sampleRate = 44100;
+    const channels = 2;
+    const frames = 400000 + 4099;
+
+    final samples = stereoTestSignal(frames);
+    final audioData = AudioData(samples: samples, sampleRate: sampleRate, channels: channels, duration: const Duration(milliseconds: 9163));
+
+    for (final (name, config) in inMemoryMatchConfigs) {
+      test('should match the in-memory result for $name', () async {
+        // A tiny budget forces many slices
+        final cooperative = await CooperativeWaveformGenerator.generate(audioData, config: config, sliceBudget: const Duration(microseconds: 50));
+        final inMemory = await WaveformGenerator.generateInMemory(audioData, config: config);
+
+        expectSameWaveform(cooperative, inMemory);
+      });
+    }
+
+    test('should yield to the event loop between slices', () async {
+      int ticks = 0;
+      final timer = Timer.periodic(Duration.zero, (_) => ticks++);
+      try {
+        await CooperativeWaveformGenerator.generate(audioData, config: const WaveformConfig(resolution: 2000), sliceBudget: const Duration(microseconds: 50));
+      } finally {
+        timer.cancel();
+      }
+
+      expect(ticks, greaterThan(1));
+    });
+
+    test('should report partial waveforms filling in from the left', () async {
+      final partials = <WaveformData>[];
+      final result = await CooperativeWaveformGenerator.generate(
+        audioData,
+        config: const WaveformConfig(resolution: 2000, normalize: false),
+        sliceBudget: const Duration(microseconds: 50),
+        partialInterval: Duration.zero,
+        onPartial: partials.add,
+      );
+
+      expect(partials, isNotEmpty);
+      int previousFilled = 0;
+      for (final partial in partials) {
+        expect(partial.amplitudes, hasLength(2000));
+        final filled = partial.amplitudes.lastIndexWhere((value) => value > 0) + 1;
+        expect(filled, greaterThanOrEqualTo(previousFilled));
+        expect(filled, lessThan(2000));
+        for (int i = 0; i < filled; i++) {
+          expect(partial.amplitudes[i], equals(result.amplitudes[i]));
+        }
+        previousFilled = filled;
+      }
+    });
+
+    test('should reject empty audio', () {
+      final empty = AudioData(samples: Float32List(0), sampleRate: sampleRate, channels: channels, duration: Duration.zero);
+
+      expect(CooperativeWaveformGenerator.generate(empty), throwsArgumentError);
+    });
+  });
+}
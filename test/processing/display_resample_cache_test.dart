@@ -0,0 +1,75 @@
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:sonix/src/models/waveform_bins.dart';
+import 'package:sonix/src/models/waveform_data.dart';
+import 'package:sonix/src/models/waveform_metadata.dart';
+import 'package:sonix/src/models/waveform_type.dart';
+import 'package:sonix/src/processing/display_resample_cache.dart';
+import 'package:sonix/src/processing/display_sampler.dart';
+import 'package:sonix/src/processing/downsample_method.dart';
+
+void main() {
+  group('DisplayResampleCache', () {
+    late WaveformData waveform;
+
+    setUp(() {
+      final amplitudes = List.generate(1000, (i) => (i % 100) / 100.0);
+      waveform = WaveformData(
+        amplitudes: amplitudes,
+        duration: const Duration(seconds: 10),
+        sampleRate: 44100,
+        metadata: WaveformMetadata(resolution: 1000, type: WaveformType.bars, normalized: true, generatedAt: DateTime(2025)),
+        bins: WaveformBins(Float32List.fromList([for (int i = 0; i < 1000; i++) -i / 1000, for (int i = 0; i < 1000; i++) i / 1000, for (int i = 0; i < 1000; i++) 0.5])),
+      );
+    });
+
+    test('should return the same result as DisplaySampler', () {
+      final cached = DisplayResampleCache.amplitudes(waveform, targetCount: 120, downsampleMethod: DownsampleMethod.rms);
+      final direct = DisplaySampler.resampleForDisplay(sourceAmplitudes: waveform.amplitudes, targetCount: 120, downsampleMethod: DownsampleMethod.rms);
+
+      expect(cached, equals(direct));
+      expect(DisplayResampleCache.bins(waveform, targetCount: 120).data, equals(DisplaySampler.resampleBinsForDisplay(sourceBins: waveform.bins!, targetCount: 120).data));
+    });
+
+    test('should reuse results for the same waveform, count and methods', () {
+      final first = DisplayResampleCache.amplitudes(waveform, targetCount: 120);
+
+      expect(identical(DisplayResampleCache.amplitudes(waveform, targetCount: 120), first), isTrue);
+      expect(identical(DisplayResampleCache.amplitudes(waveform, targetCount: 121), first), isFalse);
+      expect(identical(DisplayResampleCache.amplitudes(waveform, targetCount: 120, downsampleMethod: DownsampleMethod.average), first), isFalse);
+      expect(identical(DisplayResampleCache.bins(waveform, targetCount: 50), DisplayResampleCache.bins(waveform, targetCount: 50)), isTrue);
+    });
+
+    test('should not share results between different waveforms', () {
+      final other = WaveformData.fromAmplitudes(List.of(waveform.amplitudes));
+
+      expect(identical(DisplayResampleCache.amplitudes(other, targetCount: 120), DisplayResampleCache.amplitudes(waveform, targetCount: 120)), isFalse);
+    });
+
+    test('should keep only the most recently used resolutions', () {
+      final oldest = DisplayResampleCache.amplitudes(waveform, targetCount: 10);
+      final second = DisplayResampleCache.amplitudes(waveform, targetCount: 11);
+      for (int i = 2; i < DisplayResampleCache.maxEntriesPerWaveform; i++) {
+        DisplayResampleCache.amplitudes(waveform, targetCount: 10 + i);
+      }
+
+      // Touching the oldest entry makes the second one the next to go
+      expect(identical(DisplayResampleCache.amplitudes(waveform, targetCount: 10), oldest), isTrue);
+      DisplayResampleCache.amplitudes(waveform, targetCount: 99);
+
+      expect(identical(DisplayResampleCache.amplitudes(waveform, targetCount: 10), oldest), isTrue);
+      expect(identical(DisplayResampleCache.amplitudes(waveform, targetCount: 11), second), isFalse);
+    });
+
+    test('should drop results when the waveform is disposed or invalidated', () {
+      final before = DisplayResampleCache.amplitudes(waveform, targetCount: 120);
+
+      DisplayResampleCache.invalidate(waveform);
+      expect(identical(DisplayResampleCache.amplitudes(waveform, targetCount: 120), before), isFalse);
+
+      waveform.dispose();
+      expect(DisplayResampleCache.amplitudes(waveform, targetCount: 120), isEmpty);
+    });
+  });
+}
@@ -1,4 +1,8 @@
+import 'dart:math' as math;
+import 'dart:typed_data';
+
 import 'package:flutter_test/flutter_test.dart';
+import 'package:sonix/src/models/waveform_bins.dart';
 import 'package:sonix/src/processing/display_sampler.dart';
 import 'package:sonix/src/models/waveform_type.dart';
 import 'package:sonix/src/processing/downsample_method.dart';
@@ -84,6 +88,36 @@ void main() {
       final avgResult = DisplaySampler.resampleForDisplay(sourceAmplitudes: sourceAmplitudes, targetCount: 2, downsampleMethod: DownsampleMethod.average);
       expect(avgResult.every((amp) => amp == 0.5), isTrue); // All should be 0.5
     });
+
+    group('resampleBinsForDisplay', () {
+      // min | max | rms for 4 bins
+      final source = WaveformBins(Float32List.fromList([-0.5, -0.1, -0.9, 0.0, 0.4, 0.2, 0.3, 0.8, 0.3, 0.1, 0.6, 0.4]));
+
+      test('should keep the extreme min and max when downsampling', () {
+        final result = DisplaySampler.resampleBinsForDisplay(sourceBins: source, targetCount: 2);
+
+        expect(result.length, equals(2));
+        expect(result.min[0], closeTo(-0.5, 1e-6));
+        expect(result.max[0], closeTo(0.4, 1e-6));
+        expect(result.min[1], closeTo(-0.9, 1e-6));
+        expect(result.max[1], closeTo(0.8, 1e-6));
+        expect(result.rms[0], closeTo(math.sqrt((0.09 + 0.01) / 2), 1e-6));
+        expect(result.rms[1], closeTo(math.sqrt((0.36 + 0.16) / 2), 1e-6));
+      });
+
+      test('should repeat bins when upsampling', () {
+        final result = DisplaySampler.resampleBinsForDisplay(sourceBins: source, targetCount: 8);
+
+        expect(result.length, equals(8));
+        expect(result.min[0], equals(result.min[1]));
+        expect(result.max[6], closeTo(0.8, 1e-6));
+        expect(result.max[7], closeTo(0.8, 1e-6));
+      });
+
+      test('should return empty bins for empty input or zero target', () {
+        expect(DisplaySampler.resampleBinsForDisplay(sourceBins: WaveformBins.allocate(0), targetCount: 10).isEmpty, isTrue);
+        expect(DisplaySampler.resampleBinsForDisplay(sourceBins: source, targetCount: 0).isEmpty, isTrue);
+      });
+    });
   });
 }
-
@@ -0,0 +1,102 @@
+import 'dart:io';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:sonix/src/models/waveform_channel_mode.dart';
+import 'package:sonix/src/processing/audio_file_processor.dart';
+import 'package:sonix/src/processing/downsampling_algorithm.dart';
+import 'package:sonix/src/processing/multi_waveform_generator.dart';
+import 'package:sonix/src/processing/waveform_config.dart';
+import 'package:sonix/src/processing/waveform_generator.dart';
+import '../ffmpeg/ffmpeg_setup_helper.dart';
+
+void main() {
+  setUpAll(() async {
+    await FFMPEGSetupHelper.setupFFMPEGForTesting();
+  });
+
+  group('MultiWaveformGenerator', () {
+    const stereoPath = 'test/assets/test_stereo_44100.wav';
+
+    test('should return one waveform per config in order', () async {
+      final configs = [
+        const WaveformConfig(resolution: 50),
+        const WaveformConfig(resolution: 400, algorithm: DownsamplingAlgorithm.peak),
+        const WaveformConfig(resolution: 120, algorithm: DownsamplingAlgorithm.average, normalize: false),
+      ];
+
+      final waveforms = await MultiWaveformGenerator.generate(stereoPath, configs);
+
+      expect(waveforms, hasLength(3));
+      expect(waveforms[0].amplitudes, hasLength(50));
+      expect(waveforms[1].amplitudes, hasLength(400));
+      expect(waveforms[2].amplitudes, hasLength(120));
+      expect(waveforms[2].metadata.normalized, isFalse);
+    });
+
+    test('should match in-memory generation for each config', () async {
+      final configs = [
+        const WaveformConfig(resolution: 100),
+        const WaveformConfig(resolution: 300, algorithm: DownsamplingAlgorithm.peak),
+        const WaveformConfig(resolution: 80, algorithm: DownsamplingAlgorithm.average, enableSmoothing: true),
+      ];
+
+      final waveforms = await MultiWaveformGenerator.generate(stereoPath, configs);
+      final audioData = await AudioFileProcessor().process(stereoPath);
+
+      for (int i = 0; i < configs.length; i++) {
+        final expected = await WaveformGenerator.generateInMemory(audioData, config: configs[i]);
+        expect(waveforms[i].sampleRate, equals(expected.sampleRate));
+        expect(waveforms[i].amplitudes, hasLength(expected.amplitudes.length));
+        for (int bin = 0; bin < expected.amplitudes.length; bin++) {
+          expect(waveforms[i].amplitudes[bin], closeTo(expected.amplitudes[bin], 1e-4), reason: 'config $i, bin $bin');
+        }
+      }
+    });
+
+    test('should match in-memory per-channel generation', () async {
+      const config = WaveformConfig(resolution: 64, channelMode: WaveformChannelMode.midSide);
+
+      final waveforms = await MultiWaveformGenerator.generate(stereoPath, const [config, WaveformConfig(resolution: 32)]);
+      final audioData = await AudioFileProcessor().process(stereoPath);
+      final expected = await WaveformGenerator.generateInMemory(audioData, config: config);
+
+      expect(waveforms[0].channelCount, equals(4));
+      expect(waveforms[0].channelAmplitudes!.length, equals(expected.channelAmplitudes!.length));
+      for (int i = 0; i < expected.channelAmplitudes!.length; i++) {
+        expect(waveforms[0].channelAmplitudes![i], closeTo(expected.channelAmplitudes![i], 1e-4), reason: 'index $i');
+      }
+      expect(waveforms[1].hasChannelData, isFalse);
+    });
+
+    test('should fall back to a single in-memory decode for median configs', () async {
+      final configs = [
+        const WaveformConfig(resolution: 60, algorithm: DownsamplingAlgorithm.median),
+        const WaveformConfig(resolution: 60),
+      ];
+
+      final waveforms = await MultiWaveformGenerator.generate(stereoPath, configs);
+
+      expect(waveforms, hasLength(2));
+      expect(waveforms[0].amplitudes, hasLength(60));
+      expect(waveforms[1].amplitudes, hasLength(60));
+    });
+
+    test('should throw ArgumentError for empty config list', () async {
+      await expectLater(MultiWaveformGenerator.generate(stereoPath, const []), throwsA(isA<ArgumentError>()));
+    });
+
+    test('should reject invalid configs before decoding', () async {
+      await expectLater(
+        MultiWaveformGenerator.generate('/non/existent/file.wav', const [WaveformConfig(resolution: 0)]),
+        throwsA(isA<ArgumentError>()),
+      );
+    });
+
+    test('should throw FileSystemException for non-existent file', () async {
+      await expectLater(
+        MultiWaveformGenerator.generate('/non/existent/file.wav', const [WaveformConfig()]),
+        throwsA(isA<FileSystemException>()),
+      );
+    });
+  });
+}
@@ -0,0 +1,95 @@
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:sonix/src/models/audio_data.dart';
+import 'package:sonix/src/models/waveform_bins.dart';
+import 'package:sonix/src/processing/parallel_waveform_generator.dart';
+import 'package:sonix/src/processing/waveform_algorithms.dart';
+import 'package:sonix/src/processing/waveform_config.dart';
+import 'package:sonix/src/processing/waveform_generator.dart';
+import '../test_helpers/waveform_test_signal.dart';
+
+void main() {
+  group('ParallelWaveformGenerator', () {
+    const sampleRate = 44100;
+    const channels = 2;
+    // Enough for three workers, and not a multiple of the resolutions below
+    const frames = 3 * ParallelWaveformGenerator.minFramesPerWorker + 4099;
+
+    final samples = stereoTestSignal(frames);
+    final audioData = AudioData(samples: samples, sampleRate: sampleRate, channels: channels, duration: const Duration(seconds: 71));
+
+    for (final (name, config) in inMemoryMatchConfigs) {
+      test('should match the in-memory result for $name', () async {
+        final parallel = await ParallelWaveformGenerator.generate(audioData, config: config, workers: 3);
+        final inMemory = await WaveformGenerator.generateInMemory(audioData, config: config);
+
+        expectSameWaveform(parallel, inMemory);
+      });
+    }
+
+    test('should produce the same bins for any number of workers', () async {
+      const config = WaveformConfig(resolution: 997, generateBins: true);
+
+      final two = await ParallelWaveformGenerator.generate(audioData, config: config, workers: 2);
+      final three = await ParallelWaveformGenerator.generate(audioData, config: config, workers: 3);
+
+      expectSameWaveform(two, three);
+    });
+
+    test('should fall back to a single pass for short inputs', () async {
+      final short = AudioData(samples: Float32List.sublistView(samples, 0, 2000), sampleRate: sampleRate, channels: channels, duration: Duration.zero);
+
+      final waveform = await ParallelWaveformGenerator.generate(short, config: const WaveformConfig(resolution: 100), workers: 8);
+
+      expect(waveform.amplitudes, hasLength(100));
+    });
+
+    test('should reject empty audio', () async {
+      final empty = AudioData(samples: Float32List(0), sampleRate: sampleRate, channels: channels, duration: Duration.zero);
+
+      await expectLater(ParallelWaveformGenerator.generate(empty), throwsArgumentError);
+    });
+
+    test('should bound the worker count by frames, bins and the maximum', () {
+      const perWorker = ParallelWaveformGenerator.minFramesPerWorker;
+
+      expect(ParallelWaveformGenerator.workerCountFor(10 * perWorker, 1000, 4), equals(4));
+      expect(ParallelWaveformGenerator.workerCountFor(2 * perWorker, 1000, 8), equals(2));
+      expect(ParallelWaveformGenerator.workerCountFor(10 * perWorker, 3, 8), equals(3));
+      expect(ParallelWaveformGenerator.workerCountFor(perWorker ~/ 2, 1000, 8), equals(1));
+      expect(ParallelWaveformGenerator.workerCountFor(500, 1000, 8), equals(1));
+    });
+  });
+
+  group('WaveformAlgorithms bin ranges', () {
+    final samples = List<double>.generate(2 * 1003, (i) => math.sin(i * 0.3));
+
+    test('should reduce disjoint bin ranges into the single-pass result', () {
+      final expected = WaveformAlgorithms.downsampleChannels(samples, 37, channels: 2, computeBins: true);
+
+      final mixed = List<double>.filled(37, 0.0);
+      final channelAmplitudes = Float32List(2 * 37);
+      final bins = WaveformBins.allocate(37);
+      for (final (start, end) in [(20, 37), (0, 11), (11, 20)]) {
+        WaveformAlgorithms.downsampleChannelsRange(samples, 37, start, end, channels: 2, mixed: mixed, channelAmplitudes: channelAmplitudes, bins: bins);
+      }
+
+      expect(mixed, equals(expected.mixed));
+      expect(channelAmplitudes, equals(expected.channelAmplitudes));
+      expect(bins.data, equals(expected.bins!.data));
+    });
+
+    test('should reduce disjoint fixed-bin ranges into the single-pass result', () {
+      final expected = WaveformAlgorithms.downsampleFixedBins(samples, 64, channels: 2);
+      expect(WaveformAlgorithms.fixedBinCount(1003, 64), equals(expected.length));
+
+      final bins = WaveformBins.allocate(expected.length);
+      WaveformAlgorithms.downsampleFixedBinsRange(samples, 64, 9, expected.length, channels: 2, bins: bins);
+      WaveformAlgorithms.downsampleFixedBinsRange(samples, 64, 0, 9, channels: 2, bins: bins);
+
+      expect(bins.data, equals(expected.data));
+    });
+  });
+}
@@ -0,0 +1,140 @@
+import 'dart:async';
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:sonix/src/models/audio_data.dart';
+import 'package:sonix/src/models/waveform_channel_mode.dart';
+import 'package:sonix/src/models/waveform_data.dart';
+import 'package:sonix/src/processing/downsampling_algorithm.dart';
+import 'package:sonix/src/processing/streaming_waveform_generator.dart';
+import 'package:sonix/src/processing/waveform_config.dart';
+import 'package:sonix/src/processing/waveform_generator.dart';
+import '../test_helpers/waveform_test_signal.dart';
+
+void main() {
+  group('StreamingWaveformGenerator', () {
+    const sampleRate = 8000;
+    const channels = 2;
+    const frames = 10007; // Not a multiple of the resolution or chunk size
+
+    final samples = stereoTestSignal(frames, envelopePeriod: 1500);
+    final audioData = AudioData(samples: samples, sampleRate: sampleRate, channels: channels, duration: const Duration(microseconds: frames * 125));
+
+    Stream<AudioData> chunked(int framesPerChunk, {int? totalFrames}) async* {
+      final end = (totalFrames ?? frames) * channels;
+      for (int start = 0; start < end; start += framesPerChunk * channels) {
+        final chunk = Float32List.sublistView(samples, start, math.min(start + framesPerChunk * channels, end));
+        yield AudioData(samples: chunk, sampleRate: sampleRate, channels: channels, duration: Duration.zero);
+      }
+    }
+
+    void expectClose(List<double> actual, List<double> expected) {
+      expect(actual, hasLength(expected.length));
+      for (int i = 0; i < expected.length; i++) {
+        expect(actual[i], closeTo(expected[i], 1e-6), reason: 'index $i');
+      }
+    }
+
+    for (final algorithm in [DownsamplingAlgorithm.rms, DownsamplingAlgorithm.peak, DownsamplingAlgorithm.average]) {
+      test('should match in-memory generation for ${algorithm.name}', () async {
+        final config = WaveformConfig(resolution: 300, algorithm: algorithm);
+
+        final streamed = await StreamingWaveformGenerator.generate(chunked(777), expectedFrames: frames, config: config);
+        final inMemory = await WaveformGenerator.generateInMemory(audioData, config: config);
+
+        expectClose(streamed.amplitudes, inMemory.amplitudes);
+        expect(streamed.duration, equals(audioData.duration));
+      });
+    }
+
+    test('should match per-channel amplitudes, bins and pyramid', () async {
+      const config = WaveformConfig(resolution: 128, channelMode: WaveformChannelMode.midSide, generateBins: true, generatePyramid: true);
+
+      final streamed = await StreamingWaveformGenerator.generate(chunked(1000), expectedFrames: frames, config: config);
+      final inMemory = await WaveformGenerator.generateInMemory(audioData, config: config);
+
+      expectClose(streamed.amplitudes, inMemory.amplitudes);
+      expect(streamed.channelCount, equals(4));
+      expectClose(streamed.channelAmplitudes!, inMemory.channelAmplitudes!);
+      expectClose(streamed.bins!.data, inMemory.bins!.data);
+      expect(streamed.pyramid!.levelCount, equals(inMemory.pyramid!.levelCount));
+      expect(streamed.pyramid!.totalFrames, equals(frames));
+      expectClose(streamed.pyramid!.levels.first.data, inMemory.pyramid!.levels.first.data);
+    });
+
+    test('should not depend on chunk boundaries', () async {
+      const config = WaveformConfig(resolution: 97, normalize: false);
+
+      final large = await StreamingWaveformGenerator.generate(chunked(frames), expectedFrames: frames, config: config);
+      final tiny = await StreamingWaveformGenerator.generate(chunked(3), expectedFrames: frames, config: config);
+
+      expectClose(tiny.amplitudes, large.amplitudes);
+    });
+
+    test('should fold chunks in slices and report partials with a slice budget', () async {
+      const config = WaveformConfig(resolution: 97, normalize: false);
+      final partials = <WaveformData>[];
+
+      final sliced = await StreamingWaveformGenerator.generate(
+        chunked(2000),
+        expectedFrames: frames,
+        config: config,
+        sliceBudget: const Duration(microseconds: 1),
+        onPartial: partials.add,
+        partialInterval: Duration.zero,
+      );
+      final whole = await StreamingWaveformGenerator.generate(chunked(2000), expectedFrames: frames, config: config);
+
+      expectClose(sliced.amplitudes, whole.amplitudes);
+      expect(partials, isNotEmpty);
+      expect(partials.first.amplitudes, hasLength(97));
+      expect(partials.first.amplitudes.last, equals(0.0)); // Not reached yet
+      expect(partials.first.duration, equals(audioData.duration));
+    });
+
+    test('should not report partials without a slice budget', () async {
+      final partials = <WaveformData>[];
+
+      await StreamingWaveformGenerator.generate(chunked(2000), expectedFrames: frames, onPartial: partials.add, partialInterval: Duration.zero);
+
+      expect(partials, isEmpty);
+    });
+
+    test('should fold frames beyond the expected count into the last bin', () async {
+      const config = WaveformConfig(resolution: 100, normalize: false, algorithm: DownsamplingAlgorithm.peak);
+
+      final waveform = await StreamingWaveformGenerator.generate(chunked(500), expectedFrames: frames - 2000, config: config);
+
+      expect(waveform.amplitudes, hasLength(100));
+      expect(waveform.duration, equals(audioData.duration));
+      expect(waveform.amplitudes.last, greaterThan(0.0));
+    });
+
+    test('should leave bins past a shorter stream silent', () async {
+      const config = WaveformConfig(resolution: 100, normalize: false);
+
+      final waveform = await StreamingWaveformGenerator.generate(chunked(500, totalFrames: frames ~/ 2), expectedFrames: frames, config: config);
+
+      expect(waveform.amplitudes, hasLength(100));
+      expect(waveform.amplitudes.first, greaterThan(0.0));
+      expect(waveform.amplitudes.last, equals(0.0));
+    });
+
+    test('should reject median downsampling', () {
+      const config = WaveformConfig(algorithm: DownsamplingAlgorithm.median);
+
+      expect(StreamingWaveformGenerator.supports(config), isFalse);
+      expect(() => StreamingWaveformGenerator(expectedFrames: frames, channels: channels, sampleRate: sampleRate, config: config), throwsArgumentError);
+    });
+
+    test('should throw StateError for an empty stream or after finish', () async {
+      await expectLater(StreamingWaveformGenerator.generate(const Stream.empty(), expectedFrames: frames), throwsStateError);
+
+      final generator = StreamingWaveformGenerator(expectedFrames: frames, channels: channels, sampleRate: sampleRate)..add(samples);
+      generator.finish();
+      expect(() => generator.add(samples), throwsStateError);
+      expect(generator.framesProcessed, equals(frames));
+    });
+  });
+}
@@ -0,0 +1,273 @@
+import 'dart:async';
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:sonix/src/models/waveform_bins.dart';
+import 'package:sonix/src/models/waveform_data.dart';
+import 'package:sonix/src/models/waveform_metadata.dart';
+import 'package:sonix/src/models/waveform_pyramid.dart';
+import 'package:sonix/src/models/waveform_type.dart';
+import 'package:sonix/src/processing/waveform_cache.dart';
+import 'package:sonix/src/processing/waveform_config.dart';
+import 'package:sonix/src/utils/file_fingerprint.dart';
+import 'package:sonix/src/utils/memory_manager.dart';
+
+void main() {
+  late Directory tempDir;
+  late File track;
+
+  setUp(() async {
+    tempDir = await Directory.systemTemp.createTemp('waveform_cache_test');
+    track = File('${tempDir.path}/track.wav');
+    await track.writeAsBytes(List.generate(300 * 1024, (i) => i % 251));
+  });
+
+  tearDown(() async {
+    await tempDir.delete(recursive: true);
+  });
+
+  WaveformData waveformOf(int length, double value) => WaveformData.fromAmplitudes(List.filled(length, value));
+
+  group('FileFingerprint', () {
+    test('should hash only the ends of the file', () async {
+      final original = await FileFingerprint.compute(track.path);
+
+      // A change in the middle keeps the size and both ends
+      final bytes = await track.readAsBytes();
+      bytes[150 * 1024] ^= 0xff;
+      await track.writeAsBytes(bytes);
+      expect(await FileFingerprint.compute(track.path), equals(original));
+
+      bytes[bytes.length - 1] ^= 0xff;
+      await track.writeAsBytes(bytes);
+      expect(await FileFingerprint.compute(track.path), isNot(equals(original)));
+    });
+
+    test('should fingerprint small and missing files', () async {
+      final small = File('${tempDir.path}/small.wav')..writeAsBytesSync([1, 2, 3]);
+
+      final fingerprint = await FileFingerprint.compute(small.path);
+
+      expect(fingerprint!.size, equals(3));
+      expect(fingerprint.tailHash, equals(0));
+      expect(await FileFingerprint.compute('${tempDir.path}/missing.wav'), isNull);
+    });
+  });
+
+  group('WaveformCache', () {
+    const config = WaveformConfig(resolution: 100);
+
+    test('should generate once and answer repeats from memory', () async {
+      final cache = WaveformCache();
+      int generated = 0;
+      Future<WaveformData> generate() async {
+        generated++;
+        return waveformOf(100, 0.5);
+      }
+
+      final first = await cache.getOrGenerate(track.path, config, generate);
+      final second = await cache.getOrGenerate(track.path, config, generate);
+      final other = await cache.getOrGenerate(track.path, const WaveformConfig(resolution: 50), () async => waveformOf(50, 0.25));
+
+      expect(generated, equals(1));
+      expect(second.amplitudes, equals(first.amplitudes));
+      expect(other.amplitudes, hasLength(50));
+      expect(cache.memoryHits, equals(1));
+      expect(cache.misses, equals(2));
+      cache.dispose();
+    });
+
+    test('should share one generation between concurrent misses', () async {
+      final directory = Directory('${tempDir.path}/cache');
+      final cache = WaveformCache(directory: directory);
+      final release = Completer<void>();
+      int generated = 0;
+      Future<WaveformData> generate() async {
+        generated++;
+        await release.future;
+        return waveformOf(100, 0.5);
+      }
+
+      final first = cache.getOrGenerate(track.path, config, generate);
+      final second = cache.getOrGenerate(track.path, config, generate);
+      await pumpEventQueue();
+      release.complete();
+      final waveforms = await Future.wait([first, second]);
+
+      expect(generated, equals(1));
+      expect(waveforms[1].amplitudes, equals(waveforms[0].amplitudes));
+      waveforms[0].dispose();
+      expect(waveforms[1].amplitudes, hasLength(100));
+
+      // The disk entry is written in the background
+      await cache.flush();
+      expect(directory.listSync().whereType<File>().where((file) => file.path.endsWith(WaveformCache.entryExtension)), hasLength(1));
+      cache.dispose();
+    });
+
+    test('should not let callers dispose the cached waveform', () async {
+      final cache = WaveformCache();
+      await cache.put(track.path, config, waveformOf(100, 0.5));
+
+      (await cache.get(track.path, config))!.dispose();
+
+      expect((await cache.get(track.path, config))!.amplitudes, hasLength(100));
+      cache.dispose();
+    });
+
+    test('should not let callers edit the cached bins or pyramid', () async {
+      final cache = WaveformCache();
+      final bins = WaveformBins(Float32List.fromList(List.filled(30, 0.5)));
+      final pyramid = WaveformPyramid.fromBaseLevel(WaveformBins(Float32List.fromList(List.filled(30, 0.5))), sampleRate: 44100, totalFrames: 2560);
+      await cache.put(
+        track.path,
+        config,
+        WaveformData(
+          amplitudes: List.filled(10, 0.5),
+          duration: Duration.zero,
+          sampleRate: 44100,
+          metadata: WaveformMetadata(resolution: 10, type: WaveformType.bars, normalized: true, generatedAt: DateTime(2025)),
+          bins: bins,
+          pyramid: pyramid,
+        ),
+      );
+
+      final first = (await cache.get(track.path, config))!;
+      first.bins!.data.fillRange(0, 30, 1.0);
+      first.pyramid!.levels.first.data.fillRange(0, 30, 1.0);
+      final second = (await cache.get(track.path, config))!;
+
+      expect(second.bins!.data, everyElement(0.5));
+      expect(second.pyramid!.levels.first.data, everyElement(0.5));
+      cache.dispose();
+    });
+
+    test('should invalidate entries when the file content changes', () async {
+      final cache = WaveformCache();
+      await cache.put(track.path, config, waveformOf(100, 0.5));
+
+      await track.writeAsBytes(List.filled(1000, 7));
+      await track.setLastModified(DateTime.now().add(const Duration(minutes: 1)));
+
+      expect(await cache.get(track.path, config), isNull);
+      expect(cache.memoryEntries, equals(0));
+      cache.dispose();
+    });
+
+    test('should invalidate both tiers when a same-size edit keeps the fingerprint', () async {
+      final cache = WaveformCache(directory: Directory('${tempDir.path}/cache'));
+      await cache.put(track.path, config, waveformOf(100, 0.5));
+
+      // Re-rendering a region in the middle keeps the size and both ends
+      final bytes = await track.readAsBytes();
+      bytes[150 * 1024] ^= 0xff;
+      await track.writeAsBytes(bytes);
+      await track.setLastModified(DateTime(2020));
+
+      expect(await cache.get(track.path, config), isNull);
+      expect(cache.memoryEntries, equals(0));
+      expect(cache.diskHits, equals(0));
+      cache.dispose();
+    });
+
+    test('should drop the least recently used entries beyond the memory budget', () async {
+      // Each 1000-amplitude waveform takes about 4.5KB
+      final cache = WaveformCache(memoryBudget: 10 * 1024);
+      for (int resolution = 1; resolution <= 3; resolution++) {
+        await cache.put(track.path, WaveformConfig(resolution: resolution), waveformOf(1000, 0.5));
+      }
+
+      expect(cache.memoryEntries, equals(2));
+      expect(cache.memoryBytes, lessThanOrEqualTo(10 * 1024));
+      expect(await cache.get(track.path, const WaveformConfig(resolution: 1)), isNull);
+      cache.dispose();
+    });
+
+    test('should shrink on memory pressure', () async {
+      final cache = WaveformCache();
+      for (int resolution = 1; resolution <= 4; resolution++) {
+        await cache.put(track.path, WaveformConfig(resolution: resolution), waveformOf(1000, 0.5));
+      }
+      final before = cache.memoryBytes;
+
+      await MemoryManager().forceMemoryCleanup();
+
+      expect(cache.memoryBytes, lessThanOrEqualTo(before ~/ 2));
+      cache.dispose();
+    });
+
+    test('should persist entries on disk across caches', () async {
+      final directory = Directory('${tempDir.path}/cache');
+      final writer = WaveformCache(directory: directory);
+      final waveform = waveformOf(100, 0.5);
+      await writer.put(track.path, config, waveform);
+      writer.dispose();
+
+      final reader = WaveformCache(directory: directory);
+      final restored = await reader.get(track.path, config);
+
+      expect(restored!.amplitudes, equals(waveform.amplitudes));
+      expect(reader.diskHits, equals(1));
+      expect(await reader.get(track.path, config), isNotNull);
+      expect(reader.memoryHits, equals(1));
+      reader.dispose();
+    });
+
+    test('should find disk entries by content after a move', () async {
+      final directory = Directory('${tempDir.path}/cache');
+      final cache = WaveformCache(directory: directory, memoryBudget: 0);
+      await cache.put(track.path, config, waveformOf(100, 0.5));
+
+      final moved = await track.rename('${tempDir.path}/moved.wav');
+
+      expect(await cache.get(moved.path, config), isNotNull);
+      expect(await cache.get(moved.path, const WaveformConfig(resolution: 99)), isNull);
+      cache.dispose();
+    });
+
+    test('should discard corrupt disk entries', () async {
+      final directory = Directory('${tempDir.path}/cache');
+      final cache = WaveformCache(directory: directory, memoryBudget: 0);
+      await cache.put(track.path, config, waveformOf(100, 0.5));
+      final entry = directory.listSync().whereType<File>().single;
+      await entry.writeAsBytes(Uint8List(8));
+
+      expect(await cache.get(track.path, config), isNull);
+      expect(await entry.exists(), isFalse);
+      cache.dispose();
+    });
+
+    test('should delete the least recently used disk entries beyond the disk budget', () async {
+      final directory = Directory('${tempDir.path}/cache');
+      // A 1000-amplitude float32 entry takes about 4KB
+      final cache = WaveformCache(directory: directory, memoryBudget: 0, diskBudget: 10 * 1024);
+      for (int resolution = 1; resolution <= 4; resolution++) {
+        await cache.put(track.path, WaveformConfig(resolution: resolution), waveformOf(1000, 0.5));
+        // Distinct modification times order the entries
+        await Future<void>.delayed(const Duration(milliseconds: 20));
+      }
+
+      final entries = directory.listSync().whereType<File>().toList();
+      expect(entries.length, equals(2));
+      expect(entries.fold<int>(0, (sum, file) => sum + file.lengthSync()), lessThanOrEqualTo(10 * 1024));
+      expect(await cache.get(track.path, const WaveformConfig(resolution: 4)), isNotNull);
+      cache.dispose();
+    });
+
+    test('should pass missing files through to the generator', () async {
+      final cache = WaveformCache();
+
+      expect(
+        cache.getOrGenerate('${tempDir.path}/missing.wav', config, () async => throw const FileSystemException('missing')),
+        throwsA(isA<FileSystemException>()),
+      );
+      cache.dispose();
+    });
+
+    test('should reject negative budgets', () {
+      expect(() => WaveformCache(memoryBudget: -1), throwsArgumentError);
+      expect(() => WaveformCache(diskBudget: -1), throwsArgumentError);
+    });
+  });
+}
@@ -0,0 +1,96 @@
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:sonix/src/processing/normalization_method.dart';
+import 'package:sonix/src/processing/scaling_curve.dart';
+import 'package:sonix/src/processing/waveform_algorithms.dart';
+import 'package:sonix/src/processing/waveform_config.dart';
+import 'package:sonix/src/processing/waveform_post_processor.dart';
+
+/// The unfused steps: smoothing, then normalization, then scaling
+List<double> _staged(List<double> amplitudes, WaveformConfig config) {
+  var result = amplitudes;
+  if (config.enableSmoothing) {
+    result = WaveformAlgorithms.smoothAmplitudes(result, windowSize: config.smoothingWindowSize);
+  }
+  if (config.normalize) {
+    result = WaveformAlgorithms.normalize(result, method: config.normalizationMethod);
+  }
+  if (config.scalingCurve != ScalingCurve.linear || config.scalingFactor != 1.0) {
+    result = WaveformAlgorithms.scaleAmplitudes(result, scalingCurve: config.scalingCurve, factor: config.scalingFactor);
+  }
+  return result;
+}
+
+void main() {
+  group('WaveformPostProcessor', () {
+    final random = math.Random(46);
+    final amplitudes = List.generate(5003, (i) => random.nextDouble() * (0.3 + 0.7 * math.sin(i / 400).abs()));
+
+    for (final (name, config) in const [
+      ('no steps', WaveformConfig(normalize: false)),
+      ('peak normalization', WaveformConfig()),
+      ('RMS normalization', WaveformConfig(normalizationMethod: NormalizationMethod.rms)),
+      ('smoothing', WaveformConfig(normalize: false, enableSmoothing: true, smoothingWindowSize: 3)),
+      ('wide smoothing with RMS', WaveformConfig(enableSmoothing: true, smoothingWindowSize: 31, normalizationMethod: NormalizationMethod.rms)),
+      ('logarithmic curve', WaveformConfig(enableSmoothing: true, smoothingWindowSize: 5, scalingCurve: ScalingCurve.logarithmic)),
+      ('exponential curve', WaveformConfig(scalingCurve: ScalingCurve.exponential, scalingFactor: 1.5)),
+      ('square-root curve', WaveformConfig(normalizationMethod: NormalizationMethod.rms, scalingCurve: ScalingCurve.sqrt)),
+      ('linear factor', WaveformConfig(normalize: false, scalingFactor: 3.0)),
+    ]) {
+      test('should match the staged steps for $name', () {
+        final expected = _staged(amplitudes, config);
+
+        final fused = WaveformPostProcessor.process(amplitudes, config);
+
+        expect(fused, hasLength(expected.length));
+        for (int i = 0; i < expected.length; i++) {
+          expect(fused[i], closeTo(expected[i], 1e-6), reason: 'value $i');
+        }
+      });
+    }
+
+    test('should smooth each segment separately', () {
+      const config = WaveformConfig(normalize: false, enableSmoothing: true, smoothingWindowSize: 7);
+      final left = List.generate(100, (i) => i / 100.0);
+      final right = List.generate(100, (i) => 1.0 - i / 100.0);
+
+      final fused = WaveformPostProcessor.process([...left, ...right], config, segmentLength: 100);
+
+      final expected = [...WaveformAlgorithms.smoothAmplitudes(left, windowSize: 7), ...WaveformAlgorithms.smoothAmplitudes(right, windowSize: 7)];
+      for (int i = 0; i < expected.length; i++) {
+        expect(fused[i], closeTo(expected[i], 1e-6), reason: 'value $i');
+      }
+    });
+
+    test('should process in place', () {
+      const config = WaveformConfig(enableSmoothing: true, smoothingWindowSize: 9, scalingCurve: ScalingCurve.logarithmic);
+      final buffer = Float32List.fromList(amplitudes);
+      final expected = WaveformPostProcessor.process(Float32List.fromList(amplitudes), config);
+
+      final result = WaveformPostProcessor.process(buffer, config, output: buffer);
+
+      expect(identical(result, buffer), isTrue);
+      expect(result, equals(expected));
+    });
+
+    test('should leave the input untouched without an output', () {
+      final input = Float32List.fromList([0.1, 0.5, 0.2, 0.8]);
+
+      WaveformPostProcessor.process(input, const WaveformConfig(enableSmoothing: true));
+
+      expect(input, equals(Float32List.fromList([0.1, 0.5, 0.2, 0.8])));
+    });
+
+    test('should return silence when the normalization reference is zero', () {
+      final result = WaveformPostProcessor.process(List.filled(10, 0.0), const WaveformConfig(scalingCurve: ScalingCurve.sqrt));
+
+      expect(result, everyElement(0.0));
+    });
+
+    test('should reject an output of the wrong length', () {
+      expect(() => WaveformPostProcessor.process([0.1, 0.2], const WaveformConfig(), output: Float32List(3)), throwsArgumentError);
+    });
+  });
+}
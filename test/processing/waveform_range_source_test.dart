@@ -0,0 +1,236 @@
+import 'dart:async';
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:sonix/src/models/audio_data.dart';
+import 'package:sonix/src/models/waveform_bins.dart';
+import 'package:sonix/src/models/waveform_data.dart';
+import 'package:sonix/src/models/waveform_metadata.dart';
+import 'package:sonix/src/models/waveform_pyramid.dart';
+import 'package:sonix/src/models/waveform_type.dart';
+import 'package:sonix/src/processing/waveform_range_source.dart';
+import 'package:sonix/src/processing/waveform_tile_cache.dart';
+
+/// Source whose loads complete when the test says so
+class _DeferredRangeSource implements WaveformRangeSource {
+  final List<(int, Completer<WaveformBins>)> requests = [];
+
+  @override
+  int get totalFrames => 1 << 20;
+
+  @override
+  int get sampleRate => 44100;
+
+  @override
+  Future<WaveformBins> loadBins(int startFrame, int framesPerBin, int binCount) {
+    final completer = Completer<WaveformBins>();
+    requests.add((startFrame, completer));
+    return completer.future;
+  }
+}
+
+void main() {
+  group('WaveformDataRangeSource', () {
+    test('should slice amplitudes as a symmetric envelope', () {
+      final amplitudes = List.generate(100, (i) => i / 100.0);
+      final source = WaveformDataRangeSource(WaveformData.fromAmplitudes(amplitudes));
+
+      // fromAmplitudes covers one second at 44.1kHz: 441 frames per amplitude
+      expect(source.totalFrames, equals(44100));
+      final bins = source.loadBins(0, 441, 100);
+
+      for (int i = 0; i < 100; i++) {
+        expect(bins.max[i], closeTo(amplitudes[i], 1e-6));
+        expect(bins.min[i], closeTo(-amplitudes[i], 1e-6));
+      }
+    });
+
+    test('should merge every source bin under a wider output bin', () {
+      final amplitudes = List.generate(100, (i) => i / 100.0);
+      final source = WaveformDataRangeSource(WaveformData.fromAmplitudes(amplitudes));
+
+      final bins = source.loadBins(441 * 10, 441 * 10, 3);
+
+      expect(bins.max[0], closeTo(0.19, 1e-6));
+      expect(bins.min[0], closeTo(-0.19, 1e-6));
+      expect(bins.max[2], closeTo(0.39, 1e-6));
+    });
+
+    test('should use the coarsest pyramid level with enough detail', () {
+      const totalFrames = 256 * 64;
+      final base = WaveformBins(Float32List.fromList([for (int i = 0; i < 64; i++) -i / 64, for (int i = 0; i < 64; i++) i / 64, for (int i = 0; i < 64; i++) 0.25]));
+      final pyramid = WaveformPyramid.fromBaseLevel(base, sampleRate: 44100, totalFrames: totalFrames);
+      final waveform = WaveformData(
+        amplitudes: List.filled(10, 0.5),
+        duration: pyramid.duration,
+        sampleRate: 44100,
+        metadata: WaveformMetadata(resolution: 10, type: WaveformType.bars, normalized: true, generatedAt: DateTime(2025)),
+        pyramid: pyramid,
+      );
+      final source = WaveformDataRangeSource(waveform);
+
+      final bins = source.loadBins(0, 1024, 16);
+      final level = pyramid.levels[2];
+
+      expect(source.totalFrames, equals(totalFrames));
+      expect(bins.max, equals(level.max));
+      expect(bins.min, equals(level.min));
+      expect(bins.rms[0], closeTo(0.25, 1e-6));
+    });
+
+    test('should leave bins past the end silent', () {
+      final source = WaveformDataRangeSource(WaveformData.fromAmplitudes(List.filled(100, 0.8)));
+
+      final bins = source.loadBins(44100 - 441, 441, 4);
+
+      expect(bins.length, equals(4));
+      expect(bins.max[0], closeTo(0.8, 1e-6));
+      expect(bins.max.skip(1), everyElement(0.0));
+    });
+
+    test('should be equal for the same waveform', () {
+      final waveform = WaveformData.fromAmplitudes(List.filled(10, 0.5));
+
+      expect(WaveformDataRangeSource(waveform), equals(WaveformDataRangeSource(waveform)));
+      expect(WaveformDataRangeSource(waveform), isNot(equals(WaveformDataRangeSource(WaveformData.fromAmplitudes(List.filled(10, 0.5))))));
+    });
+  });
+
+  group('AudioRangeSource', () {
+    test('should reduce the channel mix of the requested frames', () async {
+      // Stereo: left ramps up, right is its negation plus an offset
+      final samples = Float32List(2 * 4096);
+      for (int frame = 0; frame < 4096; frame++) {
+        samples[2 * frame] = frame / 4096;
+        samples[2 * frame + 1] = 0.5 - frame / 4096;
+      }
+      final source = AudioRangeSource.fromAudioData(AudioData(samples: samples, sampleRate: 44100, channels: 2, duration: const Duration(milliseconds: 93)));
+
+      final bins = await source.loadBins(1024, 512, 2);
+
+      expect(source.totalFrames, equals(4096));
+      expect(bins.min, everyElement(closeTo(0.25, 1e-6)));
+      expect(bins.max, everyElement(closeTo(0.25, 1e-6)));
+      expect(bins.rms, everyElement(closeTo(0.25, 1e-6)));
+    });
+
+    test('should only read the requested frames', () async {
+      final reads = <(int, int)>[];
+      final source = AudioRangeSource(
+        totalFrames: 10000,
+        sampleRate: 8000,
+        channels: 1,
+        readFrames: (startFrame, endFrame) {
+          reads.add((startFrame, endFrame));
+          return Float32List.fromList([for (int i = startFrame; i < endFrame; i++) math.sin(i / 10)]);
+        },
+      );
+
+      final bins = await source.loadBins(9000, 256, 8);
+
+      expect(reads, equals([(9000, 10000)]));
+      expect(bins.length, equals(8));
+      expect(bins.rms[3], greaterThan(0.0));
+      // 1000 frames fill four bins; the rest is past the end
+      expect(bins.rms.skip(4), everyElement(0.0));
+    });
+
+    test('should reduce loads beyond the inline limit on a background isolate with the same result', () async {
+      const frames = 4 * AudioRangeSource.maxInlineFrames;
+      final samples = Float32List.fromList([for (int i = 0; i < 2 * frames; i++) math.sin(i / 50) * (i.isEven ? 1.0 : 0.5)]);
+      final source = AudioRangeSource.fromAudioData(AudioData(samples: samples, sampleRate: 44100, channels: 2, duration: const Duration(seconds: 6)));
+
+      // The whole recording in 16 bins, then one inline-sized bin of it
+      final overview = await source.loadBins(0, frames ~/ 16, 16);
+      final detail = await source.loadBins(frames ~/ 16, frames ~/ 16 ~/ 4, 4);
+
+      expect(overview.length, equals(16));
+      expect(overview.min[1], closeTo(detail.min.reduce(math.min), 1e-6));
+      expect(overview.max[1], closeTo(detail.max.reduce(math.max), 1e-6));
+    });
+  });
+
+  group('WaveformTileCache', () {
+    test('should store tiles from synchronous sources immediately', () {
+      final cache = WaveformTileCache(WaveformDataRangeSource(WaveformData.fromAmplitudes(List.filled(100, 0.5))), tileBins: 16);
+
+      final tile = cache.tile(64, 0);
+
+      expect(tile, isNotNull);
+      expect(tile!.length, equals(16));
+      expect(identical(cache.tile(64, 0), tile), isTrue);
+      expect(cache.contains(64, 0), isTrue);
+      expect(cache.contains(128, 0), isFalse);
+    });
+
+    test('should not load tiles outside the source', () {
+      final cache = WaveformTileCache(WaveformDataRangeSource(WaveformData.fromAmplitudes(List.filled(100, 0.5))), tileBins: 16);
+
+      // 44100 frames in tiles of 16 * 64 frames
+      expect(cache.tileCount(64), equals(44));
+      expect(cache.tile(64, -1), isNull);
+      expect(cache.tile(64, 44), isNull);
+      expect(cache.length, equals(0));
+    });
+
+    test('should drop the least recently used tiles', () {
+      final cache = WaveformTileCache(WaveformDataRangeSource(WaveformData.fromAmplitudes(List.filled(100, 0.5))), tileBins: 16, maxTiles: 3);
+
+      cache.tile(64, 0);
+      cache.tile(64, 1);
+      cache.tile(64, 2);
+      cache.tile(64, 0); // Most recently used again
+      cache.tile(64, 3);
+
+      expect(cache.length, equals(3));
+      expect(cache.contains(64, 0), isTrue);
+      expect(cache.contains(64, 1), isFalse);
+      expect(cache.contains(64, 3), isTrue);
+    });
+
+    test('should load asynchronous tiles once and report completion', () async {
+      final source = _DeferredRangeSource();
+      int loaded = 0;
+      final cache = WaveformTileCache(source, tileBins: 16, onTileLoaded: () => loaded++);
+
+      expect(cache.tile(64, 2), isNull);
+      expect(cache.tile(64, 2), isNull);
+      cache.prefetch(64, 2);
+      expect(source.requests.length, equals(1));
+      expect(source.requests.single.$1, equals(2 * 16 * 64));
+
+      source.requests.single.$2.complete(WaveformBins.allocate(16));
+      await Future<void>.delayed(Duration.zero);
+
+      expect(loaded, equals(1));
+      expect(cache.tile(64, 2), isNotNull);
+    });
+
+    test('should discard loads started before clear', () async {
+      final source = _DeferredRangeSource();
+      int loaded = 0;
+      final cache = WaveformTileCache(source, tileBins: 16, onTileLoaded: () => loaded++);
+
+      cache.tile(64, 0);
+      cache.clear();
+      source.requests.single.$2.complete(WaveformBins.allocate(16));
+      await Future<void>.delayed(Duration.zero);
+
+      expect(loaded, equals(0));
+      expect(cache.contains(64, 0), isFalse);
+    });
+
+    test('should retry tiles whose load failed', () async {
+      final source = _DeferredRangeSource();
+      final cache = WaveformTileCache(source, tileBins: 16);
+
+      cache.tile(64, 0);
+      source.requests.single.$2.completeError(StateError('decode failed'));
+      await Future<void>.delayed(Duration.zero);
+      cache.tile(64, 0);
+
+      expect(source.requests.length, equals(2));
+    });
+  });
+}
@@ -160,9 +160,13 @@ void main() {
     });
 
     test('both methods should produce valid comparable results', () async {
-      final mainThreadResult = await sonix.generateWaveform(testFilePath, resolution: 200);
+      // With the cache on, the second call would be answered from the first
+      final uncached = Sonix(const SonixConfig(waveformCacheSize: 0));
+      addTearDown(uncached.dispose);
 
-      final isolateResult = await sonix.generateWaveformInIsolate(testFilePath, resolution: 200);
+      final mainThreadResult = await uncached.generateWaveform(testFilePath, resolution: 200);
+
+      final isolateResult = await uncached.generateWaveformInIsolate(testFilePath, resolution: 200);
 
       // Both should have the same length
       expect(mainThreadResult.amplitudes.length, equals(isolateResult.amplitudes.length));
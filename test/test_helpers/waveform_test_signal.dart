@@ -0,0 +1,56 @@
+/// Shared fixtures for tests comparing waveform generators against
+/// `WaveformGenerator.generateInMemory`
+library;
+
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:sonix/src/models/waveform_channel_mode.dart';
+import 'package:sonix/src/models/waveform_data.dart';
+import 'package:sonix/src/processing/downsampling_algorithm.dart';
+import 'package:sonix/src/processing/waveform_config.dart';
+
+/// Interleaved stereo sines under a sawtooth envelope of [envelopePeriod] frames
+///
+/// The right channel is quieter and at a different frequency, so mixed,
+/// per-channel and mid/side results all differ.
+Float32List stereoTestSignal(int frames, {int envelopePeriod = 70000}) {
+  final samples = Float32List(frames * 2);
+  for (int frame = 0; frame < frames; frame++) {
+    final envelope = 0.2 + 0.8 * (frame % envelopePeriod) / envelopePeriod;
+    samples[frame * 2] = envelope * math.sin(frame * 0.07);
+    samples[frame * 2 + 1] = 0.5 * envelope * math.sin(frame * 0.11 + 1.0);
+  }
+  return samples;
+}
+
+/// Configs covering every algorithm family and output a generator must reproduce
+const List<(String, WaveformConfig)> inMemoryMatchConfigs = [
+  ('RMS', WaveformConfig(resolution: 1000)),
+  ('peak', WaveformConfig(resolution: 777, algorithm: DownsamplingAlgorithm.peak, normalize: false)),
+  ('median with smoothing', WaveformConfig(resolution: 500, algorithm: DownsamplingAlgorithm.median, enableSmoothing: true)),
+  ('per-channel bins', WaveformConfig(resolution: 1200, channelMode: WaveformChannelMode.perChannel, generateBins: true)),
+  ('mid/side pyramid', WaveformConfig(resolution: 300, channelMode: WaveformChannelMode.midSide, generatePyramid: true)),
+];
+
+/// Expects [actual] to match the in-memory result [expected]
+///
+/// Mixed amplitudes are compared to float rounding (see
+/// `WaveformAlgorithms.downsampleChannelsRange`); everything else must be
+/// identical.
+void expectSameWaveform(WaveformData actual, WaveformData expected) {
+  expect(actual.amplitudes, hasLength(expected.amplitudes.length));
+  for (int i = 0; i < expected.amplitudes.length; i++) {
+    expect(actual.amplitudes[i], closeTo(expected.amplitudes[i], 1e-6), reason: 'bin $i');
+  }
+  expect(actual.channelAmplitudes, equals(expected.channelAmplitudes));
+  expect(actual.channelCount, equals(expected.channelCount));
+  expect(actual.bins?.data, equals(expected.bins?.data));
+  expect(actual.pyramid?.levelCount, equals(expected.pyramid?.levelCount));
+  for (int i = 0; i < (expected.pyramid?.levelCount ?? 0); i++) {
+    expect(actual.pyramid!.levels[i].data, equals(expected.pyramid!.levels[i].data), reason: 'pyramid level $i');
+  }
+  expect(actual.duration, equals(expected.duration));
+  expect(actual.sampleRate, equals(expected.sampleRate));
+}
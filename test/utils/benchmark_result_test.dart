@@ -0,0 +1,132 @@
+import 'dart:convert';
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:sonix/src/processing/downsampling_algorithm.dart';
+import 'package:sonix/src/utils/benchmark_result.dart';
+import 'package:sonix/src/utils/waveform_benchmark.dart';
+
+void main() {
+  BenchmarkResult resultOf(Map<String, List<double>> times, {Map<String, Map<String, double>> metrics = const {}}) {
+    return BenchmarkResult(testName: 'test', results: times, metrics: metrics, iterations: 3, completedAt: DateTime.utc(2025));
+  }
+
+  group('BenchmarkResult', () {
+    test('should round-trip through JSON', () {
+      final original = resultOf(
+        {
+          'a': [10, 12, 11],
+        },
+        metrics: {
+          'a': {BenchmarkResult.throughputMetric: 120, BenchmarkResult.peakRssMetric: 1 << 20},
+        },
+      );
+
+      final restored = BenchmarkResult.fromJson(jsonDecode(jsonEncode(original.toJson())) as Map<String, dynamic>);
+
+      expect(restored.testName, equals('test'));
+      expect(restored.results['a'], equals([10, 12, 11]));
+      expect(restored.metrics['a'], equals(original.metrics['a']));
+      expect(restored.medianTime('a'), equals(11));
+      expect(restored.completedAt, equals(original.completedAt));
+    });
+
+    test('should reject JSON that is not a result', () {
+      expect(() => BenchmarkResult.fromJson({'scenarios': 'nope'}), throwsFormatException);
+    });
+
+    test('should report slower medians beyond the threshold as regressions', () {
+      final baseline = resultOf({
+        'fast': [100, 100, 100],
+        'slow': [100, 100, 100],
+        'better': [100, 100, 100],
+      });
+      // One outlier does not move the median
+      final current = resultOf({
+        'fast': [105, 500, 104],
+        'slow': [130, 125, 128],
+        'better': [50, 60, 55],
+      });
+
+      final comparison = current.compareWith(baseline, threshold: 0.1);
+
+      expect(comparison.hasRegressions, isTrue);
+      expect(comparison.regressions.single.scenario, equals('slow'));
+      expect(comparison.regressions.single.change, closeTo(0.28, 1e-9));
+      expect(comparison.improvements.single.scenario, equals('better'));
+    });
+
+    test('should ignore time differences below the minimum delta', () {
+      final baseline = resultOf({
+        'tiny': [0.2, 0.2, 0.2],
+      });
+      final current = resultOf({
+        'tiny': [0.6, 0.6, 0.6],
+      });
+
+      expect(current.compareWith(baseline).hasRegressions, isFalse);
+      expect(current.compareWith(baseline, minimumTimeDelta: 0.1).hasRegressions, isTrue);
+    });
+
+    test('should treat lower throughput and higher peak memory as regressions', () {
+      final times = {
+        'a': [10.0],
+      };
+      final baseline = resultOf(
+        times,
+        metrics: {
+          'a': {BenchmarkResult.throughputMetric: 100, BenchmarkResult.peakRssMetric: 1000, BenchmarkResult.allocatedMetric: 10},
+        },
+      );
+      final current = resultOf(
+        times,
+        metrics: {
+          'a': {BenchmarkResult.throughputMetric: 80, BenchmarkResult.peakRssMetric: 1500, BenchmarkResult.allocatedMetric: 1000},
+        },
+      );
+
+      final comparison = current.compareWith(baseline);
+
+      expect(comparison.regressions.map((d) => d.measure), unorderedEquals([BenchmarkResult.throughputMetric, BenchmarkResult.peakRssMetric]));
+    });
+
+    test('should list scenarios missing on either side', () {
+      final baseline = resultOf({
+        'old': [1],
+        'both': [1],
+      });
+      final current = resultOf({
+        'both': [1],
+        'new': [1],
+      });
+
+      final comparison = current.compareWith(baseline);
+
+      expect(comparison.addedScenarios, equals(['new']));
+      expect(comparison.missingScenarios, equals(['old']));
+      expect(comparison.hasRegressions, isFalse);
+    });
+  });
+
+  group('WaveformBenchmark', () {
+    test('should write a WAV file of the requested length', () async {
+      final tempDir = await Directory.systemTemp.createTemp('waveform_benchmark_test');
+      try {
+        final file = await WaveformBenchmark.writeTestWav('${tempDir.path}/tone.wav', const Duration(milliseconds: 1500), sampleRate: 8000, channels: 2);
+        final bytes = await file.readAsBytes();
+        final header = ByteData.sublistView(bytes, 0, 44);
+
+        expect(String.fromCharCodes(bytes.sublist(0, 4)), equals('RIFF'));
+        expect(header.getUint32(40, Endian.little), equals(12000 * 2 * 2));
+        expect(bytes.length, equals(44 + 12000 * 2 * 2));
+      } finally {
+        await tempDir.delete(recursive: true);
+      }
+    });
+
+    test('should name scenarios after the file and parameters', () {
+      expect(WaveformBenchmark.scenarioKey('/music/a.mp3', BenchmarkMode.isolate, DownsamplingAlgorithm.peak, 1000), equals('a.mp3/isolate/peak/1000'));
+    });
+  });
+}
@@ -1,9 +1,12 @@
 import 'package:flutter_test/flutter_test.dart';
+import 'package:sonix/src/models/waveform_channel_mode.dart';
+import 'package:sonix/src/processing/float32_simd.dart';
 import 'package:sonix/src/processing/waveform_algorithms.dart';
 import 'package:sonix/src/processing/downsampling_algorithm.dart';
 import 'package:sonix/src/processing/normalization_method.dart';
 import 'package:sonix/src/processing/scaling_curve.dart';
 import 'dart:math' as math;
+import 'dart:typed_data';
 
 void main() {
   group('WaveformAlgorithms', () {
@@ -103,6 +106,155 @@ void main() {
       });
     });
 
+    group('Per-Channel Downsampling', () {
+      // Stereo audio: [L1, R1, L2, R2, L3, R3, L4, R4]
+      final stereo = [0.5, -0.1, -0.8, 0.2, 0.4, -0.4, 0.9, 0.3];
+
+      test('should produce planar per-channel peaks in one pass', () {
+        final result = WaveformAlgorithms.downsampleChannels(stereo, 2, algorithm: DownsamplingAlgorithm.peak, channels: 2);
+
+        expect(result.channelCount, equals(2));
+        expect(result.channelAmplitudes.length, equals(4));
+        expect(result.channelAmplitudes[0], closeTo(0.8, 1e-6)); // Left, bin 0
+        expect(result.channelAmplitudes[1], closeTo(0.9, 1e-6)); // Left, bin 1
+        expect(result.channelAmplitudes[2], closeTo(0.2, 1e-6)); // Right, bin 0
+        expect(result.channelAmplitudes[3], closeTo(0.4, 1e-6)); // Right, bin 1
+      });
+
+      test('should compute the mixed amplitudes like downsample', () {
+        final result = WaveformAlgorithms.downsampleChannels(stereo, 2, algorithm: DownsamplingAlgorithm.rms, channels: 2);
+        final expected = WaveformAlgorithms.downsample(stereo, 2, algorithm: DownsamplingAlgorithm.rms, channels: 2);
+
+        expect(result.mixed.length, equals(expected.length));
+        for (int i = 0; i < expected.length; i++) {
+          expect(result.mixed[i], closeTo(expected[i], 1e-12));
+        }
+      });
+
+      test('should produce left, right, mid and side for midSide mode', () {
+        final result = WaveformAlgorithms.downsampleChannels(
+          stereo,
+          1,
+          algorithm: DownsamplingAlgorithm.peak,
+          channels: 2,
+          mode: WaveformChannelMode.midSide,
+        );
+
+        expect(result.channelCount, equals(4));
+        expect(result.channelAmplitudes[0], closeTo(0.9, 1e-6)); // Left
+        expect(result.channelAmplitudes[1], closeTo(0.4, 1e-6)); // Right
+        expect(result.channelAmplitudes[2], closeTo(0.6, 1e-6)); // Mid: (0.9 + 0.3) / 2
+        expect(result.channelAmplitudes[3], closeTo(0.5, 1e-6)); // Side: (-0.8 - 0.2) / 2
+      });
+
+      test('should treat mono as dual mono in midSide mode', () {
+        final result = WaveformAlgorithms.downsampleChannels(
+          [0.5, -0.5, 0.25, -0.25],
+          1,
+          algorithm: DownsamplingAlgorithm.peak,
+          mode: WaveformChannelMode.midSide,
+        );
+
+        expect(result.channelAmplitudes[0], closeTo(0.5, 1e-6));
+        expect(result.channelAmplitudes[1], closeTo(0.5, 1e-6));
+        expect(result.channelAmplitudes[2], closeTo(0.5, 1e-6));
+        expect(result.channelAmplitudes[3], equals(0.0));
+      });
+
+      test('should support median per channel', () {
+        final result = WaveformAlgorithms.downsampleChannels(stereo, 1, algorithm: DownsamplingAlgorithm.median, channels: 2);
+
+        expect(result.channelAmplitudes[0], closeTo(0.65, 1e-6)); // |0.5|, |-0.8|, |0.4|, |0.9|
+        expect(result.channelAmplitudes[1], closeTo(0.25, 1e-6)); // |-0.1|, |0.2|, |-0.4|, |0.3|
+      });
+
+      test('should handle empty samples', () {
+        final result = WaveformAlgorithms.downsampleChannels([], 10, channels: 2);
+        expect(result.mixed, isEmpty);
+        expect(result.channelAmplitudes, isEmpty);
+      });
+
+      test('should collect signed min/max/RMS bins of the mixed signal', () {
+        // Mixed frames: 0.2, -0.3, 0.0, 0.6
+        final result = WaveformAlgorithms.downsampleChannels(stereo, 2, channels: 2, mode: WaveformChannelMode.mixed, computeBins: true);
+        final bins = result.bins!;
+
+        expect(result.channelCount, equals(0));
+        expect(bins.length, equals(2));
+        expect(bins.min[0], closeTo(-0.3, 1e-6));
+        expect(bins.max[0], closeTo(0.2, 1e-6));
+        expect(bins.rms[0], closeTo(math.sqrt(0.065), 1e-6));
+        expect(bins.min[1], closeTo(0.0, 1e-6));
+        expect(bins.max[1], closeTo(0.6, 1e-6));
+        expect(bins.rms[1], closeTo(math.sqrt(0.18), 1e-6));
+        expect(bins.rms[0], closeTo(result.mixed[0], 1e-6)); // Same pass as the RMS amplitudes
+      });
+
+      test('should not collect bins unless requested', () {
+        final result = WaveformAlgorithms.downsampleChannels(stereo, 2, channels: 2);
+        expect(result.bins, isNull);
+      });
+
+      test('should reduce fixed-width bins with a partial last bin', () {
+        // Mixed frames: 0.2, -0.3, 0.0, 0.6
+        final bins = WaveformAlgorithms.downsampleFixedBins(stereo, 3, channels: 2);
+
+        expect(bins.length, equals(2));
+        expect(bins.min[0], closeTo(-0.3, 1e-6));
+        expect(bins.max[0], closeTo(0.2, 1e-6));
+        expect(bins.min[1], closeTo(0.6, 1e-6));
+        expect(bins.rms[1], closeTo(0.6, 1e-6));
+        expect(WaveformAlgorithms.downsampleFixedBins([], 256).isEmpty, isTrue);
+      });
+    });
+
+    group('Float32 SIMD paths', () {
+      final buffer = Float32List(4099);
+      for (int i = 0; i < buffer.length; i++) {
+        buffer[i] = math.sin(i * 0.013) * (0.3 + 0.7 * (i % 317) / 317);
+      }
+
+      // Views at every lane offset exercise the scalar head and tail
+      final views = [for (int offset = 0; offset < 4; offset++) Float32List.sublistView(buffer, offset, buffer.length - 3 + offset)];
+
+      test('should match the scalar RMS and peak', () {
+        for (final view in views) {
+          final scalar = List<double>.of(view);
+
+          expect(WaveformAlgorithms.calculateRMS(view), closeTo(WaveformAlgorithms.calculateRMS(scalar), 1e-6));
+          expect(WaveformAlgorithms.calculatePeak(view), equals(WaveformAlgorithms.calculatePeak(scalar)));
+          final combined = WaveformAlgorithms.calculateRMSAndPeak(view);
+          expect(combined.rms, closeTo(WaveformAlgorithms.calculateRMS(scalar), 1e-6));
+          expect(combined.peak, equals(WaveformAlgorithms.calculatePeak(scalar)));
+        }
+      });
+
+      test('should match the scalar downsampling for mono and stereo', () {
+        for (final view in views) {
+          final scalar = List<double>.of(view);
+          for (final channels in [1, 2]) {
+            for (final algorithm in [DownsamplingAlgorithm.rms, DownsamplingAlgorithm.peak, DownsamplingAlgorithm.average]) {
+              final simd = WaveformAlgorithms.downsample(view, 37, algorithm: algorithm, channels: channels);
+              final expected = WaveformAlgorithms.downsample(scalar, 37, algorithm: algorithm, channels: channels);
+
+              expect(simd, hasLength(expected.length));
+              for (int i = 0; i < expected.length; i++) {
+                expect(simd[i], closeTo(expected[i], 1e-6), reason: '$algorithm, $channels channels, offset ${view.offsetInBytes}, bin $i');
+              }
+            }
+          }
+        }
+      });
+
+      test('should reduce ranges shorter than a vector', () {
+        final simd = Float32Simd(views[1]);
+
+        expect(simd.sumOfSquares(2, 4), closeTo(views[1][2] * views[1][2] + views[1][3] * views[1][3], 1e-9));
+        expect(simd.peak(5, 5), equals(0.0));
+        expect(simd.stereoPeak(1, 2), closeTo(((views[1][2] + views[1][3]) / 2).abs(), 1e-7));
+      });
+    });
+
     group('Average Calculation', () {
       test('should calculate average of absolute values', () {
         final samples = [0.2, -0.4, 0.6, -0.8];
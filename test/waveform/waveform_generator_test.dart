@@ -1,5 +1,6 @@
 import 'package:flutter_test/flutter_test.dart';
 import 'package:sonix/src/models/audio_data.dart';
+import 'package:sonix/src/models/waveform_channel_mode.dart';
 import 'package:sonix/src/models/waveform_type.dart';
 import 'package:sonix/src/processing/waveform_generator.dart';
 import 'package:sonix/src/processing/waveform_config.dart';
@@ -81,6 +82,117 @@ void main() {
       });
     });
 
+    group('Channel Modes', () {
+      late AudioData stereoAudioData;
+
+      setUp(() {
+        // Left is a full-scale sine, right is the same sine at a quarter of the level
+        final samples = <double>[];
+        for (int i = 0; i < 1000; i++) {
+          final value = math.sin(i * 0.1) * 0.8;
+          samples
+            ..add(value)
+            ..add(value * 0.25);
+        }
+        stereoAudioData = AudioData(samples: samples, sampleRate: 44100, channels: 2, duration: const Duration(seconds: 1));
+      });
+
+      test('should not produce channel data in mixed mode', () async {
+        final result = await WaveformGenerator.generateInMemory(stereoAudioData, config: const WaveformConfig(resolution: 50));
+
+        expect(result.hasChannelData, isFalse);
+        expect(result.channelAmplitudes, isNull);
+      });
+
+      test('should produce per-channel amplitudes alongside the mixed amplitudes', () async {
+        const config = WaveformConfig(resolution: 50, channelMode: WaveformChannelMode.perChannel);
+        final result = await WaveformGenerator.generateInMemory(stereoAudioData, config: config);
+        final mixedOnly = await WaveformGenerator.generateInMemory(stereoAudioData, config: const WaveformConfig(resolution: 50));
+
+        expect(result.channelCount, equals(2));
+        expect(result.channelResolution, equals(50));
+        expect(result.channel(0).length, equals(50));
+        for (int i = 0; i < 50; i++) {
+          expect(result.amplitudes[i], closeTo(mixedOnly.amplitudes[i], 1e-9));
+        }
+      });
+
+      test('should normalize channels jointly', () async {
+        const config = WaveformConfig(resolution: 50, channelMode: WaveformChannelMode.perChannel);
+        final result = await WaveformGenerator.generateInMemory(stereoAudioData, config: config);
+
+        final left = result.channel(0);
+        final right = result.channel(1);
+        expect(left.reduce(math.max), closeTo(1.0, 1e-6));
+        expect(right.reduce(math.max), closeTo(0.25, 1e-3));
+      });
+
+      test('should produce four channels in midSide mode', () async {
+        const config = WaveformConfig(resolution: 20, channelMode: WaveformChannelMode.midSide);
+        final result = await WaveformGenerator.generateInMemory(stereoAudioData, config: config);
+
+        expect(result.channelCount, equals(4));
+        expect(result.channelAmplitudes!.length, equals(80));
+        expect(result.channelMode, equals(WaveformChannelMode.midSide));
+      });
+
+      test('should produce channel data from generateChunked', () async {
+        const config = WaveformConfig(resolution: 20, channelMode: WaveformChannelMode.perChannel);
+        final result = await WaveformGenerator.generateChunked(stereoAudioData, config: config, maxMemoryUsage: 1024);
+
+        expect(result.channelCount, equals(2));
+      });
+    });
+
+    group('Min/Max/RMS Bins', () {
+      test('should not produce bins by default', () async {
+        final result = await WaveformGenerator.generateInMemory(testAudioData, config: const WaveformConfig(resolution: 50));
+        expect(result.bins, isNull);
+      });
+
+      test('should produce normalized signed bins alongside identical amplitudes', () async {
+        const config = WaveformConfig(resolution: 50, generateBins: true);
+        final result = await WaveformGenerator.generateInMemory(testAudioData, config: config);
+        final plain = await WaveformGenerator.generateInMemory(testAudioData, config: const WaveformConfig(resolution: 50));
+        final bins = result.bins!;
+
+        expect(bins.length, equals(50));
+        expect(bins.peak, closeTo(1.0, 1e-6));
+        expect(bins.min.reduce(math.min), lessThan(-0.9));
+        for (int i = 0; i < 50; i++) {
+          expect(result.amplitudes[i], closeTo(plain.amplitudes[i], 1e-9));
+          expect(bins.min[i], lessThanOrEqualTo(bins.max[i]));
+          expect(bins.rms[i], lessThanOrEqualTo(math.max(bins.min[i].abs(), bins.max[i].abs()) + 1e-6));
+        }
+      });
+
+      test('should keep raw values when normalization is disabled', () async {
+        const config = WaveformConfig(resolution: 10, generateBins: true, normalize: false);
+        final result = await WaveformGenerator.generateChunked(testAudioData, config: config);
+
+        expect(result.bins!.peak, closeTo(0.8, 0.01));
+      });
+    });
+
+    group('Pyramid', () {
+      test('should build a pyramid at 256 frames per bin', () async {
+        const config = WaveformConfig(resolution: 10, generatePyramid: true);
+        final result = await WaveformGenerator.generateInMemory(testAudioData, config: config);
+        final pyramid = result.pyramid!;
+
+        expect(pyramid.levels.first.length, equals(4)); // ceil(1000 / 256)
+        expect(pyramid.levels.last.length, equals(1));
+        expect(pyramid.totalFrames, equals(1000));
+        expect(pyramid.levels.last.max[0], closeTo(1.0, 0.01));
+        expect(result.bins, isNull);
+      });
+
+      test('should not build a pyramid by default', () async {
+        final result = await WaveformGenerator.generateInMemory(testAudioData, config: const WaveformConfig(resolution: 10));
+        expect(result.pyramid, isNull);
+      });
+    });
+
     group('Configuration Validation', () {
       test('should throw on invalid resolution', () async {
         final invalidConfig = const WaveformConfig(resolution: 0);
@@ -225,6 +337,30 @@ void main() {
         expect(modified.normalize, isFalse); // Changed
         expect(original.normalize, isTrue); // Original unchanged
       });
+
+      test('should round-trip channel mode through JSON', () {
+        const config = WaveformConfig(channelMode: WaveformChannelMode.midSide);
+        final restored = WaveformConfig.fromJson(config.toJson());
+
+        expect(restored.channelMode, equals(WaveformChannelMode.midSide));
+        expect(WaveformConfig.fromJson(const {}).channelMode, equals(WaveformChannelMode.mixed));
+      });
+
+      test('should compare by value', () {
+        const config = WaveformConfig(resolution: 300, generateBins: true);
+
+        expect(WaveformConfig.fromJson(config.toJson()), equals(config));
+        expect(WaveformConfig.fromJson(config.toJson()).hashCode, equals(config.hashCode));
+        expect(config.copyWith(scalingFactor: 1.5), isNot(equals(config)));
+      });
+
+      test('should derive a stable 32-bit hash from the settings', () {
+        const config = WaveformConfig(resolution: 300);
+
+        expect(config.stableHash, equals(WaveformConfig.fromJson(config.toJson()).stableHash));
+        expect(config.stableHash, inInclusiveRange(0, 0xffffffff));
+        expect(config.copyWith(resolution: 301).stableHash, isNot(equals(config.stableHash)));
+      });
     });
   });
 }
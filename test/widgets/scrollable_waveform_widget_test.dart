@@ -0,0 +1,149 @@
+import 'dart:async';
+import 'dart:typed_data';
+
+import 'package:flutter/material.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:sonix/sonix.dart';
+import 'package:sonix/src/models/audio_data.dart';
+
+/// Records every range requested from the wrapped source
+class _RecordingRangeSource implements WaveformRangeSource {
+  final WaveformRangeSource inner;
+  final List<(int, int)> requests = [];
+
+  _RecordingRangeSource(this.inner);
+
+  @override
+  int get totalFrames => inner.totalFrames;
+
+  @override
+  int get sampleRate => inner.sampleRate;
+
+  @override
+  FutureOr<WaveformBins> loadBins(int startFrame, int framesPerBin, int binCount) {
+    requests.add((startFrame, framesPerBin));
+    return inner.loadBins(startFrame, framesPerBin, binCount);
+  }
+}
+
+void main() {
+  // Three hours at 44.1kHz
+  const totalFrames = 3 * 3600 * 44100;
+  final waveform = WaveformData(
+    amplitudes: List.generate(20000, (i) => (i % 100) / 100.0),
+    duration: const Duration(hours: 3),
+    sampleRate: 44100,
+    metadata: WaveformMetadata(resolution: 20000, type: WaveformType.bars, normalized: true, generatedAt: DateTime(2025)),
+  );
+
+  Widget host(Widget child) => MaterialApp(home: Scaffold(body: child));
+
+  group('WaveformViewportController', () {
+    test('should fit the whole source once the extent is known', () {
+      final viewport = WaveformViewportController();
+
+      viewport.updateExtent(totalFrames, 800);
+
+      expect(viewport.framesPerPixel, equals(totalFrames / 800));
+      expect(viewport.startFrame, equals(0.0));
+      expect(viewport.endFrame, equals(totalFrames.toDouble()));
+    });
+
+    test('should clamp scrolling and zooming to the source', () {
+      final viewport = WaveformViewportController(framesPerPixel: 100)..updateExtent(100000, 500);
+      int notifications = 0;
+      viewport.addListener(() => notifications++);
+
+      viewport.scrollTo(-10);
+      expect(viewport.startFrame, equals(0.0));
+      expect(notifications, equals(0));
+
+      viewport.scrollTo(1e9);
+      expect(viewport.startFrame, equals(50000.0));
+
+      viewport.zoomTo(0.01);
+      expect(viewport.framesPerPixel, equals(viewport.minFramesPerPixel));
+
+      viewport.zoomBy(0.0001);
+      expect(viewport.framesPerPixel, equals(200.0));
+      expect(viewport.startFrame, equals(0.0));
+      expect(notifications, equals(3));
+    });
+
+    test('should keep the focal frame in place while zooming', () {
+      final viewport = WaveformViewportController(startFrame: 10000, framesPerPixel: 10)..updateExtent(1000000, 500);
+
+      viewport.zoomBy(2, focalPixel: 100);
+
+      expect(viewport.framesPerPixel, equals(5.0));
+      expect(viewport.startFrame + 100 * viewport.framesPerPixel, equals(11000.0));
+    });
+
+    test('should show a frame range', () {
+      final viewport = WaveformViewportController()..updateExtent(totalFrames, 800);
+
+      viewport.showRange(3600.0 * 44100, 3610.0 * 44100);
+
+      expect(viewport.startFrame, equals(3600.0 * 44100));
+      expect(viewport.endFrame, closeTo(3610.0 * 44100, 1e-6));
+    });
+  });
+
+  group('ScrollableWaveformWidget', () {
+    testWidgets('should only load the tiles under the viewport and their neighbours', (tester) async {
+      final source = _RecordingRangeSource(WaveformDataRangeSource(waveform));
+      final viewport = WaveformViewportController(framesPerPixel: 64);
+
+      await tester.pumpWidget(host(ScrollableWaveformWidget(source: source, viewportController: viewport)));
+
+      // 3px per bar at 64 frames per pixel: 256 frames per bin, 65536 per tile.
+      // 800px show 51200 frames, all in tile 0; tile 1 is prefetched.
+      expect(source.requests.toSet(), equals({(0, 256), (65536, 256)}));
+    });
+
+    testWidgets('should scroll when dragged and load the newly visible tiles', (tester) async {
+      final source = _RecordingRangeSource(WaveformDataRangeSource(waveform));
+      final viewport = WaveformViewportController(framesPerPixel: 64);
+
+      await tester.pumpWidget(host(ScrollableWaveformWidget(source: source, viewportController: viewport)));
+      await tester.drag(find.byType(ScrollableWaveformWidget), const Offset(-600, 0));
+      await tester.pump();
+
+      expect(viewport.startFrame, greaterThan(0.0));
+      expect(viewport.startFrame, lessThanOrEqualTo(600.0 * 64));
+      expect(source.requests.map((request) => request.$1), contains(2 * 65536));
+    });
+
+    testWidgets('should seek to the tapped frame', (tester) async {
+      final viewport = WaveformViewportController(startFrame: 44100.0 * 60, framesPerPixel: 64);
+      final controller = WaveformController();
+      double? seekPosition;
+
+      await tester.pumpWidget(
+        host(ScrollableWaveformWidget.fromWaveformData(waveform, viewportController: viewport, controller: controller, onSeek: (position) => seekPosition = position)),
+      );
+      await tester.tap(find.byType(ScrollableWaveformWidget));
+      await tester.pump();
+
+      final tappedFrame = 44100.0 * 60 + 400 * 64;
+      expect(seekPosition, closeTo(tappedFrame / totalFrames, 1e-9));
+      expect(controller.position, equals(seekPosition));
+
+      controller.dispose();
+    });
+
+    testWidgets('should paint tiles that load asynchronously', (tester) async {
+      final samples = Float32List.fromList(List.generate(44100, (i) => (i % 441) / 441.0));
+      final source = AudioRangeSource.fromAudioData(AudioData(samples: samples, sampleRate: 44100, channels: 1, duration: const Duration(seconds: 1)));
+
+      for (final type in WaveformType.values) {
+        await tester.pumpWidget(
+          host(ScrollableWaveformWidget(source: source, style: WaveformStyle(type: type, showCenterLine: true), playbackPosition: 0.5)),
+        );
+        await tester.pump();
+
+        expect(tester.takeException(), isNull);
+      }
+    });
+  });
+}
@@ -1,14 +1,22 @@
+import 'dart:typed_data';
+
 import 'package:flutter_test/flutter_test.dart';
+import 'package:sonix/src/models/waveform_bins.dart';
+import 'package:sonix/src/models/waveform_channel_mode.dart';
 import 'package:sonix/src/models/waveform_data.dart';
+import 'package:sonix/src/models/waveform_metadata.dart';
 import 'package:sonix/src/models/waveform_type.dart';
 
+/// Matches a [Float32List] against doubles rounded to 32-bit precision
+Matcher equalsFloats(List<double> expected) => equals(Float32List.fromList(expected));
+
 void main() {
   group('Waveform Data Tests', () {
     test('should create WaveformData from amplitude list', () {
       final amplitudes = [0.1, 0.5, 0.8, 0.3, 0.9, 0.2];
       final waveformData = WaveformData.fromAmplitudes(amplitudes);
 
-      expect(waveformData.amplitudes, equals(amplitudes));
+      expect(waveformData.amplitudes, equalsFloats(amplitudes));
       expect(waveformData.metadata.resolution, equals(6));
       expect(waveformData.metadata.type, equals(WaveformType.bars));
       expect(waveformData.metadata.normalized, isTrue);
@@ -18,7 +26,7 @@ void main() {
       final amplitudeString = '[0.1, 0.5, 0.8, 0.3, 0.9, 0.2]';
       final waveformData = WaveformData.fromAmplitudeString(amplitudeString);
 
-      expect(waveformData.amplitudes, equals([0.1, 0.5, 0.8, 0.3, 0.9, 0.2]));
+      expect(waveformData.amplitudes, equalsFloats([0.1, 0.5, 0.8, 0.3, 0.9, 0.2]));
       expect(waveformData.amplitudes.length, equals(6));
     });
 
@@ -28,9 +36,20 @@ void main() {
       expect(waveformData.metadata.resolution, equals(0));
     });
 
+    test('should accept integer amplitudes from JSON', () {
+      final waveformData = WaveformData.fromAmplitudeString('[0, 1, 0.5]');
+      expect(waveformData.amplitudes, equals([0.0, 1.0, 0.5]));
+    });
+
+    test('should release amplitudes on dispose', () {
+      final waveformData = WaveformData.fromAmplitudes([0.1, 0.5]);
+      waveformData.dispose();
+      expect(waveformData.amplitudes, isEmpty);
+    });
+
     test('should handle single amplitude value', () {
       final waveformData = WaveformData.fromAmplitudes([0.7]);
-      expect(waveformData.amplitudes, equals([0.7]));
+      expect(waveformData.amplitudes, equalsFloats([0.7]));
       expect(waveformData.metadata.resolution, equals(1));
     });
 
@@ -43,10 +62,87 @@ void main() {
       };
 
       final waveformData = WaveformData.fromJson(originalData);
-      expect(waveformData.amplitudes, equals([0.1, 0.5, 0.8, 0.3, 0.9, 0.2]));
+      expect(waveformData.amplitudes, equalsFloats([0.1, 0.5, 0.8, 0.3, 0.9, 0.2]));
       expect(waveformData.duration.inSeconds, equals(5));
       expect(waveformData.sampleRate, equals(44100));
     });
+
+    group('per-channel amplitudes', () {
+      WaveformData stereoWaveform() => WaveformData(
+        amplitudes: [0.5, 0.75, 1.0],
+        duration: const Duration(seconds: 3),
+        sampleRate: 44100,
+        metadata: WaveformMetadata(resolution: 3, type: WaveformType.bars, normalized: true, generatedAt: DateTime.utc(2024)),
+        channelAmplitudes: Float32List.fromList([0.5, 0.5, 1.0, 0.25, 0.5, 0.75]),
+        channelCount: 2,
+        channelMode: WaveformChannelMode.perChannel,
+      );
+
+      test('should expose zero-copy channel views', () {
+        final waveform = stereoWaveform();
+
+        expect(waveform.hasChannelData, isTrue);
+        expect(waveform.channelResolution, equals(3));
+        expect(waveform.channel(0), equals([0.5, 0.5, 1.0]));
+        expect(waveform.channel(1), equals([0.25, 0.5, 0.75]));
+        expect(waveform.channel(1).buffer, same(waveform.channelAmplitudes!.buffer));
+      });
+
+      test('should reject out-of-range channels', () {
+        expect(() => stereoWaveform().channel(2), throwsRangeError);
+      });
+
+      test('should throw StateError without channel data', () {
+        expect(() => WaveformData.fromAmplitudes([0.1, 0.2]).channel(0), throwsStateError);
+      });
+
+      test('should round-trip channel data through JSON', () {
+        final restored = WaveformData.fromJsonString(stereoWaveform().toJsonString());
+
+        expect(restored.channelCount, equals(2));
+        expect(restored.channelMode, equals(WaveformChannelMode.perChannel));
+        expect(restored.channel(1), equals([0.25, 0.5, 0.75]));
+      });
+
+      test('should omit channel fields from JSON for mixed waveforms', () {
+        final json = WaveformData.fromAmplitudes([0.1, 0.2]).toJson();
+        expect(json.containsKey('channelAmplitudes'), isFalse);
+      });
+    });
+
+    group('min/max/RMS bins', () {
+      test('should expose struct-of-arrays views', () {
+        final bins = WaveformBins(Float32List.fromList([-0.5, -1.0, 0.25, 0.75, 0.2, 0.5]));
+
+        expect(bins.length, equals(2));
+        expect(bins.min, equals([-0.5, -1.0]));
+        expect(bins.max, equals([0.25, 0.75]));
+        expect(bins.rms, equalsFloats([0.2, 0.5]));
+        expect(bins.peak, equals(1.0));
+        expect(bins.max.buffer, same(bins.data.buffer));
+      });
+
+      test('should reject buffers that are not a multiple of three', () {
+        expect(() => WaveformBins(Float32List(4)), throwsArgumentError);
+      });
+
+      test('should round-trip bins through JSON', () {
+        final waveform = WaveformData(
+          amplitudes: [0.5, 1.0],
+          duration: const Duration(seconds: 1),
+          sampleRate: 44100,
+          metadata: WaveformMetadata(resolution: 2, type: WaveformType.bars, normalized: true, generatedAt: DateTime.utc(2024)),
+          bins: WaveformBins(Float32List.fromList([-0.5, -1.0, 0.25, 0.75, 0.2, 0.5])),
+        );
+
+        final restored = WaveformData.fromJsonString(waveform.toJsonString());
+
+        expect(restored.bins, isNotNull);
+        expect(restored.bins!.min, equals([-0.5, -1.0]));
+        expect(restored.bins!.rms, equalsFloats([0.2, 0.5]));
+        expect(WaveformData.fromAmplitudes([0.1]).toJson().containsKey('bins'), isFalse);
+      });
+    });
   });
 }
 
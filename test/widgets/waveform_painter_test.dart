@@ -0,0 +1,69 @@
+import 'dart:typed_data';
+import 'dart:ui' as ui;
+
+import 'package:flutter/material.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:sonix/sonix.dart';
+
+void main() {
+  TestWidgetsFlutterBinding.ensureInitialized();
+
+  group('WaveformPainter', () {
+    const size = Size(300, 80);
+    final waveform = WaveformData.fromAmplitudes(List.generate(2000, (i) => (i % 50) / 50.0));
+
+    /// Paints [painter] into a picture and rasterizes it
+    Future<ByteData> render(WaveformPainter painter) async {
+      final recorder = ui.PictureRecorder();
+      painter.paint(Canvas(recorder), size);
+      final image = await recorder.endRecording().toImage(size.width.toInt(), size.height.toInt());
+      final bytes = await image.toByteData();
+      image.dispose();
+      return bytes!;
+    }
+
+    /// RGBA of the pixel at ([x], [y])
+    List<int> pixel(ByteData bytes, int x, int y) {
+      final offset = (y * size.width.toInt() + x) * 4;
+      return [for (int i = 0; i < 4; i++) bytes.getUint8(offset + i)];
+    }
+
+    for (final type in WaveformType.values) {
+      test('should paint ${type.name} waveforms at any playback position', () async {
+        final style = WaveformStyle(type: type, playedColor: Colors.red, unplayedColor: Colors.blue, showCenterLine: true, gradient: const LinearGradient(colors: [Colors.white, Colors.black]));
+
+        for (final position in [null, 0.0, 0.3, 1.0]) {
+          await render(WaveformPainter(waveformData: waveform, style: style, playbackPosition: position));
+        }
+      });
+    }
+
+    test('should paint the signed envelope of waveforms with bins', () async {
+      final withBins = WaveformData(
+        amplitudes: List.filled(100, 0.5),
+        duration: const Duration(seconds: 1),
+        sampleRate: 44100,
+        metadata: WaveformMetadata(resolution: 100, type: WaveformType.bars, normalized: true, generatedAt: DateTime(2025)),
+        bins: WaveformBins(Float32List.fromList([...List.filled(100, -0.5), ...List.filled(100, 0.5), ...List.filled(100, 0.3)])),
+      );
+
+      for (final type in WaveformType.values) {
+        final style = WaveformStyle(type: type, downsampleMethod: DownsampleMethod.minMax);
+        await render(WaveformPainter(waveformData: withBins, style: style, playbackPosition: 0.5));
+      }
+    });
+
+    test('should split played and unplayed colors at the playback position', () async {
+      final solid = WaveformData.fromAmplitudes(List.filled(100, 1.0));
+      const style = WaveformStyle(playedColor: Color(0xFFFF0000), unplayedColor: Color(0xFF0000FF), barSpacing: 0, padding: EdgeInsets.zero, antiAlias: false);
+
+      final half = await render(WaveformPainter(waveformData: solid, style: style, playbackPosition: 0.5));
+      expect(pixel(half, 60, 40), equals([0xFF, 0, 0, 0xFF]));
+      expect(pixel(half, 240, 40), equals([0, 0, 0xFF, 0xFF]));
+
+      // Same recordings, clip moved
+      final most = await render(WaveformPainter(waveformData: solid, style: style, playbackPosition: 0.9));
+      expect(pixel(most, 240, 40), equals([0xFF, 0, 0, 0xFF]));
+    });
+  });
+}